@@ -75,6 +75,7 @@ struct frDebugSettings;
 class FlexDR;
 struct FlexDRViaData;
 class frMarker;
+class frMarkerStreamWriter;
 
 struct ParamStruct
 {
@@ -99,6 +100,7 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  bool mazeDistHeuristic = false;
 };
 
 class TritonRoute
@@ -154,6 +156,7 @@ class TritonRoute
   void setSharedVolume(const std::string& vol);
   void setCloudSize(unsigned int cloud_sz) { cloud_sz_ = cloud_sz; }
   unsigned int getCloudSize() const { return cloud_sz_; }
+  void setCompressUpdates(bool on) { compress_updates_ = on; }
   void setDebugPaEdge(bool on = true);
   void setDebugPaCommit(bool on = true);
   void reportConstraints();
@@ -166,6 +169,11 @@ class TritonRoute
   // for debugging and not general usage.
   std::string runDRWorker(const std::string& workerStr, FlexDRViaData* viaData);
   void debugSingleWorker(const std::string& dumpDir, const std::string& drcRpt);
+  // Replays a dumped worker the given number of times and reports
+  // maze expansion and GC check throughput.  Used for benchmarking.
+  void benchSingleWorker(const std::string& dumpDir, int iterations);
+  // Reports the process peak memory at the end of a benchmark run.
+  void reportBenchPeakMemory() const;
   void updateGlobals(const char* file_name);
   void resetDb(const char* file_name);
   void clearDesign();
@@ -183,6 +191,9 @@ class TritonRoute
   void reportDRC(const std::string& file_name,
                  const std::list<std::unique_ptr<frMarker>>& markers,
                  odb::Rect drcBox = odb::Rect(0, 0, 0, 0));
+  void reportDRCBinary(const std::string& file_name,
+                       const std::list<std::unique_ptr<frMarker>>& markers,
+                       odb::Rect drcBox);
   void checkDRC(const char* filename, int x1, int y1, int x2, int y2);
   bool initGuide();
   void prep();
@@ -209,6 +220,7 @@ class TritonRoute
   std::mutex results_mutex_;
   int results_sz_{0};
   unsigned int cloud_sz_{0};
+  bool compress_updates_{false};
   boost::asio::thread_pool dist_pool_{1};
 
   void initDesign();
@@ -216,8 +228,11 @@ class TritonRoute
   void ta();
   void dr();
   void applyUpdates(const std::vector<std::vector<drUpdate>>& updates);
+  void applyDebugWorkerParams(FlexDRWorker* worker) const;
   void getDRCMarkers(std::list<std::unique_ptr<frMarker>>& markers,
-                     const odb::Rect& requiredDrcBox);
+                     const odb::Rect& requiredDrcBox,
+                     frMarkerStreamWriter* stream = nullptr);
+  void streamDRCMarker(frMarkerStreamWriter& stream, const frMarker* marker);
   void stackVias(odb::dbBTerm* bterm,
                  int top_layer_idx,
                  int bterm_bottom_layer_idx,
@@ -30,14 +30,18 @@
 
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <set>
 
 #include "DesignCallBack.h"
+#include "db/infra/frTime.h"
 #include "db/tech/frTechObject.h"
 #include "distributed/PinAccessJobDescription.h"
 #include "distributed/RoutingCallBack.h"
 #include "distributed/drUpdate.h"
+#include "distributed/drUpdateCodec.h"
 #include "distributed/frArchive.h"
 #include "dr/FlexDR.h"
 #include "dr/FlexDR_graphics.h"
@@ -48,6 +52,7 @@
 #include "global.h"
 #include "gr/FlexGR.h"
 #include "gui/gui.h"
+#include "io/frMarkerStream.h"
 #include "io/io.h"
 #include "odb/dbShape.h"
 #include "ord/OpenRoad.hh"
@@ -69,6 +74,34 @@ extern int Drt_Init(Tcl_Interp* interp);
 
 namespace drt {
 
+namespace {
+
+// .drcb reports index their markers in 100um x 100um tiles
+constexpr int drcb_tile_size_microns = 100;
+
+bool isBinaryDRCReport(const std::string& file_name)
+{
+  return file_name.size() > 5
+         && file_name.compare(file_name.size() - 5, 5, ".drcb") == 0;
+}
+
+std::unique_ptr<frMarkerStreamWriter> openBinaryDRCReport(
+    const std::string& file_name,
+    frTechObject* tech,
+    utl::Logger* logger)
+{
+  const int dbu = tech->getDBUPerUU();
+  auto writer = std::make_unique<frMarkerStreamWriter>(
+      file_name, dbu, drcb_tile_size_microns * dbu);
+  if (!writer->isOpen()) {
+    logger->warn(DRT, 626, "Cannot open DRC report file {}.", file_name);
+    return nullptr;
+  }
+  return writer;
+}
+
+}  // namespace
+
 TritonRoute::TritonRoute()
     : debug_(std::make_unique<frDebugSettings>()),
       db_callback_(std::make_unique<DesignCallBack>(this)),
@@ -227,6 +260,31 @@ std::string TritonRoute::runDRWorker(const std::string& workerStr,
   return result;
 }
 
+void TritonRoute::applyDebugWorkerParams(FlexDRWorker* worker) const
+{
+  if (debug_->mazeEndIter != -1) {
+    worker->setMazeEndIter(debug_->mazeEndIter);
+  }
+  if (debug_->markerCost != -1) {
+    worker->setMarkerCost(debug_->markerCost);
+  }
+  if (debug_->drcCost != -1) {
+    worker->setDrcCost(debug_->drcCost);
+  }
+  if (debug_->fixedShapeCost != -1) {
+    worker->setFixedShapeCost(debug_->fixedShapeCost);
+  }
+  if (debug_->markerDecay != -1) {
+    worker->setMarkerDecay(debug_->markerDecay);
+  }
+  if (debug_->ripupMode != -1) {
+    worker->setRipupMode(getMode(debug_->ripupMode));
+  }
+  if (debug_->followGuide != -1) {
+    worker->setFollowGuide((debug_->followGuide == 1));
+  }
+}
+
 void TritonRoute::debugSingleWorker(const std::string& dumpDir,
                                     const std::string& drcRpt)
 {
@@ -252,27 +310,7 @@ void TritonRoute::debugSingleWorker(const std::string& dumpDir,
   workerFile.close();
   auto worker
       = FlexDRWorker::load(workerStr, logger_, design_.get(), graphics_.get());
-  if (debug_->mazeEndIter != -1) {
-    worker->setMazeEndIter(debug_->mazeEndIter);
-  }
-  if (debug_->markerCost != -1) {
-    worker->setMarkerCost(debug_->markerCost);
-  }
-  if (debug_->drcCost != -1) {
-    worker->setDrcCost(debug_->drcCost);
-  }
-  if (debug_->fixedShapeCost != -1) {
-    worker->setFixedShapeCost(debug_->fixedShapeCost);
-  }
-  if (debug_->markerDecay != -1) {
-    worker->setMarkerDecay(debug_->markerDecay);
-  }
-  if (debug_->ripupMode != -1) {
-    worker->setRipupMode(getMode(debug_->ripupMode));
-  }
-  if (debug_->followGuide != -1) {
-    worker->setFollowGuide((debug_->followGuide == 1));
-  }
+  applyDebugWorkerParams(worker.get());
   worker->setSharedVolume(shared_volume_);
   worker->setDebugSettings(debug_.get());
   worker->setViaData(&viaData);
@@ -294,6 +332,78 @@ void TritonRoute::debugSingleWorker(const std::string& dumpDir,
   }
 }
 
+void TritonRoute::benchSingleWorker(const std::string& dumpDir,
+                                    int iterations)
+{
+  {
+    io::Writer writer(this, logger_);
+    writer.updateTrackAssignment(db_->getChip()->getBlock());
+  }
+  FlexDRViaData viaData;
+  std::ifstream viaDataFile(fmt::format("{}/viadata.bin", dumpDir),
+                            std::ios::binary);
+  if (!viaDataFile.good()) {
+    logger_->error(DRT, 627, "Cannot open {}/viadata.bin.", dumpDir);
+  }
+  frIArchive ar(viaDataFile);
+  ar >> viaData;
+
+  std::ifstream workerFile(fmt::format("{}/worker.bin", dumpDir),
+                           std::ios::binary);
+  if (!workerFile.good()) {
+    logger_->error(DRT, 628, "Cannot open {}/worker.bin.", dumpDir);
+  }
+  std::string workerStr((std::istreambuf_iterator<char>(workerFile)),
+                        std::istreambuf_iterator<char>());
+  workerFile.close();
+
+  // The replayed worker only routes inside its own copy of the grid graph
+  // and never calls end(), so every iteration starts from the same state.
+  uint64_t numExpansions = 0;
+  uint64_t numGCChecks = 0;
+  std::chrono::duration<double> elapsed(0);
+  for (int i = 0; i < iterations; i++) {
+    auto worker
+        = FlexDRWorker::load(workerStr, logger_, design_.get(), nullptr);
+    applyDebugWorkerParams(worker.get());
+    worker->setSharedVolume(shared_volume_);
+    worker->setDebugSettings(debug_.get());
+    worker->setViaData(&viaData);
+    const auto start = std::chrono::steady_clock::now();
+    worker->reloadedMain();
+    elapsed += std::chrono::steady_clock::now() - start;
+    numExpansions += worker->getNumMazeExpansions();
+    numGCChecks += worker->getNumGCChecks();
+  }
+
+  const double seconds = std::max(elapsed.count(), 1e-9);
+  logger_->info(DRT,
+                629,
+                "Replayed worker {} {} times in {:.3f}s ({:.3f}s per run).",
+                dumpDir,
+                iterations,
+                elapsed.count(),
+                elapsed.count() / iterations);
+  logger_->info(DRT,
+                630,
+                "  Maze expansions: {} ({:.0f}/s).",
+                numExpansions,
+                numExpansions / seconds);
+  logger_->info(DRT,
+                631,
+                "  GC checks: {} ({:.1f}/s).",
+                numGCChecks,
+                numGCChecks / seconds);
+}
+
+void TritonRoute::reportBenchPeakMemory() const
+{
+  // The high-water mark covers the whole process, so it is reported once
+  // after all workers have been replayed.
+  logger_->info(
+      DRT, 623, "Peak memory: {:.2f}MB.", getPeakRSS() / (1024.0 * 1024.0));
+}
+
 void TritonRoute::updateGlobals(const char* file_name)
 {
   std::ifstream file(file_name);
@@ -325,9 +435,13 @@ void TritonRoute::clearDesign()
 
 static void deserializeUpdate(frDesign* design,
                               const std::string& updateStr,
-                              std::vector<drUpdate>& updates)
+                              std::vector<drUpdate>& updates,
+                              utl::Logger* logger)
 {
-  std::ifstream file(updateStr.c_str());
+  std::ifstream file(updateStr.c_str(), std::ios::binary);
+  if (drUpdateCodec::read(design, file, updates, logger)) {
+    return;
+  }
   frIArchive ar(file);
   ar.setDesign(design);
   registerTypes(ar);
@@ -353,7 +467,7 @@ void TritonRoute::updateDesign(const std::vector<std::string>& updatesStrs)
   std::vector<std::vector<drUpdate>> updates(updatesStrs.size());
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < updatesStrs.size(); i++) {
-    deserializeUpdate(design_.get(), updatesStrs.at(i), updates[i]);
+    deserializeUpdate(design_.get(), updatesStrs.at(i), updates[i], logger_);
   }
   applyUpdates(updates);
 }
@@ -829,12 +943,12 @@ void TritonRoute::sendDesignDist()
   design_->clearUpdates();
 }
 static void serializeUpdatesBatch(const std::vector<drUpdate>& batch,
-                                  const std::string& file_name)
+                                  const std::string& file_name,
+                                  bool compress,
+                                  utl::Logger* logger)
 {
-  std::ofstream file(file_name.c_str());
-  frOArchive ar(file);
-  registerTypes(ar);
-  ar << batch;
+  std::ofstream file(file_name.c_str(), std::ios::binary);
+  drUpdateCodec::write(batch, file, compress, logger);
   file.close();
 }
 
@@ -881,7 +995,8 @@ void TritonRoute::sendDesignUpdates(const std::string& globals_path)
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < designUpdates.size(); i++) {
     updates[i] = fmt::format("{}updates_{}.bin", shared_volume_, i);
-    serializeUpdatesBatch(designUpdates.at(i), updates[i]);
+    serializeUpdatesBatch(
+        designUpdates.at(i), updates[i], compress_updates_, logger_);
   }
   serializeTask->done();
   std::unique_ptr<ProfileTask> task;
@@ -1041,8 +1156,11 @@ void TritonRoute::fixMaxSpacing()
   writer.updateDb(db_);
 }
 
+// With a stream, markers are written to it as each batch of workers
+// finishes instead of being collected in markers.
 void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
-                                const Rect& requiredDrcBox)
+                                const Rect& requiredDrcBox,
+                                frMarkerStreamWriter* stream)
 {
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
   std::vector<std::vector<std::unique_ptr<FlexGCWorker>>> workersBatches(1);
@@ -1078,7 +1196,7 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
       workersBatches.back().push_back(std::move(gcWorker));
     }
   }
-  std::map<MarkerId, frMarker*> mapMarkers;
+  std::set<MarkerId> markerIds;
   omp_set_num_threads(MAX_THREADS);
   for (auto& workers : workersBatches) {
 #pragma omp parallel for schedule(dynamic)
@@ -1094,13 +1212,15 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
         }
         auto layerNum = marker->getLayerNum();
         auto con = marker->getConstraint();
-        if (mapMarkers.find({bbox, layerNum, con, marker->getSrcs()})
-            != mapMarkers.end()) {
+        if (!markerIds.insert({bbox, layerNum, con, marker->getSrcs()})
+                 .second) {
           continue;
         }
-        markers.push_back(std::make_unique<frMarker>(*marker));
-        mapMarkers[{bbox, layerNum, con, marker->getSrcs()}]
-            = markers.back().get();
+        if (stream) {
+          streamDRCMarker(*stream, marker.get());
+        } else {
+          markers.push_back(std::make_unique<frMarker>(*marker));
+        }
       }
     }
     workers.clear();
@@ -1125,6 +1245,14 @@ void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
     requiredDrcBox = design_->getTopBlock()->getBBox();
   }
   frList<std::unique_ptr<frMarker>> markers;
+  if (isBinaryDRCReport(filename)) {
+    auto writer = openBinaryDRCReport(filename, design_->getTech(), logger_);
+    if (writer) {
+      getDRCMarkers(markers, requiredDrcBox, writer.get());
+      writer->close();
+    }
+    return;
+  }
   getDRCMarkers(markers, requiredDrcBox);
   reportDRC(filename, markers, requiredDrcBox);
 }
@@ -1344,6 +1472,7 @@ void TritonRoute::setParams(const ParamStruct& params)
     MINNUMACCESSPOINT_MACROCELLPIN = params.minAccessPoints;
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
+  MAZE_DIST_HEURISTIC = params.mazeDistHeuristic;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
 }
 
@@ -1374,6 +1503,70 @@ int TritonRoute::getWorkerResultsSize()
   return results_sz_;
 }
 
+namespace {
+
+std::string getViolName(const frMarker* marker, const frLayer* layer)
+{
+  auto con = marker->getConstraint();
+  if (!con) {
+    return "nullptr";
+  }
+  if (con->typeId() == frConstraintTypeEnum::frcShortConstraint
+      && layer->getType() == dbTechLayerType::CUT) {
+    return "Cut Short";
+  }
+  return con->getViolName();
+}
+
+// get source(s) of violation
+// format: type:name/identifier
+std::string getViolSrcs(const frMarker* marker, utl::Logger* logger)
+{
+  std::string srcs;
+  for (auto src : marker->getSrcs()) {
+    if (src) {
+      switch (src->typeId()) {
+        case frcNet:
+          srcs += "net:" + (static_cast<frNet*>(src))->getName() + " ";
+          break;
+        case frcInstTerm: {
+          frInstTerm* instTerm = (static_cast<frInstTerm*>(src));
+          srcs += "iterm:" + instTerm->getInst()->getName() + "/"
+                  + instTerm->getTerm()->getName() + " ";
+          break;
+        }
+        case frcBTerm: {
+          frBTerm* bterm = (static_cast<frBTerm*>(src));
+          srcs += "bterm:" + bterm->getName() + " ";
+          break;
+        }
+        case frcInstBlockage: {
+          frInst* inst = (static_cast<frInstBlockage*>(src))->getInst();
+          srcs += "inst:" + inst->getName() + " ";
+          break;
+        }
+        case frcInst: {
+          frInst* inst = (static_cast<frInst*>(src));
+          srcs += "inst:" + inst->getName() + " ";
+          break;
+        }
+        case frcBlockage: {
+          srcs += "obstruction: ";
+          break;
+        }
+        default:
+          logger->error(DRT,
+                        291,
+                        "Unexpected source type in marker: {}",
+                        src->typeId());
+      }
+    }
+  }
+  return srcs;
+}
+
+}  // namespace
+
 void TritonRoute::reportDRC(const std::string& file_name,
                             const frList<std::unique_ptr<frMarker>>& markers,
                             Rect drcBox)
@@ -1389,76 +1582,24 @@ void TritonRoute::reportDRC(const std::string& file_name,
     }
     return;
   }
+  if (isBinaryDRCReport(file_name)) {
+    reportDRCBinary(file_name, markers, drcBox);
+    return;
+  }
   std::ofstream drcRpt(file_name.c_str());
   if (drcRpt.is_open()) {
+    auto tech = getDesign()->getTech();
     for (const auto& marker : markers) {
       // get violation bbox
       Rect bbox = marker->getBBox();
       if (drcBox != Rect() && !drcBox.intersects(bbox)) {
         continue;
       }
-      auto tech = getDesign()->getTech();
       auto layer = tech->getLayer(marker->getLayerNum());
-      auto layerType = layer->getType();
-
-      auto con = marker->getConstraint();
-      drcRpt << "  violation type: ";
-      if (con) {
-        std::string violName;
-        if (con->typeId() == frConstraintTypeEnum::frcShortConstraint
-            && layerType == dbTechLayerType::CUT) {
-          violName = "Cut Short";
-        } else {
-          violName = con->getViolName();
-        }
-        drcRpt << violName;
-      } else {
-        drcRpt << "nullptr";
-      }
-      drcRpt << std::endl;
-      // get source(s) of violation
-      // format: type:name/identifier
-      drcRpt << "    srcs: ";
-      for (auto src : marker->getSrcs()) {
-        if (src) {
-          switch (src->typeId()) {
-            case frcNet:
-              drcRpt << "net:" << (static_cast<frNet*>(src))->getName() << " ";
-              break;
-            case frcInstTerm: {
-              frInstTerm* instTerm = (static_cast<frInstTerm*>(src));
-              drcRpt << "iterm:" << instTerm->getInst()->getName() << "/"
-                     << instTerm->getTerm()->getName() << " ";
-              break;
-            }
-            case frcBTerm: {
-              frBTerm* bterm = (static_cast<frBTerm*>(src));
-              drcRpt << "bterm:" << bterm->getName() << " ";
-              break;
-            }
-            case frcInstBlockage: {
-              frInst* inst = (static_cast<frInstBlockage*>(src))->getInst();
-              drcRpt << "inst:" << inst->getName() << " ";
-              break;
-            }
-            case frcInst: {
-              frInst* inst = (static_cast<frInst*>(src));
-              drcRpt << "inst:" << inst->getName() << " ";
-              break;
-            }
-            case frcBlockage: {
-              drcRpt << "obstruction: ";
-              break;
-            }
-            default:
-              logger_->error(DRT,
-                             291,
-                             "Unexpected source type in marker: {}",
-                             src->typeId());
-          }
-        }
-      }
-      drcRpt << "\n";
+
+      drcRpt << "  violation type: " << getViolName(marker.get(), layer)
+             << std::endl;
+      drcRpt << "    srcs: " << getViolSrcs(marker.get(), logger_) << "\n";
 
       drcRpt << "    bbox = ( " << bbox.xMin() / dbu << ", "
              << bbox.yMin() / dbu << " ) - ( " << bbox.xMax() / dbu << ", "
@@ -1470,4 +1611,34 @@ void TritonRoute::reportDRC(const std::string& file_name,
   }
 }
 
+// The design markers are repaired between the DR iterations, so they are
+// only written once they are final.
+void TritonRoute::reportDRCBinary(
+    const std::string& file_name,
+    const frList<std::unique_ptr<frMarker>>& markers,
+    Rect drcBox)
+{
+  auto writer = openBinaryDRCReport(file_name, getDesign()->getTech(), logger_);
+  if (!writer) {
+    return;
+  }
+  for (const auto& marker : markers) {
+    if (drcBox != Rect() && !drcBox.intersects(marker->getBBox())) {
+      continue;
+    }
+    streamDRCMarker(*writer, marker.get());
+  }
+  writer->close();
+}
+
+void TritonRoute::streamDRCMarker(frMarkerStreamWriter& stream,
+                                  const frMarker* marker)
+{
+  auto layer = getDesign()->getTech()->getLayer(marker->getLayerNum());
+  stream.addMarker(layer->getName(),
+                   getViolName(marker, layer),
+                   getViolSrcs(marker, logger_),
+                   marker->getBBox());
+}
+
 }  // namespace drt
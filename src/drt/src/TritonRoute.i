@@ -54,13 +54,15 @@ int detailed_route_num_drvs()
 void detailed_route_distributed(const char* remote_ip,
                                 unsigned short remote_port,
                                 const char* sharedVolume,
-                                unsigned int cloud_sz)
+                                unsigned int cloud_sz,
+                                bool compress_updates)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   router->setDistributed(true);
   router->setWorkerIpPort(remote_ip, remote_port);
   router->setSharedVolume(sharedVolume);
   router->setCloudSize(cloud_sz);
+  router->setCompressUpdates(compress_updates);
 }
 
 void detailed_route_set_default_via(const char* viaName)
@@ -95,7 +97,8 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        bool mazeDistHeuristic)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +125,8 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    mazeDistHeuristic});
   router->main();
   router->setDistributed(false);
 }
@@ -212,6 +216,26 @@ run_worker_cmd(const char* dump_dir, const char* worker_dir, const char* drc_rpt
   router->debugSingleWorker(fmt::format("{}/{}", dump_dir, worker_dir), drc_rpt);
 }
 
+void
+bench_worker_cmd(const char* dump_dir, const char* worker_dir, int iterations)
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->updateGlobals(fmt::format("{}/init_globals.bin", dump_dir).c_str());
+  router->resetDb(fmt::format("{}/design.odb", dump_dir).c_str());
+  router->updateGlobals(fmt::format("{}/{}/globals.bin", dump_dir, worker_dir).c_str());
+  router->updateDesign(fmt::format("{}/{}/updates.bin", dump_dir, worker_dir).c_str());
+  router->updateGlobals(fmt::format("{}/{}/worker_globals.bin", dump_dir, worker_dir).c_str());
+
+  router->benchSingleWorker(fmt::format("{}/{}", dump_dir, worker_dir), iterations);
+}
+
+void
+bench_report_peak_memory_cmd()
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->reportBenchPeakMemory();
+}
+
 void detailed_route_step_drt(int size,
                              int offset,
                              int mazeEndIter,
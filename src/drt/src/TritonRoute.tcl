@@ -54,12 +54,14 @@ sta::define_cmd_args "detailed_route" {
     [-remote_port rport]
     [-shared_volume vol]
     [-cloud_size sz]
+    [-compress_updates]
     [-clean_patches]
     [-no_pin_access]
     [-min_access_points count]
     [-save_guide_updates]
     [-repair_pdn_vias layer]
     [-single_step_dr]
+    [-maze_dist_heuristic]
 }
 
 proc detailed_route { args } {
@@ -70,7 +72,8 @@ proc detailed_route { args } {
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
       -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
     flags {-disable_via_gen -distributed -clean_patches -no_pin_access \
-           -single_step_dr -save_guide_updates}
+           -single_step_dr -save_guide_updates -compress_updates \
+           -maze_dist_heuristic}
   sta::check_argc_eq0 "detailed_route" $args
 
   set enable_via_gen [expr ![info exists flags(-disable_via_gen)]]
@@ -80,6 +83,7 @@ proc detailed_route { args } {
   # development.  It is not listed in the help string intentionally.
   set single_step_dr [expr [info exists flags(-single_step_dr)]]
   set save_guide_updates [expr [info exists flags(-save_guide_updates)]]
+  set maze_dist_heuristic [expr [info exists flags(-maze_dist_heuristic)]]
 
   if { [info exists keys(-repair_pdn_vias)] } {
     set repair_pdn_vias $keys(-repair_pdn_vias)
@@ -184,7 +188,8 @@ proc detailed_route { args } {
     } else {
       utl::error DRT 516 "-cloud_size is required for distributed routing."
     }
-    drt::detailed_route_distributed $rhost $rport $vol $cloudsz
+    set compress_updates [info exists flags(-compress_updates)]
+    drt::detailed_route_distributed $rhost $rport $vol $cloudsz $compress_updates
   }
   if { [info exists keys(-min_access_points)] } {
     sta::check_cardinal "-min_access_points" $keys(-min_access_points)
@@ -197,7 +202,8 @@ proc detailed_route { args } {
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step \
+    $maze_dist_heuristic
 }
 
 proc detailed_route_num_drvs { args } {
@@ -353,7 +359,7 @@ proc pin_access { args } {
     } else {
       utl::error DRT 555 "-cloud_size is required for distributed routing."
     }
-    drt::detailed_route_distributed $rhost $rport $vol $cloudsz
+    drt::detailed_route_distributed $rhost $rport $vol $cloudsz 0
   }
   drt::pin_access_cmd $db_process_node $bottom_routing_layer \
     $top_routing_layer $verbose $min_access_points
@@ -390,6 +396,51 @@ proc detailed_route_run_worker { args } {
   drt::run_worker_cmd $dump_dir $worker_dir $drc_rpt
 }
 
+sta::define_cmd_args "detailed_route_bench_workers" {
+    [-dump_dir dir]
+    [-worker_dirs dirs]
+    [-iterations count]
+};# checker off
+
+proc detailed_route_bench_workers { args } {
+  sta::parse_key_args "detailed_route_bench_workers" args \
+    keys {-dump_dir -worker_dirs -iterations} \
+    flags {};# checker off
+  sta::check_argc_eq0 "detailed_route_bench_workers" $args
+  if { [info exists keys(-dump_dir)] } {
+    set dump_dir $keys(-dump_dir)
+  } else {
+    utl::error DRT 624 "-dump_dir is required for detailed_route_bench_workers command"
+  }
+
+  if { [info exists keys(-worker_dirs)] } {
+    set worker_dirs $keys(-worker_dirs)
+  } else {
+    # Use every dumped worker in dump_dir as the corpus.
+    set worker_dirs {}
+    foreach dir [lsort [glob -nocomplain -type d -directory $dump_dir -tails *]] {
+      if { [file exists [file join $dump_dir $dir worker.bin]] } {
+        lappend worker_dirs $dir
+      }
+    }
+  }
+  if { [llength $worker_dirs] == 0 } {
+    utl::error DRT 625 "No dumped workers found in $dump_dir."
+  }
+
+  if { [info exists keys(-iterations)] } {
+    set iterations $keys(-iterations)
+    sta::check_positive_integer "-iterations" $iterations
+  } else {
+    set iterations 1
+  }
+
+  foreach worker_dir $worker_dirs {
+    drt::bench_worker_cmd $dump_dir $worker_dir $iterations
+  }
+  drt::bench_report_peak_memory_cmd
+}
+
 sta::define_cmd_args "detailed_route_worker_debug" {
     [-maze_end_iter iter]
     [-drc_cost d_cost]
@@ -85,6 +85,7 @@ class drUpdate
   void serialize(Archive& ar, unsigned int version);
 
   friend class boost::serialization::access;
+  friend class drUpdateCodec;
 };
 
 }  // namespace drt
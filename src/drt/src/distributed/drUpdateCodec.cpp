@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "distributed/drUpdateCodec.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "db/obj/frNet.h"
+#include "distributed/frArchive.h"
+#include "frDesign.h"
+#include "serialization.h"
+#include "utl/Logger.h"
+
+namespace drt {
+
+namespace {
+
+constexpr char kMagic[3] = {'D', 'R', 'U'};
+constexpr uint8_t kCompressedFlag = 1;
+
+// update flag bits
+constexpr uint8_t kTapered = 1 << 0;
+constexpr uint8_t kBottomConnected = 1 << 1;
+constexpr uint8_t kTopConnected = 1 << 2;
+constexpr uint8_t kNetModified = 1 << 3;
+
+// net reference kinds
+enum NetRef : uint8_t
+{
+  NO_NET,
+  REGULAR_NET,
+  SPECIAL_NET,
+  FAKE_VSS_NET,
+  FAKE_VDD_NET
+};
+
+void putVarint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string& out, int64_t value)
+{
+  // zigzag so that small negative deltas stay small
+  putVarint(out,
+            (static_cast<uint64_t>(value) << 1)
+                ^ static_cast<uint64_t>(value >> 63));
+}
+
+class Reader
+{
+ public:
+  Reader(const std::string& in, utl::Logger* logger) : in_(in), logger_(logger)
+  {
+  }
+
+  uint64_t getVarint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (pos_ >= in_.size()) {
+        truncated();
+      }
+      const auto byte = static_cast<uint8_t>(in_[pos_++]);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    logger_->error(DRT, 633, "Malformed varint in drUpdate batch.");
+  }
+
+  int64_t getSigned()
+  {
+    const uint64_t value = getVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  uint8_t getByte()
+  {
+    if (pos_ >= in_.size()) {
+      truncated();
+    }
+    return static_cast<uint8_t>(in_[pos_++]);
+  }
+
+  std::string getBytes(size_t size)
+  {
+    if (pos_ + size > in_.size()) {
+      truncated();
+    }
+    std::string bytes = in_.substr(pos_, size);
+    pos_ += size;
+    return bytes;
+  }
+
+ private:
+  [[noreturn]] void truncated() const
+  {
+    logger_->error(DRT, 632, "Truncated drUpdate batch.");
+  }
+
+  const std::string& in_;
+  utl::Logger* logger_;
+  size_t pos_ = 0;
+};
+
+void putPoint(std::string& out, const Point& pt, Point& prev)
+{
+  putSigned(out, static_cast<int64_t>(pt.x()) - prev.x());
+  putSigned(out, static_cast<int64_t>(pt.y()) - prev.y());
+  prev = pt;
+}
+
+Point getPoint(Reader& reader, Point& prev)
+{
+  const frCoord x = prev.x() + reader.getSigned();
+  const frCoord y = prev.y() + reader.getSigned();
+  prev = Point(x, y);
+  return prev;
+}
+
+}  // namespace
+
+void drUpdateCodec::encode(const std::vector<drUpdate>& batch,
+                           std::string& out)
+{
+  putVarint(out, batch.size());
+  Point prev(0, 0);
+  for (const auto& update : batch) {
+    out.push_back(static_cast<char>(update.type_));
+    putVarint(out, update.obj_type_);
+
+    uint8_t flags = 0;
+    flags |= update.tapered_ ? kTapered : 0;
+    flags |= update.bottomConnected_ ? kBottomConnected : 0;
+    flags |= update.topConnected_ ? kTopConnected : 0;
+    NetRef ref = NO_NET;
+    int net_id = 0;
+    if (frNet* net = update.net_) {
+      flags |= net->isModified() ? kNetModified : 0;
+      if (net->isFake()) {
+        ref = net->getType() == odb::dbSigType::GROUND ? FAKE_VSS_NET
+                                                        : FAKE_VDD_NET;
+      } else {
+        ref = net->isSpecial() ? SPECIAL_NET : REGULAR_NET;
+        net_id = net->getId();
+      }
+    }
+    out.push_back(static_cast<char>(flags));
+    out.push_back(static_cast<char>(ref));
+    if (ref == REGULAR_NET || ref == SPECIAL_NET) {
+      putVarint(out, net_id);
+    }
+    putSigned(out, update.index_in_owner_);
+
+    switch (update.obj_type_) {
+      case frcPathSeg: {
+        putVarint(out, update.layer_);
+        putPoint(out, update.begin_, prev);
+        putSigned(out,
+                  static_cast<int64_t>(update.end_.x()) - update.begin_.x());
+        putSigned(out,
+                  static_cast<int64_t>(update.end_.y()) - update.begin_.y());
+        const frSegStyle& style = update.style_;
+        putVarint(out, style.getWidth());
+        putVarint(out, style.getBeginExt());
+        putVarint(out, style.getEndExt());
+        putVarint(out, static_cast<frEndStyleEnum>(style.getBeginStyle()));
+        putVarint(out, static_cast<frEndStyleEnum>(style.getEndStyle()));
+        break;
+      }
+      case frcPatchWire: {
+        putVarint(out, update.layer_);
+        putPoint(out, update.begin_, prev);
+        const Rect& box = update.offsetBox_;
+        putSigned(out, box.xMin());
+        putSigned(out, box.yMin());
+        putSigned(out, box.xMax());
+        putSigned(out, box.yMax());
+        break;
+      }
+      case frcVia: {
+        putPoint(out, update.begin_, prev);
+        putVarint(out, update.viaDef_ ? update.viaDef_->getId() + 1 : 0);
+        break;
+      }
+      case frcMarker: {
+        std::stringstream stream(std::ios_base::out | std::ios_base::binary);
+        frOArchive ar(stream);
+        registerTypes(ar);
+        ar << update.marker_;
+        const std::string bytes = stream.str();
+        putVarint(out, bytes.size());
+        out += bytes;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void drUpdateCodec::decode(frDesign* design,
+                           const std::string& in,
+                           std::vector<drUpdate>& batch,
+                           utl::Logger* logger)
+{
+  Reader reader(in, logger);
+  const auto size = reader.getVarint();
+  batch.clear();
+  batch.reserve(size);
+  Point prev(0, 0);
+  frBlock* block = design->getTopBlock();
+  for (uint64_t i = 0; i < size; i++) {
+    drUpdate update(static_cast<drUpdate::UpdateType>(reader.getByte()));
+    update.obj_type_ = static_cast<frBlockObjectEnum>(reader.getVarint());
+
+    const uint8_t flags = reader.getByte();
+    update.tapered_ = flags & kTapered;
+    update.bottomConnected_ = flags & kBottomConnected;
+    update.topConnected_ = flags & kTopConnected;
+    const uint8_t ref = reader.getByte();
+    switch (ref) {
+      case NO_NET:
+        break;
+      case REGULAR_NET:
+      case SPECIAL_NET: {
+        const auto net_id = reader.getVarint();
+        update.net_ = ref == REGULAR_NET ? block->getNet(net_id)
+                                         : block->getSNet(net_id);
+        if (update.net_ == nullptr) {
+          logger->error(
+              DRT, 634, "Unknown net id {} in drUpdate batch.", net_id);
+        }
+        break;
+      }
+      case FAKE_VSS_NET:
+        update.net_ = block->getFakeVSSNet();
+        break;
+      case FAKE_VDD_NET:
+        update.net_ = block->getFakeVDDNet();
+        break;
+      default:
+        logger->error(
+            DRT, 635, "Unknown net reference {} in drUpdate batch.", ref);
+    }
+    if (update.net_ != nullptr && (flags & kNetModified)) {
+      update.net_->setModified(true);
+    }
+    update.index_in_owner_ = reader.getSigned();
+
+    switch (update.obj_type_) {
+      case frcPathSeg: {
+        update.layer_ = reader.getVarint();
+        update.begin_ = getPoint(reader, prev);
+        const frCoord dx = reader.getSigned();
+        const frCoord dy = reader.getSigned();
+        update.end_ = Point(update.begin_.x() + dx, update.begin_.y() + dy);
+        update.style_.setWidth(reader.getVarint());
+        update.style_.setBeginExt(reader.getVarint());
+        update.style_.setEndExt(reader.getVarint());
+        update.style_.setBeginStyle(
+            static_cast<frEndStyleEnum>(reader.getVarint()),
+            update.style_.getBeginExt());
+        update.style_.setEndStyle(
+            static_cast<frEndStyleEnum>(reader.getVarint()),
+            update.style_.getEndExt());
+        break;
+      }
+      case frcPatchWire: {
+        update.layer_ = reader.getVarint();
+        update.begin_ = getPoint(reader, prev);
+        const frCoord xlo = reader.getSigned();
+        const frCoord ylo = reader.getSigned();
+        const frCoord xhi = reader.getSigned();
+        const frCoord yhi = reader.getSigned();
+        update.offsetBox_ = Rect(xlo, ylo, xhi, yhi);
+        break;
+      }
+      case frcVia: {
+        update.begin_ = getPoint(reader, prev);
+        const auto via_id = reader.getVarint();
+        if (via_id != 0) {
+          const auto& vias = design->getTech()->getVias();
+          if (via_id > vias.size()) {
+            logger->error(
+                DRT, 636, "Unknown via id {} in drUpdate batch.", via_id - 1);
+          }
+          update.viaDef_ = vias[via_id - 1].get();
+        }
+        break;
+      }
+      case frcMarker: {
+        const auto bytes = reader.getBytes(reader.getVarint());
+        std::stringstream stream(bytes,
+                                 std::ios_base::in | std::ios_base::binary);
+        frIArchive ar(stream);
+        ar.setDesign(design);
+        registerTypes(ar);
+        ar >> update.marker_;
+        break;
+      }
+      default:
+        break;
+    }
+    batch.push_back(std::move(update));
+  }
+}
+
+void drUpdateCodec::write(const std::vector<drUpdate>& batch,
+                          std::ostream& os,
+                          bool compress,
+                          utl::Logger* logger)
+{
+  std::string raw;
+  encode(batch, raw);
+
+  os.write(kMagic, sizeof(kMagic));
+  os.put(static_cast<char>(kVersion));
+  os.put(static_cast<char>(compress ? kCompressedFlag : 0));
+  if (!compress) {
+    os.write(raw.data(), raw.size());
+    return;
+  }
+  uLongf compressed_size = compressBound(raw.size());
+  std::string compressed(compressed_size, '\0');
+  if (compress2(reinterpret_cast<Bytef*>(compressed.data()),
+                &compressed_size,
+                reinterpret_cast<const Bytef*>(raw.data()),
+                raw.size(),
+                Z_BEST_SPEED)
+      != Z_OK) {
+    logger->error(DRT, 637, "Failed to compress drUpdate batch.");
+  }
+  std::string size_prefix;
+  putVarint(size_prefix, raw.size());
+  os.write(size_prefix.data(), size_prefix.size());
+  os.write(compressed.data(), compressed_size);
+}
+
+bool drUpdateCodec::read(frDesign* design,
+                         std::istream& is,
+                         std::vector<drUpdate>& batch,
+                         utl::Logger* logger)
+{
+  const auto start = is.tellg();
+  char header[sizeof(kMagic) + 2];
+  if (!is.read(header, sizeof(header))
+      || !std::equal(kMagic, kMagic + sizeof(kMagic), header)) {
+    is.clear();
+    is.seekg(start);
+    return false;
+  }
+  const auto version = static_cast<uint8_t>(header[sizeof(kMagic)]);
+  if (version != kVersion) {
+    logger->error(DRT,
+                  638,
+                  "Unsupported drUpdate batch version {}, expected {}.",
+                  version,
+                  kVersion);
+  }
+  const auto flags = static_cast<uint8_t>(header[sizeof(kMagic) + 1]);
+  std::string payload((std::istreambuf_iterator<char>(is)),
+                      std::istreambuf_iterator<char>());
+  if ((flags & kCompressedFlag) == 0) {
+    decode(design, payload, batch, logger);
+    return true;
+  }
+
+  Reader reader(payload, logger);
+  uLongf raw_size = reader.getVarint();
+  std::string size_prefix;
+  putVarint(size_prefix, raw_size);
+  std::string raw(raw_size, '\0');
+  if (uncompress(reinterpret_cast<Bytef*>(raw.data()),
+                 &raw_size,
+                 reinterpret_cast<const Bytef*>(payload.data())
+                     + size_prefix.size(),
+                 payload.size() - size_prefix.size())
+      != Z_OK) {
+    logger->error(DRT, 639, "Failed to decompress drUpdate batch.");
+  }
+  decode(design, raw, batch, logger);
+  return true;
+}
+
+}  // namespace drt
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "distributed/drUpdate.h"
+
+namespace utl {
+class Logger;
+}
+
+namespace drt {
+
+class frDesign;
+
+// Compact, versioned encoding of a drUpdate batch used to ship design
+// updates to distributed workers.  Compared to the generic boost archive
+// it writes coordinates as zigzag varints (delta coded against the
+// previous update), refers to nets by id and can optionally zlib-compress
+// the payload.  Markers are rare in update batches and fall back to the
+// boost archive.
+class drUpdateCodec
+{
+ public:
+  static constexpr uint8_t kVersion = 1;
+
+  static void write(const std::vector<drUpdate>& batch,
+                    std::ostream& os,
+                    bool compress,
+                    utl::Logger* logger);
+  // Returns false if the stream does not hold a compact batch; the stream
+  // is left untouched in that case.  Malformed batches are reported as
+  // errors through the logger.
+  static bool read(frDesign* design,
+                   std::istream& is,
+                   std::vector<drUpdate>& batch,
+                   utl::Logger* logger);
+
+ private:
+  static void encode(const std::vector<drUpdate>& batch, std::string& out);
+  static void decode(frDesign* design,
+                     const std::string& in,
+                     std::vector<drUpdate>& batch,
+                     utl::Logger* logger);
+};
+
+}  // namespace drt
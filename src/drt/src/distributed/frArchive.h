@@ -61,7 +61,7 @@ struct frOArchive : OutputArchive
 struct frIArchive : InputArchive
 {
   frIArchive(std::istream& os, unsigned flags = 0)
-      : InputArchive(os, flags), design(nullptr)
+      : InputArchive(os, flags), design(nullptr), is_(os)
   {
   }
 
@@ -73,9 +73,15 @@ struct frIArchive : InputArchive
   }
   frDesign* getDesign() const { return design; }
   void setDesign(frDesign* in) { design = in; }
+  // true when nothing is left to load from the stream
+  bool atEnd() const
+  {
+    return is_.rdbuf()->sgetc() == std::istream::traits_type::eof();
+  }
 
  private:
   frDesign* design;
+  std::istream& is_;
 };
 }  // namespace drt
 
@@ -300,6 +300,18 @@ int FlexDRWorker::main(frDesign* design)
              duration_cast<duration<double>>(t3 - t0).count(),
              getInitNumMarkers(),
              num_markers);
+  debugPrint(logger_,
+             DRT,
+             "maze",
+             1,
+             "worker ({:.3f} {:.3f}) ({:.3f} {:.3f}) maze expansions {} "
+             "GC checks {}",
+             routeBox_.xMin() * micronPerDBU,
+             routeBox_.yMin() * micronPerDBU,
+             routeBox_.xMax() * micronPerDBU,
+             routeBox_.yMax() * micronPerDBU,
+             getNumMazeExpansions(),
+             getNumGCChecks());
 
   return 0;
 }
@@ -389,6 +389,11 @@ class FlexDRWorker
   FlexGCWorker* getGCWorker() { return gcWorker_.get(); }
   const FlexDRViaData* getViaData() const { return via_data_; }
   const FlexGridGraph& getGridGraph() const { return gridGraph_; }
+  uint64_t getNumMazeExpansions() const
+  {
+    return gridGraph_.getNumExpansions();
+  }
+  uint64_t getNumGCChecks() const { return numGCChecks_; }
   // others
   int main(frDesign* design);
   void distributedMain(frDesign* design);
@@ -515,6 +520,9 @@ class FlexDRWorker
   bool isCongested_ = false;
   bool save_updates_ = false;
 
+  // statistics (not serialized)
+  uint64_t numGCChecks_ = 0;
+
   // hellpers
   bool isRoutePatchWire(const frPatchWire* pwire) const;
   bool isRouteVia(const frVia* via) const;
@@ -1734,6 +1734,7 @@ void FlexDRWorker::route_queue()
   if (needRecheck_) {
     gcWorker_->setEnableSurgicalFix(true);
     gcWorker_->main();
+    numGCChecks_++;
     writeGCPatchesToDRWorker();
     gcWorker_->clearPWires();
     setMarkers(gcWorker_->getMarkers());
@@ -1773,6 +1774,7 @@ void FlexDRWorker::route_queue()
   gcWorker_->resetTargetNet();
   gcWorker_->setEnableSurgicalFix(true);
   gcWorker_->main();
+  numGCChecks_++;
   // write back GC patches
   writeGCPatchesToDRWorker();
 
@@ -1987,6 +1989,7 @@ void FlexDRWorker::route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue)
         gcWorker_->updateDRNet(net);
         gcWorker_->setEnableSurgicalFix(true);
         gcWorker_->main();
+        numGCChecks_++;
         modEolCosts_poly(gcWorker_->getTargetNet(), ModCostType::addRouteShape);
         // write back GC patches
         drNet* currNet = net;
@@ -2052,6 +2055,7 @@ void FlexDRWorker::route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue)
           gcWorker_->updateDRNet(net);
           gcWorker_->setEnableSurgicalFix(true);
           gcWorker_->main();
+          numGCChecks_++;
           if (gcWorker_->getMarkers().empty()) {
             net->setModified(true);
             writeGCPatchesToDRWorker();
@@ -2070,11 +2074,13 @@ void FlexDRWorker::route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue)
           auto net = static_cast<frNet*>(obj);
           if (gcWorker_->setTargetNet(net)) {
             gcWorker_->main();
+            numGCChecks_++;
             didCheck = true;
           }
         } else {
           if (gcWorker_->setTargetNet(obj)) {
             gcWorker_->main();
+            numGCChecks_++;
             didCheck = true;
           }
         }
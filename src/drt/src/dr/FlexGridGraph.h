@@ -951,6 +951,7 @@ class FlexGridGraph
     return (isLayer1 ? (*halfViaEncArea_)[z].first
                      : (*halfViaEncArea_)[z].second);
   }
+  uint64_t getNumExpansions() const { return numExpansions_; }
   int nTracksX() { return xCoords_.size(); }
   int nTracksY() { return yCoords_.size(); }
   void cleanup()
@@ -975,6 +976,8 @@ class FlexGridGraph
     yCoords_.shrink_to_fit();
     wavefront_.cleanup();
     wavefront_.fit();
+    distField_.clear();
+    distField_.shrink_to_fit();
   }
 
   void printNode(frMIdx x, frMIdx y, frMIdx z)
@@ -1081,6 +1084,11 @@ class FlexGridGraph
   frUInt4 ggFixedShapeCost_;
   // temporary variables
   FlexWavefront wavefront_;
+  // number of nodes popped and expanded by search (not serialized)
+  uint64_t numExpansions_ = 0;
+  // lower bound of the path cost from each node to the current
+  // destination; empty unless MAZE_DIST_HEURISTIC is set
+  std::vector<frCost> distField_;
   const std::vector<std::pair<frCoord, frCoord>>* halfViaEncArea_
       = nullptr;  // std::pair<layer1area, layer2area>
   // ndr related
@@ -1267,6 +1275,11 @@ class FlexGridGraph
                  const std::map<frLayerNum, dbTechLayerDir>& zMap,
                  const Rect& bbox,
                  bool initDR);
+  void initDistField();
+  frCost getMinEdgeCost(frMIdx gridX,
+                        frMIdx gridY,
+                        frMIdx gridZ,
+                        frDirEnum dir) const;
   frCost getEstCost(const FlexMazeIdx& src,
                     const FlexMazeIdx& dstMazeIdx1,
                     const FlexMazeIdx& dstMazeIdx2,
@@ -26,6 +26,8 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <queue>
+
 #include "dr/FlexDR.h"
 #include "dr/FlexDR_graphics.h"
 #include "dr/FlexGridGraph.h"
@@ -253,7 +255,115 @@ frCost FlexGridGraph::getEstCost(const FlexMazeIdx& src,
       forbiddenPenalty = 2 * ggDRCCost_ * edgeLength;
     }
   }
-  return (minCostX + minCostY + minCostZ + bendCnt + forbiddenPenalty);
+  frCost estCost = minCostX + minCostY + minCostZ + bendCnt + forbiddenPenalty;
+  if (!distField_.empty()) {
+    // unreachable nodes keep the plain estimate to avoid cost overflow
+    const frCost dist = distField_[getIdx(gridX, gridY, gridZ)];
+    if (dist != std::numeric_limits<frCost>::max()) {
+      estCost = std::max(estCost, dist);
+    }
+  }
+  return estCost;
+}
+
+// Lower bound of getCosts(): drops the route shape and fixed shape costs
+// since they depend on whether NDR costs apply along the path.
+frCost FlexGridGraph::getMinEdgeCost(frMIdx gridX,
+                                     frMIdx gridY,
+                                     frMIdx gridZ,
+                                     frDirEnum dir) const
+{
+  const frCoord edgeLength = getEdgeLength(gridX, gridY, gridZ, dir);
+  frCost cost = edgeLength;
+  if (hasGridCost(gridX, gridY, gridZ, dir)) {
+    cost += GRIDCOST * edgeLength;
+  }
+  if (hasMarkerCostAdj(gridX, gridY, gridZ, dir)) {
+    cost += ggMarkerCost_ * edgeLength;
+  }
+  if (isBlocked(gridX, gridY, gridZ, dir)) {
+    cost += BLOCKCOST * getTech()->getLayer(getLayerNum(gridZ))->getMinWidth()
+            * 20;
+  }
+  if (!hasGuide(gridX, gridY, gridZ, dir)) {
+    cost += GUIDECOST * edgeLength;
+  }
+  return cost;
+}
+
+static frDirEnum getOppositeDir(frDirEnum dir)
+{
+  switch (dir) {
+    case frDirEnum::E:
+      return frDirEnum::W;
+    case frDirEnum::W:
+      return frDirEnum::E;
+    case frDirEnum::N:
+      return frDirEnum::S;
+    case frDirEnum::S:
+      return frDirEnum::N;
+    case frDirEnum::U:
+      return frDirEnum::D;
+    case frDirEnum::D:
+      return frDirEnum::U;
+    case frDirEnum::UNKNOWN:
+      break;
+  }
+  return frDirEnum::UNKNOWN;
+}
+
+// Dijkstra from all destination nodes over the reversed grid edges.  The
+// result is the cheapest path cost to the destination ignoring bends and
+// NDR dependent costs, which makes it an admissible estimate for search().
+// It visits every node of the worker grid, O(n log n), and is run once per
+// search: the destination changes with each pin, and the marker cost decay
+// and the per net blockage resets can lower edge costs between searches, so
+// a field kept from an earlier search may overestimate.
+void FlexGridGraph::initDistField()
+{
+  frMIdx xDim, yDim, zDim;
+  getDim(xDim, yDim, zDim);
+  distField_.assign(nodes_.size(), std::numeric_limits<frCost>::max());
+
+  using Entry = std::pair<frCost, FlexMazeIdx>;
+  auto cmp = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(cmp)> queue(cmp);
+  for (frMIdx z = 0; z < zDim; z++) {
+    for (frMIdx y = 0; y < yDim; y++) {
+      for (frMIdx x = 0; x < xDim; x++) {
+        if (isDst(x, y, z)) {
+          distField_[getIdx(x, y, z)] = 0;
+          queue.emplace(0, FlexMazeIdx(x, y, z));
+        }
+      }
+    }
+  }
+
+  while (!queue.empty()) {
+    const auto [dist, idx] = queue.top();
+    queue.pop();
+    if (dist > distField_[getIdx(idx.x(), idx.y(), idx.z())]) {
+      continue;
+    }
+    for (const auto dir : frDirEnumAll) {
+      if (!hasEdge(idx.x(), idx.y(), idx.z(), dir)) {
+        continue;
+      }
+      frMIdx x = idx.x();
+      frMIdx y = idx.y();
+      frMIdx z = idx.z();
+      getNextGrid(x, y, z, dir);
+      // search() moves from (x, y, z) back towards idx, so charge the cost
+      // of that move.
+      const frCost nextDist
+          = dist + getMinEdgeCost(x, y, z, getOppositeDir(dir));
+      frCost& currDist = distField_[getIdx(x, y, z)];
+      if (nextDist < currDist) {
+        currDist = nextDist;
+        queue.emplace(nextDist, FlexMazeIdx(x, y, z));
+      }
+    }
+  }
 }
 
 frDirEnum FlexGridGraph::getLastDir(
@@ -685,6 +795,9 @@ bool FlexGridGraph::search(std::vector<FlexMazeIdx>& connComps,
                     std::max(dstMazeIdx2.z(), mi.z()));
   }
 
+  if (MAZE_DIST_HEURISTIC) {
+    initDistField();
+  }
   wavefront_.cleanup();
   // init wavefront
   Point currPt;
@@ -735,6 +848,7 @@ bool FlexGridGraph::search(std::vector<FlexMazeIdx>& connComps,
       return true;
     }
     // expand and update wavefront
+    numExpansions_++;
     expandWavefront(currGrid, dstMazeIdx1, dstMazeIdx2, centerPt);
   }
   return false;
@@ -61,7 +61,8 @@ FlexGCWorker::Impl::Impl(frTechObject* techIn,
       ignoreMinArea_(false),
       ignoreLongSideEOL_(false),
       ignoreCornerSpacing_(false),
-      surgicalFixEnabled_(false)
+      surgicalFixEnabled_(false),
+      spacingPrefilter_(true)
 {
 }
 
@@ -160,6 +161,10 @@ void FlexGCWorker::setEnableSurgicalFix(bool in)
 {
   impl_->surgicalFixEnabled_ = in;
 }
+void FlexGCWorker::setSpacingPrefilter(bool in)
+{
+  impl_->spacingPrefilter_ = in;
+}
 
 void FlexGCWorker::resetTargetNet()
 {
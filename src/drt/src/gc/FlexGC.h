@@ -60,6 +60,8 @@ class FlexGCWorker
   void setIgnoreLongSideEOL();
   void setIgnoreCornerSpacing();
   void setEnableSurgicalFix(bool in);
+  // distance prefilter of the metal spacing candidates, on by default
+  void setSpacingPrefilter(bool in);
   void addPAObj(frConnFig* obj, frBlockObject* owner);
   // getters
   std::vector<std::unique_ptr<gcNet>>& getNets();
@@ -154,6 +154,15 @@ class FlexGCWorker::Impl
 
   // temps
   std::vector<drNet*> modifiedDRNets_;
+  // structure of arrays view of the metSpc candidates of one rect
+  struct SpacingCandidates
+  {
+    std::vector<frCoord> xl;
+    std::vector<frCoord> yl;
+    std::vector<frCoord> xh;
+    std::vector<frCoord> yh;
+    std::vector<char> keep;
+  } spcCandidates_;
 
   // parameters
   gcNet* targetNet_;
@@ -167,6 +176,7 @@ class FlexGCWorker::Impl
   bool ignoreLongSideEOL_;
   bool ignoreCornerSpacing_;
   bool surgicalFixEnabled_;
+  bool spacingPrefilter_;
 
   FlexGCWorkerRegionQuery& getWorkerRegionQuery() { return rq_; }
 
@@ -227,6 +237,13 @@ class FlexGCWorker::Impl
   void checkMetalSpacing_wrongDir(gcPin* pin, frLayer* layer);
   frCoord checkMetalSpacing_getMaxSpcVal(frLayerNum layerNum,
                                          bool checkNDRs = true);
+  frCoord checkMetalSpacing_getMaxReqSpcVal(frLayerNum layerNum,
+                                            frCoord maxSpcVal);
+  template <typename T>
+  void checkMetalSpacing_filterCandidates(
+      gcRect* rect,
+      frCoord maxReqSpcVal,
+      std::vector<rq_box_value_t<T>>& candidates);
   void myBloat(const gtl::rectangle_data<frCoord>& rect,
                frCoord val,
                box_t& box);
@@ -844,6 +844,78 @@ void FlexGCWorker::Impl::checkMetalSpacing_main(gcRect* rect1,
   }
 }
 
+// Upper bound of checkMetalSpacing_prl_getReqSpcVal() for any pair on the
+// layer: same-net and spacing range rules may exceed the table maximum.
+frCoord FlexGCWorker::Impl::checkMetalSpacing_getMaxReqSpcVal(
+    frLayerNum layerNum,
+    frCoord maxSpcVal)
+{
+  auto currLayer = getTech()->getLayer(layerNum);
+  if (currLayer->hasSpacingSamenet()) {
+    maxSpcVal
+        = std::max(maxSpcVal, currLayer->getSpacingSamenet()->getMinSpacing());
+  }
+  for (const auto& con : currLayer->getSpacingRangeConstraints()) {
+    maxSpcVal = std::max(maxSpcVal, con->getMinSpacing());
+  }
+  return maxSpcVal;
+}
+
+// Drops the candidates that are at least maxReqSpcVal away from rect as
+// they can neither short nor violate spacing.  The boxes are copied into
+// flat arrays first so the distance test vectorizes.  Only the metal
+// spacing candidates are filtered here; the EOL checks query edges with
+// rule-specific windows and still run one pair at a time.
+template <typename T>
+void FlexGCWorker::Impl::checkMetalSpacing_filterCandidates(
+    gcRect* rect,
+    frCoord maxReqSpcVal,
+    std::vector<rq_box_value_t<T>>& candidates)
+{
+  const int size = candidates.size();
+  auto& cands = spcCandidates_;
+  cands.xl.resize(size);
+  cands.yl.resize(size);
+  cands.xh.resize(size);
+  cands.yh.resize(size);
+  cands.keep.resize(size);
+  for (int i = 0; i < size; i++) {
+    const Rect& box = candidates[i].first;
+    cands.xl[i] = box.xMin();
+    cands.yl[i] = box.yMin();
+    cands.xh[i] = box.xMax();
+    cands.yh[i] = box.yMax();
+  }
+
+  const frCoord xl = gtl::xl(*rect);
+  const frCoord yl = gtl::yl(*rect);
+  const frCoord xh = gtl::xh(*rect);
+  const frCoord yh = gtl::yh(*rect);
+  const int64_t maxSpcSquare = (int64_t) maxReqSpcVal * maxReqSpcVal;
+  const frCoord* candXl = cands.xl.data();
+  const frCoord* candYl = cands.yl.data();
+  const frCoord* candXh = cands.xh.data();
+  const frCoord* candYh = cands.yh.data();
+  char* keep = cands.keep.data();
+#pragma omp simd
+  for (int i = 0; i < size; i++) {
+    const frCoord gapX = std::max(std::max(candXl[i] - xh, xl - candXh[i]), 0);
+    const frCoord gapY = std::max(std::max(candYl[i] - yh, yl - candYh[i]), 0);
+    keep[i] = (int64_t) gapX * gapX + (int64_t) gapY * gapY < maxSpcSquare;
+  }
+
+  int numKept = 0;
+  for (int i = 0; i < size; i++) {
+    if (keep[i]) {
+      if (numKept != i) {
+        candidates[numKept] = std::move(candidates[i]);
+      }
+      numKept++;
+    }
+  }
+  candidates.resize(numKept);
+}
+
 void FlexGCWorker::Impl::checkMetalSpacing_main(gcRect* rect,
                                                 bool checkNDRs,
                                                 bool isSpcRect)
@@ -859,13 +931,21 @@ void FlexGCWorker::Impl::checkMetalSpacing_main(gcRect* rect,
 
   box_t queryBox;
   myBloat(*rect, maxSpcVal, queryBox);
+  const frCoord maxReqSpcVal
+      = checkMetalSpacing_getMaxReqSpcVal(layerNum, maxSpcVal);
 
   auto& workerRegionQuery = getWorkerRegionQuery();
   std::vector<rq_box_value_t<gcRect*>> result;
   workerRegionQuery.queryMaxRectangle(queryBox, layerNum, result);
+  if (spacingPrefilter_) {
+    checkMetalSpacing_filterCandidates(rect, maxReqSpcVal, result);
+  }
   if (checkNDRs) {
     std::vector<rq_box_value_t<gcRect>> resultS;
     workerRegionQuery.querySpcRectangle(queryBox, layerNum, resultS);
+    if (spacingPrefilter_) {
+      checkMetalSpacing_filterCandidates(rect, maxReqSpcVal, resultS);
+    }
     for (auto& [objBox, ptr] : resultS) {
       checkMetalSpacing_main(rect, &ptr, checkNDRs, isSpcRect);
     }
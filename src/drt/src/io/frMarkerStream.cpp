@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "io/frMarkerStream.h"
+
+#include <type_traits>
+
+namespace drt {
+
+namespace {
+
+constexpr char kMagic[4] = {'D', 'R', 'C', 'B'};
+
+template <typename T>
+void put(std::string& out, T value)
+{
+  using U = std::make_unsigned_t<T>;
+  auto bits = static_cast<U>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>(bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+void putString(std::string& out, const std::string& str)
+{
+  put<uint32_t>(out, str.size());
+  out.append(str);
+}
+
+void putRect(std::string& out, const odb::Rect& rect)
+{
+  put<int32_t>(out, rect.xMin());
+  put<int32_t>(out, rect.yMin());
+  put<int32_t>(out, rect.xMax());
+  put<int32_t>(out, rect.yMax());
+}
+
+int floorDiv(int value, int div)
+{
+  return value >= 0 ? value / div : -((-value + div - 1) / div);
+}
+
+}  // namespace
+
+frMarkerStreamWriter::frMarkerStreamWriter(const std::string& file_name,
+                                           int dbu,
+                                           int tile_size)
+    : out_(file_name, std::ios::binary), tile_size_(tile_size)
+{
+  if (!out_.is_open()) {
+    return;
+  }
+  std::string header(kMagic, sizeof(kMagic));
+  put<uint8_t>(header, kVersion);
+  header.append(3, '\0');
+  put<int32_t>(header, dbu);
+  put<int32_t>(header, tile_size);
+  out_.write(header.data(), header.size());
+  offset_ = header.size();
+}
+
+frMarkerStreamWriter::~frMarkerStreamWriter()
+{
+  close();
+}
+
+uint16_t frMarkerStreamWriter::getId(std::map<std::string, uint16_t>& ids,
+                                     std::vector<std::string>& names,
+                                     const std::string& name)
+{
+  auto it = ids.find(name);
+  if (it != ids.end()) {
+    return it->second;
+  }
+  const uint16_t id = names.size();
+  ids.emplace(name, id);
+  names.push_back(name);
+  return id;
+}
+
+void frMarkerStreamWriter::addMarker(const std::string& layer,
+                                     const std::string& type,
+                                     const std::string& srcs,
+                                     const odb::Rect& bbox)
+{
+  if (!isOpen()) {
+    return;
+  }
+  const uint16_t layer_id = getId(layer_ids_, layers_, layer);
+  const uint16_t type_id = getId(type_ids_, types_, type);
+  const TileKey key(layer_id,
+                    floorDiv(bbox.xMin(), tile_size_),
+                    floorDiv(bbox.yMin(), tile_size_));
+
+  Chunk& chunk = tiles_[key];
+  put<uint16_t>(chunk.data, layer_id);
+  put<uint16_t>(chunk.data, type_id);
+  putRect(chunk.data, bbox);
+  putString(chunk.data, srcs);
+  if (chunk.count == 0) {
+    chunk.bbox = bbox;
+  } else {
+    chunk.bbox.merge(bbox);
+  }
+  if (++chunk.count >= kChunkSize) {
+    flush(key, chunk);
+  }
+}
+
+void frMarkerStreamWriter::flush(const TileKey& key, Chunk& chunk)
+{
+  if (chunk.count == 0) {
+    return;
+  }
+  out_.write(chunk.data.data(), chunk.data.size());
+  index_.push_back({std::get<0>(key), chunk.bbox, offset_, chunk.count});
+  offset_ += chunk.data.size();
+  chunk.data.clear();
+  chunk.count = 0;
+}
+
+void frMarkerStreamWriter::close()
+{
+  if (!isOpen()) {
+    return;
+  }
+  for (auto& [key, chunk] : tiles_) {
+    flush(key, chunk);
+  }
+  tiles_.clear();
+
+  std::string index;
+  put<uint32_t>(index, layers_.size());
+  for (const auto& name : layers_) {
+    putString(index, name);
+  }
+  put<uint32_t>(index, types_.size());
+  for (const auto& name : types_) {
+    putString(index, name);
+  }
+  put<uint32_t>(index, index_.size());
+  for (const auto& entry : index_) {
+    put<uint16_t>(index, entry.layer);
+    putRect(index, entry.bbox);
+    put<uint64_t>(index, entry.offset);
+    put<uint32_t>(index, entry.count);
+  }
+  put<uint64_t>(index, offset_);
+  index.append(kMagic, sizeof(kMagic));
+  out_.write(index.data(), index.size());
+  out_.close();
+}
+
+}  // namespace drt
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "odb/geom.h"
+
+namespace drt {
+
+// Streaming writer for the tiled binary DRC report (.drcb).
+//
+// Markers are bucketed by layer and by the tile holding the lower left
+// corner of their bbox.  A tile is written out as a chunk once it holds
+// kChunkSize markers, so memory use is bounded by the number of
+// partially filled tiles rather than the size of the report.  close()
+// flushes the remaining tiles and appends an index with the offset,
+// marker count and bbox of every chunk so that readers can load a region
+// without scanning the whole file.
+//
+// Layout (all integers little endian):
+//   header : "DRCB" u8 version u8[3] reserved i32 dbu i32 tile_size
+//   chunk  : count * { u16 layer u16 type i32 xlo ylo xhi yhi
+//                      u32 len char[len] sources }
+//   index  : u32 n { u32 len char[len] } layer names
+//            u32 n { u32 len char[len] } violation types
+//            u32 n { u16 layer i32 xlo ylo xhi yhi u64 offset u32 count }
+//   trailer: u64 index_offset "DRCB"
+//
+// Sources use the same "type:name" list as the text report.
+class frMarkerStreamWriter
+{
+ public:
+  static constexpr uint8_t kVersion = 1;
+  static constexpr int kChunkSize = 256;
+
+  frMarkerStreamWriter(const std::string& file_name, int dbu, int tile_size);
+  ~frMarkerStreamWriter();
+
+  bool isOpen() const { return out_.is_open(); }
+  void addMarker(const std::string& layer,
+                 const std::string& type,
+                 const std::string& srcs,
+                 const odb::Rect& bbox);
+  void close();
+
+ private:
+  struct Chunk
+  {
+    std::string data;
+    odb::Rect bbox;
+    uint32_t count = 0;
+  };
+  struct IndexEntry
+  {
+    uint16_t layer;
+    odb::Rect bbox;
+    uint64_t offset;
+    uint32_t count;
+  };
+  using TileKey = std::tuple<uint16_t, int, int>;
+
+  uint16_t getId(std::map<std::string, uint16_t>& ids,
+                 std::vector<std::string>& names,
+                 const std::string& name);
+  void flush(const TileKey& key, Chunk& chunk);
+
+  std::ofstream out_;
+  int tile_size_;
+  uint64_t offset_ = 0;
+  std::map<std::string, uint16_t> layer_ids_;
+  std::vector<std::string> layers_;
+  std::map<std::string, uint16_t> type_ids_;
+  std::vector<std::string> types_;
+  std::map<TileKey, Chunk> tiles_;
+  std::vector<IndexEntry> index_;
+};
+
+}  // namespace drt
@@ -760,6 +760,10 @@ void serializeViaDef(Archive& ar, frViaDef*& viadef)
   }
 }
 
+// Version of the globals written after CONGCOST by serializeGlobals
+//   1: MAZE_DIST_HEURISTIC
+constexpr unsigned int globals_version = 1;
+
 template <class Archive>
 void serializeGlobals(Archive& ar)
 {
@@ -814,6 +818,23 @@ void serializeGlobals(Archive& ar)
   (ar) & SHAPEBLOATWIDTH;
   (ar) & HISTCOST;
   (ar) & CONGCOST;
+  // Globals added after CONGCOST follow a format version.  Files written
+  // before it end at CONGCOST and load as version 0.
+  unsigned int version = globals_version;
+  if constexpr (Archive::is_loading::value) {
+    if (ar.atEnd()) {
+      version = 0;
+    } else {
+      (ar) & version;
+    }
+  } else {
+    (ar) & version;
+  }
+  if (version >= 1) {
+    (ar) & MAZE_DIST_HEURISTIC;
+  } else {
+    MAZE_DIST_HEURISTIC = false;
+  }
 }
 
 }  // namespace drt
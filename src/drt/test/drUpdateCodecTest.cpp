@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// The module and main are defined in gcTest.cpp
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "distributed/drUpdate.h"
+#include "distributed/drUpdateCodec.h"
+#include "fixture.h"
+#include "frDesign.h"
+
+namespace drt {
+
+struct CodecFixture : public Fixture
+{
+  std::vector<drUpdate> roundTrip(const std::vector<drUpdate>& batch,
+                                  bool compress)
+  {
+    std::stringstream stream(std::ios_base::in | std::ios_base::out
+                             | std::ios_base::binary);
+    drUpdateCodec::write(batch, stream, compress, logger.get());
+
+    std::vector<drUpdate> decoded;
+    BOOST_TEST(
+        drUpdateCodec::read(design.get(), stream, decoded, logger.get()));
+    BOOST_TEST(decoded.size() == batch.size());
+    return decoded;
+  }
+
+  drUpdate makePathSegUpdate(frNet* net,
+                             const Point& begin,
+                             const Point& end,
+                             int index)
+  {
+    frPathSeg seg;
+    seg.setPoints(begin, end);
+    seg.setLayerNum(2);
+    frSegStyle style;
+    style.setWidth(100);
+    style.setBeginStyle(frcExtendEndStyle, 50);
+    style.setEndStyle(frcVariableEndStyle, 70);
+    seg.setStyle(style);
+    seg.setTapered(true);
+
+    drUpdate update(drUpdate::ADD_SHAPE);
+    update.setNet(net);
+    update.setIndexInOwner(index);
+    update.setPathSeg(seg);
+    return update;
+  }
+
+  // Returns a batch holding one update of every encoded object kind.
+  std::vector<drUpdate> makeMixedBatch()
+  {
+    frNet* n1 = makeNet("n1");
+    frNet* n2 = makeNet("n2");
+    n2->setModified(true);
+    frViaDef* via_def = makeViaDef("v", 3, {-50, -50}, {50, 50});
+
+    std::vector<drUpdate> batch;
+    batch.push_back(makePathSegUpdate(n1, {-1000, 200}, {2500, 200}, 3));
+
+    frPatchWire pwire;
+    pwire.setOrigin({-400, -300});
+    pwire.setOffsetBox(Rect(-20, -30, 40, 50));
+    pwire.setLayerNum(4);
+    drUpdate pwire_update(drUpdate::ADD_SHAPE_NET_ONLY);
+    pwire_update.setNet(n2);
+    pwire_update.setPatchWire(pwire);
+    batch.push_back(pwire_update);
+
+    frVia via;
+    via.setOrigin({700, -900});
+    via.setViaDef(via_def);
+    via.setBottomConnected(true);
+    via.setTopConnected(false);
+    drUpdate via_update(drUpdate::UPDATE_SHAPE);
+    via_update.setNet(n1);
+    via_update.setIndexInOwner(-1);
+    via_update.setVia(via);
+    batch.push_back(via_update);
+
+    frMarker marker;
+    marker.setBBox(Rect(10, 20, 30, 40));
+    marker.setLayerNum(2);
+    marker.setHasDir(true);
+    marker.setIsH(true);
+    drUpdate marker_update(drUpdate::ADD_SHAPE);
+    marker_update.setMarker(marker);
+    batch.push_back(marker_update);
+
+    drUpdate remove(drUpdate::REMOVE_FROM_BLOCK);
+    remove.setNet(n2);
+    remove.setIndexInOwner(7);
+    batch.push_back(remove);
+
+    return batch;
+  }
+
+  void checkMixedBatch(const std::vector<drUpdate>& batch,
+                       const std::vector<drUpdate>& decoded)
+  {
+    for (size_t i = 0; i < batch.size(); i++) {
+      TEST_ENUM_EQUAL(decoded[i].getType(), batch[i].getType());
+      TEST_ENUM_EQUAL(decoded[i].getObjTypeId(), batch[i].getObjTypeId());
+      BOOST_TEST(decoded[i].getNet() == batch[i].getNet());
+      BOOST_TEST(decoded[i].getIndexInOwner() == batch[i].getIndexInOwner());
+    }
+
+    const frPathSeg seg = decoded[0].getPathSeg();
+    const frPathSeg expected_seg = batch[0].getPathSeg();
+    BOOST_TEST(seg.getBeginPoint() == expected_seg.getBeginPoint());
+    BOOST_TEST(seg.getEndPoint() == expected_seg.getEndPoint());
+    BOOST_TEST(seg.getLayerNum() == expected_seg.getLayerNum());
+    BOOST_TEST(seg.isTapered());
+    const frSegStyle style = seg.getStyle();
+    BOOST_TEST(style.getWidth() == 100);
+    BOOST_TEST(style.getBeginExt() == 50);
+    BOOST_TEST(style.getEndExt() == 70);
+    TEST_ENUM_EQUAL(static_cast<frEndStyleEnum>(style.getBeginStyle()),
+                    frcExtendEndStyle);
+    TEST_ENUM_EQUAL(static_cast<frEndStyleEnum>(style.getEndStyle()),
+                    frcVariableEndStyle);
+
+    const frPatchWire pwire = decoded[1].getPatchWire();
+    BOOST_TEST(pwire.getOrigin() == Point(-400, -300));
+    BOOST_TEST(pwire.getOffsetBox() == Rect(-20, -30, 40, 50));
+    BOOST_TEST(pwire.getLayerNum() == 4);
+    BOOST_TEST(decoded[1].getNet()->isModified());
+
+    const frVia via = decoded[2].getVia();
+    BOOST_TEST(via.getOrigin() == Point(700, -900));
+    BOOST_TEST(via.getViaDef() == batch[2].getVia().getViaDef());
+    BOOST_TEST(via.isBottomConnected());
+    BOOST_TEST(!via.isTopConnected());
+
+    const frMarker marker = decoded[3].getMarker();
+    BOOST_TEST(marker.getBBox() == Rect(10, 20, 30, 40));
+    BOOST_TEST(marker.getLayerNum() == 2);
+    BOOST_TEST(marker.hasDir());
+    BOOST_TEST(marker.isH());
+    BOOST_TEST(marker.getConstraint() == nullptr);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(dr_update_codec, CodecFixture);
+
+BOOST_AUTO_TEST_CASE(mixed_batch)
+{
+  const auto batch = makeMixedBatch();
+  checkMixedBatch(batch, roundTrip(batch, false));
+}
+
+BOOST_AUTO_TEST_CASE(compressed_batch)
+{
+  const auto batch = makeMixedBatch();
+  checkMixedBatch(batch, roundTrip(batch, true));
+}
+
+// Fake nets have no id of their own and are referenced by kind
+BOOST_AUTO_TEST_CASE(fake_nets)
+{
+  frBlock* block = design->getTopBlock();
+  std::vector<drUpdate> batch;
+  batch.push_back(
+      makePathSegUpdate(block->getFakeVSSNet(), {0, 0}, {0, 500}, 0));
+  batch.push_back(
+      makePathSegUpdate(block->getFakeVDDNet(), {100, 0}, {100, 500}, 1));
+
+  const auto decoded = roundTrip(batch, false);
+  BOOST_TEST(decoded[0].getNet() == block->getFakeVSSNet());
+  BOOST_TEST(decoded[1].getNet() == block->getFakeVDDNet());
+}
+
+// A long batch exercises the delta coding of consecutive points
+BOOST_AUTO_TEST_CASE(large_batch)
+{
+  frNet* net = makeNet("n1");
+  std::vector<drUpdate> batch;
+  for (int i = 0; i < 1000; i++) {
+    const int x = (i * 7919) % 20000 - 10000;
+    const int y = (i * 104729) % 30000 - 15000;
+    batch.push_back(makePathSegUpdate(net, {x, y}, {x + 300, y}, i));
+  }
+
+  const auto decoded = roundTrip(batch, true);
+  for (size_t i = 0; i < batch.size(); i++) {
+    BOOST_TEST(decoded[i].getPathSeg().getBeginPoint()
+               == batch[i].getPathSeg().getBeginPoint());
+    BOOST_TEST(decoded[i].getPathSeg().getEndPoint()
+               == batch[i].getPathSeg().getEndPoint());
+    BOOST_TEST(decoded[i].getIndexInOwner() == i);
+  }
+}
+
+// Streams written with the boost archive are left for the caller
+BOOST_AUTO_TEST_CASE(not_a_compact_batch)
+{
+  std::stringstream stream("serialization::archive");
+  std::vector<drUpdate> decoded;
+  BOOST_TEST(!drUpdateCodec::read(design.get(), stream, decoded, logger.get()));
+  BOOST_TEST(stream.tellg() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(truncated_batch)
+{
+  std::stringstream stream(std::ios_base::in | std::ios_base::out
+                           | std::ios_base::binary);
+  drUpdateCodec::write(makeMixedBatch(), stream, false, logger.get());
+  std::string bytes = stream.str();
+  bytes.resize(bytes.size() / 2);
+
+  std::stringstream truncated(bytes,
+                              std::ios_base::in | std::ios_base::binary);
+  std::vector<drUpdate> decoded;
+  BOOST_CHECK_THROW(
+      drUpdateCodec::read(design.get(), truncated, decoded, logger.get()),
+      std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace drt
@@ -38,7 +38,9 @@
 #endif
 
 #include <boost/test/data/test_case.hpp>
+#include <chrono>
 #include <iostream>
+#include <string>
 
 #include "fixture.h"
 #include "frDesign.h"
@@ -422,6 +424,91 @@ BOOST_DATA_TEST_CASE(spacing_prl,
   }
 }
 
+// Check diagonal spacing for neighbours that fall inside the bloated query
+// box but may be dropped by the candidate prefilter.
+BOOST_DATA_TEST_CASE(spacing_prl_diagonal, bdata::make({true, false}), legal)
+{
+  // Setup
+  makeSpacingConstraint(2);
+
+  frNet* n1 = makeNet("n1");
+  frNet* n2 = makeNet("n2");
+
+  // Both offsets are below the 100 spacing; only the euclidean distance
+  // (113 legal, 85 illegal) decides.
+  frCoord offset = legal ? 80 : 60;
+  makePathseg(n1, 2, {0, 0}, {500, 0}, 100);
+  makePathseg(n2,
+              2,
+              {500 + offset, 100 + offset},
+              {1000 + offset, 100 + offset},
+              100);
+
+  runGC();
+
+  // Test the results
+  BOOST_TEST(worker.getMarkers().size() == (legal ? 0 : 1));
+}
+
+// Throughput of the metal spacing check on a dense staggered grid of short
+// wires, with and without the candidate prefilter.  Both runs must find the
+// same markers.  Disabled by default; run with
+//   trTest --run_test=gc/spacing_prefilter_throughput
+BOOST_AUTO_TEST_CASE(spacing_prefilter_throughput,
+                     *boost::unit_test::disabled())
+{
+  // Setup
+  makeSpacingConstraint(2);
+
+  const int rows = 60;
+  const int cols = 60;
+  const frCoord x_pitch = 450;
+  const frCoord y_pitch = 250;
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < cols; col++) {
+      const std::string name = "n" + std::to_string(row * cols + col);
+      frNet* net = makeNet(name.c_str());
+      frCoord x = col * x_pitch + (row % 2) * x_pitch / 2;
+      frCoord y = row * y_pitch;
+      // every seventh wire is pulled too close to its upper neighbours
+      if ((row * cols + col) % 7 == 0) {
+        y += 60;
+      }
+      makePathseg(net, 2, {x, y}, {x + 300, y}, 100);
+    }
+  }
+  initRegionQuery();
+
+  const Rect work(-1000, -1000, cols * x_pitch + 1000, rows * y_pitch + 1000);
+  auto run = [&](bool prefilter, double& seconds) {
+    FlexGCWorker gc(design->getTech(), logger.get());
+    gc.setSpacingPrefilter(prefilter);
+    gc.setExtBox(work);
+    gc.setDrcBox(work);
+    const auto start = std::chrono::steady_clock::now();
+    gc.init(design.get());
+    gc.main();
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                            - start)
+                  .count();
+    const size_t marker_cnt = gc.getMarkers().size();
+    gc.end();
+    return marker_cnt;
+  };
+
+  double unfiltered_seconds = 0;
+  double filtered_seconds = 0;
+  const size_t unfiltered = run(false, unfiltered_seconds);
+  const size_t filtered = run(true, filtered_seconds);
+
+  std::cout << "spacing prefilter: " << rows * cols << " wires, " << filtered
+            << " markers, off " << unfiltered_seconds << " s, on "
+            << filtered_seconds << " s\n";
+
+  BOOST_TEST(filtered > 0);
+  BOOST_TEST(filtered == unfiltered);
+}
+
 // Check violation for spacing two widths with design rule width on macro
 // obstruction
 BOOST_DATA_TEST_CASE(design_rule_width, bdata::make({true, false}), legal)
@@ -0,0 +1,4 @@
+# Replays the workers dumped by gcd_nangate45_dump_worker.tcl and reports
+# routing throughput.  Run the dump script first to build the corpus.
+source "helpers.tcl"
+detailed_route_bench_workers -dump_dir results -iterations 3
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// The module and main are defined in gcTest.cpp
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "io/frMarkerStream.h"
+
+namespace drt {
+
+namespace {
+
+using Record = std::tuple<std::string, std::string, std::string, odb::Rect>;
+
+template <typename T>
+T get(std::istream& in)
+{
+  std::make_unsigned_t<T> bits = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    bits |= static_cast<std::make_unsigned_t<T>>(
+                static_cast<uint8_t>(in.get()))
+            << (8 * i);
+  }
+  return static_cast<T>(bits);
+}
+
+std::string getString(std::istream& in)
+{
+  std::string str(get<uint32_t>(in), '\0');
+  in.read(str.data(), str.size());
+  return str;
+}
+
+odb::Rect getRect(std::istream& in)
+{
+  const int xlo = get<int32_t>(in);
+  const int ylo = get<int32_t>(in);
+  const int xhi = get<int32_t>(in);
+  const int yhi = get<int32_t>(in);
+  return {xlo, ylo, xhi, yhi};
+}
+
+// Reads the markers of the chunks whose index bbox intersects region, or
+// of every chunk if region is empty, following the layout documented in
+// frMarkerStream.h.
+std::vector<Record> readReport(const std::string& file_name,
+                               const odb::Rect& region)
+{
+  std::ifstream in(file_name, std::ios::binary);
+  std::string magic(4, '\0');
+  in.read(magic.data(), magic.size());
+  BOOST_TEST(magic == "DRCB");
+  BOOST_TEST(get<uint8_t>(in) == frMarkerStreamWriter::kVersion);
+
+  in.seekg(-12, std::ios::end);
+  in.seekg(get<uint64_t>(in));
+  std::vector<std::string> layers;
+  for (uint32_t i = get<uint32_t>(in); i > 0; --i) {
+    layers.push_back(getString(in));
+  }
+  std::vector<std::string> types;
+  for (uint32_t i = get<uint32_t>(in); i > 0; --i) {
+    types.push_back(getString(in));
+  }
+  std::vector<std::pair<uint64_t, uint32_t>> chunks;
+  for (uint32_t i = get<uint32_t>(in); i > 0; --i) {
+    get<uint16_t>(in);
+    const odb::Rect bbox = getRect(in);
+    const uint64_t offset = get<uint64_t>(in);
+    const uint32_t count = get<uint32_t>(in);
+    BOOST_TEST(count <= frMarkerStreamWriter::kChunkSize);
+    if (region.area() == 0 || region.intersects(bbox)) {
+      chunks.emplace_back(offset, count);
+    }
+  }
+
+  std::vector<Record> records;
+  for (const auto& [offset, count] : chunks) {
+    in.seekg(offset);
+    for (uint32_t i = 0; i < count; ++i) {
+      const std::string& layer = layers.at(get<uint16_t>(in));
+      const std::string& type = types.at(get<uint16_t>(in));
+      const odb::Rect bbox = getRect(in);
+      const std::string srcs = getString(in);
+      if (region.area() == 0 || region.intersects(bbox)) {
+        records.emplace_back(layer, type, srcs, bbox);
+      }
+    }
+  }
+  BOOST_TEST(in.good());
+  return records;
+}
+
+struct MarkerStreamFixture
+{
+  MarkerStreamFixture()
+      : file_name((std::filesystem::temp_directory_path()
+                   / "drt_marker_stream_test.drcb")
+                      .string())
+  {
+    // Enough markers in one tile to flush it before close(), plus markers
+    // on both sides of the origin and on a second layer.
+    for (int i = 0; i < 600; ++i) {
+      const int x = (i % 40) * 2000 - 20000;
+      const int y = (i / 40) * 3000 - 6000;
+      const std::string layer = i % 3 == 0 ? "metal2" : "metal1";
+      const std::string type = i % 2 == 0 ? "Short" : "Metal Spacing";
+      const std::string srcs = "net:n" + std::to_string(i) + " ";
+      markers.emplace_back(layer, type, srcs, odb::Rect(x, y, x + 150, y + 70));
+    }
+    for (int i = 0; i < 300; ++i) {
+      markers.emplace_back(
+          "metal1", "Short", "obstruction: ", odb::Rect(100, 100, 200 + i, 200));
+    }
+
+    frMarkerStreamWriter writer(file_name, 2000, 10000);
+    BOOST_TEST(writer.isOpen());
+    for (const auto& [layer, type, srcs, bbox] : markers) {
+      writer.addMarker(layer, type, srcs, bbox);
+    }
+    writer.close();
+  }
+
+  ~MarkerStreamFixture() { std::remove(file_name.c_str()); }
+
+  std::string file_name;
+  std::vector<Record> markers;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(marker_stream, MarkerStreamFixture);
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+  std::vector<Record> records = readReport(file_name, odb::Rect());
+  std::sort(records.begin(), records.end());
+  std::sort(markers.begin(), markers.end());
+  BOOST_TEST((records == markers));
+}
+
+BOOST_AUTO_TEST_CASE(region)
+{
+  const odb::Rect region(-5000, -5000, 5000, 5000);
+  std::vector<Record> records = readReport(file_name, region);
+  std::vector<Record> expected;
+  for (const auto& marker : markers) {
+    if (region.intersects(std::get<3>(marker))) {
+      expected.push_back(marker);
+    }
+  }
+  BOOST_TEST(!expected.empty());
+  BOOST_TEST(expected.size() < markers.size());
+  std::sort(records.begin(), records.end());
+  std::sort(expected.begin(), expected.end());
+  BOOST_TEST((records == expected));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace drt
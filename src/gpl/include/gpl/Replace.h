@@ -34,6 +34,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace odb {
@@ -68,6 +69,7 @@ class TimingBase;
 
 class InitialPlace;
 class NesterovPlace;
+class Instance;
 
 class Replace
 {
@@ -83,7 +85,7 @@ class Replace
   void reset();
 
   void doIncrementalPlace(int threads);
-  void doInitialPlace();
+  void doInitialPlace(int threads = 1);
   void runMBFF(int max_sz, float alpha, float beta, int threads, int num_paths);
 
   int doNesterovPlace(int threads, int start_iter = 0);
@@ -94,9 +96,22 @@ class Replace
   void setInitialPlaceMaxSolverIter(int iter);
   void setInitialPlaceMaxFanout(int fanout);
   void setInitialPlaceNetWeightScale(float scale);
+  // identity, jacobi or incomplete_cholesky
+  void setInitialPlacePreconditioner(const std::string& preconditioner);
 
   void setNesterovPlaceMaxIter(int iter);
 
+  // Place clusters of the netlist before the flat Nesterov placement.
+  void setMultilevelMode(bool mode);
+  void setMultilevelCoarseningRatio(float ratio);
+  void setMultilevelLevels(int levels);
+
+  // Save the Nesterov placement state every iterations iterations and
+  // resume the Nesterov placement from a saved state.
+  void setCheckpointFile(const std::string& file_name);
+  void setCheckpointIterations(int iterations);
+  void setResumeCheckpointFile(const std::string& file_name);
+
   void setBinGridCnt(int binGridCntX, int binGridCntY);
 
   void setTargetDensity(float density);
@@ -117,11 +132,13 @@ class Replace
   void setPadRight(int padding);
 
   void setTimingDrivenMode(bool mode);
+  void setTimingDrivenIncrementalMode(bool mode);
 
   void setSkipIoMode(bool mode);
 
   void setRoutabilityDrivenMode(bool mode);
   void setRoutabilityUseGrt(bool mode);
+  void setRoutabilityIncrementalGrt(bool mode);
   void setRoutabilityCheckOverflow(float overflow);
   void setRoutabilityMaxDensity(float density);
 
@@ -144,7 +161,10 @@ class Replace
                 odb::dbInst* inst = nullptr);
 
  private:
-  bool initNesterovPlace(int threads);
+  bool initNesterovPlace(
+      int threads,
+      const std::vector<std::vector<Instance*>>& clusters = {});
+  void doCoarseNesterovPlace(int threads);
 
   odb::dbDatabase* db_ = nullptr;
   sta::dbSta* sta_ = nullptr;
@@ -167,6 +187,7 @@ class Replace
   int initialPlaceMaxSolverIter_ = 100;
   int initialPlaceMaxFanout_ = 200;
   float initialPlaceNetWeightScale_ = 800;
+  std::string initialPlacePreconditioner_ = "identity";
 
   int total_placeable_insts_ = 0;
 
@@ -199,10 +220,19 @@ class Replace
   float timingNetWeightMax_ = 1.9;
 
   bool timingDrivenMode_ = true;
+  bool timingDrivenIncrementalMode_ = false;
   bool routabilityDrivenMode_ = true;
   bool routabilityUseRudy_ = true;
+  bool routabilityIncrementalGrt_ = false;
   bool uniformTargetDensityMode_ = false;
   bool skipIoMode_ = false;
+  bool multilevelMode_ = false;
+  float multilevelCoarseningRatio_ = 4;
+  int multilevelLevels_ = 2;
+
+  std::string checkpointFile_;
+  int checkpointIterations_ = 100;
+  std::string resumeCheckpointFile_;
 
   std::vector<int> timingNetWeightOverflows_;
 
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gpl {
+
+// Accumulates areas into the bins of a BinGrid from many threads without
+// atomics.  Each thread owns a band of bin rows, as grt::Rudy does with tile
+// columns.  The items are bucketed once by the bands their rows overlap, so
+// each thread only visits the items of its own band, and only one copy of
+// the bins is needed with nothing to reduce.  The areas are integers, so
+// the sums do not depend on the number of threads.
+class BinAreaBands
+{
+ public:
+  // numAreas is the number of areas stored for each bin
+  explicit BinAreaBands(int numAreas = 1) : numAreas_(numAreas) {}
+
+  // getRows(item) returns the bin rows [first, last) of item.
+  // addItem(item, firstY, lastY, areas) adds the areas of item in the bin
+  // rows [firstY, lastY), which are clipped to a band, to
+  // areas[(y * binCntX + x) * numAreas + area].
+  template <typename GetRows, typename AddItem>
+  void accumulate(size_t itemCnt,
+                  int binCntX,
+                  int binCntY,
+                  int numThreads,
+                  const GetRows& getRows,
+                  const AddItem& addItem);
+
+  int64_t area(size_t bin, int area = 0) const
+  {
+    return areas_[bin * numAreas_ + area];
+  }
+
+ private:
+  int numAreas_;
+  std::vector<int64_t> areas_;
+  // per item: bin rows
+  std::vector<std::pair<int, int>> rows_;
+  // per bin row: band
+  std::vector<int> rowBands_;
+  // per band: items overlapping it, in item order
+  std::vector<std::vector<size_t>> buckets_;
+};
+
+template <typename GetRows, typename AddItem>
+void BinAreaBands::accumulate(const size_t itemCnt,
+                              const int binCntX,
+                              const int binCntY,
+                              const int numThreads,
+                              const GetRows& getRows,
+                              const AddItem& addItem)
+{
+  const size_t rowSize = static_cast<size_t>(binCntX) * numAreas_;
+  areas_.resize(rowSize * binCntY);
+  if (binCntY == 0) {
+    return;
+  }
+
+  const int bandCnt = std::clamp(numThreads, 1, binCntY);
+  auto bandFirstY = [&](int band) { return binCntY * band / bandCnt; };
+  rowBands_.resize(binCntY);
+  for (int band = 0; band < bandCnt; band++) {
+    std::fill(rowBands_.begin() + bandFirstY(band),
+              rowBands_.begin() + bandFirstY(band + 1),
+              band);
+  }
+
+  rows_.resize(itemCnt);
+#pragma omp parallel for num_threads(numThreads)
+  for (size_t i = 0; i < itemCnt; i++) {
+    rows_[i] = getRows(i);
+  }
+
+  buckets_.resize(bandCnt);
+  for (auto& bucket : buckets_) {
+    bucket.clear();
+  }
+  for (size_t i = 0; i < itemCnt; i++) {
+    const auto [firstY, lastY] = rows_[i];
+    if (firstY >= lastY) {
+      continue;
+    }
+    for (int band = rowBands_[firstY]; band <= rowBands_[lastY - 1]; band++) {
+      buckets_[band].push_back(i);
+    }
+  }
+
+#pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+  for (int band = 0; band < bandCnt; band++) {
+    const int firstY = bandFirstY(band);
+    const int lastY = bandFirstY(band + 1);
+    std::fill(areas_.begin() + firstY * rowSize,
+              areas_.begin() + lastY * rowSize,
+              0);
+    for (const size_t i : buckets_[band]) {
+      addItem(i,
+              std::max(rows_[i].first, firstY),
+              std::min(rows_[i].second, lastY),
+              areas_.data());
+    }
+  }
+}
+
+}  // namespace gpl
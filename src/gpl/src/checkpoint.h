@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <vector>
+
+namespace gpl {
+
+// Value I/O of the placement checkpoint written by NesterovPlace, shared by
+// the classes that save their state in it.  Values are stored as they are in
+// memory so a resumed run continues bit for bit.
+template <typename T>
+void writeBinary(std::ofstream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readBinary(std::ifstream& in)
+{
+  T value{};
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+// A vector stored with its size.
+template <typename T>
+void writeBinaryVector(std::ofstream& out, const std::vector<T>& values)
+{
+  writeBinary<uint32_t>(out, values.size());
+  for (const T& value : values) {
+    writeBinary<T>(out, value);
+  }
+}
+
+// Reads a vector written by writeBinaryVector.  Returns false when its size
+// is not one of the allowed sizes.
+template <typename T>
+bool readBinaryVector(std::ifstream& in,
+                      std::vector<T>& values,
+                      std::initializer_list<size_t> allowed_sizes)
+{
+  const uint32_t size = readBinary<uint32_t>(in);
+  if (std::find(allowed_sizes.begin(), allowed_sizes.end(), size)
+      == allowed_sizes.end()) {
+    return false;
+  }
+  values.resize(size);
+  for (T& value : values) {
+    value = readBinary<T>(in);
+  }
+  return static_cast<bool>(in);
+}
+
+}  // namespace gpl
@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "clustering.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+#include "odb/db.h"
+#include "placerBase.h"
+#include "utl/Logger.h"
+
+namespace gpl {
+
+using utl::GPL;
+
+// Nets with more pins than this carry little placement information and
+// would dominate the neighbor scans.
+static constexpr size_t maxClusteringNetDegree = 50;
+
+BestChoiceClustering::BestChoiceClustering(
+    std::shared_ptr<PlacerBaseCommon> pbc,
+    utl::Logger* log)
+    : pbc_(std::move(pbc)), log_(log)
+{
+}
+
+void BestChoiceClustering::init()
+{
+  insts_.clear();
+  instIndex_.clear();
+  for (Instance* inst : pbc_->placeInsts()) {
+    if (inst->isMacro() || inst->isLocked()) {
+      continue;
+    }
+    instIndex_[inst] = insts_.size();
+    insts_.push_back(inst);
+  }
+
+  const int instCnt = insts_.size();
+  clusterOf_.resize(instCnt);
+  members_.resize(instCnt);
+  areas_.resize(instCnt);
+  groups_.resize(instCnt);
+  versions_.assign(instCnt, 0);
+  for (int i = 0; i < instCnt; i++) {
+    clusterOf_[i] = i;
+    members_[i] = {i};
+    areas_[i] = insts_[i]->area();
+    groups_[i] = insts_[i]->dbInst()->getGroup();
+  }
+}
+
+// The best neighbor maximizes the clique-model connectivity over the
+// sum of the cluster areas, as in the best-choice clustering of
+// Alpert et al.
+bool BestChoiceClustering::findBestNeighbor(int cluster,
+                                            Candidate& candidate) const
+{
+  std::unordered_map<int, float> connectivity;
+  for (const int member : members_[cluster]) {
+    for (const Pin* pin : insts_[member]->pins()) {
+      const Net* net = pin->net();
+      if (net == nullptr) {
+        continue;
+      }
+      const size_t degree = net->pins().size();
+      if (degree < 2 || degree > maxClusteringNetDegree) {
+        continue;
+      }
+      const float weight = 1.0f / (degree - 1);
+      for (const Pin* netPin : net->pins()) {
+        if (netPin == pin || netPin->instance() == nullptr) {
+          continue;
+        }
+        auto it = instIndex_.find(netPin->instance());
+        if (it == instIndex_.end()) {
+          continue;
+        }
+        const int neighbor = clusterOf_[it->second];
+        if (neighbor != cluster) {
+          connectivity[neighbor] += weight;
+        }
+      }
+    }
+  }
+
+  bool found = false;
+  for (const auto& [neighbor, weight] : connectivity) {
+    const int64_t area = areas_[cluster] + areas_[neighbor];
+    if (area > maxClusterArea_ || groups_[neighbor] != groups_[cluster]) {
+      continue;
+    }
+    const float score = weight / area;
+    // ties go to the lowest index to stay deterministic
+    if (!found || score > candidate.score
+        || (score == candidate.score && neighbor < candidate.neighbor)) {
+      candidate.score = score;
+      candidate.neighbor = neighbor;
+      found = true;
+    }
+  }
+  if (found) {
+    candidate.cluster = cluster;
+    candidate.clusterVersion = versions_[cluster];
+    candidate.neighborVersion = versions_[candidate.neighbor];
+  }
+  return found;
+}
+
+void BestChoiceClustering::merge(int cluster, int neighbor)
+{
+  for (const int member : members_[neighbor]) {
+    clusterOf_[member] = cluster;
+  }
+  members_[cluster].insert(members_[cluster].end(),
+                           members_[neighbor].begin(),
+                           members_[neighbor].end());
+  members_[neighbor].clear();
+  areas_[cluster] += areas_[neighbor];
+  versions_[cluster]++;
+  versions_[neighbor]++;
+}
+
+// Merge the best scored pairs until targetClusterCnt clusters remain or
+// nothing can be merged any more. Returns the new number of clusters.
+int BestChoiceClustering::coarsen(int clusterCnt, const int targetClusterCnt)
+{
+  auto lowerPriority = [](const Candidate& a, const Candidate& b) {
+    return a.score < b.score || (a.score == b.score && a.cluster > b.cluster);
+  };
+  using CandidateQueue = std::priority_queue<Candidate,
+                                            std::vector<Candidate>,
+                                            decltype(lowerPriority)>;
+  CandidateQueue queue(lowerPriority);
+
+  Candidate candidate;
+  const int instCnt = insts_.size();
+  for (int cluster = 0; cluster < instCnt; cluster++) {
+    if (!members_[cluster].empty() && findBestNeighbor(cluster, candidate)) {
+      queue.push(candidate);
+    }
+  }
+
+  while (clusterCnt > targetClusterCnt && !queue.empty()) {
+    const Candidate top = queue.top();
+    queue.pop();
+    // merged away or already re-queued with a newer score
+    if (top.clusterVersion != versions_[top.cluster]) {
+      continue;
+    }
+    // the neighbor changed, so the score is stale
+    if (top.neighborVersion != versions_[top.neighbor]) {
+      if (findBestNeighbor(top.cluster, candidate)) {
+        queue.push(candidate);
+      }
+      continue;
+    }
+
+    merge(top.cluster, top.neighbor);
+    clusterCnt--;
+    if (findBestNeighbor(top.cluster, candidate)) {
+      queue.push(candidate);
+    }
+  }
+  return clusterCnt;
+}
+
+std::vector<std::vector<Instance*>> BestChoiceClustering::clusters() const
+{
+  std::vector<std::vector<Instance*>> clusters;
+  for (const auto& members : members_) {
+    if (members.size() < 2) {
+      continue;
+    }
+    std::vector<Instance*>& cluster = clusters.emplace_back();
+    cluster.reserve(members.size());
+    for (const int member : members) {
+      cluster.push_back(insts_[member]);
+    }
+  }
+  return clusters;
+}
+
+std::vector<std::vector<std::vector<Instance*>>> BestChoiceClustering::run(
+    const float coarseningRatio,
+    const int levels)
+{
+  init();
+
+  std::vector<std::vector<std::vector<Instance*>>> levelClusters;
+  const int instCnt = insts_.size();
+  if (instCnt < 2 || coarseningRatio <= 1) {
+    return levelClusters;
+  }
+
+  int64_t totalArea = 0;
+  for (const int64_t area : areas_) {
+    totalArea += area;
+  }
+
+  int clusterCnt = instCnt;
+  float levelRatio = 1;
+  for (int level = 1; level <= levels; level++) {
+    levelRatio *= coarseningRatio;
+    // leave room for uneven clusters while keeping them small next to bins
+    maxClusterArea_ = 2 * levelRatio * totalArea / instCnt;
+    const int prevClusterCnt = clusterCnt;
+    clusterCnt = coarsen(clusterCnt, instCnt / levelRatio);
+    if (clusterCnt == prevClusterCnt) {
+      break;
+    }
+
+    std::vector<std::vector<Instance*>>& clusters
+        = levelClusters.emplace_back(this->clusters());
+    int clusteredInstCnt = 0;
+    for (const auto& cluster : clusters) {
+      clusteredInstCnt += cluster.size();
+    }
+    log_->info(GPL,
+               90,
+               "Multilevel: level {} clustered {} of {} instances into {} "
+               "clusters.",
+               level,
+               clusteredInstCnt,
+               instCnt,
+               clusters.size());
+  }
+  return levelClusters;
+}
+
+}  // namespace gpl
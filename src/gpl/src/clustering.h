@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace odb {
+class dbGroup;
+}
+
+namespace utl {
+class Logger;
+}
+
+namespace gpl {
+
+class Instance;
+class PlacerBaseCommon;
+
+// Best-choice clustering of the movable standard cells. It coarsens the
+// netlist for the multilevel mode of global placement.
+class BestChoiceClustering
+{
+ public:
+  BestChoiceClustering(std::shared_ptr<PlacerBaseCommon> pbc,
+                       utl::Logger* log);
+
+  // Merge the best connected pairs until about 1/coarseningRatio of the
+  // movable standard cells remain, then keep merging the clusters of each
+  // level by the same ratio for the next one. Levels are returned finest
+  // first, each one coarsening the previous one, and stop early once the
+  // clusters no longer merge. Only the clusters with more than one
+  // instance are returned.
+  std::vector<std::vector<std::vector<Instance*>>> run(float coarseningRatio,
+                                                       int levels);
+
+ private:
+  struct Candidate
+  {
+    float score;
+    int cluster;
+    int neighbor;
+    int clusterVersion;
+    int neighborVersion;
+  };
+
+  void init();
+  int coarsen(int clusterCnt, int targetClusterCnt);
+  std::vector<std::vector<Instance*>> clusters() const;
+  bool findBestNeighbor(int cluster, Candidate& candidate) const;
+  void merge(int cluster, int neighbor);
+
+  std::shared_ptr<PlacerBaseCommon> pbc_;
+  utl::Logger* log_ = nullptr;
+
+  std::vector<Instance*> insts_;
+  std::unordered_map<const Instance*, int> instIndex_;
+
+  // per instance
+  std::vector<int> clusterOf_;
+
+  // per cluster; merged clusters are left without members
+  std::vector<std::vector<int>> members_;
+  std::vector<int64_t> areas_;
+  std::vector<odb::dbGroup*> groups_;
+  std::vector<int> versions_;
+
+  int64_t maxClusterArea_ = 0;
+};
+
+}  // namespace gpl
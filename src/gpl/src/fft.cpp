@@ -42,28 +42,21 @@
 
 namespace gpl {
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
+FFT::FFT(int binCntX,
+         int binCntY,
+         int binSizeX,
+         int binSizeY,
+         int numThreads)
     : binCntX_(binCntX),
       binCntY_(binCntY),
       binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+      binSizeY_(binSizeY),
+      numThreads_(numThreads)
 {
-  binDensity_ = new float*[binCntX_];
-  electroPhi_ = new float*[binCntX_];
-  electroForceX_ = new float*[binCntX_];
-  electroForceY_ = new float*[binCntX_];
-
-  for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i] = new float[binCntY_];
-    electroPhi_[i] = new float[binCntY_];
-    electroForceX_[i] = new float[binCntY_];
-    electroForceY_[i] = new float[binCntY_];
-
-    for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] = electroPhi_[i][j] = electroForceX_[i][j]
-          = electroForceY_[i][j] = 0.0f;
-    }
-  }
+  binDensity_.resize(binCntX_ * binCntY_, 0.0f);
+  electroPhi_.resize(binCntX_ * binCntY_, 0.0f);
+  electroForceX_.resize(binCntX_ * binCntY_, 0.0f);
+  electroForceY_.resize(binCntX_ * binCntY_, 0.0f);
 
   csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
 
@@ -74,6 +67,13 @@ FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
 
   workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
 
+  // Build the cos/sin tables up front as the first ddct2d call would, so
+  // the 1D transforms only read them and can run concurrently.
+  const int n = std::max(binCntX_, binCntY_);
+  const int nw = n >> 2;
+  makewt(nw, workArea_.data(), csTable_.data());
+  makect(n, workArea_.data(), csTable_.data() + nw);
+
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -88,68 +88,74 @@ FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
   }
 }
 
-FFT::~FFT()
-{
-  using std::vector;
-  for (int i = 0; i < binCntX_; i++) {
-    delete[] binDensity_[i];
-    delete[] electroPhi_[i];
-    delete[] electroForceX_[i];
-    delete[] electroForceY_[i];
-  }
-  delete[] binDensity_;
-  delete[] electroPhi_;
-  delete[] electroForceX_;
-  delete[] electroForceY_;
-
-  csTable_.clear();
-  wx_.clear();
-  wxSquare_.clear();
-  wy_.clear();
-  wySquare_.clear();
-
-  workArea_.clear();
-}
-
 void FFT::updateDensity(int x, int y, float density)
 {
-  binDensity_[x][y] = density;
+  binDensity_[index(x, y)] = density;
 }
 
 std::pair<float, float> FFT::getElectroForce(int x, int y) const
 {
-  return std::make_pair(electroForceX_[x][y], electroForceY_[x][y]);
+  return std::make_pair(electroForceX_[index(x, y)],
+                        electroForceY_[index(x, y)]);
 }
 
 float FFT::getElectroPhi(int x, int y) const
 {
-  return electroPhi_[x][y];
+  return electroPhi_[index(x, y)];
+}
+
+void FFT::ddxt2d(std::vector<float>& a,
+                 const int isgn,
+                 const bool rowSine,
+                 const bool colSine)
+{
+  int* ip = workArea_.data();
+  float* w = csTable_.data();
+#pragma omp parallel num_threads(numThreads_)
+  {
+#pragma omp for
+    for (int i = 0; i < binCntX_; i++) {
+      if (rowSine) {
+        ddst(binCntY_, isgn, &a[index(i, 0)], ip, w);
+      } else {
+        ddct(binCntY_, isgn, &a[index(i, 0)], ip, w);
+      }
+    }
+
+    // ddxt2d_sub leaves single row arrays alone
+    if (binCntY_ >= 2) {
+      std::vector<float> column(binCntX_);
+#pragma omp for
+      for (int j = 0; j < binCntY_; j++) {
+        for (int i = 0; i < binCntX_; i++) {
+          column[i] = a[index(i, j)];
+        }
+        if (colSine) {
+          ddst(binCntX_, isgn, column.data(), ip, w);
+        } else {
+          ddct(binCntX_, isgn, column.data(), ip, w);
+        }
+        for (int i = 0; i < binCntX_; i++) {
+          a[index(i, j)] = column[i];
+        }
+      }
+    }
+  }
 }
 
 void FFT::doFFT()
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  ddxt2d(binDensity_, -1, false, false);
 
   for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i][0] *= 0.5;
+    binDensity_[index(i, 0)] *= 0.5;
   }
 
   for (int i = 0; i < binCntY_; i++) {
-    binDensity_[0][i] *= 0.5;
-  }
-
-  for (int i = 0; i < binCntX_; i++) {
-    for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
-    }
+    binDensity_[index(0, i)] *= 0.5;
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     float wx = wx_[i];
     float wx2 = wxSquare_[i];
@@ -158,7 +164,9 @@ void FFT::doFFT()
       float wy = wy_[j];
       float wy2 = wySquare_[j];
 
-      float density = binDensity_[i][j];
+      binDensity_[index(i, j)] *= 4.0 / binCntX_ / binCntY_;
+
+      float density = binDensity_[index(i, j)];
       float phi = 0;
       float electroX = 0, electroY = 0;
 
@@ -180,33 +188,15 @@ void FFT::doFFT()
         electroX = phi * wx;
         electroY = phi * wy;
       }
-      electroPhi_[i][j] = phi;
-      electroForceX_[i][j] = electroX;
-      electroForceY_[i][j] = electroY;
+      electroPhi_[index(i, j)] = phi;
+      electroForceX_[index(i, j)] = electroX;
+      electroForceY_[index(i, j)] = electroY;
     }
   }
   // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  ddxt2d(electroPhi_, 1, false, false);
+  ddxt2d(electroForceX_, 1, false, true);
+  ddxt2d(electroForceY_, 1, true, false);
 }
 
 }  // namespace gpl
@@ -40,8 +40,11 @@ namespace gpl {
 class FFT
 {
  public:
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
-  ~FFT();
+  FFT(int binCntX,
+      int binCntY,
+      int binSizeX,
+      int binSizeY,
+      int numThreads = 1);
 
   // input func
   void updateDensity(int x, int y, float density);
@@ -54,12 +57,21 @@ class FFT
   float getElectroPhi(int x, int y) const;
 
  private:
-  // 2D array; width: binCntX_, height: binCntY_;
-  // No hope to use Vector at this moment...
-  float** binDensity_ = nullptr;
-  float** electroPhi_ = nullptr;
-  float** electroForceX_ = nullptr;
-  float** electroForceY_ = nullptr;
+  // 2D DCT/DST of a binCntX_ x binCntY_ array. Rows (fixed x) and then
+  // columns (fixed y) are transformed with the 1D Ooura routines, split
+  // over the threads. Each row and column is transformed exactly as by
+  // ddct2d, ddsct2d and ddcst2d, so the result does not depend on the
+  // number of threads.
+  void ddxt2d(std::vector<float>& a, int isgn, bool rowSine, bool colSine);
+
+  int index(int x, int y) const { return x * binCntY_ + y; }
+
+  // 2D arrays in one contiguous buffer, row x is at index(x, 0)
+  // width: binCntX_, height: binCntY_;
+  std::vector<float> binDensity_;
+  std::vector<float> electroPhi_;
+  std::vector<float> electroForceX_;
+  std::vector<float> electroForceY_;
 
   // cos/sin table (prev: w_2d)
   // length:  max(binCntX, binCntY) * 3 / 2
@@ -81,6 +93,7 @@ class FFT
   int binCntY_ = 0;
   int binSizeX_ = 0;
   int binSizeY_ = 0;
+  int numThreads_ = 1;
 };
 
 //
@@ -89,6 +102,8 @@ class FFT
 //
 //
 /// 1D FFT ////////////////////////////////////////////////////////////////
+void makewt(int nw, int* ip, float* w);
+void makect(int nc, int* ip, float* c);
 void cdft(int n, int isgn, float* a, int* ip, float* w);
 void ddct(int n, int isgn, float* a, int* ip, float* w);
 void ddst(int n, int isgn, float* a, int* ip, float* w);
@@ -210,6 +210,8 @@ void Graphics::drawCells(const std::vector<GCell*>& cells,
                                             : gui::Painter::dark_green;
     } else if (gCell->isFiller()) {
       color = gui::Painter::dark_magenta;
+    } else {
+      color = gui::Painter::dark_yellow;
     }
 
     if (gCell == selected_) {
@@ -33,7 +33,9 @@
 
 #include "initialPlace.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "placerBase.h"
 #include "solver.h"
@@ -54,6 +56,8 @@ void InitialPlaceVars::reset()
   maxSolverIter = 100;
   maxFanout = 200;
   netWeightScale = 800.0;
+  preconditioner = Preconditioner::Identity;
+  numThreads = 1;
   debug = false;
 }
 
@@ -84,6 +88,8 @@ void InitialPlace::doBicgstabPlace()
     createSparseMatrix();
     error = cpuSparseSolve(ipVars_.maxSolverIter,
                            iter,
+                           ipVars_.preconditioner,
+                           ipVars_.numThreads,
                            placeInstForceMatrixX_,
                            fixedInstForceVecX_,
                            instLocVecX_,
@@ -160,14 +166,21 @@ void InitialPlace::setPlaceInstExtId()
 void InitialPlace::updatePinInfo()
 {
   // reset all MinMax attributes
-  for (auto& pin : pbc_->pins()) {
+  const std::vector<Pin*>& pins = pbc_->pins();
+#pragma omp parallel for num_threads(ipVars_.numThreads)
+  for (size_t i = 0; i < pins.size(); i++) {
+    Pin* pin = pins[i];
     pin->unsetMinPinX();
     pin->unsetMinPinY();
     pin->unsetMaxPinX();
     pin->unsetMaxPinY();
   }
 
-  for (auto& net : pbc_->nets()) {
+  // every pin belongs to a single net
+  const std::vector<Net*>& nets = pbc_->nets();
+#pragma omp parallel for num_threads(ipVars_.numThreads)
+  for (size_t i = 0; i < nets.size(); i++) {
+    Net* net = nets[i];
     Pin *pinMinX = nullptr, *pinMinY = nullptr;
     Pin *pinMaxX = nullptr, *pinMaxY = nullptr;
     int lx = INT_MAX, ly = INT_MAX;
@@ -227,20 +240,6 @@ void InitialPlace::createSparseMatrix()
   placeInstForceMatrixX_.resize(placeCnt, placeCnt);
   placeInstForceMatrixY_.resize(placeCnt, placeCnt);
 
-  //
-  // listX and listY is a temporary vector that have tuples, (idx1, idx2, val)
-  //
-  // listX finally becomes placeInstForceMatrixX_
-  // listY finally becomes placeInstForceMatrixY_
-  //
-  // The triplet vector is recommended usages
-  // to fill in SparseMatrix from Eigen docs.
-  //
-
-  std::vector<T> listX, listY;
-  listX.reserve(1000000);
-  listY.reserve(1000000);
-
   // initialize vector
   for (auto& inst : pbc_->placeInsts()) {
     int idx = inst->extId();
@@ -251,96 +250,83 @@ void InitialPlace::createSparseMatrix()
     fixedInstForceVecX_(idx) = fixedInstForceVecY_(idx) = 0;
   }
 
-  // for each net
-  for (auto& net : pbc_->nets()) {
-    // skip for small nets.
-    if (net->pins().size() <= 1) {
-      continue;
-    }
-
-    // escape long time cals on huge fanout.
-    //
-    if (net->pins().size() >= ipVars_.maxFanout) {
-      continue;
-    }
-
-    float netWeight = ipVars_.netWeightScale / (net->pins().size() - 1);
-
-    // foreach two pins in single nets.
-    auto& pins = net->pins();
-    for (int pinIdx1 = 1; pinIdx1 < pins.size(); ++pinIdx1) {
-      Pin* pin1 = pins[pinIdx1];
-      for (int pinIdx2 = 0; pinIdx2 < pinIdx1; ++pinIdx2) {
-        Pin* pin2 = pins[pinIdx2];
-
-        // no need to fill in when instance is same
-        if (pin1->instance() == pin2->instance()) {
-          continue;
-        }
+  createAxisSparseMatrix(true, placeInstForceMatrixX_, fixedInstForceVecX_);
+  createAxisSparseMatrix(false, placeInstForceMatrixY_, fixedInstForceVecY_);
+}
 
-        // B2B modeling on min/maxX pins.
-        if (pin1->isMinPinX() || pin1->isMaxPinX() || pin2->isMinPinX()
-            || pin2->isMaxPinX()) {
-          int diffX = abs(pin1->cx() - pin2->cx());
-          float weightX = 0;
-          if (diffX > ipVars_.minDiffLength) {
-            weightX = netWeight / diffX;
-          } else {
-            weightX = netWeight / ipVars_.minDiffLength;
-          }
+void InitialPlace::createAxisSparseMatrix(bool isX,
+                                          SMatrix& placeInstForceMatrix,
+                                          Eigen::VectorXf& fixedInstForceVec)
+{
+  auto coordi = [isX](const auto* obj) { return isX ? obj->cx() : obj->cy(); };
+  auto isB2BPin = [isX](const Pin* pin) {
+    return isX ? pin->isMinPinX() || pin->isMaxPinX()
+               : pin->isMinPinY() || pin->isMaxPinY();
+  };
 
-          // both pin cames from instance
-          if (pin1->isPlaceInstConnected() && pin2->isPlaceInstConnected()) {
-            const int inst1 = pin1->instance()->extId();
-            const int inst2 = pin2->instance()->extId();
+  //
+  // list is a temporary vector that have tuples, (idx1, idx2, val)
+  // which finally becomes placeInstForceMatrix
+  //
+  // The triplet vector is recommended usages
+  // to fill in SparseMatrix from Eigen docs.
+  //
+  // The nets are split into one contiguous chunk per thread.  Each chunk
+  // collects its own triplets and fixed force terms, which are then merged
+  // in net order so the result does not depend on the number of threads.
+  //
 
-            listX.emplace_back(inst1, inst1, weightX);
-            listX.emplace_back(inst2, inst2, weightX);
+  const std::vector<Net*>& nets = pbc_->nets();
+  const int numChunks = std::max(
+      1, std::min(ipVars_.numThreads, static_cast<int>(nets.size())));
+  std::vector<std::vector<T>> chunkLists(numChunks);
+  std::vector<std::vector<std::pair<int, float>>> chunkForces(numChunks);
+
+#pragma omp parallel for num_threads(numChunks) schedule(static, 1)
+  for (int chunk = 0; chunk < numChunks; chunk++) {
+    std::vector<T>& list = chunkLists[chunk];
+    std::vector<std::pair<int, float>>& forces = chunkForces[chunk];
+    const size_t firstNet = nets.size() * chunk / numChunks;
+    const size_t lastNet = nets.size() * (chunk + 1) / numChunks;
+
+    for (size_t netIdx = firstNet; netIdx < lastNet; netIdx++) {
+      Net* net = nets[netIdx];
+      // skip for small nets.
+      if (net->pins().size() <= 1) {
+        continue;
+      }
 
-            listX.emplace_back(inst1, inst2, -weightX);
-            listX.emplace_back(inst2, inst1, -weightX);
+      // escape long time cals on huge fanout.
+      //
+      if (net->pins().size() >= ipVars_.maxFanout) {
+        continue;
+      }
 
-            fixedInstForceVecX_(inst1)
-                += -weightX
-                   * ((pin1->cx() - pin1->instance()->cx())
-                      - (pin2->cx() - pin2->instance()->cx()));
+      float netWeight = ipVars_.netWeightScale / (net->pins().size() - 1);
 
-            fixedInstForceVecX_(inst2)
-                += -weightX
-                   * ((pin2->cx() - pin2->instance()->cx())
-                      - (pin1->cx() - pin1->instance()->cx()));
-          }
-          // pin1 from IO port / pin2 from Instance
-          else if (!pin1->isPlaceInstConnected()
-                   && pin2->isPlaceInstConnected()) {
-            const int inst2 = pin2->instance()->extId();
-            listX.emplace_back(inst2, inst2, weightX);
+      // foreach two pins in single nets.
+      auto& pins = net->pins();
+      for (int pinIdx1 = 1; pinIdx1 < pins.size(); ++pinIdx1) {
+        Pin* pin1 = pins[pinIdx1];
+        for (int pinIdx2 = 0; pinIdx2 < pinIdx1; ++pinIdx2) {
+          Pin* pin2 = pins[pinIdx2];
 
-            fixedInstForceVecX_(inst2)
-                += weightX
-                   * (pin1->cx() - (pin2->cx() - pin2->instance()->cx()));
+          // no need to fill in when instance is same
+          if (pin1->instance() == pin2->instance()) {
+            continue;
           }
-          // pin1 from Instance / pin2 from IO port
-          else if (pin1->isPlaceInstConnected()
-                   && !pin2->isPlaceInstConnected()) {
-            const int inst1 = pin1->instance()->extId();
-            listX.emplace_back(inst1, inst1, weightX);
 
-            fixedInstForceVecX_(inst1)
-                += weightX
-                   * (pin2->cx() - (pin1->cx() - pin1->instance()->cx()));
+          // B2B modeling on min/max pins.
+          if (!isB2BPin(pin1) && !isB2BPin(pin2)) {
+            continue;
           }
-        }
 
-        // B2B modeling on min/maxY pins.
-        if (pin1->isMinPinY() || pin1->isMaxPinY() || pin2->isMinPinY()
-            || pin2->isMaxPinY()) {
-          int diffY = abs(pin1->cy() - pin2->cy());
-          float weightY = 0;
-          if (diffY > ipVars_.minDiffLength) {
-            weightY = netWeight / diffY;
+          int diff = abs(coordi(pin1) - coordi(pin2));
+          float weight = 0;
+          if (diff > ipVars_.minDiffLength) {
+            weight = netWeight / diff;
           } else {
-            weightY = netWeight / ipVars_.minDiffLength;
+            weight = netWeight / ipVars_.minDiffLength;
           }
 
           // both pin cames from instance
@@ -348,49 +334,92 @@ void InitialPlace::createSparseMatrix()
             const int inst1 = pin1->instance()->extId();
             const int inst2 = pin2->instance()->extId();
 
-            listY.emplace_back(inst1, inst1, weightY);
-            listY.emplace_back(inst2, inst2, weightY);
+            list.emplace_back(inst1, inst1, weight);
+            list.emplace_back(inst2, inst2, weight);
 
-            listY.emplace_back(inst1, inst2, -weightY);
-            listY.emplace_back(inst2, inst1, -weightY);
+            list.emplace_back(inst1, inst2, -weight);
+            list.emplace_back(inst2, inst1, -weight);
 
-            fixedInstForceVecY_(inst1)
-                += -weightY
-                   * ((pin1->cy() - pin1->instance()->cy())
-                      - (pin2->cy() - pin2->instance()->cy()));
+            forces.emplace_back(
+                inst1,
+                -weight
+                    * ((coordi(pin1) - coordi(pin1->instance()))
+                       - (coordi(pin2) - coordi(pin2->instance()))));
 
-            fixedInstForceVecY_(inst2)
-                += -weightY
-                   * ((pin2->cy() - pin2->instance()->cy())
-                      - (pin1->cy() - pin1->instance()->cy()));
+            forces.emplace_back(
+                inst2,
+                -weight
+                    * ((coordi(pin2) - coordi(pin2->instance()))
+                       - (coordi(pin1) - coordi(pin1->instance()))));
           }
           // pin1 from IO port / pin2 from Instance
           else if (!pin1->isPlaceInstConnected()
                    && pin2->isPlaceInstConnected()) {
             const int inst2 = pin2->instance()->extId();
-            listY.emplace_back(inst2, inst2, weightY);
+            list.emplace_back(inst2, inst2, weight);
 
-            fixedInstForceVecY_(inst2)
-                += weightY
-                   * (pin1->cy() - (pin2->cy() - pin2->instance()->cy()));
+            forces.emplace_back(
+                inst2,
+                weight
+                    * (coordi(pin1)
+                       - (coordi(pin2) - coordi(pin2->instance()))));
           }
           // pin1 from Instance / pin2 from IO port
           else if (pin1->isPlaceInstConnected()
                    && !pin2->isPlaceInstConnected()) {
             const int inst1 = pin1->instance()->extId();
-            listY.emplace_back(inst1, inst1, weightY);
+            list.emplace_back(inst1, inst1, weight);
 
-            fixedInstForceVecY_(inst1)
-                += weightY
-                   * (pin2->cy() - (pin1->cy() - pin1->instance()->cy()));
+            forces.emplace_back(
+                inst1,
+                weight
+                    * (coordi(pin2)
+                       - (coordi(pin1) - coordi(pin1->instance()))));
           }
         }
       }
     }
   }
 
-  placeInstForceMatrixX_.setFromTriplets(listX.begin(), listX.end());
-  placeInstForceMatrixY_.setFromTriplets(listY.begin(), listY.end());
+  const int placeCnt = pbc_->placeInsts().size();
+  const bool incompleteCholesky
+      = ipVars_.preconditioner == Preconditioner::IncompleteCholesky;
+
+  size_t listSize = incompleteCholesky ? placeCnt : 0;
+  for (const std::vector<T>& chunkList : chunkLists) {
+    listSize += chunkList.size();
+  }
+  std::vector<T> list;
+  list.reserve(listSize);
+
+  if (incompleteCholesky) {
+    // incomplete Cholesky requires every diagonal entry to be stored
+    for (int idx = 0; idx < placeCnt; idx++) {
+      list.emplace_back(idx, idx, 0);
+    }
+  }
+
+  for (int chunk = 0; chunk < numChunks; chunk++) {
+    list.insert(list.end(), chunkLists[chunk].begin(), chunkLists[chunk].end());
+    for (const auto& [idx, force] : chunkForces[chunk]) {
+      fixedInstForceVec(idx) += force;
+    }
+  }
+
+  placeInstForceMatrix.setFromTriplets(list.begin(), list.end());
+
+  if (incompleteCholesky) {
+    // Unconnected instances would make the system singular; pin them to
+    // their current location instead.
+    for (auto& inst : pbc_->placeInsts()) {
+      const int idx = inst->extId();
+      float& diagonal = placeInstForceMatrix.coeffRef(idx, idx);
+      if (diagonal == 0) {
+        diagonal = 1;
+        fixedInstForceVec(idx) = coordi(inst);
+      }
+    }
+  }
 }
 
 void InitialPlace::updateCoordi()
@@ -38,6 +38,7 @@
 
 #include "nesterovPlace.h"
 #include "odb/db.h"
+#include "solver.h"
 
 namespace utl {
 class Logger;
@@ -57,14 +58,14 @@ class InitialPlaceVars
   int maxSolverIter;
   int maxFanout;
   float netWeightScale;
+  Preconditioner preconditioner;
+  int numThreads;
   bool debug;
 
   InitialPlaceVars();
   void reset();
 };
 
-using SMatrix = Eigen::SparseMatrix<float, Eigen::RowMajor>;
-
 class InitialPlace
 {
  public:
@@ -114,6 +115,9 @@ class InitialPlace
   void setPlaceInstExtId();
   void updatePinInfo();
   void createSparseMatrix();
+  void createAxisSparseMatrix(bool isX,
+                              SMatrix& placeInstForceMatrix,
+                              Eigen::VectorXf& fixedInstForceVec);
   void updateCoordi();
 };
 
@@ -41,6 +41,7 @@
 
 #include <algorithm>
 #include <random>
+#include <tuple>
 
 #include "db_sta/dbNetwork.hh"
 #include "db_sta/dbSta.hh"
@@ -97,6 +98,24 @@ struct Flop
   }
 };
 
+// A pointset of a flop group with the state of its clustering
+struct Pointset
+{
+  std::vector<Flop> flops;
+  std::vector<int> array_mask;
+  int group;
+  std::vector<float> norm_power;
+  // start_trays[i][j]: start trays of size 2^i, multistart = j
+  std::vector<std::vector<std::vector<Tray>>> start_trays;
+  std::vector<std::vector<float>> start_silh;
+  // trays[i]: trays of size 2^i
+  std::vector<std::vector<Tray>> trays;
+  std::vector<Tray> final_trays;
+  std::vector<std::pair<int, int>> mapping;
+  std::map<int, int> tray_sizes_used;
+  float cost = 0;
+};
+
 // Get the function for a port.  If the port has no function then check
 // the parent bus/bundle, if any.  This covers:
 //    bundle (QN) {
@@ -936,7 +955,9 @@ double MBFF::RunILP(const std::vector<Flop>& flops,
                     const std::vector<Tray>& trays,
                     std::vector<std::pair<int, int>>& final_flop_to_slot,
                     float alpha,
-                    std::vector<int> array_mask)
+                    std::vector<int> array_mask,
+                    const std::vector<float>& norm_power,
+                    std::map<int, int>& tray_sizes_used)
 {
   const int num_flops = static_cast<int>(flops.size());
   const int num_trays = static_cast<int>(trays.size());
@@ -1078,7 +1099,7 @@ double MBFF::RunILP(const std::vector<Flop>& flops,
     if (GetBitCnt(bit_idx) == 1) {
       tray_cost[i] = 1.00;
     } else {
-      tray_cost[i] = (GetBitCnt(bit_idx) * norm_power_[bit_idx]);
+      tray_cost[i] = (GetBitCnt(bit_idx) * norm_power[bit_idx]);
     }
   }
 
@@ -1145,7 +1166,7 @@ double MBFF::RunILP(const std::vector<Flop>& flops,
     }
 
     for (const auto& sizes : trays_used) {
-      tray_sizes_used_[sizes.second]++;
+      tray_sizes_used[sizes.second]++;
     }
 
     return ret;
@@ -1242,92 +1263,122 @@ Tray MBFF::GetOneBit(const Point& pt)
   return tray;
 }
 
-void MBFF::MinCostFlow(const std::vector<Flop>& flops,
-                       std::vector<Tray>& trays,
-                       const int sz,
-                       std::vector<std::pair<int, int>>& clusters)
+// Min-cost flow network from the flops to the slots of the trays.  Its
+// topology only depends on the number of flops and of tray slots, so it is
+// built once per capacitated K-means run and only the flop to slot costs
+// change between its iterations.
+class FlopSlotFlow
 {
-  const int num_flops = static_cast<int>(flops.size());
-  const int num_trays = static_cast<int>(trays.size());
+ public:
+  FlopSlotFlow(int num_flops, const std::vector<Tray>& trays);
+
+  int numFlops() const { return num_flops_; }
+  const std::vector<std::pair<int, int>>& slotToTray() const
+  {
+    return slot_to_tray_;
+  }
+
+  // costs[slot * numFlops() + flop] is the cost of moving flop to slot;
+  // returns the flop to slot arcs used by the solution.
+  void solve(const std::vector<int>& costs, std::vector<int>& flop_slot);
 
-  lemon::ListDigraph graph;
-  std::vector<lemon::ListDigraph::Node> nodes;
-  std::vector<lemon::ListDigraph::Arc> edges;
-  std::vector<int> cur_costs, cur_caps;
+ private:
+  using Graph = lemon::ListDigraph;
+
+  int num_flops_;
+  Graph graph_;
+  Graph::ArcMap<int> costs_;
+  Graph::ArcMap<int> caps_;
+  // flop_to_slot_[slot * num_flops_ + flop]
+  std::vector<Graph::Arc> flop_to_slot_;
+  std::vector<std::pair<int, int>> slot_to_tray_;
+  std::unique_ptr<lemon::NetworkSimplex<Graph, int, int>> simplex_;
+};
 
+FlopSlotFlow::FlopSlotFlow(const int num_flops, const std::vector<Tray>& trays)
+    : num_flops_(num_flops), costs_(graph_), caps_(graph_)
+{
   // add edges from source to flop
-  lemon::ListDigraph::Node src = graph.addNode(), sink = graph.addNode();
+  const Graph::Node src = graph_.addNode();
+  const Graph::Node sink = graph_.addNode();
+  std::vector<Graph::Node> flop_nodes;
   for (int i = 0; i < num_flops; i++) {
-    lemon::ListDigraph::Node flop_node = graph.addNode();
-    nodes.push_back(flop_node);
+    const Graph::Node flop_node = graph_.addNode();
+    flop_nodes.push_back(flop_node);
 
-    lemon::ListDigraph::Arc src_to_flop = graph.addArc(src, flop_node);
-    edges.push_back(src_to_flop);
-    cur_costs.push_back(0), cur_caps.push_back(1);
+    const Graph::Arc src_to_flop = graph_.addArc(src, flop_node);
+    costs_[src_to_flop] = 0, caps_[src_to_flop] = 1;
   }
 
-  std::vector<std::pair<int, int>> slot_to_tray;
-
-  for (int i = 0; i < num_trays; i++) {
-    std::vector<Point> tray_slots = trays[i].slots;
-
-    for (size_t j = 0; j < tray_slots.size(); j++) {
-      lemon::ListDigraph::Node slot_node = graph.addNode();
-      nodes.push_back(slot_node);
+  for (size_t i = 0; i < trays.size(); i++) {
+    for (size_t j = 0; j < trays[i].slots.size(); j++) {
+      const Graph::Node slot_node = graph_.addNode();
 
       // add edges from flop to slot
       for (int k = 0; k < num_flops; k++) {
-        lemon::ListDigraph::Arc flop_to_slot
-            = graph.addArc(nodes[k], slot_node);
-        edges.push_back(flop_to_slot);
-
-        int edge_cost = (100 * GetDist(flops[k].pt, tray_slots[j]));
-        cur_costs.push_back(edge_cost), cur_caps.push_back(1);
+        const Graph::Arc flop_to_slot = graph_.addArc(flop_nodes[k], slot_node);
+        flop_to_slot_.push_back(flop_to_slot);
+        caps_[flop_to_slot] = 1;
       }
 
       // add edges from slot to sink
-      lemon::ListDigraph::Arc slot_to_sink = graph.addArc(slot_node, sink);
-      edges.push_back(slot_to_sink);
-      cur_costs.push_back(0), cur_caps.push_back(1);
+      const Graph::Arc slot_to_sink = graph_.addArc(slot_node, sink);
+      costs_[slot_to_sink] = 0, caps_[slot_to_sink] = 1;
 
-      slot_to_tray.emplace_back(i, j);
+      slot_to_tray_.emplace_back(i, j);
     }
   }
 
-  // run min-cost flow
-  lemon::ListDigraph::ArcMap<int> costs(graph), caps(graph), flow(graph);
-  lemon::ListDigraph::NodeMap<int> labels(graph);
-  lemon::NetworkSimplex<lemon::ListDigraph, int, int> new_graph(graph);
+  simplex_ = std::make_unique<lemon::NetworkSimplex<Graph, int, int>>(graph_);
+  simplex_->upperMap(caps_);
+  simplex_->stSupply(src, sink, num_flops);
+}
 
-  for (size_t i = 0; i < edges.size(); i++) {
-    costs[edges[i]] = cur_costs[i], caps[edges[i]] = cur_caps[i];
+void FlopSlotFlow::solve(const std::vector<int>& costs,
+                         std::vector<int>& flop_slot)
+{
+  for (size_t i = 0; i < flop_to_slot_.size(); i++) {
+    costs_[flop_to_slot_[i]] = costs[i];
   }
+  simplex_->costMap(costs_);
+  simplex_->run();
 
-  labels[src] = -1;
-  for (size_t i = 0; i < nodes.size(); i++) {
-    labels[nodes[i]] = i;
+  flop_slot.clear();
+  for (size_t i = 0; i < flop_to_slot_.size(); i++) {
+    if (simplex_->flow(flop_to_slot_[i]) != 0) {
+      flop_slot.push_back(i);
+    }
   }
-  labels[sink] = static_cast<int>(nodes.size());
+}
 
-  new_graph.costMap(costs);
-  new_graph.upperMap(caps);
-  new_graph.stSupply(src, sink, num_flops);
-  new_graph.run();
-  new_graph.flowMap(flow);
+void MBFF::MinCostFlow(const std::vector<Flop>& flops,
+                       std::vector<Tray>& trays,
+                       FlopSlotFlow& flow,
+                       std::vector<std::pair<int, int>>& clusters)
+{
+  const int num_flops = flow.numFlops();
+  const std::vector<std::pair<int, int>>& slot_to_tray = flow.slotToTray();
+
+  std::vector<int> costs;
+  costs.reserve(slot_to_tray.size() * num_flops);
+  for (const auto& [tray_idx, slot_idx] : slot_to_tray) {
+    const Point& slot = trays[tray_idx].slots[slot_idx];
+    for (int k = 0; k < num_flops; k++) {
+      costs.push_back(static_cast<int>(100 * GetDist(flops[k].pt, slot)));
+    }
+  }
+
+  std::vector<int> flop_slot;
+  flow.solve(costs, flop_slot);
 
   // get, and save, the clustering solution
   clusters.clear();
   clusters.resize(num_flops);
-  for (lemon::ListDigraph::ArcIt itr(graph); itr != lemon::INVALID; ++itr) {
-    const int u = labels[graph.source(itr)];
-    int v = labels[graph.target(itr)];
-    if (flow[itr] != 0 && u < num_flops && v >= num_flops) {
-      v -= num_flops;
-      const int tray_idx = slot_to_tray[v].first;
-      const int slot_idx = slot_to_tray[v].second;
-      clusters[u] = {tray_idx, slot_idx};
-      trays[tray_idx].cand[slot_idx] = u;
-    }
+  for (const int arc : flop_slot) {
+    const int u = arc % num_flops;
+    const auto [tray_idx, slot_idx] = slot_to_tray[arc / num_flops];
+    clusters[u] = {tray_idx, slot_idx};
+    trays[tray_idx].cand[slot_idx] = u;
   }
 }
 
@@ -1372,9 +1423,10 @@ void MBFF::RunCapacitatedKMeans(const std::vector<Flop>& flops,
   const int cols = sz / rows;
   const int num_trays = (num_flops + (sz - 1)) / sz;
 
+  FlopSlotFlow flow(num_flops, trays);
   float delta = 0;
   for (int i = 0; i < iter; i++) {
-    MinCostFlow(flops, trays, sz, cluster);
+    MinCostFlow(flops, trays, flow, cluster);
     delta = RunLP(flops, trays, cluster);
 
     for (int j = 0; j < num_trays; j++) {
@@ -1389,94 +1441,7 @@ void MBFF::RunCapacitatedKMeans(const std::vector<Flop>& flops,
     }
   }
 
-  MinCostFlow(flops, trays, sz, cluster);
-}
-
-void MBFF::RunMultistart(
-    std::vector<std::vector<Tray>>& trays,
-    const std::vector<Flop>& flops,
-    std::vector<std::vector<std::vector<Tray>>>& start_trays,
-    const std::vector<int> array_mask)
-{
-  const int num_flops = static_cast<int>(flops.size());
-  trays.resize(num_sizes_);
-  for (int i = 0; i < num_sizes_; i++) {
-    const int num_trays = (num_flops + (GetBitCnt(i) - 1)) / GetBitCnt(i);
-    trays[i].resize(num_trays);
-  }
-
-  // add 1-bit trays
-  for (int i = 0; i < num_flops; i++) {
-    Tray one_bit = GetOneBit(flops[i].pt);
-    one_bit.cand.reserve(1);
-    one_bit.cand.emplace_back(i);
-    trays[0][i] = std::move(one_bit);
-  }
-
-  std::vector<float> res[num_sizes_];
-  std::vector<std::pair<int, int>> ind;
-
-  for (int i = 1; i < num_sizes_; i++) {
-    if (best_master_[array_mask][i] != nullptr) {
-      for (int j = 0; j < 5; j++) {
-        ind.emplace_back(i, j);
-      }
-      res[i].resize(5);
-    }
-  }
-
-  for (int i = 1; i < num_sizes_; i++) {
-    if (best_master_[array_mask][i] != nullptr) {
-      for (int j = 0; j < 5; j++) {
-        const int rows = GetRows(GetBitCnt(i), array_mask);
-        const int cols = GetBitCnt(i) / rows;
-        const int num_trays = (num_flops + (GetBitCnt(i) - 1)) / GetBitCnt(i);
-
-        for (int k = 0; k < num_trays; k++) {
-          GetSlots(start_trays[i][j][k].pt,
-                   rows,
-                   cols,
-                   start_trays[i][j][k].slots,
-                   array_mask);
-          start_trays[i][j][k].cand.reserve(rows * cols);
-          for (int idx = 0; idx < rows * cols; idx++) {
-            start_trays[i][j][k].cand.emplace_back(-1);
-          }
-        }
-      }
-    }
-  }
-
-  for (const auto& [bit_idx, tray_idx] : ind) {
-    const int rows = GetRows(GetBitCnt(bit_idx), array_mask);
-    const int cols = GetBitCnt(bit_idx) / rows;
-
-    std::vector<std::pair<int, int>> tmp_cluster;
-
-    RunCapacitatedKMeans(flops,
-                         start_trays[bit_idx][tray_idx],
-                         rows * cols,
-                         8,
-                         tmp_cluster,
-                         array_mask);
-
-    res[bit_idx][tray_idx]
-        = GetSilh(flops, start_trays[bit_idx][tray_idx], tmp_cluster);
-  }
-
-  for (int i = 1; i < num_sizes_; i++) {
-    if (best_master_[array_mask][i] != nullptr) {
-      int opt_idx = 0;
-      float opt_val = -1;
-      for (int j = 0; j < 5; j++) {
-        if (res[i][j] > opt_val) {
-          opt_val = res[i][j];
-          opt_idx = j;
-        }
-      }
-      trays[i] = start_trays[i][opt_idx];
-    }
-  }
+  MinCostFlow(flops, trays, flow, cluster);
 }
 
 // standard K-means++ implementation
@@ -1705,118 +1670,177 @@ float MBFF::GetPairDisplacements()
   return ret;
 }
 
-float MBFF::RunClustering(const std::vector<Flop>& flops,
-                          const int mx_sz,
-                          const float alpha,
-                          const float beta,
-                          const std::vector<int> array_mask)
+void MBFF::AddPointsets(const std::vector<Flop>& flops,
+                        const int mx_sz,
+                        const std::vector<int>& array_mask,
+                        const int group,
+                        std::vector<Pointset>& pointsets)
 {
-  std::vector<std::vector<Flop>> pointsets;
-  KMeansDecomp(flops, mx_sz, pointsets);
-
-  // all_start_trays[t][i][j]: start trays of size 2^i, multistart = j for
-  // pointset[t]
-  const int num_pointsets = static_cast<int>(pointsets.size());
-  std::vector<std::vector<std::vector<Tray>>> all_start_trays[num_pointsets];
-  for (int t = 0; t < num_pointsets; t++) {
-    all_start_trays[t].resize(num_sizes_);
+  std::vector<std::vector<Flop>> flop_sets;
+  KMeansDecomp(flops, mx_sz, flop_sets);
+
+  for (std::vector<Flop>& set_flops : flop_sets) {
+    Pointset pointset;
+    pointset.flops = std::move(set_flops);
+    pointset.array_mask = array_mask;
+    pointset.group = group;
+    pointset.norm_power = norm_power_;
+    pointset.start_trays.resize(num_sizes_);
+    pointset.start_silh.resize(num_sizes_);
+
+    const int num_flops = static_cast<int>(pointset.flops.size());
     for (int i = 1; i < num_sizes_; i++) {
       if (best_master_[array_mask][i] != nullptr) {
         const int rows = GetRows(GetBitCnt(i), array_mask);
         const int cols = GetBitCnt(i) / rows;
         const float AR = (cols * single_bit_width_ * norm_area_[i])
                          / (rows * single_bit_height_);
-        const int num_trays
-            = (static_cast<int>(pointsets[t].size()) + (GetBitCnt(i) - 1))
-              / GetBitCnt(i);
-        all_start_trays[t][i].resize(5);
-        for (int j = 0; j < 5; j++) {
-          // running in parallel ==> not reproducible
-          GetStartTrays(pointsets[t], num_trays, AR, all_start_trays[t][i][j]);
+        const int num_trays = (num_flops + (GetBitCnt(i) - 1)) / GetBitCnt(i);
+        pointset.start_trays[i].resize(num_starts_);
+        pointset.start_silh[i].resize(num_starts_);
+        for (std::vector<Tray>& start_trays : pointset.start_trays[i]) {
+          // kept serial so the std::rand start trays are reproducible
+          GetStartTrays(pointset.flops, num_trays, AR, start_trays);
+          for (Tray& tray : start_trays) {
+            GetSlots(tray.pt, rows, cols, tray.slots, array_mask);
+            tray.cand.assign(rows * cols, -1);
+          }
         }
       }
     }
+
+    pointsets.push_back(std::move(pointset));
   }
+}
 
-  float ans = 0;
-  std::vector<std::pair<int, int>> all_mappings[num_pointsets];
-  std::vector<Tray> all_final_trays[num_pointsets];
+void MBFF::RunClustering(std::vector<Pointset>& pointsets, const float alpha)
+{
+  const int num_pointsets = static_cast<int>(pointsets.size());
 
-#pragma omp parallel for num_threads(num_threads_)
+  // multistart: capacitated K-means from every set of start trays, scored
+  // by the silhouette of the clustering
+  std::vector<std::tuple<int, int, int>> starts;
   for (int t = 0; t < num_pointsets; t++) {
-    std::vector<std::vector<Tray>> cur_trays;
-    RunMultistart(cur_trays, pointsets[t], all_start_trays[t], array_mask);
-
-    // run capacitated k-means per tray size
-    const int num_flops = static_cast<int>(pointsets[t].size());
     for (int i = 1; i < num_sizes_; i++) {
-      if (best_master_[array_mask][i] != nullptr) {
-        const int rows = GetRows(GetBitCnt(i), array_mask),
-                  cols = GetBitCnt(i) / rows;
-        const int num_trays = (num_flops + (GetBitCnt(i) - 1)) / GetBitCnt(i);
+      const int num_starts = pointsets[t].start_trays[i].size();
+      for (int j = 0; j < num_starts; j++) {
+        starts.emplace_back(t, i, j);
+      }
+    }
+  }
 
-        for (int j = 0; j < num_trays; j++) {
-          GetSlots(cur_trays[i][j].pt,
-                   rows,
-                   cols,
-                   cur_trays[i][j].slots,
-                   array_mask);
-        }
+  const int num_jobs = starts.size();
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int s = 0; s < num_jobs; s++) {
+    const auto [t, i, j] = starts[s];
+    Pointset& pointset = pointsets[t];
+    std::vector<Tray>& trays = pointset.start_trays[i][j];
+    const int rows = GetRows(GetBitCnt(i), pointset.array_mask);
+    const int cols = GetBitCnt(i) / rows;
 
-        std::vector<std::pair<int, int>> cluster;
-        RunCapacitatedKMeans(
-            pointsets[t], cur_trays[i], GetBitCnt(i), 35, cluster, array_mask);
-        MinCostFlow(pointsets[t], cur_trays[i], GetBitCnt(i), cluster);
-        for (int j = 0; j < num_trays; j++) {
-          GetSlots(cur_trays[i][j].pt,
-                   rows,
-                   cols,
-                   cur_trays[i][j].slots,
-                   array_mask);
-        }
+    std::vector<std::pair<int, int>> tmp_cluster;
+    RunCapacitatedKMeans(pointset.flops,
+                         trays,
+                         rows * cols,
+                         8,
+                         tmp_cluster,
+                         pointset.array_mask);
+    pointset.start_silh[i][j] = GetSilh(pointset.flops, trays, tmp_cluster);
+  }
+
+  // run capacitated k-means per tray size from the best start
+  std::vector<std::pair<int, int>> sizes;
+  for (int t = 0; t < num_pointsets; t++) {
+    pointsets[t].trays.resize(num_sizes_);
+    for (int i = 1; i < num_sizes_; i++) {
+      if (!pointsets[t].start_trays[i].empty()) {
+        sizes.emplace_back(t, i);
       }
     }
-    for (int i = 0; i < num_sizes_; i++) {
-      if (!i || best_master_[array_mask][i] != nullptr) {
-        all_final_trays[t].insert(
-            all_final_trays[t].end(), cur_trays[i].begin(), cur_trays[i].end());
+  }
+
+  const int num_size_jobs = sizes.size();
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int s = 0; s < num_size_jobs; s++) {
+    const auto [t, i] = sizes[s];
+    Pointset& pointset = pointsets[t];
+
+    int opt_idx = 0;
+    float opt_val = -1;
+    for (int j = 0; j < num_starts_; j++) {
+      if (pointset.start_silh[i][j] > opt_val) {
+        opt_val = pointset.start_silh[i][j];
+        opt_idx = j;
       }
     }
-    std::vector<std::pair<int, int>> mapping(num_flops);
-    const float cur_ans
-        = RunILP(pointsets[t], all_final_trays[t], mapping, alpha, array_mask);
-    all_mappings[t] = std::move(mapping);
-    ans += cur_ans;
+    std::vector<Tray>& trays = pointset.trays[i];
+    trays = std::move(pointset.start_trays[i][opt_idx]);
+
+    const int rows = GetRows(GetBitCnt(i), pointset.array_mask);
+    const int cols = GetBitCnt(i) / rows;
+    for (Tray& tray : trays) {
+      GetSlots(tray.pt, rows, cols, tray.slots, pointset.array_mask);
+    }
+
+    std::vector<std::pair<int, int>> cluster;
+    RunCapacitatedKMeans(
+        pointset.flops, trays, GetBitCnt(i), 35, cluster, pointset.array_mask);
   }
 
+  // choose the trays of each pointset
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
   for (int t = 0; t < num_pointsets; t++) {
-    ModifyPinConnections(
-        pointsets[t], all_final_trays[t], all_mappings[t], array_mask);
+    Pointset& pointset = pointsets[t];
+    const int num_flops = static_cast<int>(pointset.flops.size());
+
+    // add 1-bit trays
+    pointset.trays[0].resize(num_flops);
+    for (int i = 0; i < num_flops; i++) {
+      Tray one_bit = GetOneBit(pointset.flops[i].pt);
+      one_bit.cand.reserve(1);
+      one_bit.cand.emplace_back(i);
+      pointset.trays[0][i] = std::move(one_bit);
+    }
+
+    for (const std::vector<Tray>& trays : pointset.trays) {
+      pointset.final_trays.insert(
+          pointset.final_trays.end(), trays.begin(), trays.end());
+    }
+    pointset.mapping.resize(num_flops);
+    pointset.cost = RunILP(pointset.flops,
+                           pointset.final_trays,
+                           pointset.mapping,
+                           alpha,
+                           pointset.array_mask,
+                           pointset.norm_power,
+                           pointset.tray_sizes_used);
   }
+}
 
-  if (graphics_) {
-    Graphics::LineSegs segs;
-    for (int t = 0; t < num_pointsets; t++) {
-      const int num_flops = pointsets[t].size();
-      for (int i = 0; i < num_flops; i++) {
-        const int tray_idx = all_mappings[t][i].first;
-        if (tray_idx == std::numeric_limits<int>::max()) {
-          continue;
-        }
-        const Point tray_pt = all_final_trays[t][tray_idx].pt;
-        const odb::Point tray_pt_dbu(multiplier_ * tray_pt.x,
-                                     multiplier_ * tray_pt.y);
-        const Point flop_pt = pointsets[t][i].pt;
-        const odb::Point flop_pt_dbu(multiplier_ * flop_pt.x,
-                                     multiplier_ * flop_pt.y);
-        segs.emplace_back(flop_pt_dbu, tray_pt_dbu);
+void MBFF::ShowMapping(const std::vector<Pointset>& pointsets, const int group)
+{
+  Graphics::LineSegs segs;
+  for (const Pointset& pointset : pointsets) {
+    if (pointset.group != group) {
+      continue;
+    }
+    const int num_flops = pointset.flops.size();
+    for (int i = 0; i < num_flops; i++) {
+      const int tray_idx = pointset.mapping[i].first;
+      if (tray_idx == std::numeric_limits<int>::max()) {
+        continue;
       }
+      const Point tray_pt = pointset.final_trays[tray_idx].pt;
+      const odb::Point tray_pt_dbu(multiplier_ * tray_pt.x,
+                                   multiplier_ * tray_pt.y);
+      const Point flop_pt = pointset.flops[i].pt;
+      const odb::Point flop_pt_dbu(multiplier_ * flop_pt.x,
+                                   multiplier_ * flop_pt.y);
+      segs.emplace_back(flop_pt_dbu, tray_pt_dbu);
     }
-
-    graphics_->mbff_mapping(segs);
   }
 
-  return ans;
+  graphics_->mbff_mapping(segs);
 }
 
 void MBFF::SetVars(const std::vector<Flop>& flops)
@@ -1914,19 +1938,48 @@ void MBFF::Run(const int mx_sz, const float alpha, const float beta)
   std::vector<std::vector<Flop>> FFs;
   SeparateFlops(FFs);
   const int num_chunks = static_cast<int>(FFs.size());
-  float tot_ilp = 0;
+
+  // The flop groups (clock net and array mask) are independent.  Their
+  // pointsets and start trays are chosen serially, as that uses rand(),
+  // then the pointsets of all the groups are clustered concurrently.
+  std::vector<Pointset> pointsets;
+  std::vector<std::vector<int>> array_masks(num_chunks);
   for (int i = 0; i < num_chunks; i++) {
-    const std::vector<int> array_mask
-        = GetArrayMask(insts_[FFs[i].back().idx], false);
+    array_masks[i] = GetArrayMask(insts_[FFs[i].back().idx], false);
     // do we even have trays to cluster these flops?
-    if (!best_master_[array_mask].size()) {
+    if (!best_master_[array_masks[i]].size()) {
+      continue;
+    }
+    SetVars(FFs[i]);
+    SetRatios(array_masks[i]);
+    AddPointsets(FFs[i], mx_sz, array_masks[i], i, pointsets);
+  }
+
+  RunClustering(pointsets, alpha);
+
+  float tot_ilp = 0;
+  auto pointset = pointsets.begin();
+  for (int i = 0; i < num_chunks; i++) {
+    if (!best_master_[array_masks[i]].size()) {
       tot_ilp += (alpha * static_cast<int>(FFs[i].size()));
       tray_sizes_used_[1] += static_cast<int>(FFs[i].size());
       continue;
     }
-    SetVars(FFs[i]);
-    SetRatios(array_mask);
-    tot_ilp += RunClustering(FFs[i], mx_sz, alpha, beta, array_mask);
+    float group_ilp = 0;
+    for (; pointset != pointsets.end() && pointset->group == i; pointset++) {
+      group_ilp += pointset->cost;
+      for (const auto& [size, count] : pointset->tray_sizes_used) {
+        tray_sizes_used_[size] += count;
+      }
+      ModifyPinConnections(pointset->flops,
+                           pointset->final_trays,
+                           pointset->mapping,
+                           pointset->array_mask);
+    }
+    tot_ilp += group_ilp;
+    if (graphics_) {
+      ShowMapping(pointsets, i);
+    }
   }
 
   float tcp_disp = (beta * GetPairDisplacements());
@@ -58,6 +58,8 @@ namespace gpl {
 struct Point;
 struct Tray;
 struct Flop;
+struct Pointset;
+class FlopSlotFlow;
 class Graphics;
 enum PortName
 {
@@ -161,12 +163,6 @@ class MBFF
                      float AR,
                      std::vector<Tray>& trays);
 
-  // multistart for starting tray locations
-  void RunMultistart(std::vector<std::vector<Tray>>& trays,
-                     const std::vector<Flop>& flops,
-                     std::vector<std::vector<std::vector<Tray>>>& start_trays,
-                     std::vector<int> array_mask);
-
   // get silhouette metric for a run of multistart
   float GetSilh(const std::vector<Flop>& flops,
                 const std::vector<Tray>& trays,
@@ -179,9 +175,10 @@ class MBFF
                     int max_sz,
                     std::vector<std::vector<Flop>>& pointsets);
 
+  // flow is the network of flops and slots of trays
   void MinCostFlow(const std::vector<Flop>& flops,
                    std::vector<Tray>& trays,
-                   int sz,
+                   FlopSlotFlow& flow,
                    std::vector<std::pair<int, int>>& clusters);
   float RunLP(const std::vector<Flop>& flops,
               std::vector<Tray>& trays,
@@ -201,7 +198,9 @@ class MBFF
                 const std::vector<Tray>& trays,
                 std::vector<std::pair<int, int>>& final_flop_to_slot,
                 float alpha,
-                std::vector<int> array_mask);
+                std::vector<int> array_mask,
+                const std::vector<float>& norm_power,
+                std::map<int, int>& tray_sizes_used);
   // calculate beta (1.00) * sum(relative displacements)
   float GetPairDisplacements();
   // place trays and modify nets
@@ -214,11 +213,15 @@ class MBFF
   void SeparateFlops(std::vector<std::vector<Flop>>& ffs);
   void SetVars(const std::vector<Flop>& flops);
   void SetRatios(std::vector<int> array_mask);
-  float RunClustering(const std::vector<Flop>& flops,
-                      int mx_sz,
-                      float alpha,
-                      float beta,
-                      std::vector<int> array_mask);
+  // decompose a flop group into pointsets and choose their start trays
+  void AddPointsets(const std::vector<Flop>& flops,
+                    int mx_sz,
+                    const std::vector<int>& array_mask,
+                    int group,
+                    std::vector<Pointset>& pointsets);
+  // cluster the pointsets of all the flop groups concurrently
+  void RunClustering(std::vector<Pointset>& pointsets, float alpha);
+  void ShowMapping(const std::vector<Pointset>& pointsets, int group);
 
   void ReadFFs();
   void ReadPaths();
@@ -273,6 +276,8 @@ class MBFF
   std::vector<int> unused_;
   // max tray size: 1 << (7 - 1) = 64 bits
   int num_sizes_ = 7;
+  // sets of start trays tried for each tray size
+  int num_starts_ = 5;
   // ind of last test tray
   int test_idx_;
   // all MBFF next_states
@@ -37,10 +37,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <random>
+#include <unordered_set>
 #include <utility>
 
+#include "checkpoint.h"
 #include "fft.h"
 #include "nesterovPlace.h"
 #include "odb/db.h"
@@ -78,6 +81,21 @@ static float getOverlapDensityArea(const Bin& bin, const GCell* cell);
 
 static float fastExp(float exp);
 
+static float waMinGradient(float expSum,
+                           float xExpSum,
+                           float pinExp,
+                           int pinCoord,
+                           float wlCoeff);
+
+static float waMaxGradient(float expSum,
+                           float xExpSum,
+                           float pinExp,
+                           int pinCoord,
+                           float wlCoeff);
+
+// Number of WA slots handed to one kernel call
+static constexpr int waKernelChunk = 4096;
+
 ////////////////////////////////////////////////
 // GCell
 
@@ -129,9 +147,31 @@ void GCell::setFiller()
 {
 }
 
+// A clustered gCell is a square with the total area of its instances,
+// centered at their mean center.
 void GCell::setClusteredInstance(const std::vector<Instance*>& insts)
 {
   insts_ = insts;
+  if (insts_.empty()) {
+    return;
+  }
+
+  int64_t area = 0;
+  int64_t sumCx = 0;
+  int64_t sumCy = 0;
+  for (const Instance* inst : insts_) {
+    area += inst->area();
+    sumCx += inst->cx();
+    sumCy += inst->cy();
+  }
+  const int cx = sumCx / static_cast<int64_t>(insts_.size());
+  const int cy = sumCy / static_cast<int64_t>(insts_.size());
+  const int halfSide = std::sqrt(static_cast<double>(area)) / 2;
+
+  dLx_ = lx_ = cx - halfSide;
+  dLy_ = ly_ = cy - halfSide;
+  dUx_ = ux_ = cx + halfSide;
+  dUy_ = uy_ = cy + halfSide;
 }
 
 void GCell::setCenterLocation(int cx, int cy)
@@ -242,10 +282,11 @@ bool GCell::isMacroInstance() const
 
 bool GCell::isStdInstance() const
 {
-  if (!isInstance()) {
+  if (!isClusteredInstance()) {
     return false;
   }
-  return !instance()->isMacro();
+  // clusters only hold standard cells
+  return !isInstance() || !instance()->isMacro();
 }
 
 ////////////////////////////////////////////////
@@ -705,87 +746,100 @@ void BinGrid::initBins()
 
 void BinGrid::updateBinsNonPlaceArea()
 {
-  for (auto& bin : bins_) {
-    bin.setNonPlaceArea(0);
-    bin.setNonPlaceAreaUnscaled(0);
-  }
-
-  for (auto& inst : pb_->nonPlaceInsts()) {
-    std::pair<int, int> pairX = getMinMaxIdxX(inst);
-    std::pair<int, int> pairY = getMinMaxIdxY(inst);
-    for (int y = pairY.first; y < pairY.second; y++) {
-      for (int x = pairX.first; x < pairX.second; x++) {
-        Bin& bin = bins_[y * binCntX_ + x];
-
-        // Note that nonPlaceArea should have scale-down with
-        // target density.
-        // See MS-replace paper
-        //
-        bin.addNonPlaceArea(
-            getOverlapArea(
-                &bin,
-                inst,
-                pb_->db()->getChip()->getBlock()->getDbUnitsPerMicron())
-            * bin.targetDensity());
-        bin.addNonPlaceAreaUnscaled(getOverlapAreaUnscaled(&bin, inst)
-                                    * bin.targetDensity());
-      }
-    }
+  const std::vector<Instance*>& insts = pb_->nonPlaceInsts();
+  const int dbuPerMicron
+      = pb_->db()->getChip()->getBlock()->getDbUnitsPerMicron();
+
+  // areas per bin: nonPlaceArea, nonPlaceAreaUnscaled
+  nonPlaceAreas_.accumulate(
+      insts.size(),
+      binCntX_,
+      binCntY_,
+      num_threads_,
+      [&](size_t i) { return getMinMaxIdxY(insts[i]); },
+      [&](size_t i, int firstY, int lastY, int64_t* areas) {
+        const Instance* inst = insts[i];
+        std::pair<int, int> pairX = getMinMaxIdxX(inst);
+        for (int y = firstY; y < lastY; y++) {
+          for (int x = pairX.first; x < pairX.second; x++) {
+            const int idx = y * binCntX_ + x;
+            const Bin& bin = bins_[idx];
+
+            // Note that nonPlaceArea should have scale-down with
+            // target density.
+            // See MS-replace paper
+            //
+            areas[2 * idx] += static_cast<int64_t>(
+                getOverlapArea(&bin, inst, dbuPerMicron) * bin.targetDensity());
+            areas[2 * idx + 1] += static_cast<int64_t>(
+                getOverlapAreaUnscaled(&bin, inst) * bin.targetDensity());
+          }
+        }
+      });
+
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < bins_.size(); i++) {
+    bins_[i].setNonPlaceArea(nonPlaceAreas_.area(i, 0));
+    bins_[i].setNonPlaceAreaUnscaled(nonPlaceAreas_.area(i, 1));
   }
 }
 
 // Core Part
 void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
 {
-  // clear the Bin-area info
-  for (Bin& bin : bins_) {
-    bin.setInstPlacedAreaUnscaled(0);
-    bin.setFillerArea(0);
-  }
-
-  for (auto& cell : cells) {
-    std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
-    std::pair<int, int> pairY = getDensityMinMaxIdxY(cell);
-
-    // The following function is critical runtime hotspot
-    // for global placer.
-    //
-    if (cell->isInstance()) {
-      // macro should have
-      // scale-down with target-density
-      if (cell->isMacroInstance()) {
-        for (int y = pairY.first; y < pairY.second; y++) {
-          for (int x = pairX.first; x < pairX.second; x++) {
-            Bin& bin = bins_[y * binCntX_ + x];
-
-            const float scaledAvea = getOverlapDensityArea(bin, cell)
-                                     * cell->densityScale()
-                                     * bin.targetDensity();
-            bin.addInstPlacedAreaUnscaled(scaledAvea);
+  // The following function is critical runtime hotspot
+  // for global placer.
+  //
+  // areas per bin: instPlacedAreaUnscaled, fillerArea
+  densityAreas_.accumulate(
+      cells.size(),
+      binCntX_,
+      binCntY_,
+      num_threads_,
+      [&](size_t i) { return getDensityMinMaxIdxY(cells[i]); },
+      [&](size_t i, int firstY, int lastY, int64_t* areas) {
+        const GCell* cell = cells[i];
+        std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
+
+        if (cell->isClusteredInstance()) {
+          // macro should have
+          // scale-down with target-density
+          if (cell->isMacroInstance()) {
+            for (int y = firstY; y < lastY; y++) {
+              for (int x = pairX.first; x < pairX.second; x++) {
+                const int idx = y * binCntX_ + x;
+                const Bin& bin = bins_[idx];
+
+                const float scaledAvea = getOverlapDensityArea(bin, cell)
+                                         * cell->densityScale()
+                                         * bin.targetDensity();
+                areas[2 * idx] += static_cast<int64_t>(scaledAvea);
+              }
+            }
           }
-        }
-      }
-      // normal cells
-      else if (cell->isStdInstance()) {
-        for (int y = pairY.first; y < pairY.second; y++) {
-          for (int x = pairX.first; x < pairX.second; x++) {
-            Bin& bin = bins_[y * binCntX_ + x];
-            const float scaledArea
-                = getOverlapDensityArea(bin, cell) * cell->densityScale();
-            bin.addInstPlacedAreaUnscaled(scaledArea);
+          // normal cells
+          else if (cell->isStdInstance()) {
+            for (int y = firstY; y < lastY; y++) {
+              for (int x = pairX.first; x < pairX.second; x++) {
+                const int idx = y * binCntX_ + x;
+                const float scaledArea
+                    = getOverlapDensityArea(bins_[idx], cell)
+                      * cell->densityScale();
+                areas[2 * idx] += static_cast<int64_t>(scaledArea);
+              }
+            }
+          }
+        } else if (cell->isFiller()) {
+          for (int y = firstY; y < lastY; y++) {
+            for (int x = pairX.first; x < pairX.second; x++) {
+              const int idx = y * binCntX_ + x;
+              areas[2 * idx + 1] += static_cast<int64_t>(
+                  getOverlapDensityArea(bins_[idx], cell)
+                  * cell->densityScale());
+            }
           }
         }
-      }
-    } else if (cell->isFiller()) {
-      for (int y = pairY.first; y < pairY.second; y++) {
-        for (int x = pairX.first; x < pairX.second; x++) {
-          Bin& bin = bins_[y * binCntX_ + x];
-          bin.addFillerArea(getOverlapDensityArea(bin, cell)
-                            * cell->densityScale());
-        }
-      }
-    }
-  }
+      });
 
   overflowArea_ = 0;
   overflowAreaUnscaled_ = 0;
@@ -795,6 +849,10 @@ void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
     reduction(+ : overflowArea_, overflowAreaUnscaled_)
   for (auto it = bins_.begin(); it < bins_.end(); ++it) {
     Bin& bin = *it;  // old-style loop for old OpenMP
+    const size_t idx = it - bins_.begin();
+
+    bin.setInstPlacedAreaUnscaled(densityAreas_.area(idx, 0));
+    bin.setFillerArea(densityAreas_.area(idx, 1));
 
     // Copy unscaled to scaled
     bin.setInstPlacedArea(bin.instPlacedAreaUnscaled());
@@ -881,10 +939,12 @@ void NesterovPlaceVars::reset()
 // NesterovBaseCommon
 ///////////////////////////////////////////////
 
-NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
-                                       std::shared_ptr<PlacerBaseCommon> pbc,
-                                       utl::Logger* log,
-                                       int num_threads)
+NesterovBaseCommon::NesterovBaseCommon(
+    NesterovBaseVars nbVars,
+    std::shared_ptr<PlacerBaseCommon> pbc,
+    utl::Logger* log,
+    int num_threads,
+    const std::vector<std::vector<Instance*>>& clusters)
     : num_threads_{num_threads}
 {
   assert(omp_get_thread_num() == 0);
@@ -895,8 +955,19 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
   // gCellStor init
   gCellStor_.reserve(pbc_->placeInsts().size());
 
+  std::unordered_set<const Instance*> clusteredInsts;
+  for (const auto& cluster : clusters) {
+    clusteredInsts.insert(cluster.begin(), cluster.end());
+  }
+
   for (auto& inst : pbc_->placeInsts()) {
-    gCellStor_.emplace_back(inst);
+    if (clusteredInsts.find(inst) == clusteredInsts.end()) {
+      gCellStor_.emplace_back(inst);
+    }
+  }
+
+  for (const auto& cluster : clusters) {
+    gCellStor_.emplace_back(cluster);
   }
 
   // TODO:
@@ -920,11 +991,13 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
   // gCell ptr init
   gCells_.reserve(gCellStor_.size());
   for (auto& gCell : gCellStor_) {
-    if (!gCell.isInstance()) {
+    if (!gCell.isClusteredInstance()) {
       continue;
     }
     gCells_.push_back(&gCell);
-    gCellMap_[gCell.instance()] = &gCell;
+    for (Instance* inst : gCell.insts()) {
+      gCellMap_[inst] = &gCell;
+    }
   }
 
   // gPin ptr init
@@ -950,8 +1023,10 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
       continue;
     }
 
-    for (auto& pin : gCell.instance()->pins()) {
-      gCell.addGPin(pbToNb(pin));
+    for (Instance* inst : gCell.insts()) {
+      for (auto& pin : inst->pins()) {
+        gCell.addGPin(pbToNb(pin));
+      }
     }
   }
 
@@ -973,6 +1048,50 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+  initWaSlots();
+}
+
+void NesterovBaseCommon::initWaSlots()
+{
+  waNetStart_.reserve(gNetStor_.size() + 1);
+  waNetStart_.push_back(0);
+  for (auto& gNet : gNetStor_) {
+    waNetStart_.push_back(waNetStart_.back() + gNet.gPins().size());
+  }
+
+  const int netCnt = gNetStor_.size();
+  const int slotCnt = waNetStart_.back();
+  waSlotNet_.resize(slotCnt);
+  waSlotPin_.resize(slotCnt);
+  waPinSlot_.resize(gPinStor_.size(), -1);
+  for (int i = 0; i < netCnt; i++) {
+    int slot = waNetStart_[i];
+    for (GPin* gPin : gNetStor_[i].gPins()) {
+      waSlotNet_[slot] = i;
+      waSlotPin_[slot] = gPin;
+      waPinSlot_[gPin - gPinStor_.data()] = slot;
+      slot++;
+    }
+  }
+
+  waSlotCx_.resize(slotCnt);
+  waSlotCy_.resize(slotCnt);
+  waSlotMinExpX_.resize(slotCnt);
+  waSlotMaxExpX_.resize(slotCnt);
+  waSlotMinExpY_.resize(slotCnt);
+  waSlotMaxExpY_.resize(slotCnt);
+  waSlotGradX_.resize(slotCnt);
+  waSlotGradY_.resize(slotCnt);
+
+  waNetExpMinSumX_.resize(netCnt);
+  waNetXExpMinSumX_.resize(netCnt);
+  waNetExpMaxSumX_.resize(netCnt);
+  waNetXExpMaxSumX_.resize(netCnt);
+  waNetExpMinSumY_.resize(netCnt);
+  waNetYExpMinSumY_.resize(netCnt);
+  waNetExpMaxSumY_.resize(netCnt);
+  waNetYExpMaxSumY_.resize(netCnt);
 }
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
@@ -1017,14 +1136,102 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
   return pbToNb(pbNet);
 }
 
+// The WA kernels run over the flat slot arrays of NesterovBaseCommon.
+// On x86-64 Linux they are also compiled for AVX2 and the matching
+// version is selected when the library is loaded. Both versions do the
+// same IEEE operations per slot, so the results do not depend on it.
+#if defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define GPL_WA_KERNEL __attribute__((target_clones("avx2", "default")))
+#endif
+#endif
+#ifndef GPL_WA_KERNEL
+#define GPL_WA_KERNEL
+#endif
+
+// Replaces each exponent argument with its exp, or with -1 when
+// the argument is not above minWireLengthForceBar.
+GPL_WA_KERNEL static void waExpKernel(const int cnt,
+                                      float* exps,
+                                      const float forceBar)
+{
+#pragma omp simd
+  for (int i = 0; i < cnt; i++) {
+    // store before masking, a select would be turned back into a
+    // branch around fastExp and block the vectorizer
+    const float arg = exps[i];
+    exps[i] = fastExp(arg);
+    if (!(arg > forceBar)) {
+      exps[i] = -1.0f;
+    }
+  }
+}
+
+// Per pin WA gradient along one axis, see getWireLengthGradientPinWA.
+// As in waExpKernel each side is stored first and then masked.
+GPL_WA_KERNEL static void waGradientKernel(const int cnt,
+                                           const int* slotNet,
+                                           const int* pinCoords,
+                                           const float* minExps,
+                                           const float* maxExps,
+                                           const float* expMinSums,
+                                           const float* xExpMinSums,
+                                           const float* expMaxSums,
+                                           const float* xExpMaxSums,
+                                           const float wlCoeff,
+                                           float* grads)
+{
+  float gradientMax[waKernelChunk];
+
+#pragma omp simd
+  for (int i = 0; i < cnt; i++) {
+    const int net = slotNet[i];
+    grads[i] = waMinGradient(expMinSums[net],
+                             xExpMinSums[net],
+                             minExps[i],
+                             pinCoords[i],
+                             wlCoeff);
+    if (minExps[i] < 0) {
+      grads[i] = 0;
+    }
+  }
+
+#pragma omp simd
+  for (int i = 0; i < cnt; i++) {
+    const int net = slotNet[i];
+    gradientMax[i] = waMaxGradient(expMaxSums[net],
+                                   xExpMaxSums[net],
+                                   maxExps[i],
+                                   pinCoords[i],
+                                   wlCoeff);
+    if (maxExps[i] < 0) {
+      gradientMax[i] = 0;
+    }
+  }
+
+#pragma omp simd
+  for (int i = 0; i < cnt; i++) {
+    grads[i] -= gradientMax[i];
+  }
+}
+
 //
 // WA force cals - wlCoeffX / wlCoeffY
 //
 // * Note that wlCoeffX and wlCoeffY is 1/gamma
 // in ePlace paper.
+//
+// The pins are processed through the flat slot arrays: the locations
+// and exponent arguments are gathered per net, the exps are taken
+// over all slots at once, the sums are accumulated per net in pin
+// order and finally the per pin gradients are evaluated for
+// getWireLengthGradientWA.
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
   assert(omp_get_thread_num() == 0);
+  const int netCnt = gNetStor_.size();
+  const int slotCnt = waSlotPin_.size();
+
   // clear all WA variables.
 #pragma omp parallel for num_threads(num_threads_)
   for (auto gPin = gPinStor_.begin(); gPin < gPinStor_.end(); ++gPin) {
@@ -1033,13 +1240,16 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
   }
 
 #pragma omp parallel for num_threads(num_threads_)
-  for (auto gNet = gNetStor_.begin(); gNet < gNetStor_.end(); ++gNet) {
-    // old-style loop for old OpenMP
-
+  for (int i = 0; i < netCnt; i++) {
+    GNet* gNet = &gNetStor_[i];
     gNet->clearWaVars();
     gNet->updateBox();
 
-    for (auto& gPin : gNet->gPins()) {
+    for (int slot = waNetStart_[i]; slot < waNetStart_[i + 1]; slot++) {
+      const GPin* gPin = waSlotPin_[slot];
+      waSlotCx_[slot] = gPin->cx();
+      waSlotCy_[slot] = gPin->cy();
+
       // The WA terms are shift invariant:
       //
       //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
@@ -1047,17 +1257,37 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       //   Sum(exp(x_i))          Sum(exp(x_i - C))
       //
       // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
+      waSlotMinExpX_[slot] = (gNet->lx() - gPin->cx()) * wlCoeffX;
+      waSlotMaxExpX_[slot] = (gPin->cx() - gNet->ux()) * wlCoeffX;
+      waSlotMinExpY_[slot] = (gNet->ly() - gPin->cy()) * wlCoeffY;
+      waSlotMaxExpY_[slot] = (gPin->cy() - gNet->uy()) * wlCoeffY;
+    }
+  }
+
+  const float forceBar = nbVars_.minWireLengthForceBar;
+#pragma omp parallel for num_threads(num_threads_)
+  for (int begin = 0; begin < slotCnt; begin += waKernelChunk) {
+    const int cnt = std::min(waKernelChunk, slotCnt - begin);
+    waExpKernel(cnt, &waSlotMinExpX_[begin], forceBar);
+    waExpKernel(cnt, &waSlotMaxExpX_[begin], forceBar);
+    waExpKernel(cnt, &waSlotMinExpY_[begin], forceBar);
+    waExpKernel(cnt, &waSlotMaxExpY_[begin], forceBar);
+  }
+
+#pragma omp parallel for num_threads(num_threads_)
+  for (int i = 0; i < netCnt; i++) {
+    GNet* gNet = &gNetStor_[i];
+
+    for (int slot = waNetStart_[i]; slot < waNetStart_[i + 1]; slot++) {
+      GPin* gPin = waSlotPin_[slot];
+      const bool isInstPin = gPin->gCell() && gPin->gCell()->isInstance();
 
       // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
+      if (waSlotMinExpX_[slot] >= 0) {
+        gPin->setMinExpSumX(waSlotMinExpX_[slot]);
         gNet->addWaExpMinSumX(gPin->minExpSumX());
-        gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
+        gNet->addWaXExpMinSumX(waSlotCx_[slot] * gPin->minExpSumX());
+        if (isInstPin) {
           debugPrint(log_,
                      GPL,
                      "wlUpdateWA",
@@ -1069,11 +1299,11 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       }
 
       // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
+      if (waSlotMaxExpX_[slot] >= 0) {
+        gPin->setMaxExpSumX(waSlotMaxExpX_[slot]);
         gNet->addWaExpMaxSumX(gPin->maxExpSumX());
-        gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
+        gNet->addWaXExpMaxSumX(waSlotCx_[slot] * gPin->maxExpSumX());
+        if (isInstPin) {
           debugPrint(log_,
                      GPL,
                      "wlUpdateWA",
@@ -1085,11 +1315,11 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       }
 
       // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
+      if (waSlotMinExpY_[slot] >= 0) {
+        gPin->setMinExpSumY(waSlotMinExpY_[slot]);
         gNet->addWaExpMinSumY(gPin->minExpSumY());
-        gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
+        gNet->addWaYExpMinSumY(waSlotCy_[slot] * gPin->minExpSumY());
+        if (isInstPin) {
           debugPrint(log_,
                      GPL,
                      "wlUpdateWA",
@@ -1101,11 +1331,11 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       }
 
       // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
+      if (waSlotMaxExpY_[slot] >= 0) {
+        gPin->setMaxExpSumY(waSlotMaxExpY_[slot]);
         gNet->addWaExpMaxSumY(gPin->maxExpSumY());
-        gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
+        gNet->addWaYExpMaxSumY(waSlotCy_[slot] * gPin->maxExpSumY());
+        if (isInstPin) {
           debugPrint(log_,
                      GPL,
                      "wlUpdateWA",
@@ -1116,7 +1346,46 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
         }
       }
     }
+
+    waNetExpMinSumX_[i] = gNet->waExpMinSumX();
+    waNetXExpMinSumX_[i] = gNet->waXExpMinSumX();
+    waNetExpMaxSumX_[i] = gNet->waExpMaxSumX();
+    waNetXExpMaxSumX_[i] = gNet->waXExpMaxSumX();
+    waNetExpMinSumY_[i] = gNet->waExpMinSumY();
+    waNetYExpMinSumY_[i] = gNet->waYExpMinSumY();
+    waNetExpMaxSumY_[i] = gNet->waExpMaxSumY();
+    waNetYExpMaxSumY_[i] = gNet->waYExpMaxSumY();
   }
+
+#pragma omp parallel for num_threads(num_threads_)
+  for (int begin = 0; begin < slotCnt; begin += waKernelChunk) {
+    const int cnt = std::min(waKernelChunk, slotCnt - begin);
+    waGradientKernel(cnt,
+                     &waSlotNet_[begin],
+                     &waSlotCx_[begin],
+                     &waSlotMinExpX_[begin],
+                     &waSlotMaxExpX_[begin],
+                     waNetExpMinSumX_.data(),
+                     waNetXExpMinSumX_.data(),
+                     waNetExpMaxSumX_.data(),
+                     waNetXExpMaxSumX_.data(),
+                     wlCoeffX,
+                     &waSlotGradX_[begin]);
+    waGradientKernel(cnt,
+                     &waSlotNet_[begin],
+                     &waSlotCy_[begin],
+                     &waSlotMinExpY_[begin],
+                     &waSlotMaxExpY_[begin],
+                     waNetExpMinSumY_.data(),
+                     waNetYExpMinSumY_.data(),
+                     waNetExpMaxSumY_.data(),
+                     waNetYExpMaxSumY_.data(),
+                     wlCoeffY,
+                     &waSlotGradY_[begin]);
+  }
+
+  waCoeffX_ = wlCoeffX;
+  waCoeffY_ = wlCoeffY;
 }
 
 // get x,y WA Gradient values with given GCell
@@ -1126,8 +1395,20 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientWA(const GCell* gCell,
 {
   FloatPoint gradientPair;
 
+  // The gradients of the last updateWireLengthForceWA are valid while
+  // the coefficients and the pin location are unchanged.
+  const bool useSlots = wlCoeffX == waCoeffX_ && wlCoeffY == waCoeffY_
+                        && !log_->debugCheck(GPL, "getGradientWAPin", 1);
+
   for (auto& gPin : gCell->gPins()) {
-    auto tmpPair = getWireLengthGradientPinWA(gPin, wlCoeffX, wlCoeffY);
+    const int slot = waPinSlot_[gPin - gPinStor_.data()];
+    FloatPoint tmpPair;
+    if (useSlots && slot >= 0 && gPin->cx() == waSlotCx_[slot]
+        && gPin->cy() == waSlotCy_[slot]) {
+      tmpPair = FloatPoint(waSlotGradX_[slot], waSlotGradY_[slot]);
+    } else {
+      tmpPair = getWireLengthGradientPinWA(gPin, wlCoeffX, wlCoeffY);
+    }
 
     debugPrint(log_,
                GPL,
@@ -1178,10 +1459,8 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
     float waExpMinSumX = gPin->gNet()->waExpMinSumX();
     float waXExpMinSumX = gPin->gNet()->waXExpMinSumX();
 
-    gradientMinX
-        = (waExpMinSumX * (gPin->minExpSumX() * (1.0 - wlCoeffX * gPin->cx()))
-           + wlCoeffX * gPin->minExpSumX() * waXExpMinSumX)
-          / (waExpMinSumX * waExpMinSumX);
+    gradientMinX = waMinGradient(
+        waExpMinSumX, waXExpMinSumX, gPin->minExpSumX(), gPin->cx(), wlCoeffX);
   }
 
   // max x
@@ -1189,10 +1468,8 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
     float waExpMaxSumX = gPin->gNet()->waExpMaxSumX();
     float waXExpMaxSumX = gPin->gNet()->waXExpMaxSumX();
 
-    gradientMaxX
-        = (waExpMaxSumX * (gPin->maxExpSumX() * (1.0 + wlCoeffX * gPin->cx()))
-           - wlCoeffX * gPin->maxExpSumX() * waXExpMaxSumX)
-          / (waExpMaxSumX * waExpMaxSumX);
+    gradientMaxX = waMaxGradient(
+        waExpMaxSumX, waXExpMaxSumX, gPin->maxExpSumX(), gPin->cx(), wlCoeffX);
   }
 
   // min y
@@ -1200,10 +1477,8 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
     float waExpMinSumY = gPin->gNet()->waExpMinSumY();
     float waYExpMinSumY = gPin->gNet()->waYExpMinSumY();
 
-    gradientMinY
-        = (waExpMinSumY * (gPin->minExpSumY() * (1.0 - wlCoeffY * gPin->cy()))
-           + wlCoeffY * gPin->minExpSumY() * waYExpMinSumY)
-          / (waExpMinSumY * waExpMinSumY);
+    gradientMinY = waMinGradient(
+        waExpMinSumY, waYExpMinSumY, gPin->minExpSumY(), gPin->cy(), wlCoeffY);
   }
 
   // max y
@@ -1211,10 +1486,8 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
     float waExpMaxSumY = gPin->gNet()->waExpMaxSumY();
     float waYExpMaxSumY = gPin->gNet()->waYExpMaxSumY();
 
-    gradientMaxY
-        = (waExpMaxSumY * (gPin->maxExpSumY() * (1.0 + wlCoeffY * gPin->cy()))
-           - wlCoeffY * gPin->maxExpSumY() * waYExpMaxSumY)
-          / (waExpMaxSumY * waExpMaxSumY);
+    gradientMaxY = waMaxGradient(
+        waExpMaxSumY, waYExpMaxSumY, gPin->maxExpSumY(), gPin->cy(), wlCoeffY);
   }
 
   debugPrint(log_,
@@ -1255,6 +1528,68 @@ void NesterovBaseCommon::updateDbGCells()
   }
 }
 
+// Move the instances to their gCell, keeping the offsets of clustered
+// instances from their cluster center at the time of clustering.
+void NesterovBaseCommon::uncoarsen()
+{
+  for (GCell* gCell : gCells_) {
+    if (gCell->isInstance()) {
+      gCell->instance()->dbSetCenterLocation(gCell->dCx(), gCell->dCy());
+      continue;
+    }
+
+    const auto& insts = gCell->insts();
+    int64_t sumCx = 0;
+    int64_t sumCy = 0;
+    for (const Instance* inst : insts) {
+      sumCx += inst->cx();
+      sumCy += inst->cy();
+    }
+    const int clusterCx = sumCx / static_cast<int64_t>(insts.size());
+    const int clusterCy = sumCy / static_cast<int64_t>(insts.size());
+    for (Instance* inst : insts) {
+      inst->dbSetCenterLocation(gCell->dCx() + inst->cx() - clusterCx,
+                                gCell->dCy() + inst->cy() - clusterCy);
+    }
+  }
+}
+
+static void writeBinaryPoints(std::ofstream& out,
+                              const std::vector<FloatPoint>& points)
+{
+  for (const FloatPoint& point : points) {
+    writeBinary<float>(out, point.x);
+    writeBinary<float>(out, point.y);
+  }
+}
+
+static void readBinaryPoints(std::ifstream& in, std::vector<FloatPoint>& points)
+{
+  for (FloatPoint& point : points) {
+    point.x = readBinary<float>(in);
+    point.y = readBinary<float>(in);
+  }
+}
+
+void NesterovBaseCommon::writeCheckpoint(std::ofstream& out) const
+{
+  writeBinary<uint32_t>(out, gNetStor_.size());
+  for (const GNet& gNet : gNetStor_) {
+    writeBinary<float>(out, gNet.timingWeight());
+  }
+}
+
+bool NesterovBaseCommon::readCheckpoint(std::ifstream& in)
+{
+  if (readBinary<uint32_t>(in) != gNetStor_.size()) {
+    return false;
+  }
+  for (GNet& gNet : gNetStor_) {
+    gNet.setTimingWeight(readBinary<float>(in));
+  }
+  return static_cast<bool>(in);
+}
+
 int64_t NesterovBaseCommon::getHpwl()
 {
   assert(omp_get_thread_num() == 0);
@@ -1296,11 +1631,18 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
 
   // add place instances
   for (auto& inst : pb_->placeInsts()) {
+    GCell* gCell = nbc_->pbToNb(inst);
+    if (!gCell->isInstance()) {
+      // a clustered gCell is added once, with its first instance
+      if (gCell->insts().front() == inst) {
+        gCells_.push_back(gCell);
+      }
+      continue;
+    }
+
     int x_offset = rand() % (2 * dbu_per_micron) - dbu_per_micron;
     int y_offset = rand() % (2 * dbu_per_micron) - dbu_per_micron;
 
-    GCell* gCell = nbc_->pbToNb(inst);
-
     inst->setLocation(inst->lx() + x_offset, inst->ly() + y_offset);
 
     gCell->clearInstances();
@@ -1314,7 +1656,7 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
   }
 
   for (auto& gCell : gCells_) {
-    if (gCell->isInstance()) {
+    if (gCell->isClusteredInstance()) {
       gCellInsts_.push_back(gCell);
     } else if (gCell->isFiller()) {
       gCellFillers_.push_back(gCell);
@@ -1337,13 +1679,17 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
   bg_.setLogger(log_);
   bg_.setCorePoints(&(pb_->die()));
   bg_.setTargetDensity(targetDensity_);
+  bg_.setNumThreads(nbc_->getNumThreads());
 
   // update binGrid info
   bg_.initBins();
 
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   nbc_->getNumThreads()));
 
   fft_ = std::move(fft);
 
@@ -1491,9 +1837,10 @@ void NesterovBase::updateGCellCenterLocation(
 void NesterovBase::updateGCellDensityCenterLocation(
     const std::vector<FloatPoint>& coordis)
 {
-  for (auto& coordi : coordis) {
-    int idx = &coordi - &coordis[0];
-    gCells_[idx]->setDensityCenterLocation(coordi.x, coordi.y);
+  assert(omp_get_thread_num() == 0);
+#pragma omp parallel for num_threads(nbc_->getNumThreads())
+  for (size_t idx = 0; idx < coordis.size(); idx++) {
+    gCells_[idx]->setDensityCenterLocation(coordis[idx].x, coordis[idx].y);
   }
   bg_.updateBinsGCellDensityArea(gCells_);
 }
@@ -1953,36 +2300,19 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
     return;
   }
 
-  wireLengthGradSum_ = 0;
-  densityGradSum_ = 0;
-
-  float gradSum = 0;
-
   debugPrint(
       log_, GPL, "updateGrad", 1, "DensityPenalty: {:g}", densityPenalty_);
 
-  // TODO: This OpenMP parallel section is causing non-determinism. Consider
-  // revisiting this in the future to restore determinism.
-  //#pragma omp parallel for num_threads(nbc_->getNumThreads()) reduction(+ :
-  // wireLengthGradSum_, densityGradSum_, gradSum)
+  // The gradients of each gCell are independent.  The sums are taken
+  // afterwards in gCell order, so they do not depend on the number of
+  // threads.
+#pragma omp parallel for num_threads(nbc_->getNumThreads())
   for (size_t i = 0; i < gCells_.size(); i++) {
     GCell* gCell = gCells_.at(i);
     wireLengthGrads[i]
         = nbc_->getWireLengthGradientWA(gCell, wlCoeffX, wlCoeffY);
     densityGrads[i] = getDensityGradient(gCell);
 
-    // Different compiler has different results on the following formula.
-    // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
-    //
-    // To prevent instability problem,
-    // I partitioned the fabs(~~.x) + fabs(~~.y) as two terms.
-    //
-    wireLengthGradSum_ += std::fabs(wireLengthGrads[i].x);
-    wireLengthGradSum_ += std::fabs(wireLengthGrads[i].y);
-
-    densityGradSum_ += std::fabs(densityGrads[i].x);
-    densityGradSum_ += std::fabs(densityGrads[i].y);
-
     sumGrads[i].x = wireLengthGrads[i].x + densityPenalty_ * densityGrads[i].x;
     sumGrads[i].y = wireLengthGrads[i].y + densityPenalty_ * densityGrads[i].y;
 
@@ -2003,6 +2333,24 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
 
     sumGrads[i].x /= sumPrecondi.x;
     sumGrads[i].y /= sumPrecondi.y;
+  }
+
+  wireLengthGradSum_ = 0;
+  densityGradSum_ = 0;
+
+  float gradSum = 0;
+  for (size_t i = 0; i < gCells_.size(); i++) {
+    // Different compiler has different results on the following formula.
+    // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
+    //
+    // To prevent instability problem,
+    // I partitioned the fabs(~~.x) + fabs(~~.y) as two terms.
+    //
+    wireLengthGradSum_ += std::fabs(wireLengthGrads[i].x);
+    wireLengthGradSum_ += std::fabs(wireLengthGrads[i].y);
+
+    densityGradSum_ += std::fabs(densityGrads[i].x);
+    densityGradSum_ += std::fabs(densityGrads[i].y);
 
     gradSum += std::fabs(sumGrads[i].x) + std::fabs(sumGrads[i].y);
   }
@@ -2230,7 +2578,9 @@ void NesterovBase::nesterovUpdateCoordinates(float coeff)
     return;
   }
 
+  assert(omp_get_thread_num() == 0);
   // fill in nextCoordinates with given stepLength_
+#pragma omp parallel for num_threads(nbc_->getNumThreads())
   for (size_t k = 0; k < gCells_.size(); k++) {
     FloatPoint nextCoordi(
         curSLPCoordi_[k].x + stepLength_ * curSLPSumGrads_[k].x,
@@ -2305,6 +2655,104 @@ void NesterovBase::snapshot()
   snapshotStepLength_ = stepLength_;
 }
 
+void NesterovBase::writeCheckpoint(std::ofstream& out) const
+{
+  writeBinary<uint32_t>(out, gCells_.size());
+  for (const GCell* gCell : gCells_) {
+    writeBinary<int32_t>(out, gCell->dx());
+    writeBinary<int32_t>(out, gCell->dy());
+  }
+  writeBinary<float>(out, targetDensity_);
+
+  writeBinaryPoints(out, curSLPCoordi_);
+  writeBinaryPoints(out, curSLPWireLengthGrads_);
+  writeBinaryPoints(out, curSLPDensityGrads_);
+  writeBinaryPoints(out, curSLPSumGrads_);
+  writeBinaryPoints(out, prevSLPCoordi_);
+  writeBinaryPoints(out, prevSLPWireLengthGrads_);
+  writeBinaryPoints(out, prevSLPDensityGrads_);
+  writeBinaryPoints(out, prevSLPSumGrads_);
+  writeBinaryPoints(out, curCoordi_);
+
+  writeBinary<float>(out, stepLength_);
+  writeBinary<float>(out, densityPenalty_);
+  writeBinary<float>(out, sumOverflow_);
+  writeBinary<float>(out, sumOverflowUnscaled_);
+  writeBinary<int64_t>(out, prevHpwl_);
+  writeBinary<float>(out, minSumOverflow_);
+  writeBinary<float>(out, hpwlWithMinSumOverflow_);
+  writeBinary<int32_t>(out, iter_);
+  writeBinary<uint8_t>(out, isMaxPhiCoefChanged_);
+  writeBinary<uint8_t>(out, isConverged_);
+
+  // routability-driven revert snapshot, empty until it is taken
+  writeBinaryVector(out, snapshotCoordi_);
+  writeBinaryVector(out, snapshotSLPCoordi_);
+  writeBinaryVector(out, snapshotSLPSumGrads_);
+  writeBinary<float>(out, snapshotDensityPenalty_);
+  writeBinary<float>(out, snapshotStepLength_);
+}
+
+bool NesterovBase::readCheckpoint(std::ifstream& in)
+{
+  if (readBinary<uint32_t>(in) != gCells_.size()) {
+    return false;
+  }
+  // routability-driven inflation may have resized the gCells
+  for (GCell* gCell : gCells_) {
+    const int dx = readBinary<int32_t>(in);
+    const int dy = readBinary<int32_t>(in);
+    gCell->setSize(dx, dy);
+  }
+  setTargetDensity(readBinary<float>(in));
+  updateAreas();
+  updateDensitySize();
+
+  readBinaryPoints(in, curSLPCoordi_);
+  readBinaryPoints(in, curSLPWireLengthGrads_);
+  readBinaryPoints(in, curSLPDensityGrads_);
+  readBinaryPoints(in, curSLPSumGrads_);
+  readBinaryPoints(in, prevSLPCoordi_);
+  readBinaryPoints(in, prevSLPWireLengthGrads_);
+  readBinaryPoints(in, prevSLPDensityGrads_);
+  readBinaryPoints(in, prevSLPSumGrads_);
+  readBinaryPoints(in, curCoordi_);
+
+  stepLength_ = readBinary<float>(in);
+  densityPenalty_ = readBinary<float>(in);
+  sumOverflow_ = readBinary<float>(in);
+  sumOverflowUnscaled_ = readBinary<float>(in);
+  prevHpwl_ = readBinary<int64_t>(in);
+  minSumOverflow_ = readBinary<float>(in);
+  hpwlWithMinSumOverflow_ = readBinary<float>(in);
+  iter_ = readBinary<int32_t>(in);
+  isMaxPhiCoefChanged_ = readBinary<uint8_t>(in);
+  isConverged_ = readBinary<uint8_t>(in);
+
+  const size_t num_points = curCoordi_.size();
+  if (!readBinaryVector(in, snapshotCoordi_, {0, num_points})
+      || !readBinaryVector(in, snapshotSLPCoordi_, {0, num_points})
+      || !readBinaryVector(in, snapshotSLPSumGrads_, {0, num_points})) {
+    return false;
+  }
+  snapshotDensityPenalty_ = readBinary<float>(in);
+  snapshotStepLength_ = readBinary<float>(in);
+
+  updateGCellDensityCenterLocation(curSLPCoordi_);
+  updateDensityForceBin();
+
+  // converged regions keep their instances in place
+  if (isConverged_) {
+    for (GCell* gCell : gCells_) {
+      if (gCell->isInstance()) {
+        gCell->instance()->lock();
+      }
+    }
+  }
+
+  return static_cast<bool>(in);
+}
+
 bool NesterovBase::checkConvergence()
 {
   assert(omp_get_thread_num() == 0);
@@ -2499,6 +2947,30 @@ static float fastExp(float exp)
   return exp;
 }
 
+// Equation (4.13) terms of a single pin for the min and max side.
+// expSum and xExpSum are the net sums, pinExp is the pin's own exp.
+static float waMinGradient(const float expSum,
+                           const float xExpSum,
+                           const float pinExp,
+                           const int pinCoord,
+                           const float wlCoeff)
+{
+  return (expSum * (pinExp * (1.0 - wlCoeff * pinCoord))
+          + wlCoeff * pinExp * xExpSum)
+         / (expSum * expSum);
+}
+
+static float waMaxGradient(const float expSum,
+                           const float xExpSum,
+                           const float pinExp,
+                           const int pinCoord,
+                           const float wlCoeff)
+{
+  return (expSum * (pinExp * (1.0 + wlCoeff * pinCoord))
+          - wlCoeff * pinExp * xExpSum)
+         / (expSum * expSum);
+}
+
 static float getDistance(const std::vector<FloatPoint>& a,
                          const std::vector<FloatPoint>& b)
 {
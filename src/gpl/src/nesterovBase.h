@@ -33,11 +33,13 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "binAreaBands.h"
 #include "point.h"
 
 namespace odb {
@@ -722,6 +724,8 @@ class BinGrid
   int64_t overflowAreaUnscaled_ = 0;
   bool isSetBinCnt_ = false;
   int num_threads_ = 1;
+  BinAreaBands densityAreas_{2};
+  BinAreaBands nonPlaceAreas_{2};
 };
 
 inline std::vector<Bin>& BinGrid::bins()
@@ -769,6 +773,12 @@ class NesterovPlaceVars
   bool debug_draw_bins = true;
   odb::dbInst* debug_inst = nullptr;
 
+  // the checkpoint is written every checkpointIterations iterations
+  // when checkpointFile is set.
+  std::string checkpointFile;
+  int checkpointIterations = 100;
+  std::string resumeCheckpointFile;
+
   void reset();
 };
 
@@ -777,10 +787,13 @@ class NesterovPlaceVars
 class NesterovBaseCommon
 {
  public:
-  NesterovBaseCommon(NesterovBaseVars nbVars,
-                     std::shared_ptr<PlacerBaseCommon> pb,
-                     utl::Logger* log,
-                     int num_threads);
+  // Each of the clusters is placed as a single gCell.
+  NesterovBaseCommon(
+      NesterovBaseVars nbVars,
+      std::shared_ptr<PlacerBaseCommon> pb,
+      utl::Logger* log,
+      int num_threads,
+      const std::vector<std::vector<Instance*>>& clusters = {});
 
   const std::vector<GCell*>& gCells() const { return gCells_; }
   const std::vector<GNet*>& gNets() const { return gNets_; }
@@ -825,11 +838,22 @@ class NesterovBaseCommon
   int64_t getHpwl();
 
   void updateDbGCells();
+  // Place the instances of all gCells, including the clustered ones,
+  // in both the placer base and the db.
+  void uncoarsen();
+
+  // Timing weights of the gNets for the placement checkpoint.
+  // readCheckpoint returns false if the checkpoint has a different netlist.
+  void writeCheckpoint(std::ofstream& out) const;
+  bool readCheckpoint(std::ifstream& in);
 
   // Number of threads of execution
   size_t getNumThreads() { return num_threads_; }
 
  private:
+  // builds the flat net -> pin arrays used by updateWireLengthForceWA
+  void initWaSlots();
+
   NesterovBaseVars nbVars_;
   std::shared_ptr<PlacerBaseCommon> pbc_;
   utl::Logger* log_ = nullptr;
@@ -846,6 +870,41 @@ class NesterovBaseCommon
   std::unordered_map<Pin*, GPin*> gPinMap_;
   std::unordered_map<Net*, GNet*> gNetMap_;
 
+  // Flat (CSR) copy of the net -> pin relation for the WA kernels.
+  // Slots [waNetStart_[i], waNetStart_[i + 1]) hold the pins of
+  // gNetStor_[i] in gNet->gPins() order. Per slot values are kept in
+  // separate arrays so the exp and gradient passes run over contiguous
+  // memory.
+  std::vector<int> waNetStart_;
+  std::vector<int> waSlotNet_;
+  std::vector<GPin*> waSlotPin_;
+  // gPinStor_ index -> slot, -1 for pins without a net
+  std::vector<int> waPinSlot_;
+
+  std::vector<int> waSlotCx_;
+  std::vector<int> waSlotCy_;
+  // exponent argument, then exp value; -1 when below minWireLengthForceBar
+  std::vector<float> waSlotMinExpX_;
+  std::vector<float> waSlotMaxExpX_;
+  std::vector<float> waSlotMinExpY_;
+  std::vector<float> waSlotMaxExpY_;
+
+  // per net sums, mirrors of the GNet wa* values
+  std::vector<float> waNetExpMinSumX_;
+  std::vector<float> waNetXExpMinSumX_;
+  std::vector<float> waNetExpMaxSumX_;
+  std::vector<float> waNetXExpMaxSumX_;
+  std::vector<float> waNetExpMinSumY_;
+  std::vector<float> waNetYExpMinSumY_;
+  std::vector<float> waNetExpMaxSumY_;
+  std::vector<float> waNetYExpMaxSumY_;
+
+  // per pin gradients for the coefficients of the last force update
+  std::vector<float> waSlotGradX_;
+  std::vector<float> waSlotGradY_;
+  float waCoeffX_ = 0;
+  float waCoeffY_ = 0;
+
   int num_threads_;
 };
 
@@ -980,6 +1039,11 @@ class NesterovBase
 
   void snapshot();
 
+  // Nesterov loop data and gCell sizes for the placement checkpoint.
+  // readCheckpoint returns false if the checkpoint has different gCells.
+  void writeCheckpoint(std::ofstream& out) const;
+  bool readCheckpoint(std::ifstream& in);
+
   bool checkConvergence();
   bool checkDivergence();
   bool revertDivergence();
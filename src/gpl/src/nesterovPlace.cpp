@@ -35,10 +35,14 @@
 
 #include "nesterovPlace.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
+#include "checkpoint.h"
 #include "graphics.h"
 #include "nesterovBase.h"
 #include "odb/db.h"
@@ -46,6 +50,7 @@
 #include "routeBase.h"
 #include "timingBase.h"
 #include "utl/Logger.h"
+#include "utl/timer.h"
 
 namespace gpl {
 using utl::GPL;
@@ -310,13 +315,10 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     graphics_->cellPlot(true);
   }
 
-  // snapshot saving detection
-  bool isSnapshotSaved = false;
-
-  // snapshot info
-  float snapshotA = 0;
-  float snapshotWlCoefX = 0, snapshotWlCoefY = 0;
-  bool isDivergeTriedRevert = false;
+  isSnapshotSaved_ = false;
+  snapshotA_ = 0;
+  snapshotWlCoefX_ = snapshotWlCoefY_ = 0;
+  isDivergeTriedRevert_ = false;
 
   // backTracking variable.
   float curA = 1.0;
@@ -327,6 +329,11 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     nb->resetMinSumOverflow();
   }
 
+  if (!npVars_.resumeCheckpointFile.empty()) {
+    start_iter = readCheckpoint(npVars_.resumeCheckpointFile, curA);
+    npVars_.resumeCheckpointFile.clear();
+  }
+
   // Core Nesterov Loop
   int iter = start_iter;
   for (; iter < npVars_.maxNesterovIter; iter++) {
@@ -340,21 +347,31 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     // coeff is (a_k - 1) / ( a_(k+1) ) in paper.
     float coeff = (prevA - 1.0) / curA;
 
+    // time spent per phase, summed over the back tracking steps
+    double coordiTime = 0, wireLengthTime = 0, gradientTime = 0;
+
     // Back-Tracking loop
     int numBackTrak = 0;
     for (numBackTrak = 0; numBackTrak < npVars_.maxBackTrack; numBackTrak++) {
+      utl::Timer timer;
+
       // fill in nextCoordinates with given stepLength_
       for (auto& nb : nbVec_) {
         nb->nesterovUpdateCoordinates(coeff);
       }
+      coordiTime += timer.elapsed();
+      timer.reset();
 
       nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
+      wireLengthTime += timer.elapsed();
+      timer.reset();
 
       int numDiverge = 0;
       for (auto& nb : nbVec_) {
         updateNextGradient(nb);
         numDiverge += nb->isDiverged();
       }
+      gradientTime += timer.elapsed();
 
       // NaN or inf is detected in WireLength/Density Coef
       if (numDiverge > 0 || isDiverged_) {
@@ -384,6 +401,16 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     }
 
     debugPrint(log_, GPL, "np", 1, "NumBackTrak: {}", numBackTrak + 1);
+    debugPrint(log_,
+               GPL,
+               "timer",
+               1,
+               "Iter {}: coordinates+density {:.3f}ms, WA force {:.3f}ms, "
+               "gradients {:.3f}ms",
+               iter + 1,
+               coordiTime * 1000,
+               wireLengthTime * 1000,
+               gradientTime * 1000);
 
     // Adjust Phi dynamically for larger designs
     for (auto& nb : nbVec_) {
@@ -459,13 +486,13 @@ int NesterovPlace::doNesterovPlace(int start_iter)
 
       // revert back to the original rb solutions
       // one more opportunity
-      if (!isDivergeTriedRevert && rb_->numCall() >= 1) {
+      if (!isDivergeTriedRevert_ && rb_->numCall() >= 1) {
         // get back to the working rc size
         rb_->revertGCellSizeToMinRc();
 
-        curA = snapshotA;
-        wireLengthCoefX_ = snapshotWlCoefX;
-        wireLengthCoefY_ = snapshotWlCoefY;
+        curA = snapshotA_;
+        wireLengthCoefX_ = snapshotWlCoefX_;
+        wireLengthCoefY_ = snapshotWlCoefY_;
 
         nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
 
@@ -476,7 +503,7 @@ int NesterovPlace::doNesterovPlace(int start_iter)
         isDiverged_ = false;
         divergeCode_ = 0;
         divergeMsg_ = "";
-        isDivergeTriedRevert = true;
+        isDivergeTriedRevert_ = true;
         // turn off the RD forcely
         isRoutabilityNeed_ = false;
       } else {
@@ -485,12 +512,12 @@ int NesterovPlace::doNesterovPlace(int start_iter)
       }
     }
 
-    if (!isSnapshotSaved && npVars_.routabilityDrivenMode
+    if (!isSnapshotSaved_ && npVars_.routabilityDrivenMode
         && 0.6 >= average_overflow_unscaled_) {
-      snapshotWlCoefX = wireLengthCoefX_;
-      snapshotWlCoefY = wireLengthCoefY_;
-      snapshotA = curA;
-      isSnapshotSaved = true;
+      snapshotWlCoefX_ = wireLengthCoefX_;
+      snapshotWlCoefY_ = wireLengthCoefY_;
+      snapshotA_ = curA;
+      isSnapshotSaved_ = true;
 
       for (auto& nb : nbVec_) {
         nb->snapshot();
@@ -513,9 +540,9 @@ int NesterovPlace::doNesterovPlace(int start_iter)
         // cutFillerCoordinates();
 
         // revert back the current density penality
-        curA = snapshotA;
-        wireLengthCoefX_ = snapshotWlCoefX;
-        wireLengthCoefY_ = snapshotWlCoefY;
+        curA = snapshotA_;
+        wireLengthCoefX_ = snapshotWlCoefX_;
+        wireLengthCoefY_ = snapshotWlCoefY_;
 
         nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
 
@@ -537,6 +564,11 @@ int NesterovPlace::doNesterovPlace(int start_iter)
       // log_->report("[NesterovSolve] Finished, all regions converged");
       break;
     }
+
+    if (!npVars_.checkpointFile.empty()
+        && (iter + 1) % npVars_.checkpointIterations == 0) {
+      writeCheckpoint(iter, curA);
+    }
   }
   // in all case including diverge,
   // db should be updated.
@@ -593,4 +625,125 @@ void NesterovPlace::updateDb()
   nbc_->updateDbGCells();
 }
 
+// The checkpoint is a binary file with the Nesterov loop scalars followed
+// by the gNet weights, the loop data of each region and the timing-driven
+// and routability-driven state.  It is only valid
+// for the design and placement options it was written with.
+static const char checkpoint_magic[8] = {'G', 'P', 'L', 'C', 'K', 'P', 'T', 2};
+
+void NesterovPlace::writeCheckpoint(const int iter, const float curA) const
+{
+  // Write a temporary file and rename it over the previous checkpoint, so
+  // an interrupted write never leaves a truncated checkpoint behind.
+  const std::string& file_name = npVars_.checkpointFile;
+  const std::string tmp_file_name = file_name + ".tmp";
+  std::ofstream out(tmp_file_name, std::ios::binary);
+  if (!out) {
+    log_->error(GPL,
+                92,
+                "Placement checkpoint file {} could not be opened.",
+                tmp_file_name);
+  }
+
+  out.write(checkpoint_magic, sizeof(checkpoint_magic));
+  writeBinary<int32_t>(out, iter);
+  writeBinary<float>(out, curA);
+  writeBinary<float>(out, wireLengthCoefX_);
+  writeBinary<float>(out, wireLengthCoefY_);
+  writeBinary<float>(out, npVars_.maxPhiCoef);
+  writeBinary<float>(out, total_sum_overflow_);
+  writeBinary<float>(out, total_sum_overflow_unscaled_);
+  writeBinary<float>(out, average_overflow_);
+  writeBinary<float>(out, average_overflow_unscaled_);
+  writeBinary<uint8_t>(out, isRoutabilityNeed_);
+  writeBinary<uint8_t>(out, isSnapshotSaved_);
+  writeBinary<float>(out, snapshotA_);
+  writeBinary<float>(out, snapshotWlCoefX_);
+  writeBinary<float>(out, snapshotWlCoefY_);
+  writeBinary<uint8_t>(out, isDivergeTriedRevert_);
+
+  nbc_->writeCheckpoint(out);
+  writeBinary<uint32_t>(out, nbVec_.size());
+  for (const auto& nb : nbVec_) {
+    nb->writeCheckpoint(out);
+  }
+  tb_->writeCheckpoint(out);
+  rb_->writeCheckpoint(out);
+
+  out.flush();
+  if (!out) {
+    log_->error(GPL,
+                93,
+                "Failed to write placement checkpoint file {}.",
+                tmp_file_name);
+  }
+  out.close();
+  if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+    log_->error(GPL,
+                108,
+                "Failed to rename placement checkpoint file {} to {}.",
+                tmp_file_name,
+                file_name);
+  }
+  debugPrint(log_,
+             GPL,
+             "checkpoint",
+             1,
+             "Saved checkpoint {} at iter {}",
+             file_name,
+             iter + 1);
+}
+
+int NesterovPlace::readCheckpoint(const std::string& file_name, float& curA)
+{
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in) {
+    log_->error(
+        GPL, 94, "Failed to open placement checkpoint file {}.", file_name);
+  }
+  char magic[sizeof(checkpoint_magic)];
+  in.read(magic, sizeof(magic));
+  if (!in || !std::equal(magic, magic + sizeof(magic), checkpoint_magic)) {
+    log_->error(GPL, 95, "{} is not a placement checkpoint file.", file_name);
+  }
+
+  const int iter = readBinary<int32_t>(in);
+  curA = readBinary<float>(in);
+  wireLengthCoefX_ = readBinary<float>(in);
+  wireLengthCoefY_ = readBinary<float>(in);
+  npVars_.maxPhiCoef = readBinary<float>(in);
+  total_sum_overflow_ = readBinary<float>(in);
+  total_sum_overflow_unscaled_ = readBinary<float>(in);
+  average_overflow_ = readBinary<float>(in);
+  average_overflow_unscaled_ = readBinary<float>(in);
+  isRoutabilityNeed_ = readBinary<uint8_t>(in);
+  isSnapshotSaved_ = readBinary<uint8_t>(in);
+  snapshotA_ = readBinary<float>(in);
+  snapshotWlCoefX_ = readBinary<float>(in);
+  snapshotWlCoefY_ = readBinary<float>(in);
+  isDivergeTriedRevert_ = readBinary<uint8_t>(in);
+
+  bool matches = nbc_->readCheckpoint(in)
+                 && readBinary<uint32_t>(in) == nbVec_.size();
+  for (auto& nb : nbVec_) {
+    matches = matches && nb->readCheckpoint(in);
+  }
+  matches = matches && tb_->readCheckpoint(in) && rb_->readCheckpoint(in);
+  if (!matches) {
+    log_->error(GPL,
+                96,
+                "The placement checkpoint {} does not match the design.",
+                file_name);
+  }
+
+  nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
+
+  log_->info(GPL,
+             97,
+             "Resuming Nesterov placement from {} at iteration {}.",
+             file_name,
+             iter + 1);
+  return iter + 1;
+}
+
 }  // namespace gpl
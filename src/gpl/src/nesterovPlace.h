@@ -122,6 +122,14 @@ class NesterovPlace
   bool isDiverged_ = false;
   bool isRoutabilityNeed_ = true;
 
+  // routability-driven snapshot to revert to, and whether a divergence
+  // was already reverted
+  bool isSnapshotSaved_ = false;
+  float snapshotA_ = 0;
+  float snapshotWlCoefX_ = 0;
+  float snapshotWlCoefY_ = 0;
+  bool isDivergeTriedRevert_ = false;
+
   std::string divergeMsg_;
   int divergeCode_ = 0;
 
@@ -130,6 +138,11 @@ class NesterovPlace
 
   void cutFillerCoordinates();
 
+  // Saves the state at the end of iteration iter; readCheckpoint
+  // restores it and returns the iteration to continue from.
+  void writeCheckpoint(int iter, float curA) const;
+  int readCheckpoint(const std::string& file_name, float& curA);
+
   void init();
   void reset();
 };
@@ -35,6 +35,7 @@
 
 #include <iostream>
 
+#include "clustering.h"
 #include "db_sta/dbNetwork.hh"
 #include "db_sta/dbSta.hh"
 #include "initialPlace.h"
@@ -92,6 +93,7 @@ void Replace::reset()
   initialPlaceMaxSolverIter_ = 100;
   initialPlaceMaxFanout_ = 200;
   initialPlaceNetWeightScale_ = 800;
+  initialPlacePreconditioner_ = "identity";
 
   nesterovPlaceMaxIter_ = 5000;
   binGridCntX_ = binGridCntY_ = 0;
@@ -114,10 +116,19 @@ void Replace::reset()
   routabilityMaxInflationIter_ = 4;
 
   timingDrivenMode_ = true;
+  timingDrivenIncrementalMode_ = false;
   routabilityDrivenMode_ = true;
   routabilityUseRudy_ = true;
+  routabilityIncrementalGrt_ = false;
   uniformTargetDensityMode_ = false;
   skipIoMode_ = false;
+  multilevelMode_ = false;
+  multilevelCoarseningRatio_ = 4;
+  multilevelLevels_ = 2;
+
+  checkpointFile_.clear();
+  checkpointIterations_ = 100;
+  resumeCheckpointFile_.clear();
 
   padLeft_ = padRight_ = 0;
 
@@ -190,7 +201,7 @@ void Replace::doIncrementalPlace(int threads)
   constexpr float rough_oveflow = 0.2f;
   float previous_overflow = overflow_;
   setTargetOverflow(std::max(rough_oveflow, overflow_));
-  doInitialPlace();
+  doInitialPlace(threads);
 
   int previous_max_iter = nesterovPlaceMaxIter_;
   initNesterovPlace(threads);
@@ -210,7 +221,7 @@ void Replace::doIncrementalPlace(int threads)
   }
 }
 
-void Replace::doInitialPlace()
+void Replace::doInitialPlace(int threads)
 {
   if (pbc_ == nullptr) {
     PlacerBaseVars pbVars;
@@ -245,6 +256,12 @@ void Replace::doInitialPlace()
   ipVars.maxSolverIter = initialPlaceMaxSolverIter_;
   ipVars.maxFanout = initialPlaceMaxFanout_;
   ipVars.netWeightScale = initialPlaceNetWeightScale_;
+  if (initialPlacePreconditioner_ == "jacobi") {
+    ipVars.preconditioner = Preconditioner::Jacobi;
+  } else if (initialPlacePreconditioner_ == "incomplete_cholesky") {
+    ipVars.preconditioner = Preconditioner::IncompleteCholesky;
+  }
+  ipVars.numThreads = threads;
   ipVars.debug = gui_debug_initial_;
 
   std::unique_ptr<InitialPlace> ip(
@@ -263,7 +280,9 @@ void Replace::runMBFF(int max_sz,
   pntset.Run(max_sz, alpha, beta);
 }
 
-bool Replace::initNesterovPlace(int threads)
+bool Replace::initNesterovPlace(
+    int threads,
+    const std::vector<std::vector<Instance*>>& clusters)
 {
   if (!pbc_) {
     PlacerBaseVars pbVars;
@@ -305,7 +324,8 @@ bool Replace::initNesterovPlace(int threads)
 
     nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
 
-    nbc_ = std::make_shared<NesterovBaseCommon>(nbVars, pbc_, log_, threads);
+    nbc_ = std::make_shared<NesterovBaseCommon>(
+        nbVars, pbc_, log_, threads, clusters);
 
     for (const auto& pb : pbVec_) {
       nbVec_.push_back(std::make_shared<NesterovBase>(nbVars, pb, nbc_, log_));
@@ -315,6 +335,7 @@ bool Replace::initNesterovPlace(int threads)
   if (!rb_) {
     RouteBaseVars rbVars;
     rbVars.useRudy = routabilityUseRudy_;
+    rbVars.useIncrementalGrt = routabilityIncrementalGrt_;
     rbVars.maxDensity = routabilityMaxDensity_;
     rbVars.maxBloatIter = routabilityMaxBloatIter_;
     rbVars.maxInflationIter = routabilityMaxInflationIter_;
@@ -333,6 +354,7 @@ bool Replace::initNesterovPlace(int threads)
     tb_ = std::make_shared<TimingBase>(nbc_, rs_, log_);
     tb_->setTimingNetWeightOverflows(timingNetWeightOverflows_);
     tb_->setTimingNetWeightMax(timingNetWeightMax_);
+    tb_->setIncrementalMode(timingDrivenIncrementalMode_);
   }
 
   if (!np_) {
@@ -353,6 +375,12 @@ bool Replace::initNesterovPlace(int threads)
     npVars.debug_update_iterations = gui_debug_update_iterations_;
     npVars.debug_draw_bins = gui_debug_draw_bins_;
     npVars.debug_inst = gui_debug_inst_;
+    // checkpoints only hold the flat placement
+    if (clusters.empty()) {
+      npVars.checkpointFile = checkpointFile_;
+      npVars.checkpointIterations = checkpointIterations_;
+      npVars.resumeCheckpointFile = resumeCheckpointFile_;
+    }
 
     for (const auto& nb : nbVec_) {
       nb->setNpVars(&npVars);
@@ -368,6 +396,10 @@ bool Replace::initNesterovPlace(int threads)
 
 int Replace::doNesterovPlace(int threads, int start_iter)
 {
+  if (multilevelMode_ && start_iter == 0 && pbc_ && !nbc_
+      && resumeCheckpointFile_.empty()) {
+    doCoarseNesterovPlace(threads);
+  }
   if (!initNesterovPlace(threads)) {
     return 0;
   }
@@ -377,6 +409,54 @@ int Replace::doNesterovPlace(int threads, int start_iter)
   return np_->doNesterovPlace(start_iter);
 }
 
+// Place the best-choice clusters of the netlist up to a rough overflow,
+// from the coarsest level to the finest, spreading the instances of each
+// level back before the next one is clustered from them.  The flat
+// placement starts from the placement of the finest level.
+void Replace::doCoarseNesterovPlace(int threads)
+{
+  BestChoiceClustering clustering(pbc_, log_);
+  const std::vector<std::vector<std::vector<Instance*>>> levels
+      = clustering.run(multilevelCoarseningRatio_, multilevelLevels_);
+  if (levels.empty()) {
+    return;
+  }
+
+  // Timing and routability are left to the flat placement.
+  constexpr float coarse_overflow = 0.3f;
+  const float previous_overflow = overflow_;
+  const bool previous_timing_driven = timingDrivenMode_;
+  const bool previous_routability_driven = routabilityDrivenMode_;
+  setTargetOverflow(std::max(coarse_overflow, overflow_));
+  timingDrivenMode_ = false;
+  routabilityDrivenMode_ = false;
+
+  for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+    const std::vector<std::vector<Instance*>>& clusters = *level;
+    if (initNesterovPlace(threads, clusters)) {
+      np_->doNesterovPlace();
+      nbc_->uncoarsen();
+      log_->info(
+          GPL, 91, "Multilevel: uncoarsened {} clusters.", clusters.size());
+    }
+
+    // converged NesterovBases lock their instances
+    for (auto& pb : pbVec_) {
+      pb->unlockAll();
+    }
+
+    np_.reset();
+    tb_.reset();
+    rb_.reset();
+    nbVec_.clear();
+    nbc_.reset();
+  }
+
+  overflow_ = previous_overflow;
+  timingDrivenMode_ = previous_timing_driven;
+  routabilityDrivenMode_ = previous_routability_driven;
+}
+
 void Replace::setInitialPlaceMaxIter(int iter)
 {
   initialPlaceMaxIter_ = iter;
@@ -402,6 +482,59 @@ void Replace::setInitialPlaceNetWeightScale(float scale)
   initialPlaceNetWeightScale_ = scale;
 }
 
+void Replace::setInitialPlacePreconditioner(const std::string& preconditioner)
+{
+  if (preconditioner != "identity" && preconditioner != "jacobi"
+      && preconditioner != "incomplete_cholesky") {
+    log_->error(GPL,
+                89,
+                "Unknown initial place preconditioner {}. Use identity, "
+                "jacobi or incomplete_cholesky.",
+                preconditioner);
+  }
+  initialPlacePreconditioner_ = preconditioner;
+}
+
+void Replace::setMultilevelMode(bool mode)
+{
+  multilevelMode_ = mode;
+}
+
+void Replace::setMultilevelCoarseningRatio(float ratio)
+{
+  multilevelCoarseningRatio_ = ratio;
+}
+
+void Replace::setMultilevelLevels(int levels)
+{
+  if (levels < 1) {
+    log_->error(
+        GPL, 109, "Multilevel levels must be at least 1, got {}.", levels);
+  }
+  multilevelLevels_ = levels;
+}
+
+void Replace::setCheckpointFile(const std::string& file_name)
+{
+  checkpointFile_ = file_name;
+}
+
+void Replace::setCheckpointIterations(int iterations)
+{
+  if (iterations < 1) {
+    log_->error(GPL,
+                98,
+                "Checkpoint iterations must be at least 1, got {}.",
+                iterations);
+  }
+  checkpointIterations_ = iterations;
+}
+
+void Replace::setResumeCheckpointFile(const std::string& file_name)
+{
+  resumeCheckpointFile_ = file_name;
+}
+
 void Replace::setNesterovPlaceMaxIter(int iter)
 {
   nesterovPlaceMaxIter_ = iter;
@@ -492,6 +625,11 @@ void Replace::setTimingDrivenMode(bool mode)
   timingDrivenMode_ = mode;
 }
 
+void Replace::setTimingDrivenIncrementalMode(bool mode)
+{
+  timingDrivenIncrementalMode_ = mode;
+}
+
 void Replace::setRoutabilityDrivenMode(bool mode)
 {
   routabilityDrivenMode_ = mode;
@@ -502,6 +640,11 @@ void Replace::setRoutabilityUseGrt(bool mode)
   routabilityUseRudy_ = !mode;
 }
 
+void Replace::setRoutabilityIncrementalGrt(bool mode)
+{
+  routabilityIncrementalGrt_ = mode;
+}
+
 void Replace::setRoutabilityCheckOverflow(float overflow)
 {
   routabilityCheckOverflow_ = overflow;
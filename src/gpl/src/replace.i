@@ -33,7 +33,8 @@ void
 replace_initial_place_cmd()
 {
   Replace* replace = getReplace();
-  replace->doInitialPlace();
+  int threads = ord::OpenRoad::openRoad()->getThreadCount();
+  replace->doInitialPlace(threads);
 }
 
 void 
@@ -82,6 +83,55 @@ set_initial_place_max_fanout_cmd(int fanout)
   replace->setInitialPlaceMaxFanout(fanout);
 }
 
+void
+set_initial_place_preconditioner_cmd(const char* preconditioner)
+{
+  Replace* replace = getReplace();
+  replace->setInitialPlacePreconditioner(preconditioner);
+}
+
+void
+set_multilevel_mode_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setMultilevelMode(mode);
+}
+
+void
+set_multilevel_coarsening_ratio_cmd(float ratio)
+{
+  Replace* replace = getReplace();
+  replace->setMultilevelCoarseningRatio(ratio);
+}
+
+void
+set_multilevel_levels_cmd(int levels)
+{
+  Replace* replace = getReplace();
+  replace->setMultilevelLevels(levels);
+}
+
+void
+set_checkpoint_file_cmd(const char* file_name)
+{
+  Replace* replace = getReplace();
+  replace->setCheckpointFile(file_name);
+}
+
+void
+set_checkpoint_iterations_cmd(int iterations)
+{
+  Replace* replace = getReplace();
+  replace->setCheckpointIterations(iterations);
+}
+
+void
+set_resume_checkpoint_file_cmd(const char* file_name)
+{
+  Replace* replace = getReplace();
+  replace->setResumeCheckpointFile(file_name);
+}
+
 void
 set_nesv_place_iter_cmd(int iter)
 {
@@ -153,6 +203,12 @@ void set_timing_driven_mode(bool timing_driven)
   replace->setTimingDrivenMode(timing_driven);
 }
 
+void set_timing_driven_incremental_mode(bool incremental)
+{
+  Replace* replace = getReplace();
+  replace->setTimingDrivenIncrementalMode(incremental);
+}
+
 
 void
 set_routability_driven_mode(bool routability_driven)
@@ -168,6 +224,13 @@ void
   replace->setRoutabilityUseGrt(use_grt);
 }
 
+void
+set_routability_incremental_grt(bool incremental)
+{
+  Replace* replace = getReplace();
+  replace->setRoutabilityIncrementalGrt(incremental);
+}
+
 void
 set_routability_check_overflow_cmd(float overflow) 
 {
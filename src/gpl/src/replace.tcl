@@ -35,10 +35,17 @@ sta::define_cmd_args "global_placement" {\
     [-skip_initial_place]\
     [-skip_nesterov_place]\
     [-timing_driven]\
+    [-timing_driven_incremental]\
     [-routability_driven]\
     [-disable_timing_driven]\
     [-disable_routability_driven]\
     [-incremental]\
+    [-multilevel]\
+    [-multilevel_coarsening_ratio multilevel_coarsening_ratio]\
+    [-multilevel_levels multilevel_levels]\
+    [-checkpoint_file checkpoint_file]\
+    [-checkpoint_iterations checkpoint_iterations]\
+    [-resume_checkpoint checkpoint_file]\
     [-skip_io]\
     [-bin_grid_count grid_count]\
     [-density target_density]\
@@ -50,7 +57,9 @@ sta::define_cmd_args "global_placement" {\
     [-overflow overflow]\
     [-initial_place_max_iter initial_place_max_iter]\
     [-initial_place_max_fanout initial_place_max_fanout]\
+    [-initial_place_preconditioner initial_place_preconditioner]\
     [-routability_use_grt]\
+    [-routability_incremental_grt]\
     [-routability_target_rc_metric routability_target_rc_metric]\
     [-routability_check_overflow routability_check_overflow]\
     [-routability_max_density routability_max_density]\
@@ -73,12 +82,15 @@ proc global_placement { args } {
       -min_phi_coef -max_phi_coef -overflow \
       -reference_hpwl \
       -initial_place_max_iter -initial_place_max_fanout \
+      -initial_place_preconditioner \
       -routability_check_overflow -routability_max_density \
       -routability_max_bloat_iter -routability_max_inflation_iter \
       -routability_target_rc_metric \
       -routability_inflation_ratio_coef \
       -routability_max_inflation_ratio \
       -routability_rc_coefficients \
+      -multilevel_coarsening_ratio -multilevel_levels \
+      -checkpoint_file -checkpoint_iterations -resume_checkpoint \
       -timing_driven_net_reweight_overflow \
       -timing_driven_net_weight_max \
       -timing_driven_nets_percentage \
@@ -86,11 +98,14 @@ proc global_placement { args } {
     flags {-skip_initial_place \
       -skip_nesterov_place \
       -timing_driven \
+      -timing_driven_incremental \
       -routability_driven \
       -routability_use_grt \
+      -routability_incremental_grt \
       -disable_timing_driven \
       -disable_routability_driven \
       -skip_io \
+      -multilevel \
       -incremental}
 
   # flow control for initial_place
@@ -106,6 +121,38 @@ proc global_placement { args } {
     utl::warn "GPL" 152 "-force_cpu is deprecated."
   }
 
+  gpl::set_multilevel_mode_cmd [info exists flags(-multilevel)]
+  if { [info exists keys(-multilevel_coarsening_ratio)] } {
+    set coarsening_ratio $keys(-multilevel_coarsening_ratio)
+    sta::check_positive_float "-multilevel_coarsening_ratio" $coarsening_ratio
+    gpl::set_multilevel_coarsening_ratio_cmd $coarsening_ratio
+  }
+  if { [info exists keys(-multilevel_levels)] } {
+    set levels $keys(-multilevel_levels)
+    sta::check_positive_integer "-multilevel_levels" $levels
+    if { $levels < 1 } {
+      utl::error GPL 110 "-multilevel_levels must be at least 1."
+    }
+    gpl::set_multilevel_levels_cmd $levels
+  }
+
+  if { [info exists keys(-checkpoint_file)] } {
+    gpl::set_checkpoint_file_cmd $keys(-checkpoint_file)
+  }
+  if { [info exists keys(-checkpoint_iterations)] } {
+    set checkpoint_iterations $keys(-checkpoint_iterations)
+    sta::check_positive_integer "-checkpoint_iterations" $checkpoint_iterations
+    if { $checkpoint_iterations < 1 } {
+      utl::error GPL 99 "-checkpoint_iterations must be at least 1."
+    }
+    gpl::set_checkpoint_iterations_cmd $checkpoint_iterations
+  }
+  if { [info exists keys(-resume_checkpoint)] } {
+    # the checkpoint replaces the initial placement
+    gpl::set_resume_checkpoint_file_cmd $keys(-resume_checkpoint)
+    gpl::set_initial_place_max_iter_cmd 0
+  }
+
   set skip_io [info exists flags(-skip_io)]
   gpl::set_skip_io_mode_cmd $skip_io
   if { $skip_io } {
@@ -142,6 +189,8 @@ proc global_placement { args } {
       rsz::set_worst_slack_nets_percent $keys(-timing_driven_nets_percentage)
     }
   }
+  gpl::set_timing_driven_incremental_mode \
+    [info exists flags(-timing_driven_incremental)]
 
   if { [info exists flags(-disable_timing_driven)] } {
     utl::warn "GPL" 115 "-disable_timing_driven is deprecated."
@@ -168,12 +217,23 @@ proc global_placement { args } {
     }
   }
 
+  set routability_incremental_grt [info exists flags(-routability_incremental_grt)]
+  if { $routability_incremental_grt && !$routability_use_grt } {
+    utl::warn "GPL" 153 "-routability_incremental_grt requires -routability_use_grt."
+    set routability_incremental_grt 0
+  }
+  gpl::set_routability_incremental_grt $routability_incremental_grt
+
   if { [info exists keys(-initial_place_max_fanout)] } {
     set initial_place_max_fanout $keys(-initial_place_max_fanout)
     sta::check_positive_integer "-initial_place_max_fanout" $initial_place_max_fanout
     gpl::set_initial_place_max_fanout_cmd $initial_place_max_fanout
   }
 
+  if { [info exists keys(-initial_place_preconditioner)] } {
+    gpl::set_initial_place_preconditioner_cmd $keys(-initial_place_preconditioner)
+  }
+
   # density settings
   set target_density 0.7
   set uniform_mode 0
@@ -39,6 +39,7 @@
 #include <string>
 #include <utility>
 
+#include "checkpoint.h"
 #include "grt/GlobalRouter.h"
 #include "grt/Rudy.h"
 #include "nesterovBase.h"
@@ -255,6 +256,7 @@ void RouteBaseVars::reset()
   maxBloatIter = 1;
   maxInflationIter = 4;
   useRudy = true;
+  useIncrementalGrt = false;
 }
 
 /////////////////////////////////////////////
@@ -278,10 +280,14 @@ RouteBase::RouteBase(RouteBaseVars rbVars,
   init();
 }
 
-RouteBase::~RouteBase() = default;
+RouteBase::~RouteBase()
+{
+  releaseGrt();
+}
 
 void RouteBase::reset()
 {
+  releaseGrt();
   rbVars_.reset();
   db_ = nullptr;
   nbc_ = nullptr;
@@ -296,6 +302,7 @@ void RouteBase::reset()
 
   minRcCellSize_.clear();
   minRcCellSize_.shrink_to_fit();
+  rudyComputed_ = false;
 
   resetRoutabilityResources();
 }
@@ -304,12 +311,21 @@ void RouteBase::resetRoutabilityResources()
 {
   inflatedAreaDelta_ = 0;
 
-  if (!rbVars_.useRudy) {
+  // an incremental global route is kept for the next routability call
+  if (!rbVars_.useRudy && !incrementalGrt_) {
     grouter_->clear();
   }
   tg_.reset();
 }
 
+void RouteBase::releaseGrt()
+{
+  if (incrementalGrt_) {
+    incrementalGrt_.reset();
+    grouter_->clear();
+  }
+}
+
 void RouteBase::init()
 {
   // tg_ init
@@ -318,6 +334,7 @@ void RouteBase::init()
 
   tg_->setLogger(log_);
   minRcCellSize_.resize(nbc_->gCells().size(), std::make_pair(0, 0));
+  rudyComputed_ = false;
 }
 
 void RouteBase::getRudyResult()
@@ -338,7 +355,23 @@ void RouteBase::getGrtResult()
   // this option must be off
   grouter_->setCriticalNetsPercentage(0);
 
-  grouter_->globalRoute();
+  if (incrementalGrt_) {
+    // the nets of every moved instance were marked dirty by the callbacks;
+    // only those whose pins changed gcell are ripped up and rerouted
+    const int dirtyNetCnt = grouter_->getDirtyNets().size();
+    const int reroutedNetCnt = incrementalGrt_->updateRoutes().size();
+    log_->info(GPL,
+               88,
+               "Incremental global route: {} of {} dirty nets rerouted.",
+               reroutedNetCnt,
+               dirtyNetCnt);
+  } else {
+    grouter_->globalRoute();
+    if (rbVars_.useIncrementalGrt) {
+      incrementalGrt_ = std::make_unique<grt::IncrementalGRoute>(
+          grouter_, db_->getChip()->getBlock());
+    }
+  }
 
   updateGrtRoute();
 }
@@ -407,7 +440,16 @@ static float getUsageCapacityRatio(Tile* tile,
 void RouteBase::updateRudyRoute()
 {
   grt::Rudy* rudy = grouter_->getRudy();
-  rudy->calculateRudy();
+  rudy->setNumThreads(nbc_->getNumThreads());
+  // The RUDY object is shared with grt and other placement runs, so the
+  // first call of a run recomputes it with the current capacity reductions.
+  // Later calls only recompute the tiles of the nets whose pins moved.
+  if (!rudyComputed_) {
+    rudy->calculateRudy();
+    rudyComputed_ = true;
+  } else {
+    rudy->updateRudy();
+  }
   tg_->setNumRoutingLayers(0);
 
   // update grid tile info
@@ -810,6 +852,30 @@ std::pair<bool, bool> RouteBase::routability()
   return std::make_pair(true, true);
 }
 
+void RouteBase::writeCheckpoint(std::ofstream& out) const
+{
+  writeBinary<int64_t>(out, inflatedAreaDelta_);
+  writeBinary<int32_t>(out, bloatIterCnt_);
+  writeBinary<int32_t>(out, inflationIterCnt_);
+  writeBinary<int32_t>(out, numCall_);
+  writeBinary<float>(out, minRc_);
+  writeBinary<float>(out, minRcTargetDensity_);
+  writeBinary<int32_t>(out, minRcViolatedCnt_);
+  writeBinaryVector(out, minRcCellSize_);
+}
+
+bool RouteBase::readCheckpoint(std::ifstream& in)
+{
+  inflatedAreaDelta_ = readBinary<int64_t>(in);
+  bloatIterCnt_ = readBinary<int32_t>(in);
+  inflationIterCnt_ = readBinary<int32_t>(in);
+  numCall_ = readBinary<int32_t>(in);
+  minRc_ = readBinary<float>(in);
+  minRcTargetDensity_ = readBinary<float>(in);
+  minRcViolatedCnt_ = readBinary<int32_t>(in);
+  return readBinaryVector(in, minRcCellSize_, {minRcCellSize_.size()});
+}
+
 void RouteBase::revertGCellSizeToMinRc()
 {
   // revert back the gcell sizes
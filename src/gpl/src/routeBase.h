@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <fstream>
 #include <memory>
 #include <vector>
 
@@ -42,6 +43,7 @@ class dbDatabase;
 
 namespace grt {
 class GlobalRouter;
+class IncrementalGRoute;
 }
 
 namespace utl {
@@ -152,6 +154,9 @@ class RouteBaseVars
 {
  public:
   bool useRudy;
+  // reroute only the nets with pins in other gcells than at the last
+  // getGrtResult call
+  bool useIncrementalGrt;
   float targetRC;
   float inflationRatioCoef;
   float maxInflationRatio;
@@ -202,6 +207,11 @@ class RouteBase
 
   void revertGCellSizeToMinRc();
 
+  // Inflation history for the placement checkpoint.
+  // readCheckpoint returns false if the checkpoint has different gCells.
+  void writeCheckpoint(std::ofstream& out) const;
+  bool readCheckpoint(std::ifstream& in);
+
  private:
   RouteBaseVars rbVars_;
   odb::dbDatabase* db_ = nullptr;
@@ -213,6 +223,12 @@ class RouteBase
 
   std::unique_ptr<TileGrid> tg_;
 
+  // marks the nets of moved instances as dirty between getGrtResult calls
+  std::unique_ptr<grt::IncrementalGRoute> incrementalGrt_;
+
+  // whether this run already computed the RUDY from scratch
+  bool rudyComputed_ = false;
+
   int64_t inflatedAreaDelta_ = 0;
 
   int bloatIterCnt_ = 0;
@@ -231,6 +247,7 @@ class RouteBase
   void init();
   void reset();
   void resetRoutabilityResources();
+  void releaseGrt();
 
   // update inflationIterCnt_, bloatIterCnt_ and numCall_
   void increaseCounter();
@@ -37,8 +37,43 @@
 
 namespace gpl {
 
+template <typename PreconditionerType>
+static float solveAxis(int maxSolverIter,
+                       const SMatrix& placeInstForceMatrix,
+                       const Eigen::VectorXf& fixedInstForceVec,
+                       Eigen::VectorXf& instLocVec)
+{
+  BiCGSTAB<SMatrix, PreconditionerType> solver;
+  solver.setMaxIterations(maxSolverIter);
+  solver.compute(placeInstForceMatrix);
+  instLocVec = solver.solveWithGuess(fixedInstForceVec, instLocVec);
+  return solver.error();
+}
+
+static float solveAxis(int maxSolverIter,
+                       Preconditioner preconditioner,
+                       const SMatrix& placeInstForceMatrix,
+                       const Eigen::VectorXf& fixedInstForceVec,
+                       Eigen::VectorXf& instLocVec)
+{
+  switch (preconditioner) {
+    case Preconditioner::Jacobi:
+      return solveAxis<Eigen::DiagonalPreconditioner<float>>(
+          maxSolverIter, placeInstForceMatrix, fixedInstForceVec, instLocVec);
+    case Preconditioner::IncompleteCholesky:
+      return solveAxis<Eigen::IncompleteCholesky<float>>(
+          maxSolverIter, placeInstForceMatrix, fixedInstForceVec, instLocVec);
+    case Preconditioner::Identity:
+      break;
+  }
+  return solveAxis<IdentityPreconditioner>(
+      maxSolverIter, placeInstForceMatrix, fixedInstForceVec, instLocVec);
+}
+
 ResidualError cpuSparseSolve(int maxSolverIter,
                              int iter,
+                             Preconditioner preconditioner,
+                             int numThreads,
                              SMatrix& placeInstForceMatrixX,
                              Eigen::VectorXf& fixedInstForceVecX,
                              Eigen::VectorXf& instLocVecX,
@@ -48,15 +83,23 @@ ResidualError cpuSparseSolve(int maxSolverIter,
                              utl::Logger* logger)
 {
   ResidualError error;
-  BiCGSTAB<SMatrix, IdentityPreconditioner> solver;
-  solver.setMaxIterations(maxSolverIter);
-  solver.compute(placeInstForceMatrixX);
-  instLocVecX = solver.solveWithGuess(fixedInstForceVecX, instLocVecX);
-  error.x = solver.error();
-
-  solver.compute(placeInstForceMatrixY);
-  instLocVecY = solver.solveWithGuess(fixedInstForceVecY, instLocVecY);
-  error.y = solver.error();
+  // The X and Y systems are independent. With a single thread the region
+  // stays inactive so Eigen may still parallelize its sparse products.
+#pragma omp parallel sections num_threads(2) if (numThreads > 1)
+  {
+#pragma omp section
+    error.x = solveAxis(maxSolverIter,
+                        preconditioner,
+                        placeInstForceMatrixX,
+                        fixedInstForceVecX,
+                        instLocVecX);
+#pragma omp section
+    error.y = solveAxis(maxSolverIter,
+                        preconditioner,
+                        placeInstForceMatrixY,
+                        fixedInstForceVecY,
+                        instLocVecY);
+  }
   return error;
 }
 }  // namespace gpl
@@ -56,14 +56,27 @@ struct ResidualError
   float y;  // The relative residual error for Y
 };
 
+// Preconditioner of the BiCGSTAB solver. The B2B system is symmetric
+// positive semi-definite, so both Jacobi and incomplete Cholesky apply.
+enum class Preconditioner
+{
+  Identity,
+  Jacobi,
+  IncompleteCholesky
+};
+
 using Eigen::BiCGSTAB;
 using Eigen::IdentityPreconditioner;
 using utl::GPL;
 
 using SMatrix = Eigen::SparseMatrix<float, Eigen::RowMajor>;
 
+// Solve the X and Y systems, concurrently when numThreads > 1.
+// instLocVecX/Y hold the initial guess (warm start) and get the solution.
 ResidualError cpuSparseSolve(int maxSolverIter,
                              int iter,
+                             Preconditioner preconditioner,
+                             int numThreads,
                              SMatrix& placeInstForceMatrixX,
                              Eigen::VectorXf& fixedInstForceVecX,
                              Eigen::VectorXf& instLocVecX,
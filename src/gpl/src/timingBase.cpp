@@ -37,6 +37,7 @@
 #include <cmath>
 #include <utility>
 
+#include "checkpoint.h"
 #include "nesterovBase.h"
 #include "placerBase.h"
 #include "rsz/Resizer.hh"
@@ -142,9 +143,60 @@ void TimingBase::setTimingNetWeightMax(float max)
   net_weight_max_ = max;
 }
 
+void TimingBase::setIncrementalMode(bool mode)
+{
+  incremental_ = mode;
+}
+
+// Invalidate the parasitics of the nets whose HPWL moved far enough from
+// the one they were last estimated with, as a proxy for their Steiner tree.
+int TimingBase::markMovedNets(int& arc_count)
+{
+  // relative HPWL change that triggers a parasitics re-estimate
+  constexpr double incrementalHpwlRatio = 0.05;
+
+  int moved_net_count = 0;
+  arc_count = 0;
+  for (size_t i = 0; i < nbc_->gNets().size(); i++) {
+    GNet* gNet = nbc_->gNets()[i];
+    if (gNet->gPins().size() < 2) {
+      continue;
+    }
+    const int64_t hpwl = gNet->hpwl();
+    const int64_t prev_hpwl = netHpwls_[i];
+    if (std::abs(hpwl - prev_hpwl)
+        > incrementalHpwlRatio * std::max<int64_t>(prev_hpwl, 1)) {
+      rs_->parasiticsInvalid(gNet->net()->dbNet());
+      netHpwls_[i] = hpwl;
+      moved_net_count++;
+      arc_count += gNet->gPins().size() - 1;
+    }
+  }
+  return moved_net_count;
+}
+
 bool TimingBase::updateGNetWeights(float overflow)
 {
-  rs_->findResizeSlacks();
+  if (incremental_ && netHpwls_.size() == nbc_->gNets().size()) {
+    int arc_count = 0;
+    const int moved_net_count = markMovedNets(arc_count);
+    const int estimated_net_count = rs_->findResizeSlacks(true);
+    log_->info(GPL,
+               107,
+               "Timing-driven: re-estimated {} nets, {} moved nets with {} "
+               "wire arcs.",
+               estimated_net_count,
+               moved_net_count,
+               arc_count);
+  } else {
+    rs_->findResizeSlacks();
+    if (incremental_) {
+      netHpwls_.resize(nbc_->gNets().size());
+      for (size_t i = 0; i < nbc_->gNets().size(); i++) {
+        netHpwls_[i] = nbc_->gNets()[i]->hpwl();
+      }
+    }
+  }
 
   // get worst resize nets
   sta::NetSeq& worst_slack_nets = rs_->resizeWorstSlackNets();
@@ -210,4 +262,16 @@ bool TimingBase::updateGNetWeights(float overflow)
   return true;
 }
 
+void TimingBase::writeCheckpoint(std::ofstream& out) const
+{
+  writeBinaryVector(out, timingOverflowChk_);
+  writeBinaryVector(out, netHpwls_);
+}
+
+bool TimingBase::readCheckpoint(std::ifstream& in)
+{
+  return readBinaryVector(in, timingOverflowChk_, {timingOverflowChk_.size()})
+         && readBinaryVector(in, netHpwls_, {0, nbc_->gNets().size()});
+}
+
 }  // namespace gpl
@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <fstream>
 #include <memory>
 #include <vector>
 
@@ -67,11 +69,21 @@ class TimingBase
 
   void setTimingNetWeightMax(float max);
 
+  // Only re-estimate the parasitics of nets whose HPWL changed by more
+  // than incrementalHpwlRatio since their last estimate.
+  void setIncrementalMode(bool mode);
+
   // updateNetWeight.
   // True: successfully reweighted gnets
   // False: no slacks found
   bool updateGNetWeights(float overflow);
 
+  // Reweighting progress for the placement checkpoint.
+  // readCheckpoint returns false if the checkpoint has different overflows
+  // or gNets.
+  void writeCheckpoint(std::ofstream& out) const;
+  bool readCheckpoint(std::ifstream& in);
+
  private:
   rsz::Resizer* rs_ = nullptr;
   utl::Logger* log_ = nullptr;
@@ -80,7 +92,11 @@ class TimingBase
   std::vector<int> timingNetWeightOverflow_;
   std::vector<int> timingOverflowChk_;
   float net_weight_max_ = 1.9;
+  bool incremental_ = false;
+  // HPWL of each gNet when its parasitics were last estimated.
+  std::vector<int64_t> netHpwls_;
   void initTimingOverflowChk();
+  int markMovedNets(int& arc_count);
 };
 
 }  // namespace gpl
@@ -0,0 +1,105 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/defin.h"
+#include "odb/lefin.h"
+#include "src/gpl/src/nesterovBase.h"
+#include "src/gpl/src/placerBase.h"
+#include "utl/Logger.h"
+
+namespace gpl {
+
+class BinGridTest : public ::testing::Test
+{
+ protected:
+  template <class T>
+  using OdbUniquePtr = std::unique_ptr<T, void (*)(T*)>;
+
+  void SetUp() override
+  {
+    db_ = OdbUniquePtr<odb::dbDatabase>(odb::dbDatabase::create(),
+                                        &odb::dbDatabase::destroy);
+    odb::lefin lef_reader(
+        db_.get(), &logger_, /*ignore_non_routing_layers=*/false);
+    odb::dbLib* lib
+        = lef_reader.createTechAndLib("tech", "lib", "nangate45.lef");
+    std::vector<odb::dbLib*> libs = {lib};
+    odb::defin def_reader(db_.get(), &logger_);
+    def_reader.createChip(libs, "simple01.def", lib->getTech());
+
+    pbc_ = std::make_shared<PlacerBaseCommon>(
+        db_.get(), PlacerBaseVars(), &logger_);
+    pb_ = std::make_shared<PlacerBase>(db_.get(), pbc_, &logger_);
+
+    // the placeable instances and fillers spread at random over the core,
+    // with some density scaling as after the gCell size updates
+    const Die& die = pbc_->die();
+    std::mt19937 rand(1);
+    std::uniform_int_distribution<int> x(die.coreLx(), die.coreUx());
+    std::uniform_int_distribution<int> y(die.coreLy(), die.coreUy());
+    std::uniform_real_distribution<float> scale(0.5, 1.0);
+    for (Instance* inst : pb_->placeInsts()) {
+      gCells_.emplace_back(inst);
+    }
+    const int fillerCnt = 20000;
+    for (int i = 0; i < fillerCnt; i++) {
+      gCells_.emplace_back(x(rand), y(rand), 760, 2800);
+    }
+    for (GCell& gCell : gCells_) {
+      gCell.setDensityCenterLocation(x(rand), y(rand));
+      gCell.setDensityScale(scale(rand));
+      gCellPtrs_.push_back(&gCell);
+    }
+  }
+
+  // Bins of a 64x64 grid over the core after adding the gCells with
+  // numThreads threads.
+  std::vector<Bin> updateBins(int numThreads)
+  {
+    BinGrid binGrid(&pbc_->die());
+    binGrid.setPlacerBase(pb_);
+    binGrid.setLogger(&logger_);
+    binGrid.setTargetDensity(0.7);
+    binGrid.setBinCnt(64, 64);
+    binGrid.setNumThreads(numThreads);
+    binGrid.initBins();
+    binGrid.updateBinsGCellDensityArea(gCellPtrs_);
+    return binGrid.bins();
+  }
+
+  utl::Logger logger_;
+  OdbUniquePtr<odb::dbDatabase> db_{nullptr, &odb::dbDatabase::destroy};
+  std::shared_ptr<PlacerBaseCommon> pbc_;
+  std::shared_ptr<PlacerBase> pb_;
+  std::vector<GCell> gCells_;
+  std::vector<GCell*> gCellPtrs_;
+};
+
+// The areas of each bin must not depend on the number of threads.
+TEST_F(BinGridTest, DensityAreaMatchesSerial)
+{
+  const std::vector<Bin> serial = updateBins(1);
+
+  int64_t totalArea = 0;
+  for (const Bin& bin : serial) {
+    totalArea += bin.instPlacedAreaUnscaled() + bin.fillerArea();
+  }
+  ASSERT_GT(totalArea, 0);
+
+  for (const int numThreads : {2, 3, 8}) {
+    const std::vector<Bin> bins = updateBins(numThreads);
+    ASSERT_EQ(bins.size(), serial.size());
+    for (size_t i = 0; i < bins.size(); i++) {
+      EXPECT_EQ(bins[i].instPlacedAreaUnscaled(),
+                serial[i].instPlacedAreaUnscaled());
+      EXPECT_EQ(bins[i].fillerArea(), serial[i].fillerArea());
+      EXPECT_EQ(bins[i].nonPlaceArea(), serial[i].nonPlaceArea());
+      EXPECT_EQ(bins[i].density(), serial[i].density());
+    }
+  }
+}
+
+}  // namespace gpl
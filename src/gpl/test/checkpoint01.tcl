@@ -0,0 +1,38 @@
+# resume a routability-driven placement of simple01 from its last
+# checkpoint and compare with the uninterrupted placement
+source helpers.tcl
+set test_name checkpoint01
+read_liberty ./library/nangate45/NangateOpenCellLibrary_typical.lib
+
+read_lef ./nangate45.lef
+read_def ./simple01-rd.def
+
+set block [ord::get_db_block]
+set initial_locations {}
+foreach inst [$block getInsts] {
+  lappend initial_locations [$inst getLocation]
+}
+
+set checkpoint_file [make_result_file $test_name.ckpt]
+global_placement -routability_driven -routability_target_rc_metric 1.25 \
+  -checkpoint_file $checkpoint_file -checkpoint_iterations 100
+set def_file [make_result_file $test_name.def]
+write_def $def_file
+
+foreach inst [$block getInsts] location $initial_locations {
+  $inst setLocation {*}$location
+}
+
+global_placement -routability_driven -routability_target_rc_metric 1.25 \
+  -resume_checkpoint $checkpoint_file
+set resumed_def_file [make_result_file ${test_name}_resumed.def]
+write_def $resumed_def_file
+
+set isDiff [diff_files $def_file $resumed_def_file]
+
+if { $isDiff != 0 } {
+  exit 1
+}
+
+puts "pass"
+exit
@@ -1,5 +1,6 @@
 #include "src/gpl/src/fft.h"
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -146,4 +147,49 @@ TEST(FloatFFTTest, Basic)
   }
 }
 
+// Times doFFT on a placement sized grid and checks that the threaded
+// transform gives exactly the single threaded result.
+TEST(FloatFFTTest, Throughput)
+{
+  const int bin_cnt = 512;
+  const int iterations = 10;
+  const int thread_counts[] = {1, 2, 4, 8};
+
+  std::unique_ptr<gpl::FFT> reference;
+  for (const int threads : thread_counts) {
+    std::unique_ptr<gpl::FFT> fft(
+        new gpl::FFT(bin_cnt, bin_cnt, bin_cnt, bin_cnt, threads));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int iter = 0; iter < iterations; iter++) {
+      for (int x = 0; x < bin_cnt; x++) {
+        for (int y = 0; y < bin_cnt; y++) {
+          fft->updateDensity(x, y, static_cast<float>((x * 7 + y * 13) % 31));
+        }
+      }
+      fft->doFFT();
+    }
+    const std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+
+    std::cout << fmt::format("{}x{} FFT, {} threads: {:.2f} ms/iteration\n",
+                             bin_cnt,
+                             bin_cnt,
+                             threads,
+                             elapsed.count() * 1000 / iterations);
+
+    if (!reference) {
+      reference = std::move(fft);
+      continue;
+    }
+
+    for (int x = 0; x < bin_cnt; x++) {
+      for (int y = 0; y < bin_cnt; y++) {
+        ASSERT_EQ(fft->getElectroForce(x, y), reference->getElectroForce(x, y));
+        ASSERT_EQ(fft->getElectroPhi(x, y), reference->getElectroPhi(x, y));
+      }
+    }
+  }
+}
+
 }  // namespace
@@ -0,0 +1,88 @@
+# initial placement of simple01 with each BiCGSTAB preconditioner
+source helpers.tcl
+set test_name initial_place_preconditioner01
+read_lef ./nangate45.lef
+read_def ./simple01.def
+
+set block [ord::get_db_block]
+
+proc placement {} {
+  set locations {}
+  foreach inst [$::block getInsts] {
+    lappend locations [$inst getLocation]
+  }
+  return $locations
+}
+
+proc restore_placement { locations } {
+  foreach inst [$::block getInsts] location $locations {
+    $inst setLocation {*}$location
+  }
+}
+
+proc hpwl {} {
+  set wirelength 0
+  foreach net [$::block getNets] {
+    set bbox [$net getTermBBox]
+    incr wirelength [expr { [$bbox dx] + [$bbox dy] }]
+  }
+  return $wirelength
+}
+
+proc insts_in_die {} {
+  set die [$::block getDieArea]
+  foreach inst [$::block getInsts] {
+    set bbox [$inst getBBox]
+    if { [$bbox xMin] < [$die xMin] || [$bbox yMin] < [$die yMin]
+         || [$bbox xMax] > [$die xMax] || [$bbox yMax] > [$die yMax] } {
+      return 0
+    }
+  }
+  return 1
+}
+
+proc place_and_report { label args } {
+  set start [clock milliseconds]
+  global_placement -init_density_penalty 0.01 {*}$args
+  set runtime [expr [clock milliseconds] - $start]
+  set wirelength [hpwl]
+  puts "$label: hpwl $wirelength runtime ${runtime}ms"
+  return $wirelength
+}
+
+set initial_placement [placement]
+
+set identity_hpwl [place_and_report "identity"]
+
+restore_placement $initial_placement
+set jacobi_hpwl [place_and_report "jacobi" \
+                   -initial_place_preconditioner jacobi]
+
+restore_placement $initial_placement
+set cholesky_hpwl [place_and_report "incomplete_cholesky" \
+                     -initial_place_preconditioner incomplete_cholesky]
+check "instances in die" { insts_in_die } 1
+
+set def_file [make_result_file $test_name.def]
+write_def $def_file
+
+# the matrices are merged in net order whatever the thread count
+restore_placement $initial_placement
+place_and_report "jacobi initial place 1 thread" \
+  -initial_place_preconditioner jacobi -skip_nesterov_place
+set initial_jacobi_placement [placement]
+
+set_thread_count 4
+restore_placement $initial_placement
+place_and_report "jacobi initial place 4 threads" \
+  -initial_place_preconditioner jacobi -skip_nesterov_place
+set_thread_count 1
+
+check "jacobi wirelength within 10% of identity" \
+  { expr { $jacobi_hpwl <= 1.1 * $identity_hpwl } } 1
+check "incomplete_cholesky wirelength within 10% of identity" \
+  { expr { $cholesky_hpwl <= 1.1 * $identity_hpwl } } 1
+check "jacobi placement independent of thread count" \
+  { expr { [placement] == $initial_jacobi_placement } } 1
+
+exit_summary
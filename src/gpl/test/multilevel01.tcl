@@ -0,0 +1,80 @@
+# multilevel placement of simple01 against a flat placement of the same
+# design
+source helpers.tcl
+set test_name multilevel01
+read_lef ./nangate45.lef
+read_def ./simple01.def
+
+set block [ord::get_db_block]
+
+proc placement {} {
+  set locations {}
+  foreach inst [$::block getInsts] {
+    lappend locations [$inst getLocation]
+  }
+  return $locations
+}
+
+proc restore_placement { locations } {
+  foreach inst [$::block getInsts] location $locations {
+    $inst setLocation {*}$location
+  }
+}
+
+proc hpwl {} {
+  set wirelength 0
+  foreach net [$::block getNets] {
+    set bbox [$net getTermBBox]
+    incr wirelength [expr { [$bbox dx] + [$bbox dy] }]
+  }
+  return $wirelength
+}
+
+proc insts_in_die {} {
+  set die [$::block getDieArea]
+  foreach inst [$::block getInsts] {
+    set bbox [$inst getBBox]
+    if { [$bbox xMin] < [$die xMin] || [$bbox yMin] < [$die yMin]
+         || [$bbox xMax] > [$die xMax] || [$bbox yMax] > [$die yMax] } {
+      return 0
+    }
+  }
+  return 1
+}
+
+proc place_and_report { label args } {
+  set start [clock milliseconds]
+  global_placement -init_density_penalty 0.01 -skip_initial_place {*}$args
+  set runtime [expr [clock milliseconds] - $start]
+  set wirelength [hpwl]
+  puts "$label: hpwl $wirelength runtime ${runtime}ms"
+  return $wirelength
+}
+
+set initial_placement [placement]
+
+set flat_hpwl [place_and_report "flat"]
+set flat_placement [placement]
+
+restore_placement $initial_placement
+set one_level_hpwl [place_and_report "multilevel 1 level" \
+                      -multilevel -multilevel_levels 1]
+
+restore_placement $initial_placement
+set multilevel_hpwl [place_and_report "multilevel 2 levels" \
+                       -multilevel -multilevel_coarsening_ratio 4 \
+                       -multilevel_levels 2]
+
+set def_file [make_result_file $test_name.def]
+write_def $def_file
+
+# the clusters placed first make the result differ from the flat placement
+check "multilevel placement differs from flat" \
+  { expr { [placement] != $flat_placement } } 1
+check "instances in die" { insts_in_die } 1
+check "1 level wirelength within 10% of flat" \
+  { expr { $one_level_hpwl <= 1.1 * $flat_hpwl } } 1
+check "2 level wirelength within 10% of flat" \
+  { expr { $multilevel_hpwl <= 1.1 * $flat_hpwl } } 1
+
+exit_summary
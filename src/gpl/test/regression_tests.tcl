@@ -33,3 +33,10 @@ record_tests {
   #gpl_readme_msgs_check
 }
 #  clust02
+record_pass_fail_tests {
+  multilevel01
+  checkpoint01
+  routability_incremental_grt01
+  timing_driven_incremental01
+  initial_place_preconditioner01
+}
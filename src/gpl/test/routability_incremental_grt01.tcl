@@ -0,0 +1,73 @@
+# routability driven placement of simple01-rd with grt congestion, routed
+# from scratch in every routability iteration and incrementally
+source helpers.tcl
+set test_name routability_incremental_grt01
+read_liberty ./library/nangate45/NangateOpenCellLibrary_typical.lib
+read_lef ./nangate45.lef
+read_def ./simple01-rd.def
+
+set block [ord::get_db_block]
+
+proc placement {} {
+  set locations {}
+  foreach inst [$::block getInsts] {
+    lappend locations [$inst getLocation]
+  }
+  return $locations
+}
+
+proc restore_placement { locations } {
+  foreach inst [$::block getInsts] location $locations {
+    $inst setLocation {*}$location
+  }
+}
+
+proc hpwl {} {
+  set wirelength 0
+  foreach net [$::block getNets] {
+    set bbox [$net getTermBBox]
+    incr wirelength [expr { [$bbox dx] + [$bbox dy] }]
+  }
+  return $wirelength
+}
+
+proc insts_in_die {} {
+  set die [$::block getDieArea]
+  foreach inst [$::block getInsts] {
+    set bbox [$inst getBBox]
+    if { [$bbox xMin] < [$die xMin] || [$bbox yMin] < [$die yMin]
+         || [$bbox xMax] > [$die xMax] || [$bbox yMax] > [$die yMax] } {
+      return 0
+    }
+  }
+  return 1
+}
+
+# the target RC is below the FinalRC of simple01-rd (0.993), so the
+# routability iterations run and call the global router repeatedly
+proc place_and_report { label args } {
+  set start [clock milliseconds]
+  global_placement -routability_driven -routability_use_grt \
+    -routability_target_rc_metric 0.9 {*}$args
+  set runtime [expr [clock milliseconds] - $start]
+  set wirelength [hpwl]
+  puts "$label: hpwl $wirelength runtime ${runtime}ms"
+  return $wirelength
+}
+
+set initial_placement [placement]
+
+set full_hpwl [place_and_report "full grt"]
+
+restore_placement $initial_placement
+set incremental_hpwl [place_and_report "incremental grt" \
+                        -routability_incremental_grt]
+
+set def_file [make_result_file $test_name.def]
+write_def $def_file
+
+check "instances in die" { insts_in_die } 1
+check "incremental grt wirelength within 10% of full grt" \
+  { expr { $incremental_hpwl <= 1.1 * $full_hpwl } } 1
+
+exit_summary
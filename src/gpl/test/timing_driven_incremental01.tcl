@@ -0,0 +1,82 @@
+# timing driven placement of simple01-td with full and incremental
+# parasitics estimation at each net reweighting
+source helpers.tcl
+set test_name timing_driven_incremental01
+read_liberty ./library/nangate45/NangateOpenCellLibrary_typical.lib
+read_lef ./nangate45.lef
+read_def ./simple01-td.def
+
+set period 2
+create_clock -name core_clock -period $period clk
+
+set_wire_rc -signal -layer metal3
+set_wire_rc -clock -layer metal5
+
+set block [ord::get_db_block]
+
+proc placement {} {
+  set locations {}
+  foreach inst [$::block getInsts] {
+    lappend locations [$inst getLocation]
+  }
+  return $locations
+}
+
+proc restore_placement { locations } {
+  foreach inst [$::block getInsts] location $locations {
+    $inst setLocation {*}$location
+  }
+}
+
+proc hpwl {} {
+  set wirelength 0
+  foreach net [$::block getNets] {
+    set bbox [$net getTermBBox]
+    incr wirelength [expr { [$bbox dx] + [$bbox dy] }]
+  }
+  return $wirelength
+}
+
+proc insts_in_die {} {
+  set die [$::block getDieArea]
+  foreach inst [$::block getInsts] {
+    set bbox [$inst getBBox]
+    if { [$bbox xMin] < [$die xMin] || [$bbox yMin] < [$die yMin]
+         || [$bbox xMax] > [$die xMax] || [$bbox yMax] > [$die yMax] } {
+      return 0
+    }
+  }
+  return 1
+}
+
+# returns the wirelength and the worst slack of the placement
+proc place_and_report { label args } {
+  set start [clock milliseconds]
+  global_placement -timing_driven {*}$args
+  set runtime [expr [clock milliseconds] - $start]
+  estimate_parasitics -placement
+  set wirelength [hpwl]
+  set wns [sta::worst_slack -max]
+  puts "$label: hpwl $wirelength worst slack $wns runtime ${runtime}ms"
+  return [list $wirelength $wns]
+}
+
+set initial_placement [placement]
+
+lassign [place_and_report "full"] full_hpwl full_wns
+
+restore_placement $initial_placement
+lassign [place_and_report "incremental" -timing_driven_incremental] \
+  incremental_hpwl incremental_wns
+
+set def_file [make_result_file $test_name.def]
+write_def $def_file
+
+check "instances in die" { insts_in_die } 1
+check "incremental wirelength within 10% of full" \
+  { expr { $incremental_hpwl <= 1.1 * $full_hpwl } } 1
+# slacks are in the user time unit, as the clock period
+check "incremental worst slack within 10% of the period of full" \
+  { expr { $incremental_wns >= $full_wns - 0.1 * $period } } 1
+
+exit_summary
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -99,6 +100,7 @@ class GlobalRouter;
 class AbstractRoutingCongestionDataSource;
 class GRouteDbCbk;
 class Rudy;
+struct BlockObstructions;
 
 struct RegionAdjustment
 {
@@ -179,6 +181,9 @@ class GlobalRouter : public ant::GlobalRouteSource
   void setCongestionReportFile(const char* file_name);
   void setGridOrigin(int x, int y);
   void setAllowCongestion(bool allow_congestion);
+  void setMazeThreadCount(int threads);
+  void setThreadCount(int threads);
+  void setIncrementalMargin(int margin);
   void setMacroExtension(int macro_extension);
 
   // flow functions
@@ -188,6 +193,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   void saveGuides();
   void writeSegments(const char* file_name);
   void readSegments(const char* file_name);
+  void writeSnapshot(const char* file_name);
+  void readSnapshot(const char* file_name);
   void netIsCovered(Net* net, const GRoute& segments);
   bool segmentIsLine(const GSegment& segment);
   bool isConnected(odb::dbNet* net);
@@ -222,6 +229,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   // check_antennas
   bool haveRoutes() override;
   bool haveDetailedRoutes();
+  // total 2D overflow left by the last global_route
+  int getTotalOverflow() const;
   void makeNetWires() override;
   void destroyNetWires() override;
 
@@ -290,6 +299,12 @@ class GlobalRouter : public ant::GlobalRouteSource
  private:
   // Net functions
   Net* addNet(odb::dbNet* db_net);
+  Net* makeNet(odb::dbNet* db_net);
+  // messages found while making the pins of a net; they are reported after
+  // the parallel loop so that the log keeps the net order
+  using PinDiagnostics = std::vector<std::function<void()>>;
+  void makeNetPins(Net* net, PinDiagnostics& diagnostics);
+  void reportDiagnostics(const PinDiagnostics& diagnostics);
   void removeNet(odb::dbNet* db_net);
 
   void applyAdjustments(int min_routing_layer, int max_routing_layer);
@@ -413,15 +428,28 @@ class GlobalRouter : public ant::GlobalRouteSource
       odb::Rect& die_area,
       const std::vector<int>& layer_extensions,
       std::map<int, std::vector<odb::Rect>>& layer_obs_map);
+  void findInstanceObstructions(odb::dbInst* inst,
+                                const odb::Rect& die_area,
+                                const std::vector<int>& layer_extensions,
+                                BlockObstructions& obstructions);
   void findNetsObstructions(odb::Rect& die_area);
-  void applyNetObstruction(const odb::Rect& rect,
-                           odb::dbTechLayer* tech_layer,
+  void findNetObstructions(odb::dbNet* db_net,
                            const odb::Rect& die_area,
-                           odb::dbNet* db_net);
+                           BlockObstructions& obstructions);
+  void addNetObstruction(const odb::Rect& rect,
+                         odb::dbTechLayer* tech_layer,
+                         const odb::Rect& die_area,
+                         BlockObstructions& obstructions);
   int computeMaxRoutingLayer();
   std::map<int, odb::dbTechVia*> getDefaultVias(int max_routing_layer);
-  void makeItermPins(Net* net, odb::dbNet* db_net, const odb::Rect& die_area);
-  void makeBtermPins(Net* net, odb::dbNet* db_net, const odb::Rect& die_area);
+  bool makeItermPins(Net* net,
+                     odb::dbNet* db_net,
+                     const odb::Rect& die_area,
+                     PinDiagnostics& diagnostics);
+  bool makeBtermPins(Net* net,
+                     odb::dbNet* db_net,
+                     const odb::Rect& die_area,
+                     PinDiagnostics& diagnostics);
   void initClockNets();
   bool isClkTerm(odb::dbITerm* iterm, sta::dbNetwork* network);
   void initGridAndNets();
@@ -453,6 +481,10 @@ class GlobalRouter : public ant::GlobalRouteSource
   int overflow_iterations_;
   int congestion_report_iter_step_;
   bool allow_congestion_;
+  int maze_thread_count_;
+  int thread_count_;
+  // gcells around the rerouted nets searched by incremental routing
+  int incremental_margin_;
   std::vector<int> vertical_capacities_;
   std::vector<int> horizontal_capacities_;
   int macro_extension_;
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "odb/db.h"
@@ -68,6 +69,16 @@ class Rudy
    * */
   void calculateRudy();
 
+  /**
+   * Updates the result of the last `calculateRudy` by recomputing the tiles
+   * covered by the nets whose pin bounding box changed, were created or were
+   * destroyed since then.  The result is the same as `calculateRudy`, as
+   * long as the capacity reductions did not change.  Falls back to
+   * `calculateRudy` when there is no previous result or when most of the
+   * nets changed.
+   * */
+  void updateRudy();
+
   /**
    * Set the grid area and grid numbers.
    * Default value will be the die area of block and (40, 40), respectively.
@@ -81,6 +92,12 @@ class Rudy
    * */
   void setWireWidth(int wire_width) { wire_width_ = wire_width; }
 
+  /**
+   * Set the number of threads used to compute the net boxes and to
+   * accumulate them into the tiles.  The result does not depend on it.
+   * */
+  void setNumThreads(int num_threads) { num_threads_ = num_threads; }
+
   const Tile& getTile(int x, int y) const { return grid_.at(x).at(y); }
   std::pair<int, int> getGridSize() const;
   int getTileSize() const { return tile_size_; }
@@ -90,9 +107,20 @@ class Rudy
    * \pre This function should be called after `setGridConfig`
    * */
   void makeGrid();
-  void getResourceReductions();
+  void getResourceReductions(const std::vector<char>* dirty_tiles = nullptr);
   Tile& getEditableTile(int x, int y) { return grid_.at(x).at(y); }
-  void processIntersectionSignalNet(odb::Rect net_rect);
+  void findNetRects(std::vector<odb::dbNet*>& nets,
+                    std::vector<odb::Rect>& net_rects);
+  void getTileRange(const odb::Rect& net_rect,
+                    int& min_x_index,
+                    int& max_x_index,
+                    int& min_y_index,
+                    int& max_y_index) const;
+  void processIntersectionSignalNet(
+      odb::Rect net_rect,
+      int first_x_index,
+      int last_x_index,
+      const std::vector<char>* dirty_tiles = nullptr);
 
   odb::dbBlock* block_;
   odb::Rect grid_block_;
@@ -101,7 +129,10 @@ class Rudy
   int tile_cnt_y_ = 40;
   int wire_width_ = 100;
   int tile_size_ = 0;
+  int num_threads_ = 1;
   std::vector<std::vector<Tile>> grid_;
+  // net boxes added to the tiles by the last computation
+  std::map<odb::dbNet*, odb::Rect> net_rects_;
 };
 
 }  // namespace grt
@@ -39,6 +39,7 @@
 #include <boost/icl/interval.hpp>
 #include <cmath>
 #include <cstring>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <istream>
@@ -46,6 +47,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -72,6 +74,7 @@
 #include "stt/SteinerTreeBuilder.h"
 #include "utl/Logger.h"
 #include "utl/algorithms.h"
+#include "utl/timer.h"
 
 namespace grt {
 
@@ -95,6 +98,9 @@ GlobalRouter::GlobalRouter()
       overflow_iterations_(50),
       congestion_report_iter_step_(0),
       allow_congestion_(false),
+      maze_thread_count_(0),
+      thread_count_(1),
+      incremental_margin_(40),
       macro_extension_(0),
       initialized_(false),
       verbose_(false),
@@ -156,6 +162,7 @@ void GlobalRouter::clear()
   fastroute_->clear();
   vertical_capacities_.clear();
   horizontal_capacities_.clear();
+  dirty_nets_.clear();
   initialized_ = false;
 }
 
@@ -232,6 +239,11 @@ bool GlobalRouter::haveRoutes()
   return !routes_.empty();
 }
 
+int GlobalRouter::getTotalOverflow() const
+{
+  return fastroute_->totalOverflow();
+}
+
 bool GlobalRouter::haveDetailedRoutes()
 {
   for (odb::dbNet* db_net : block_->getNets()) {
@@ -598,7 +610,12 @@ void GlobalRouter::updateDirtyNets(std::vector<Net*>& dirty_nets)
   getMinMaxLayer(min_layer, max_layer);
   initRoutingLayers(min_layer, max_layer);
   for (odb::dbNet* db_net : dirty_nets_) {
-    Net* net = db_net_map_[db_net];
+    auto net_it = db_net_map_.find(db_net);
+    // nets that are not global routed, e.g. supply nets, have no routes
+    if (net_it == db_net_map_.end()) {
+      continue;
+    }
+    Net* net = net_it->second;
     // get last pin positions
     std::vector<odb::Point> last_pos;
     for (const Pin& pin : net->getPins()) {
@@ -606,13 +623,13 @@ void GlobalRouter::updateDirtyNets(std::vector<Net*>& dirty_nets)
     }
     net->destroyPins();
     // update pin positions
-    makeItermPins(net, db_net, grid_->getGridArea());
-    makeBtermPins(net, db_net, grid_->getGridArea());
-    findPins(net);
+    PinDiagnostics diagnostics;
+    makeNetPins(net, diagnostics);
+    reportDiagnostics(diagnostics);
     destroyNetWire(net);
     // compare new positions with last positions & add on vector
     if (pinPositionsChanged(net, last_pos)) {
-      dirty_nets.push_back(db_net_map_[db_net]);
+      dirty_nets.push_back(net);
     }
   }
   dirty_nets_.clear();
@@ -801,7 +818,7 @@ void GlobalRouter::findPins(Net* net)
     // this way, the result based on drt APs is maintained
     if (!has_access_points && pinOverlapsWithSingleTrack(pin, pos_on_grid)) {
       const int conn_layer = pin.getConnectionLayer();
-      odb::dbTechLayer* layer = routing_layers_[conn_layer];
+      odb::dbTechLayer* layer = routing_layers_.at(conn_layer);
       pos_on_grid = grid_->getPositionOnGrid(pos_on_grid);
       if (!(pos_on_grid == pin_position)
           && ((layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL
@@ -1593,6 +1610,21 @@ void GlobalRouter::setAllowCongestion(bool allow_congestion)
   allow_congestion_ = allow_congestion;
 }
 
+void GlobalRouter::setMazeThreadCount(int threads)
+{
+  maze_thread_count_ = threads;
+}
+
+void GlobalRouter::setThreadCount(int threads)
+{
+  thread_count_ = threads;
+}
+
+void GlobalRouter::setIncrementalMargin(int margin)
+{
+  incremental_margin_ = margin;
+}
+
 void GlobalRouter::setMacroExtension(int macro_extension)
 {
   macro_extension_ = macro_extension;
@@ -1686,6 +1718,8 @@ void GlobalRouter::configFastRoute()
   fastroute_->setVerbose(verbose_);
   fastroute_->setOverflowIterations(overflow_iterations_);
   fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
+  fastroute_->setMazeThreadCount(maze_thread_count_);
+  fastroute_->setThreadCount(thread_count_);
 
   if (congestion_file_name_ != nullptr) {
     fastroute_->setCongestionReportFile(congestion_file_name_);
@@ -1921,10 +1955,10 @@ void GlobalRouter::updateDbCongestionFromGuides()
             = (y == grid_->getYGrids() - 1 ? last_row_capH : capH);
         const uint16_t thisCapV
             = (x == grid_->getXGrids() - 1 ? last_col_capV : capV);
-        const uint16_t blockageH = thisCapH - h_edges_3D[k][y][x].cap;
-        const uint16_t blockageV = thisCapV - v_edges_3D[k][y][x].cap;
-        const uint16_t usageH = h_edges_3D[k][y][x].usage + blockageH;
-        const uint16_t usageV = v_edges_3D[k][y][x].usage + blockageV;
+        const uint16_t blockageH = thisCapH - h_edges_3D.cap(k, y, x);
+        const uint16_t blockageV = thisCapV - v_edges_3D.cap(k, y, x);
+        const uint16_t usageH = h_edges_3D.usage(k, y, x) + blockageH;
+        const uint16_t usageV = v_edges_3D.usage(k, y, x) + blockageV;
         db_gcell->setCapacity(layer, x, y, thisCapH + thisCapV);
         db_gcell->setUsage(layer, x, y, usageH + usageV);
       }
@@ -2210,6 +2244,280 @@ void GlobalRouter::readSegments(const char* file_name)
   }
 }
 
+// The global route snapshot is a binary file with the routing grid, the
+// names of the routing layers, the segments of each net and the gcell
+// congestion of the block.  Layers are stored as indexes into the layer
+// names so the file can be read back with a different layer numbering.
+static const char snapshot_magic[8] = {'G', 'R', 'T', 'S', 'N', 'A', 'P', 1};
+
+// Integers are stored little endian so snapshots can be exchanged between
+// hosts, as in the DRC report and the detailed routing update formats.
+template <typename T>
+static void writeBinary(std::ofstream& out, const T& value)
+{
+  using U = std::make_unsigned_t<T>;
+  auto bits = static_cast<U>(value);
+  char bytes[sizeof(T)];
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    bytes[i] = static_cast<char>(bits & 0xff);
+    bits >>= 8;
+  }
+  out.write(bytes, sizeof(T));
+}
+
+template <typename T>
+static T readBinary(std::ifstream& in)
+{
+  using U = std::make_unsigned_t<T>;
+  unsigned char bytes[sizeof(T)] = {};
+  in.read(reinterpret_cast<char*>(bytes), sizeof(T));
+  U value = 0;
+  for (size_t i = sizeof(T); i > 0; --i) {
+    value = (value << 8) | bytes[i - 1];
+  }
+  return static_cast<T>(value);
+}
+
+static void writeBinaryString(std::ofstream& out, const std::string& str)
+{
+  writeBinary<uint32_t>(out, str.size());
+  out.write(str.data(), str.size());
+}
+
+void GlobalRouter::writeSnapshot(const char* file_name)
+{
+  std::ofstream out(file_name, std::ios::binary);
+  if (!out) {
+    logger_->error(GRT,
+                   266,
+                   "Global route snapshot file {} could not be opened.",
+                   file_name);
+  }
+
+  out.write(snapshot_magic, sizeof(snapshot_magic));
+  writeBinary<int32_t>(out, grid_->getXMin());
+  writeBinary<int32_t>(out, grid_->getYMin());
+  writeBinary<int32_t>(out, grid_->getTileSize());
+  writeBinary<int32_t>(out, grid_->getXGrids());
+  writeBinary<int32_t>(out, grid_->getYGrids());
+
+  odb::dbTech* tech = db_->getTech();
+  const int num_layers = tech->getRoutingLayerCount();
+  writeBinary<uint16_t>(out, num_layers);
+  for (int l = 1; l <= num_layers; l++) {
+    writeBinaryString(out, tech->findRoutingLayer(l)->getName());
+  }
+
+  uint32_t num_routes = 0;
+  for (const auto& [db_net, route] : routes_) {
+    if (!route.empty()) {
+      num_routes++;
+    }
+  }
+  writeBinary<uint32_t>(out, num_routes);
+  for (const auto& [db_net, route] : routes_) {
+    if (route.empty()) {
+      continue;
+    }
+    writeBinaryString(out, db_net->getName());
+    writeBinary<uint32_t>(out, route.size());
+    for (const GSegment& segment : route) {
+      writeBinary<int32_t>(out, segment.init_x);
+      writeBinary<int32_t>(out, segment.init_y);
+      writeBinary<uint16_t>(out, segment.init_layer);
+      writeBinary<int32_t>(out, segment.final_x);
+      writeBinary<int32_t>(out, segment.final_y);
+      writeBinary<uint16_t>(out, segment.final_layer);
+    }
+  }
+
+  // gcell congestion, only for grids with a single pattern per axis as
+  // created by the global router
+  odb::dbGCellGrid* gcell_grid = block_->getGCellGrid();
+  const bool has_congestion = gcell_grid != nullptr
+                              && gcell_grid->getNumGridPatternsX() == 1
+                              && gcell_grid->getNumGridPatternsY() == 1;
+  writeBinary<uint8_t>(out, has_congestion);
+  if (has_congestion) {
+    int origin_x, count_x, step_x, origin_y, count_y, step_y;
+    gcell_grid->getGridPatternX(0, origin_x, count_x, step_x);
+    gcell_grid->getGridPatternY(0, origin_y, count_y, step_y);
+    writeBinary<int32_t>(out, origin_x);
+    writeBinary<int32_t>(out, count_x);
+    writeBinary<int32_t>(out, step_x);
+    writeBinary<int32_t>(out, origin_y);
+    writeBinary<int32_t>(out, count_y);
+    writeBinary<int32_t>(out, step_y);
+    for (int l = 1; l <= num_layers; l++) {
+      const odb::dbMatrix<odb::dbGCellGrid::GCellData> congestion
+          = gcell_grid->getLayerCongestionMap(tech->findRoutingLayer(l));
+      writeBinary<uint32_t>(out, congestion.numRows());
+      writeBinary<uint32_t>(out, congestion.numCols());
+      for (uint x = 0; x < congestion.numRows(); x++) {
+        for (uint y = 0; y < congestion.numCols(); y++) {
+          writeBinary<uint8_t>(out, congestion(x, y).capacity);
+          writeBinary<uint8_t>(out, congestion(x, y).usage);
+        }
+      }
+    }
+  }
+
+  if (!out) {
+    logger_->error(
+        GRT, 267, "Failed to write global route snapshot file {}.", file_name);
+  }
+}
+
+void GlobalRouter::readSnapshot(const char* file_name)
+{
+  if (db_->getChip() == nullptr || db_->getChip()->getBlock() == nullptr
+      || db_->getTech() == nullptr) {
+    logger_->error(GRT, 268, "Load design before reading the snapshot.");
+  }
+
+  std::ifstream in(file_name, std::ios::binary | std::ios::ate);
+  if (!in) {
+    logger_->error(
+        GRT, 269, "Failed to open global route snapshot file {}.", file_name);
+  }
+  const std::streamoff file_size = in.tellg();
+  in.seekg(0);
+  // sizes read from the file are checked against the bytes left in it, so a
+  // corrupt file cannot make the reader allocate without bound
+  auto check_size = [&](uint64_t bytes) {
+    if (!in || bytes > static_cast<uint64_t>(file_size - in.tellg())) {
+      logger_->error(GRT,
+                     278,
+                     "Global route snapshot file {} is truncated or corrupt.",
+                     file_name);
+    }
+  };
+  auto read_string = [&]() {
+    const uint32_t size = readBinary<uint32_t>(in);
+    check_size(size);
+    std::string str(size, '\0');
+    in.read(str.data(), size);
+    return str;
+  };
+
+  char magic[sizeof(snapshot_magic)];
+  in.read(magic, sizeof(magic));
+  if (!in || !std::equal(magic, magic + sizeof(magic), snapshot_magic)) {
+    logger_->error(
+        GRT, 270, "{} is not a global route snapshot file.", file_name);
+  }
+
+  initGridAndNets();
+
+  const int x_min = readBinary<int32_t>(in);
+  const int y_min = readBinary<int32_t>(in);
+  const int tile_size = readBinary<int32_t>(in);
+  const int x_grids = readBinary<int32_t>(in);
+  const int y_grids = readBinary<int32_t>(in);
+  if (x_min != grid_->getXMin() || y_min != grid_->getYMin()
+      || tile_size != grid_->getTileSize() || x_grids != grid_->getXGrids()
+      || y_grids != grid_->getYGrids()) {
+    logger_->error(GRT,
+                   271,
+                   "The routing grid of snapshot {} does not match the "
+                   "design.",
+                   file_name);
+  }
+
+  odb::dbTech* tech = db_->getTech();
+  const int num_layers = readBinary<uint16_t>(in);
+  // each layer name has at least its size
+  check_size(num_layers * sizeof(uint32_t));
+  std::vector<odb::dbTechLayer*> layers(num_layers + 1, nullptr);
+  for (int l = 1; l <= num_layers; l++) {
+    const std::string layer_name = read_string();
+    layers[l] = tech->findLayer(layer_name.c_str());
+    if (layers[l] == nullptr) {
+      logger_->error(GRT, 272, "Cannot find layer {}.", layer_name);
+    }
+  }
+  auto routing_level = [&](int layer) {
+    if (layer < 1 || layer > num_layers) {
+      logger_->error(
+          GRT, 273, "Error reading global route snapshot file {}.", file_name);
+    }
+    return layers[layer]->getRoutingLevel();
+  };
+
+  // nets missing from the snapshot are left without a route
+  routes_.clear();
+  // bytes of a route without its name and segments, and of a segment
+  const uint64_t route_bytes = 2 * sizeof(uint32_t);
+  const uint64_t segment_bytes = 4 * sizeof(int32_t) + 2 * sizeof(uint16_t);
+  const uint32_t num_routes = readBinary<uint32_t>(in);
+  check_size(num_routes * route_bytes);
+  for (uint32_t i = 0; i < num_routes && in; i++) {
+    const std::string net_name = read_string();
+    odb::dbNet* db_net = block_->findNet(net_name.c_str());
+    if (db_net == nullptr) {
+      logger_->error(GRT, 274, "Cannot find net {}.", net_name);
+    }
+    const uint32_t num_segments = readBinary<uint32_t>(in);
+    check_size(num_segments * segment_bytes);
+    GRoute& route = routes_[db_net];
+    route.resize(num_segments);
+    for (GSegment& segment : route) {
+      segment.init_x = readBinary<int32_t>(in);
+      segment.init_y = readBinary<int32_t>(in);
+      segment.init_layer = routing_level(readBinary<uint16_t>(in));
+      segment.final_x = readBinary<int32_t>(in);
+      segment.final_y = readBinary<int32_t>(in);
+      segment.final_layer = routing_level(readBinary<uint16_t>(in));
+    }
+  }
+
+  if (readBinary<uint8_t>(in)) {
+    const int origin_x = readBinary<int32_t>(in);
+    const int count_x = readBinary<int32_t>(in);
+    const int step_x = readBinary<int32_t>(in);
+    const int origin_y = readBinary<int32_t>(in);
+    const int count_y = readBinary<int32_t>(in);
+    const int step_y = readBinary<int32_t>(in);
+    odb::dbGCellGrid* gcell_grid = block_->getGCellGrid();
+    if (gcell_grid) {
+      gcell_grid->resetGrid();
+    } else {
+      gcell_grid = odb::dbGCellGrid::create(block_);
+    }
+    gcell_grid->addGridPatternX(origin_x, count_x, step_x);
+    gcell_grid->addGridPatternY(origin_y, count_y, step_y);
+    for (int l = 1; l <= num_layers && in; l++) {
+      const uint32_t num_rows = readBinary<uint32_t>(in);
+      const uint32_t num_cols = readBinary<uint32_t>(in);
+      // capacity and usage of each gcell
+      check_size(uint64_t(num_rows) * num_cols * 2 * sizeof(uint8_t));
+      for (uint x = 0; x < num_rows; x++) {
+        for (uint y = 0; y < num_cols; y++) {
+          gcell_grid->setCapacity(layers[l], x, y, readBinary<uint8_t>(in));
+          gcell_grid->setUsage(layers[l], x, y, readBinary<uint8_t>(in));
+        }
+      }
+    }
+    heatmap_->update();
+  }
+
+  if (!in) {
+    logger_->error(
+        GRT, 275, "Error reading global route snapshot file {}.", file_name);
+  }
+
+  for (auto& [db_net, route] : routes_) {
+    if (!isConnected(db_net)) {
+      logger_->error(
+          GRT, 276, "Net {} has disconnected segments.", db_net->getName());
+    }
+    auto net = db_net_map_.find(db_net);
+    if (net != db_net_map_.end()) {
+      netIsCovered(net->second, route);
+    }
+  }
+}
+
 void GlobalRouter::netIsCovered(Net* net, const GRoute& segments)
 {
   for (const Pin& pin : net->getPins()) {
@@ -2738,7 +3046,7 @@ bool GlobalRouter::pinOverlapsWithSingleTrack(const Pin& pin,
   int conn_layer = pin.getConnectionLayer();
   std::vector<odb::Rect> pin_boxes = pin.getBoxes().at(conn_layer);
 
-  odb::dbTechLayer* layer = routing_layers_[conn_layer];
+  odb::dbTechLayer* layer = routing_layers_.at(conn_layer);
   RoutingTracks tracks = getRoutingTracksByIndex(conn_layer);
 
   odb::Rect pin_rect;
@@ -3012,6 +3320,8 @@ void GlobalRouter::initRoutingTracks(int max_routing_layer)
 
 void GlobalRouter::computeCapacities(int max_layer)
 {
+  const utl::DebugScopedTimer timer(
+      logger_, GRT, "timer", 1, "Compute capacities: {}");
   int h_capacity, v_capacity;
 
   for (auto const& [level, tech_layer] : routing_layers_) {
@@ -3078,6 +3388,8 @@ static bool nameLess(const Net* a, const Net* b)
 
 std::vector<Net*> GlobalRouter::findNets()
 {
+  const utl::DebugScopedTimer timer(
+      logger_, GRT, "timer", 1, "Find nets and pins: {}");
   initClockNets();
 
   std::vector<odb::dbNet*> db_nets;
@@ -3087,17 +3399,44 @@ std::vector<Net*> GlobalRouter::findNets()
   } else {
     db_nets = nets_to_route_;
   }
-  std::vector<Net*> clk_nets;
+
+  // the nets are created in order, their pins are independent of each other
+  std::vector<Net*> new_nets;
+  new_nets.reserve(db_nets.size());
   for (odb::dbNet* db_net : db_nets) {
-    Net* net = addNet(db_net);
-    // add clock nets not connected to a leaf first
+    Net* net = makeNet(db_net);
     if (net) {
-      bool is_non_leaf_clock = isNonLeafClock(net->getDbNet());
-      if (is_non_leaf_clock)
-        clk_nets.push_back(net);
+      new_nets.push_back(net);
     }
   }
 
+  // the messages are reported in net order and the first error stops the
+  // report, so the log does not depend on the number of threads
+  std::vector<PinDiagnostics> diagnostics(new_nets.size());
+  std::vector<std::exception_ptr> exceptions(new_nets.size());
+#pragma omp parallel for num_threads(thread_count_) schedule(dynamic, 64)
+  for (int i = 0; i < new_nets.size(); i++) {
+    try {
+      makeNetPins(new_nets[i], diagnostics[i]);
+    } catch (...) {
+      exceptions[i] = std::current_exception();
+    }
+  }
+  for (int i = 0; i < new_nets.size(); i++) {
+    reportDiagnostics(diagnostics[i]);
+    if (exceptions[i]) {
+      std::rethrow_exception(exceptions[i]);
+    }
+  }
+
+  std::vector<Net*> clk_nets;
+  for (Net* net : new_nets) {
+    // add clock nets not connected to a leaf first
+    bool is_non_leaf_clock = isNonLeafClock(net->getDbNet());
+    if (is_non_leaf_clock)
+      clk_nets.push_back(net);
+  }
+
   std::vector<Net*> non_clk_nets;
   for (auto [ignored, net] : db_net_map_) {
     bool is_non_leaf_clock = isNonLeafClock(net->getDbNet());
@@ -3118,19 +3457,46 @@ std::vector<Net*> GlobalRouter::findNets()
 }
 
 Net* GlobalRouter::addNet(odb::dbNet* db_net)
+{
+  Net* net = makeNet(db_net);
+  if (net) {
+    PinDiagnostics diagnostics;
+    makeNetPins(net, diagnostics);
+    reportDiagnostics(diagnostics);
+  }
+  return net;
+}
+
+Net* GlobalRouter::makeNet(odb::dbNet* db_net)
 {
   if (!db_net->getSigType().isSupply() && !db_net->isSpecial()
       && db_net->getSWires().empty() && !db_net->isConnectedByAbutment()) {
     Net* net = new Net(db_net, db_net->getWire() != nullptr);
     db_net_map_[db_net] = net;
-    makeItermPins(net, db_net, grid_->getGridArea());
-    makeBtermPins(net, db_net, grid_->getGridArea());
-    findPins(net);
     return net;
   }
   return nullptr;
 }
 
+// Only reads the block and the grid, so it is called concurrently for
+// different nets.  Messages go to diagnostics instead of the logger; the pins
+// are incomplete when it holds an error.
+void GlobalRouter::makeNetPins(Net* net, PinDiagnostics& diagnostics)
+{
+  odb::dbNet* db_net = net->getDbNet();
+  if (makeItermPins(net, db_net, grid_->getGridArea(), diagnostics)
+      && makeBtermPins(net, db_net, grid_->getGridArea(), diagnostics)) {
+    findPins(net);
+  }
+}
+
+void GlobalRouter::reportDiagnostics(const PinDiagnostics& diagnostics)
+{
+  for (const auto& report : diagnostics) {
+    report();
+  }
+}
+
 void GlobalRouter::removeNet(odb::dbNet* db_net)
 {
   Net* net = db_net_map_[db_net];
@@ -3191,9 +3557,10 @@ bool GlobalRouter::isNonLeafClock(odb::dbNet* db_net)
   return true;
 }
 
-void GlobalRouter::makeItermPins(Net* net,
+bool GlobalRouter::makeItermPins(Net* net,
                                  odb::dbNet* db_net,
-                                 const odb::Rect& die_area)
+                                 const odb::Rect& die_area,
+                                 PinDiagnostics& diagnostics)
 {
   bool is_clock = (net->getSignalType() == odb::dbSigType::CLOCK);
   int max_routing_layer = (is_clock && max_layer_for_clock_ > 0)
@@ -3205,10 +3572,12 @@ void GlobalRouter::makeItermPins(Net* net,
     const odb::dbMasterType type = master->getType();
 
     if (type.isCover() && verbose_) {
-      logger_->warn(
-          GRT,
-          34,
-          "Net connected to instance of class COVER added for routing.");
+      diagnostics.emplace_back([this] {
+        logger_->warn(
+            GRT,
+            34,
+            "Net connected to instance of class COVER added for routing.");
+      });
     }
 
     const bool connected_to_pad = type.isPad();
@@ -3216,7 +3585,10 @@ void GlobalRouter::makeItermPins(Net* net,
 
     odb::dbInst* inst = iterm->getInst();
     if (!inst->isPlaced()) {
-      logger_->error(GRT, 10, "Instance {} is not placed.", inst->getName());
+      diagnostics.emplace_back([this, name = inst->getName()] {
+        logger_->error(GRT, 10, "Instance {} is not placed.", name);
+      });
+      return false;
     }
     const odb::dbTransform transform = inst->getTransform();
 
@@ -3237,8 +3609,9 @@ void GlobalRouter::makeItermPins(Net* net,
         transform.apply(rect);
 
         if (!die_area.contains(rect) && verbose_) {
-          logger_->warn(
-              GRT, 35, "Pin {} is outside die area.", getITermName(iterm));
+          diagnostics.emplace_back([this, name = getITermName(iterm)] {
+            logger_->warn(GRT, 35, "Pin {} is outside die area.", name);
+          });
         }
         pin_boxes[tech_layer].push_back(rect);
         if (tech_layer->getRoutingLevel() > last_layer) {
@@ -3254,12 +3627,16 @@ void GlobalRouter::makeItermPins(Net* net,
     }
 
     if (pin_layers.empty()) {
-      logger_->error(
-          GRT,
-          29,
-          "Pin {} does not have geometries below the max routing layer ({}).",
-          getITermName(iterm),
-          getLayerName(max_routing_layer, db_));
+      diagnostics.emplace_back(
+          [this, name = getITermName(iterm), max_routing_layer] {
+            logger_->error(GRT,
+                           29,
+                           "Pin {} does not have geometries below the max "
+                           "routing layer ({}).",
+                           name,
+                           getLayerName(max_routing_layer, db_));
+          });
+      return false;
     }
 
     Pin pin(iterm,
@@ -3270,11 +3647,13 @@ void GlobalRouter::makeItermPins(Net* net,
 
     net->addPin(pin);
   }
+  return true;
 }
 
-void GlobalRouter::makeBtermPins(Net* net,
+bool GlobalRouter::makeBtermPins(Net* net,
                                  odb::dbNet* db_net,
-                                 const odb::Rect& die_area)
+                                 const odb::Rect& die_area,
+                                 PinDiagnostics& diagnostics)
 {
   for (odb::dbBTerm* bterm : db_net->getBTerms()) {
     int posX, posY;
@@ -3289,7 +3668,10 @@ void GlobalRouter::makeBtermPins(Net* net,
     for (odb::dbBPin* bterm_pin : bterm->getBPins()) {
       int last_layer = -1;
       if (!bterm_pin->getPlacementStatus().isPlaced()) {
-        logger_->error(GRT, 11, "Pin {} is not placed.", pin_name);
+        diagnostics.emplace_back([this, pin_name] {
+          logger_->error(GRT, 11, "Pin {} is not placed.", pin_name);
+        });
+        return false;
       }
 
       for (odb::dbBox* bpin_box : bterm_pin->getBoxes()) {
@@ -3300,16 +3682,21 @@ void GlobalRouter::makeBtermPins(Net* net,
 
         odb::Rect rect = bpin_box->getBox();
         if (!die_area.contains(rect) && verbose_) {
-          logger_->warn(GRT, 36, "Pin {} is outside die area.", pin_name);
+          diagnostics.emplace_back([this, pin_name] {
+            logger_->warn(GRT, 36, "Pin {} is outside die area.", pin_name);
+          });
           odb::Rect intersection;
           rect.intersection(die_area, intersection);
           rect = intersection;
           if (rect.area() == 0) {
-            logger_->error(GRT,
-                           209,
-                           "Pin {} is completely outside the die area and "
-                           "cannot bet routed.",
-                           pin_name);
+            diagnostics.emplace_back([this, pin_name] {
+              logger_->error(GRT,
+                             209,
+                             "Pin {} is completely outside the die area and "
+                             "cannot bet routed.",
+                             pin_name);
+            });
+            return false;
           }
         }
         pin_boxes[tech_layer].push_back(rect);
@@ -3325,16 +3712,20 @@ void GlobalRouter::makeBtermPins(Net* net,
     }
 
     if (pin_layers.empty()) {
-      logger_->error(
-          GRT,
-          42,
-          "Pin {} does not have geometries in a valid routing layer.",
-          pin_name);
+      diagnostics.emplace_back([this, pin_name] {
+        logger_->error(
+            GRT,
+            42,
+            "Pin {} does not have geometries in a valid routing layer.",
+            pin_name);
+      });
+      return false;
     }
 
     Pin pin(bterm, pin_pos, pin_layers, pin_boxes, getRectMiddle(die_area));
     net->addPin(pin);
   }
+  return true;
 }
 
 std::string getITermName(odb::dbITerm* iterm)
@@ -3522,210 +3913,285 @@ void GlobalRouter::extendObstructions(
   }
 }
 
+// Obstructions of one instance or net.  They are collected concurrently and
+// applied to FastRoute in block order, so the adjustments and warnings are
+// the same for any number of threads.
+struct BlockObstructions
+{
+  std::vector<std::pair<odb::Rect, odb::dbTechLayer*>> rects;
+  // extended macro obstructions, used to adjust the transition layers
+  std::vector<std::pair<int, odb::Rect>> macro_rects;
+  int obstructions_cnt = 0;
+  bool is_macro = false;
+  int rects_outside_die = 0;
+  std::vector<const char*> pins_outside_die;
+};
+
 int GlobalRouter::findInstancesObstructions(
     odb::Rect& die_area,
     const std::vector<int>& layer_extensions,
     std::map<int, std::vector<odb::Rect>>& layer_obs_map)
 {
+  const utl::DebugScopedTimer timer(
+      logger_, GRT, "timer", 1, "Find instance obstructions: {}");
   int macros_cnt = 0;
   int obstructions_cnt = 0;
   int pin_out_of_die_count = 0;
-  odb::dbTech* tech = db_->getTech();
-  for (odb::dbInst* inst : block_->getInsts()) {
-    odb::dbMaster* master = inst->getMaster();
 
-    const odb::dbTransform transform = inst->getTransform();
+  odb::dbSet<odb::dbInst> block_insts = block_->getInsts();
+  const std::vector<odb::dbInst*> insts(block_insts.begin(),
+                                        block_insts.end());
+  std::vector<BlockObstructions> inst_obstructions(insts.size());
+#pragma omp parallel for num_threads(thread_count_) schedule(dynamic, 256)
+  for (int i = 0; i < insts.size(); i++) {
+    findInstanceObstructions(
+        insts[i], die_area, layer_extensions, inst_obstructions[i]);
+  }
 
-    bool isMacro = false;
-    if (master->isBlock()) {
+  for (int i = 0; i < insts.size(); i++) {
+    const BlockObstructions& obstructions = inst_obstructions[i];
+    if (obstructions.is_macro) {
       macros_cnt++;
-      isMacro = true;
     }
+    obstructions_cnt += obstructions.obstructions_cnt;
+    for (const auto& [layer, rect] : obstructions.macro_rects) {
+      layer_obs_map[layer].push_back(rect);
+    }
+    if (verbose_) {
+      for (int j = 0; j < obstructions.rects_outside_die; j++) {
+        logger_->warn(GRT,
+                      38,
+                      "Found blockage outside die area in instance {}.",
+                      insts[i]->getConstName());
+      }
+    }
+    for (const char* mterm_name : obstructions.pins_outside_die) {
+      logger_->warn(GRT,
+                    39,
+                    "Found pin {} outside die area in instance {}.",
+                    mterm_name,
+                    insts[i]->getConstName());
+      pin_out_of_die_count++;
+    }
+    for (const auto& [rect, tech_layer] : obstructions.rects) {
+      applyObstructionAdjustment(rect, tech_layer);
+    }
+  }
 
-    if (isMacro) {
-      std::unordered_map<int, std::vector<odb::Rect>> macro_obs_per_layer;
-      int bottom_layer = std::numeric_limits<int>::max();
-      int top_layer = std::numeric_limits<int>::min();
+  if (pin_out_of_die_count > 0) {
+    if (verbose_)
+      logger_->error(
+          GRT, 28, "Found {} pins outside die area.", pin_out_of_die_count);
+  }
+
+  if (verbose_)
+    logger_->info(GRT, 3, "Macros: {}", macros_cnt);
+  return obstructions_cnt;
+}
+
+void GlobalRouter::findInstanceObstructions(
+    odb::dbInst* inst,
+    const odb::Rect& die_area,
+    const std::vector<int>& layer_extensions,
+    BlockObstructions& obstructions)
+{
+  odb::dbTech* tech = db_->getTech();
+  odb::dbMaster* master = inst->getMaster();
 
-      for (odb::dbBox* box : master->getObstructions()) {
-        int layer = box->getTechLayer()->getRoutingLevel();
-        if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
-          odb::Rect rect = box->getBox();
-          transform.apply(rect);
+  const odb::dbTransform transform = inst->getTransform();
 
-          macro_obs_per_layer[layer].push_back(rect);
-          obstructions_cnt++;
+  obstructions.is_macro = master->isBlock();
 
-          bottom_layer = std::min(bottom_layer, layer);
-          top_layer = std::max(top_layer, layer);
-        }
-      }
+  if (obstructions.is_macro) {
+    std::unordered_map<int, std::vector<odb::Rect>> macro_obs_per_layer;
+    int bottom_layer = std::numeric_limits<int>::max();
+    int top_layer = std::numeric_limits<int>::min();
 
-      extendObstructions(macro_obs_per_layer, bottom_layer, top_layer);
+    for (odb::dbBox* box : master->getObstructions()) {
+      int layer = box->getTechLayer()->getRoutingLevel();
+      if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
+        odb::Rect rect = box->getBox();
+        transform.apply(rect);
 
-      // iterate all Rects for each layer and apply adjustment in FastRoute
-      for (auto& [layer, obs] : macro_obs_per_layer) {
-        odb::dbTechLayer* tech_layer = tech->findRoutingLayer(layer);
-        int layer_extension = layer_extensions[layer];
-        layer_extension += macro_extension_ * grid_->getTileSize();
-        for (odb::Rect& cur_obs : obs) {
-          if (tech_layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL) {
-            cur_obs.set_ylo(cur_obs.yMin() - layer_extension);
-            cur_obs.set_yhi(cur_obs.yMax() + layer_extension);
-          } else if (tech_layer->getDirection()
-                     == odb::dbTechLayerDir::VERTICAL) {
-            cur_obs.set_xlo(cur_obs.xMin() - layer_extension);
-            cur_obs.set_xhi(cur_obs.xMax() + layer_extension);
-          }
-          layer_obs_map[layer].push_back(cur_obs);
-          applyObstructionAdjustment(cur_obs, tech->findRoutingLayer(layer));
+        macro_obs_per_layer[layer].push_back(rect);
+        obstructions.obstructions_cnt++;
+
+        bottom_layer = std::min(bottom_layer, layer);
+        top_layer = std::max(top_layer, layer);
+      }
+    }
+
+    extendObstructions(macro_obs_per_layer, bottom_layer, top_layer);
+
+    // iterate all Rects for each layer and apply adjustment in FastRoute
+    for (auto& [layer, obs] : macro_obs_per_layer) {
+      odb::dbTechLayer* tech_layer = tech->findRoutingLayer(layer);
+      int layer_extension = layer_extensions[layer];
+      layer_extension += macro_extension_ * grid_->getTileSize();
+      for (odb::Rect& cur_obs : obs) {
+        if (tech_layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL) {
+          cur_obs.set_ylo(cur_obs.yMin() - layer_extension);
+          cur_obs.set_yhi(cur_obs.yMax() + layer_extension);
+        } else if (tech_layer->getDirection()
+                   == odb::dbTechLayerDir::VERTICAL) {
+          cur_obs.set_xlo(cur_obs.xMin() - layer_extension);
+          cur_obs.set_xhi(cur_obs.xMax() + layer_extension);
         }
+        obstructions.macro_rects.emplace_back(layer, cur_obs);
+        obstructions.rects.emplace_back(cur_obs, tech_layer);
       }
-    } else {
-      for (odb::dbBox* box : master->getObstructions()) {
-        int layer = box->getTechLayer()->getRoutingLevel();
-        if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
-          odb::Rect rect = box->getBox();
-          transform.apply(rect);
-
-          odb::Point lower_bound = odb::Point(rect.xMin(), rect.yMin());
-          odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
-          odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
-          if (!die_area.contains(obstruction_rect)) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            38,
-                            "Found blockage outside die area in instance {}.",
-                            inst->getConstName());
-          }
-          odb::dbTechLayer* tech_layer = box->getTechLayer();
-          applyObstructionAdjustment(obstruction_rect, tech_layer);
-          obstructions_cnt++;
+    }
+  } else {
+    for (odb::dbBox* box : master->getObstructions()) {
+      int layer = box->getTechLayer()->getRoutingLevel();
+      if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
+        odb::Rect rect = box->getBox();
+        transform.apply(rect);
+
+        odb::Point lower_bound = odb::Point(rect.xMin(), rect.yMin());
+        odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
+        odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
+        if (!die_area.contains(obstruction_rect)) {
+          obstructions.rects_outside_die++;
         }
+        odb::dbTechLayer* tech_layer = box->getTechLayer();
+        obstructions.rects.emplace_back(obstruction_rect, tech_layer);
+        obstructions.obstructions_cnt++;
       }
     }
+  }
 
-    for (odb::dbMTerm* mterm : master->getMTerms()) {
-      for (odb::dbMPin* mpin : mterm->getMPins()) {
-        odb::Point lower_bound;
-        odb::Point upper_bound;
-        odb::Rect pin_box;
-        int pin_layer;
+  for (odb::dbMTerm* mterm : master->getMTerms()) {
+    for (odb::dbMPin* mpin : mterm->getMPins()) {
+      odb::Point lower_bound;
+      odb::Point upper_bound;
+      odb::Rect pin_box;
+      int pin_layer;
 
-        for (odb::dbBox* box : mpin->getGeometry()) {
-          odb::Rect rect = box->getBox();
-          transform.apply(rect);
+      for (odb::dbBox* box : mpin->getGeometry()) {
+        odb::Rect rect = box->getBox();
+        transform.apply(rect);
 
-          odb::dbTechLayer* tech_layer = box->getTechLayer();
-          if (!tech_layer
-              || tech_layer->getType() != odb::dbTechLayerType::ROUTING) {
-            continue;
-          }
+        odb::dbTechLayer* tech_layer = box->getTechLayer();
+        if (!tech_layer
+            || tech_layer->getType() != odb::dbTechLayerType::ROUTING) {
+          continue;
+        }
 
-          pin_layer = tech_layer->getRoutingLevel();
-          if (min_routing_layer_ <= pin_layer
-              && pin_layer <= max_routing_layer_) {
-            lower_bound = odb::Point(rect.xMin(), rect.yMin());
-            upper_bound = odb::Point(rect.xMax(), rect.yMax());
-            pin_box = odb::Rect(lower_bound, upper_bound);
-            if (!die_area.contains(pin_box)
-                && !mterm->getSigType().isSupply()) {
-              logger_->warn(GRT,
-                            39,
-                            "Found pin {} outside die area in instance {}.",
-                            mterm->getConstName(),
-                            inst->getConstName());
-              pin_out_of_die_count++;
-            }
-            odb::dbTechLayer* tech_layer = box->getTechLayer();
-            applyObstructionAdjustment(pin_box, tech_layer);
+        pin_layer = tech_layer->getRoutingLevel();
+        if (min_routing_layer_ <= pin_layer
+            && pin_layer <= max_routing_layer_) {
+          lower_bound = odb::Point(rect.xMin(), rect.yMin());
+          upper_bound = odb::Point(rect.xMax(), rect.yMax());
+          pin_box = odb::Rect(lower_bound, upper_bound);
+          if (!die_area.contains(pin_box)
+              && !mterm->getSigType().isSupply()) {
+            obstructions.pins_outside_die.push_back(mterm->getConstName());
           }
+          obstructions.rects.emplace_back(pin_box, tech_layer);
         }
       }
     }
   }
-
-  if (pin_out_of_die_count > 0) {
-    if (verbose_)
-      logger_->error(
-          GRT, 28, "Found {} pins outside die area.", pin_out_of_die_count);
-  }
-
-  if (verbose_)
-    logger_->info(GRT, 3, "Macros: {}", macros_cnt);
-  return obstructions_cnt;
 }
 
 void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
 {
-  odb::dbSet<odb::dbNet> nets = block_->getNets();
+  const utl::DebugScopedTimer timer(
+      logger_, GRT, "timer", 1, "Find net obstructions: {}");
+  odb::dbSet<odb::dbNet> block_nets = block_->getNets();
 
-  if (nets.empty()) {
+  if (block_nets.empty()) {
     logger_->error(GRT, 94, "Design with no nets.");
   }
 
-  for (odb::dbNet* db_net : nets) {
-    odb::uint wire_cnt = 0, via_cnt = 0;
-    db_net->getWireCount(wire_cnt, via_cnt);
-    if (wire_cnt == 0)
-      continue;
+  const std::vector<odb::dbNet*> nets(block_nets.begin(), block_nets.end());
+  std::vector<BlockObstructions> net_obstructions(nets.size());
+#pragma omp parallel for num_threads(thread_count_) schedule(dynamic, 256)
+  for (int i = 0; i < nets.size(); i++) {
+    findNetObstructions(nets[i], die_area, net_obstructions[i]);
+  }
+
+  for (int i = 0; i < nets.size(); i++) {
+    const BlockObstructions& obstructions = net_obstructions[i];
+    if (verbose_) {
+      for (int j = 0; j < obstructions.rects_outside_die; j++) {
+        logger_->warn(GRT,
+                      41,
+                      "Net {} has wires/vias outside die area.",
+                      nets[i]->getConstName());
+      }
+    }
+    for (const auto& [rect, tech_layer] : obstructions.rects) {
+      applyObstructionAdjustment(rect, tech_layer);
+    }
+  }
+}
+
+void GlobalRouter::findNetObstructions(odb::dbNet* db_net,
+                                       const odb::Rect& die_area,
+                                       BlockObstructions& obstructions)
+{
+  odb::uint wire_cnt = 0, via_cnt = 0;
+  db_net->getWireCount(wire_cnt, via_cnt);
+  if (wire_cnt == 0)
+    return;
 
-    std::vector<odb::dbShape> via_boxes;
-    if (db_net->getSigType().isSupply()) {
-      for (odb::dbSWire* swire : db_net->getSWires()) {
-        for (odb::dbSBox* s : swire->getWires()) {
-          if (s->isVia()) {
-            s->getViaBoxes(via_boxes);
-            for (const odb::dbShape& box : via_boxes) {
-              odb::dbTechLayer* tech_layer = box.getTechLayer();
-              if (tech_layer->getRoutingLevel() == 0) {
-                continue;
-              }
-              odb::Rect via_rect = box.getBox();
-              applyNetObstruction(via_rect, tech_layer, die_area, db_net);
+  std::vector<odb::dbShape> via_boxes;
+  if (db_net->getSigType().isSupply()) {
+    for (odb::dbSWire* swire : db_net->getSWires()) {
+      for (odb::dbSBox* s : swire->getWires()) {
+        if (s->isVia()) {
+          s->getViaBoxes(via_boxes);
+          for (const odb::dbShape& box : via_boxes) {
+            odb::dbTechLayer* tech_layer = box.getTechLayer();
+            if (tech_layer->getRoutingLevel() == 0) {
+              continue;
             }
-          } else {
-            odb::Rect wire_rect = s->getBox();
-            odb::dbTechLayer* tech_layer = s->getTechLayer();
-            applyNetObstruction(wire_rect, tech_layer, die_area, db_net);
+            odb::Rect via_rect = box.getBox();
+            addNetObstruction(via_rect, tech_layer, die_area, obstructions);
           }
+        } else {
+          odb::Rect wire_rect = s->getBox();
+          odb::dbTechLayer* tech_layer = s->getTechLayer();
+          addNetObstruction(wire_rect, tech_layer, die_area, obstructions);
         }
       }
-    } else {
-      odb::dbWirePath path;
-      odb::dbWirePathShape pshape;
-      odb::dbWire* wire = db_net->getWire();
-
-      odb::dbWirePathItr pitr;
-      for (pitr.begin(wire); pitr.getNextPath(path);) {
-        while (pitr.getNextShape(pshape)) {
-          const odb::dbShape& shape = pshape.shape;
-          if (shape.isVia()) {
-            odb::dbShape::getViaBoxes(shape, via_boxes);
-            for (const odb::dbShape& box : via_boxes) {
-              odb::dbTechLayer* tech_layer = box.getTechLayer();
-              if (tech_layer->getRoutingLevel() == 0) {
-                continue;
-              }
-              odb::Rect via_rect = box.getBox();
-              applyNetObstruction(via_rect, tech_layer, die_area, db_net);
+    }
+  } else {
+    odb::dbWirePath path;
+    odb::dbWirePathShape pshape;
+    odb::dbWire* wire = db_net->getWire();
+
+    odb::dbWirePathItr pitr;
+    for (pitr.begin(wire); pitr.getNextPath(path);) {
+      while (pitr.getNextShape(pshape)) {
+        const odb::dbShape& shape = pshape.shape;
+        if (shape.isVia()) {
+          odb::dbShape::getViaBoxes(shape, via_boxes);
+          for (const odb::dbShape& box : via_boxes) {
+            odb::dbTechLayer* tech_layer = box.getTechLayer();
+            if (tech_layer->getRoutingLevel() == 0) {
+              continue;
             }
-          } else {
-            odb::Rect wire_rect = shape.getBox();
-            odb::dbTechLayer* tech_layer = shape.getTechLayer();
-
-            applyNetObstruction(wire_rect, tech_layer, die_area, db_net);
+            odb::Rect via_rect = box.getBox();
+            addNetObstruction(via_rect, tech_layer, die_area, obstructions);
           }
+        } else {
+          odb::Rect wire_rect = shape.getBox();
+          odb::dbTechLayer* tech_layer = shape.getTechLayer();
+
+          addNetObstruction(wire_rect, tech_layer, die_area, obstructions);
         }
       }
     }
   }
 }
 
-void GlobalRouter::applyNetObstruction(const odb::Rect& rect,
-                                       odb::dbTechLayer* tech_layer,
-                                       const odb::Rect& die_area,
-                                       odb::dbNet* db_net)
+void GlobalRouter::addNetObstruction(const odb::Rect& rect,
+                                     odb::dbTechLayer* tech_layer,
+                                     const odb::Rect& die_area,
+                                     BlockObstructions& obstructions)
 {
   int l = tech_layer->getRoutingLevel();
 
@@ -3734,14 +4200,9 @@ void GlobalRouter::applyNetObstruction(const odb::Rect& rect,
     odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
     odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
     if (!die_area.contains(obstruction_rect)) {
-      if (verbose_) {
-        logger_->warn(GRT,
-                      41,
-                      "Net {} has wires/vias outside die area.",
-                      db_net->getConstName());
-      }
+      obstructions.rects_outside_die++;
     }
-    applyObstructionAdjustment(obstruction_rect, tech_layer);
+    obstructions.rects.emplace_back(obstruction_rect, tech_layer);
   }
 }
 
@@ -4285,6 +4746,38 @@ void GlobalRouter::addDirtyNet(odb::dbNet* net)
   dirty_nets_.insert(net);
 }
 
+// Sets up FastRoute for an incremental reroute and restores its settings
+// when it goes out of scope, also when the reroute fails with GRT 232.
+class IncrementalRouteScope
+{
+ public:
+  IncrementalRouteScope(FastRouteCore* fastroute,
+                        int margin,
+                        int congestion_report_iter_step)
+      : fastroute_(fastroute),
+        critical_nets_percentage_(fastroute->getCriticalNetsPercentage()),
+        congestion_report_iter_step_(congestion_report_iter_step)
+  {
+    fastroute_->setCriticalNetsPercentage(0);
+    fastroute_->setCongestionReportIterStep(0);
+    // reroute only around the dirty nets, keeping the usage of the rest
+    fastroute_->setIncrementalMargin(margin);
+    fastroute_->setIncremental(true);
+  }
+
+  ~IncrementalRouteScope()
+  {
+    fastroute_->setCriticalNetsPercentage(critical_nets_percentage_);
+    fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
+    fastroute_->setIncremental(false);
+  }
+
+ private:
+  FastRouteCore* fastroute_;
+  const float critical_nets_percentage_;
+  const int congestion_report_iter_step_;
+};
+
 std::vector<Net*> GlobalRouter::updateDirtyRoutes(bool save_guides)
 {
   std::vector<Net*> dirty_nets;
@@ -4304,10 +4797,8 @@ std::vector<Net*> GlobalRouter::updateDirtyRoutes(bool save_guides)
       return dirty_nets;
     }
 
-    const float old_critical_nets_percentage
-        = fastroute_->getCriticalNetsPercentage();
-    fastroute_->setCriticalNetsPercentage(0);
-    fastroute_->setCongestionReportIterStep(0);
+    IncrementalRouteScope incremental_scope(
+        fastroute_, incremental_margin_, congestion_report_iter_step_);
 
     initFastRouteIncr(dirty_nets);
 
@@ -4359,8 +4850,8 @@ std::vector<Net*> GlobalRouter::updateDirtyRoutes(bool save_guides)
                        "heatmap in the GUI.");
       }
     }
-    fastroute_->setCriticalNetsPercentage(old_critical_nets_percentage);
-    fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
+    // only the gcells under the ripped-up and rerouted nets are rewritten
+    updateDbCongestion();
     if (save_guides) {
       saveGuides();
     }
@@ -36,6 +36,7 @@
 
 %{
 #include "grt/GlobalRouter.h"
+#include "grt/Rudy.h"
 #include "GrouteRenderer.h"
 #include "FastRouteRenderer.h"
 #include "ord/OpenRoad.hh"
@@ -77,6 +78,12 @@ have_detailed_routes()
   return getGlobalRouter()->haveDetailedRoutes();
 }
 
+int
+total_overflow()
+{
+  return getGlobalRouter()->getTotalOverflow();
+}
+
 void
 set_capacity_adjustment(float adjustment)
 {
@@ -142,6 +149,24 @@ set_grid_origin(int x, int y)
   getGlobalRouter()->setGridOrigin(x, y);
 }
 
+void
+set_maze_thread_count(int threads)
+{
+  getGlobalRouter()->setMazeThreadCount(threads);
+}
+
+void
+set_thread_count(int threads)
+{
+  getGlobalRouter()->setThreadCount(threads);
+}
+
+void
+set_incremental_margin(int margin)
+{
+  getGlobalRouter()->setIncrementalMargin(margin);
+}
+
 void
 set_allow_congestion(bool allowCongestion)
 {
@@ -303,6 +328,41 @@ void read_segments(const char* file_name)
   getGlobalRouter()->readSegments(file_name);
 }
 
+void write_snapshot(const char* file_name)
+{
+  getGlobalRouter()->writeSnapshot(file_name);
+}
+
+void read_snapshot(const char* file_name)
+{
+  getGlobalRouter()->readSnapshot(file_name);
+}
+
+void calculate_rudy()
+{
+  getGlobalRouter()->getRudy()->calculateRudy();
+}
+
+void update_rudy()
+{
+  getGlobalRouter()->getRudy()->updateRudy();
+}
+
+int rudy_tile_count_x()
+{
+  return getGlobalRouter()->getRudy()->getGridSize().first;
+}
+
+int rudy_tile_count_y()
+{
+  return getGlobalRouter()->getRudy()->getGridSize().second;
+}
+
+float rudy_tile(int x, int y)
+{
+  return getGlobalRouter()->getRudy()->getTile(x, y).getRudy();
+}
+
 } // namespace
 
 %} // inline
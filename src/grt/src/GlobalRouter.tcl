@@ -199,6 +199,9 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-allow_overflow] \
                                   [-overflow_iterations iterations] \
                                   [-verbose] \
+                                  [-parallel_maze] \
+                                  [-threads threads] \
+                                  [-incremental_margin gcells] \
                                   [-start_incremental] \
                                   [-end_incremental]
 }
@@ -206,9 +209,11 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
 proc global_route { args } {
   sta::parse_key_args "global_route" args \
     keys {-guide_file -congestion_iterations -congestion_report_file \
-          -overflow_iterations -grid_origin -critical_nets_percentage -congestion_report_iter_step
+          -overflow_iterations -grid_origin -critical_nets_percentage -congestion_report_iter_step \
+          -threads -incremental_margin
          } \
-    flags {-allow_congestion -allow_overflow -verbose -start_incremental -end_incremental}
+    flags {-allow_congestion -allow_overflow -verbose -parallel_maze \
+           -start_incremental -end_incremental}
 
   sta::check_argc_eq0 "global_route" $args
 
@@ -221,6 +226,33 @@ proc global_route { args } {
   }
 
   grt::set_verbose [info exists flags(-verbose)]
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+    if { $threads < 1 } {
+      utl::error GRT 277 "-threads must be at least 1."
+    }
+  } else {
+    set threads [ord::thread_count]
+  }
+  grt::set_thread_count $threads
+
+  if { [info exists keys(-incremental_margin)] } {
+    set margin $keys(-incremental_margin)
+    sta::check_positive_integer "-incremental_margin" $margin
+    if { $margin < 20 } {
+      utl::error GRT 279 "-incremental_margin must be at least 20."
+    }
+    grt::set_incremental_margin $margin
+  } else {
+    grt::set_incremental_margin 40
+  }
+
+  if { [info exists flags(-parallel_maze)] } {
+    grt::set_maze_thread_count $threads
+  } else {
+    grt::set_maze_thread_count 0
+  }
 
   if { [info exists keys(-grid_origin)] } {
     set origin $keys(-grid_origin)
@@ -422,6 +454,28 @@ proc read_global_route_segments { args } {
   grt::read_segments $file_name
 }
 
+sta::define_cmd_args "write_global_route_snapshot" { file_name }
+
+proc write_global_route_snapshot { args } {
+  sta::parse_key_args "write_global_route_snapshot" args \
+    keys {} \
+    flags {}
+  sta::check_argc_eq1 "write_global_route_snapshot" $args
+  set file_name $args
+  grt::write_snapshot $file_name
+}
+
+sta::define_cmd_args "read_global_route_snapshot" { file_name }
+
+proc read_global_route_snapshot { args } {
+  sta::parse_key_args "read_global_route_snapshot" args \
+    keys {} \
+    flags {}
+  sta::check_argc_eq1 "read_global_route_snapshot" $args
+  set file_name $args
+  grt::read_snapshot $file_name
+}
+
 sta::define_cmd_args "global_route_debug" {
   [-st]       # Show the Steiner Tree generated by stt
   [-rst]      # Show the Rectilinear Steiner Tree generated by FastRoute
@@ -32,6 +32,8 @@
 
 #include "grt/Rudy.h"
 
+#include <omp.h>
+
 #include "grt/GRoute.h"
 #include "grt/GlobalRouter.h"
 #include "odb/dbShape.h"
@@ -113,12 +115,17 @@ void Rudy::makeGrid()
   }
 }
 
-void Rudy::getResourceReductions()
+// Adds the capacity reduction of every tile, or only of the tiles marked in
+// dirty_tiles when it is given.
+void Rudy::getResourceReductions(const std::vector<char>* dirty_tiles)
 {
   CapacityReductionData cap_usage_data;
   grouter_->getCapacityReductionData(cap_usage_data);
   for (int x = 0; x < grid_.size(); x++) {
     for (int y = 0; y < grid_[x].size(); y++) {
+      if (dirty_tiles != nullptr && !(*dirty_tiles)[x * tile_cnt_y_ + y]) {
+        continue;
+      }
       Tile& tile = getEditableTile(x, y);
       uint8_t tile_cap = cap_usage_data[x][y].capacity;
       float tile_reduction = cap_usage_data[x][y].reduction;
@@ -139,16 +146,182 @@ void Rudy::calculateRudy()
 
   getResourceReductions();
 
+  std::vector<odb::dbNet*> nets;
+  std::vector<odb::Rect> net_rects;
+  findNetRects(nets, net_rects);
+
   // refer: https://ieeexplore.ieee.org/document/4211973
+  // Each thread owns a band of tile columns and adds every net to it in
+  // block order, so the sum of each tile is the same as in a serial walk.
+#pragma omp parallel num_threads(num_threads_)
+  {
+    const int num_bands = omp_get_num_threads();
+    const int band = omp_get_thread_num();
+    const int first_x_index = tile_cnt_x_ * band / num_bands;
+    const int last_x_index = tile_cnt_x_ * (band + 1) / num_bands - 1;
+    for (const odb::Rect& net_rect : net_rects) {
+      processIntersectionSignalNet(net_rect, first_x_index, last_x_index);
+    }
+  }
+
+  net_rects_.clear();
+  for (int i = 0; i < nets.size(); i++) {
+    net_rects_[nets[i]] = net_rects[i];
+  }
+}
+
+void Rudy::updateRudy()
+{
+  if (net_rects_.empty()) {
+    calculateRudy();
+    return;
+  }
+
+  std::vector<odb::dbNet*> nets;
+  std::vector<odb::Rect> net_rects;
+  findNetRects(nets, net_rects);
+
+  // boxes to remove from and to add to the tiles
+  std::vector<odb::Rect> removed_rects;
+  std::vector<odb::Rect> added_rects;
+  std::map<odb::dbNet*, odb::Rect> old_net_rects = std::move(net_rects_);
+  net_rects_.clear();
+  for (int i = 0; i < nets.size(); i++) {
+    net_rects_[nets[i]] = net_rects[i];
+    auto old_rect = old_net_rects.find(nets[i]);
+    if (old_rect == old_net_rects.end()) {
+      added_rects.push_back(net_rects[i]);
+    } else {
+      if (old_rect->second != net_rects[i]) {
+        removed_rects.push_back(old_rect->second);
+        added_rects.push_back(net_rects[i]);
+      }
+      old_net_rects.erase(old_rect);
+    }
+  }
+  for (const auto& [net, rect] : old_net_rects) {
+    removed_rects.push_back(rect);
+  }
+
+  // a full computation is cheaper when most nets moved
+  if (removed_rects.size() + added_rects.size() > nets.size()) {
+    calculateRudy();
+    return;
+  }
+
+  // Recompute from scratch only the tiles covered by a changed box.  They
+  // are cleared and get their reduction and every net added in the same
+  // order as in calculateRudy, so the result is the same as a full
+  // computation instead of drifting with each subtraction.
+  std::vector<char> dirty_tiles(tile_cnt_x_ * tile_cnt_y_, 0);
+  int num_dirty_tiles = 0;
+  for (const auto* rects : {&removed_rects, &added_rects}) {
+    for (const odb::Rect& rect : *rects) {
+      int min_x, max_x, min_y, max_y;
+      getTileRange(rect, min_x, max_x, min_y, max_y);
+      for (int x = min_x; x <= max_x; x++) {
+        for (int y = min_y; y <= max_y; y++) {
+          char& dirty = dirty_tiles[x * tile_cnt_y_ + y];
+          num_dirty_tiles += !dirty;
+          dirty = 1;
+        }
+      }
+    }
+  }
+  if (num_dirty_tiles == 0) {
+    return;
+  }
+  if (num_dirty_tiles > tile_cnt_x_ * tile_cnt_y_ / 2) {
+    calculateRudy();
+    return;
+  }
+
+  // dirty_sum[(x + 1) * (tile_cnt_y_ + 1) + y + 1] is the number of dirty
+  // tiles in [0, x] x [0, y], to skip the nets that touch none of them.
+  const int sum_cnt_y = tile_cnt_y_ + 1;
+  std::vector<int> dirty_sum((tile_cnt_x_ + 1) * sum_cnt_y, 0);
+  for (int x = 0; x < tile_cnt_x_; x++) {
+    for (int y = 0; y < tile_cnt_y_; y++) {
+      dirty_sum[(x + 1) * sum_cnt_y + y + 1]
+          = dirty_tiles[x * tile_cnt_y_ + y] + dirty_sum[x * sum_cnt_y + y + 1]
+            + dirty_sum[(x + 1) * sum_cnt_y + y] - dirty_sum[x * sum_cnt_y + y];
+    }
+  }
+
+  for (int x = 0; x < tile_cnt_x_; x++) {
+    for (int y = 0; y < tile_cnt_y_; y++) {
+      if (dirty_tiles[x * tile_cnt_y_ + y]) {
+        getEditableTile(x, y).clearRudy();
+      }
+    }
+  }
+  getResourceReductions(&dirty_tiles);
+
+#pragma omp parallel num_threads(num_threads_)
+  {
+    const int num_bands = omp_get_num_threads();
+    const int band = omp_get_thread_num();
+    const int first_x_index = tile_cnt_x_ * band / num_bands;
+    const int last_x_index = tile_cnt_x_ * (band + 1) / num_bands - 1;
+    for (const odb::Rect& net_rect : net_rects) {
+      int min_x, max_x, min_y, max_y;
+      getTileRange(net_rect, min_x, max_x, min_y, max_y);
+      min_x = std::max(min_x, first_x_index);
+      max_x = std::min(max_x, last_x_index);
+      if (min_x > max_x || min_y > max_y) {
+        continue;
+      }
+      const int num_dirty = dirty_sum[(max_x + 1) * sum_cnt_y + max_y + 1]
+                            - dirty_sum[min_x * sum_cnt_y + max_y + 1]
+                            - dirty_sum[(max_x + 1) * sum_cnt_y + min_y]
+                            + dirty_sum[min_x * sum_cnt_y + min_y];
+      if (num_dirty != 0) {
+        processIntersectionSignalNet(
+            net_rect, first_x_index, last_x_index, &dirty_tiles);
+      }
+    }
+  }
+}
+
+void Rudy::findNetRects(std::vector<odb::dbNet*>& nets,
+                        std::vector<odb::Rect>& net_rects)
+{
   for (auto net : block_->getNets()) {
     if (!net->getSigType().isSupply()) {
-      const auto net_rect = net->getTermBBox();
-      processIntersectionSignalNet(net_rect);
+      nets.push_back(net);
     }
   }
+
+  net_rects.resize(nets.size());
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 256)
+  for (int i = 0; i < nets.size(); i++) {
+    net_rects[i] = nets[i]->getTermBBox();
+  }
 }
 
-void Rudy::processIntersectionSignalNet(const odb::Rect net_rect)
+// Returns the index range of the tiles that net_rect may overlap.
+void Rudy::getTileRange(const odb::Rect& net_rect,
+                        int& min_x_index,
+                        int& max_x_index,
+                        int& min_y_index,
+                        int& max_y_index) const
+{
+  min_x_index
+      = std::max(0, (net_rect.xMin() - grid_block_.xMin()) / tile_size_);
+  max_x_index = std::min(tile_cnt_x_ - 1,
+                         (net_rect.xMax() - grid_block_.xMin()) / tile_size_);
+  min_y_index
+      = std::max(0, (net_rect.yMin() - grid_block_.yMin()) / tile_size_);
+  max_y_index = std::min(tile_cnt_y_ - 1,
+                         (net_rect.yMax() - grid_block_.yMin()) / tile_size_);
+}
+
+// Adds the RUDY of a net to the tiles of the columns first_x_index to
+// last_x_index, or only to the tiles marked in dirty_tiles when it is given.
+void Rudy::processIntersectionSignalNet(const odb::Rect net_rect,
+                                        const int first_x_index,
+                                        const int last_x_index,
+                                        const std::vector<char>* dirty_tiles)
 {
   const auto net_area = net_rect.area();
   if (net_area == 0) {
@@ -160,18 +333,17 @@ void Rudy::processIntersectionSignalNet(const odb::Rect net_rect)
   const auto net_congestion = wire_area / net_area;
 
   // Calculate the intersection range
-  const int min_x_index
-      = std::max(0, (net_rect.xMin() - grid_block_.xMin()) / tile_size_);
-  const int max_x_index = std::min(
-      tile_cnt_x_ - 1, (net_rect.xMax() - grid_block_.xMin()) / tile_size_);
-  const int min_y_index
-      = std::max(0, (net_rect.yMin() - grid_block_.yMin()) / tile_size_);
-  const int max_y_index = std::min(
-      tile_cnt_y_ - 1, (net_rect.yMax() - grid_block_.yMin()) / tile_size_);
+  int min_x_index, max_x_index, min_y_index, max_y_index;
+  getTileRange(net_rect, min_x_index, max_x_index, min_y_index, max_y_index);
+  min_x_index = std::max(min_x_index, first_x_index);
+  max_x_index = std::min(max_x_index, last_x_index);
 
   // Iterate over the tiles in the calculated range
   for (int x = min_x_index; x <= max_x_index; ++x) {
     for (int y = min_y_index; y <= max_y_index; ++y) {
+      if (dirty_tiles != nullptr && !(*dirty_tiles)[x * tile_cnt_y_ + y]) {
+        continue;
+      }
       Tile& tile = getEditableTile(x, y);
       const auto tile_box = tile.getRect();
       if (net_rect.overlaps(tile_box)) {
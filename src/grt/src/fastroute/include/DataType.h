@@ -135,25 +135,106 @@ struct FrNet  // A Net is a set of connected MazePoints
   std::unique_ptr<std::vector<int>> edge_cost_per_layer_;
 };
 
-struct Edge  // An Edge is the routing track holder between two adjacent
-             // MazePoints
+// The routing track holders between two adjacent MazePoints of one direction
+// of the 2D grid. The way it is indexed is (Y, X). Each field is kept in its
+// own array so that a routing stage only streams the fields it uses.
+class EdgeGrid
 {
-  int16_t congCNT;
-  uint16_t cap;    // the capacity of the edge
-  uint16_t usage;  // the usage of the edge
-  uint16_t red;
-  int16_t last_usage;
-  float est_usage;  // the estimated usage of the edge
-
-  uint16_t usage_red() const { return usage + red; }
-  float est_usage_red() const { return est_usage + red; }
+ public:
+  void resize(int y_size, int x_size)
+  {
+    x_size_ = x_size;
+    const size_t size = static_cast<size_t>(y_size) * x_size;
+    cong_cnt_.assign(size, 0);
+    cap_.assign(size, 0);
+    usage_.assign(size, 0);
+    red_.assign(size, 0);
+    last_usage_.assign(size, 0);
+    est_usage_.assign(size, 0);
+  }
+
+  int16_t& congCNT(int y, int x) { return cong_cnt_[index(y, x)]; }
+  // the capacity of the edge
+  uint16_t& cap(int y, int x) { return cap_[index(y, x)]; }
+  // the usage of the edge
+  uint16_t& usage(int y, int x) { return usage_[index(y, x)]; }
+  uint16_t& red(int y, int x) { return red_[index(y, x)]; }
+  int16_t& last_usage(int y, int x) { return last_usage_[index(y, x)]; }
+  // the estimated usage of the edge
+  float& est_usage(int y, int x) { return est_usage_[index(y, x)]; }
+
+  int16_t congCNT(int y, int x) const { return cong_cnt_[index(y, x)]; }
+  uint16_t cap(int y, int x) const { return cap_[index(y, x)]; }
+  uint16_t usage(int y, int x) const { return usage_[index(y, x)]; }
+  uint16_t red(int y, int x) const { return red_[index(y, x)]; }
+  int16_t last_usage(int y, int x) const { return last_usage_[index(y, x)]; }
+  float est_usage(int y, int x) const { return est_usage_[index(y, x)]; }
+
+  uint16_t usage_red(int y, int x) const
+  {
+    const size_t idx = index(y, x);
+    return usage_[idx] + red_[idx];
+  }
+  float est_usage_red(int y, int x) const
+  {
+    const size_t idx = index(y, x);
+    return est_usage_[idx] + red_[idx];
+  }
+
+ private:
+  size_t index(int y, int x) const
+  {
+    return static_cast<size_t>(y) * x_size_ + x;
+  }
+
+  int x_size_ = 0;
+  std::vector<int16_t> cong_cnt_;
+  std::vector<uint16_t> cap_;
+  std::vector<uint16_t> usage_;
+  std::vector<uint16_t> red_;
+  std::vector<int16_t> last_usage_;
+  std::vector<float> est_usage_;
 };
 
-struct Edge3D
+// The routing track holders of one direction of the 3D grid, indexed by
+// (Layer, Y, X). Like EdgeGrid, every field has its own array, and each
+// layer is a contiguous block of it.
+class EdgeGrid3D
 {
-  uint16_t cap;    // the capacity of the edge
-  uint16_t usage;  // the usage of the edge
-  uint16_t red;    // the reduction of capacity of the edge
+ public:
+  void resize(int num_layers, int y_size, int x_size)
+  {
+    y_size_ = y_size;
+    x_size_ = x_size;
+    const size_t size = static_cast<size_t>(num_layers) * y_size * x_size;
+    cap_.assign(size, 0);
+    usage_.assign(size, 0);
+    red_.assign(size, 0);
+  }
+  bool empty() const { return cap_.empty(); }
+
+  // the capacity of the edge
+  uint16_t& cap(int l, int y, int x) { return cap_[index(l, y, x)]; }
+  // the usage of the edge
+  uint16_t& usage(int l, int y, int x) { return usage_[index(l, y, x)]; }
+  // the reduction of capacity of the edge
+  uint16_t& red(int l, int y, int x) { return red_[index(l, y, x)]; }
+
+  uint16_t cap(int l, int y, int x) const { return cap_[index(l, y, x)]; }
+  uint16_t usage(int l, int y, int x) const { return usage_[index(l, y, x)]; }
+  uint16_t red(int l, int y, int x) const { return red_[index(l, y, x)]; }
+
+ private:
+  size_t index(int l, int y, int x) const
+  {
+    return (static_cast<size_t>(l) * y_size_ + y) * x_size_ + x;
+  }
+
+  int y_size_ = 0;
+  int x_size_ = 0;
+  std::vector<uint16_t> cap_;
+  std::vector<uint16_t> usage_;
+  std::vector<uint16_t> red_;
 };
 
 struct TreeNode
@@ -40,6 +40,7 @@
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_set.hpp>
 #include <boost/multi_array.hpp>
+#include <functional>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -93,6 +94,118 @@ struct DebugSetting
 
 using stt::Tree;
 
+// Scratch state of the 2D maze search.  Each thread routing nets in
+// mazeRouteMSMD owns one.
+struct MazeSearchSpace
+{
+  void resize(int x_range,
+              int y_range,
+              int x_grid,
+              int y_grid,
+              float unreached);
+  // restore d1/d2/hyper_* on the grids reached by the last search
+  void resetTouched(float unreached);
+
+  multi_array<float, 2> d1;
+  multi_array<float, 2> d2;
+  multi_array<int, 2> corr_edge;
+  multi_array<short, 2> parent_x1;
+  multi_array<short, 2> parent_y1;
+  multi_array<short, 2> parent_x3;
+  multi_array<short, 2> parent_y3;
+  multi_array<bool, 2> hv;
+  multi_array<bool, 2> hyper_v;
+  multi_array<bool, 2> hyper_h;
+  multi_array<bool, 2> in_region;
+  std::vector<float*> src_heap;
+  std::vector<float*> dest_heap;
+  std::vector<bool> pop_heap2;
+  // slot of each d1 grid in src_heap, -1 when not in the heap
+  std::vector<int> heap_pos;
+  // flat indices of the d1/d2 grids written by the current search
+  std::vector<int> touched;
+  std::vector<OrderNetEdge> net_eo;
+  // search statistics reported with the maze_stats debug group
+  int64 num_searches = 0;
+  int64 num_touched = 0;
+  // edges whose usage changed, merged into h/v_used_ggrid_
+  std::vector<std::pair<int, int>> h_used_ggrid;
+  std::vector<std::pair<int, int>> v_used_ggrid;
+};
+
+// Scratch state of the L, Z, spiral and monotonic pattern routing of one
+// net.  The parallel pattern routing gives one to each thread.
+struct PatternRouteSpace
+{
+  void resize(int x_range, int y_range);
+
+  std::vector<float> cost_hvh;       // Horizontal first Z
+  std::vector<float> cost_vhv;       // Vertical first Z
+  std::vector<float> cost_h;         // Horizontal segment cost
+  std::vector<float> cost_v;         // Vertical segment cost
+  std::vector<float> cost_lr;        // Left and right boundary cost
+  std::vector<float> cost_tb;        // Top and bottom boundary cost
+  std::vector<float> cost_hvh_test;  // Vertical first Z
+  std::vector<float> cost_v_test;    // Vertical segment cost
+  std::vector<float> cost_tb_test;   // Top and bottom boundary cost
+  // cost grids of the monotonic routing
+  multi_array<float, 2> d1;
+  multi_array<float, 2> d2;
+  // edges whose usage changed, merged into h/v_used_ggrid_
+  std::vector<std::pair<int, int>> h_used_ggrid;
+  std::vector<std::pair<int, int>> v_used_ggrid;
+};
+
+// FLUTE tree of a net and the pin positions (in gcells) and vertical
+// coefficient it was built for.  fluteNormal also keeps the sorted pins
+// of nets with more than 3 pins for fluteCongest.
+struct RsmtCacheEntry
+{
+  std::vector<int> x;
+  std::vector<int> y;
+  float coeffV = 0;
+  Tree tree;
+  std::vector<int> gxs;
+  std::vector<int> gys;
+  std::vector<int> gs;
+};
+
+struct parent3D
+{
+  short l;
+  int x, y;
+};
+
+// Scratch state of the 3D maze search, kept across calls so the grids are
+// allocated once per routing grid instead of once per process.
+struct MazeSearchSpace3D
+{
+  void resize(int num_layers,
+              int x_range,
+              int y_range,
+              int x_grid,
+              int y_grid,
+              int unreached);
+  // restore d1/d2 on the grids reached by the last search
+  void resetTouched(int unreached);
+
+  multi_array<int, 3> d1;
+  multi_array<int, 3> d2;
+  multi_array<Direction, 3> directions;
+  multi_array<int, 3> corr_edge;
+  multi_array<parent3D, 3> parent;
+  std::vector<int*> src_heap;
+  std::vector<int*> dest_heap;
+  std::vector<bool> pop_heap2;
+  // slot of each d1 grid in src_heap, -1 when not in the heap
+  std::vector<int> heap_pos;
+  // flat indices of the d1/d2 grids written by the current search
+  std::vector<int> touched;
+  // search statistics reported with the maze_stats debug group
+  int64 num_searches = 0;
+  int64 num_touched = 0;
+};
+
 class FastRouteCore
 {
  public:
@@ -169,8 +282,8 @@ class FastRouteCore
   const std::vector<short>& getVerticalCapacities() { return v_capacity_3D_; }
   const std::vector<short>& getHorizontalCapacities() { return h_capacity_3D_; }
   int getEdgeCapacity(int x1, int y1, int x2, int y2, int layer);
-  const multi_array<Edge3D, 3>& getHorizontalEdges3D() { return h_edges_3D_; }
-  const multi_array<Edge3D, 3>& getVerticalEdges3D() { return v_edges_3D_; }
+  const EdgeGrid3D& getHorizontalEdges3D() { return h_edges_3D_; }
+  const EdgeGrid3D& getVerticalEdges3D() { return v_edges_3D_; }
   void setLastColVCapacity(short cap, int layer)
   {
     last_col_v_capacity_3D_[layer] = cap;
@@ -193,6 +306,10 @@ class FastRouteCore
   void setMaxNetDegree(int);
   void setVerbose(bool v);
   void setCriticalNetsPercentage(float u);
+  void setMazeThreadCount(int threads);
+  void setThreadCount(int threads);
+  void setIncremental(bool incremental);
+  void setIncrementalMargin(int margin);
   float getCriticalNetsPercentage() { return critical_nets_percentage_; };
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
   void setOverflowIterations(int iterations);
@@ -240,6 +357,8 @@ class FastRouteCore
   void getNetId(odb::dbNet* db_net, int& net_id, bool& exists);
   void clearNetRoute(const int netID);
   void clearNets();
+  void computeRouteRegion();
+  void addCongestionDirtyRoutes(int netID);
   double dbuToMicrons(int dbu);
   odb::Rect globalRoutingToBox(const GSegment& route);
   NetRouteMap getRoutes();
@@ -259,6 +378,38 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  void mazeRouteMSMDParallel(const std::vector<int>& net_order,
+                             const int iter,
+                             const int expand,
+                             const float cost_height,
+                             const int ripup_threshold,
+                             const int maze_edge_threshold,
+                             const int cost_type,
+                             const float logis_cof,
+                             const int via,
+                             const int slope,
+                             const int L,
+                             const float slack_th);
+  bool mazeRouteNet(MazeSearchSpace& space,
+                    const int netID,
+                    const int iter,
+                    const int expand,
+                    const float cost_height,
+                    const int ripup_threshold,
+                    const int maze_edge_threshold,
+                    const int cost_type,
+                    const float logis_cof,
+                    const int via,
+                    const int slope,
+                    const int L,
+                    const float slack_th,
+                    const odb::Rect& bounds,
+                    int& last_enlarge);
+  void mergeUsedGrids(MazeSearchSpace& space);
+  void mergeUsedGrids(PatternRouteSpace& space);
+  odb::Rect netRouteBox(int netID, int expand, const odb::Rect& bounds) const;
+  std::vector<std::vector<int>> batchByRegion(
+      const std::vector<odb::Rect>& boxes) const;
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -293,12 +444,9 @@ class FastRouteCore
                    std::vector<short>& new_route_x,
                    std::vector<short>& new_route_y);
   void convertToMazerouteNet(const int netID);
-  void setupHeap(const int netID,
+  void setupHeap(MazeSearchSpace& space,
+                 const int netID,
                  const int edgeID,
-                 std::vector<float*>& src_heap,
-                 std::vector<float*>& dest_heap,
-                 multi_array<float, 2>& d1,
-                 multi_array<float, 2>& d2,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -405,6 +553,21 @@ class FastRouteCore
                    const int acc,
                    const float coeffV,
                    Tree& t);
+  void fluteNormalCached(const int netID,
+                         const int acc,
+                         const float coeffV,
+                         Tree& t);
+  void genNetRSMT(PatternRouteSpace& space,
+                  const int netID,
+                  const bool congestionDriven,
+                  const bool reRoute,
+                  const bool genTree,
+                  const bool newType,
+                  const bool noADJ,
+                  int& wl,
+                  int& wl1,
+                  int& num_segs,
+                  int& num_shifts);
   void fluteCongest(const int netID,
                     const std::vector<int>& x,
                     const std::vector<int>& y,
@@ -421,9 +584,16 @@ class FastRouteCore
   void routeSegL(Segment* seg);
   void routeLAll(bool firstTime);
   // new functions for tree data structure
-  void newrouteL(int netID, RouteType ripuptype, bool viaGuided);
-  void newrouteZ(int netID, int threshold);
-  void newrouteZ_edge(int netID, int edgeID);
+  void newrouteL(PatternRouteSpace& space,
+                 int netID,
+                 RouteType ripuptype,
+                 bool viaGuided);
+  void newrouteZ(PatternRouteSpace& space, int netID, int threshold);
+  void newrouteZ_edge(PatternRouteSpace& space, int netID, int edgeID);
+  void patternRouteNets(
+      int expand,
+      const std::function<void(PatternRouteSpace&, int)>& route_net,
+      bool independent = false);
   void newrouteLAll(bool firstTime, bool viaGuided);
   void newrouteZAll(int threshold);
   void routeMonotonicAll(int threshold, int expand, float logis_cof);
@@ -433,11 +603,11 @@ class FastRouteCore
   void routeSegV(Segment* seg);
   void routeSegH(Segment* seg);
   void routeSegLFirstTime(Segment* seg);
-  void spiralRoute(int netID, int edgeID);
-  void routeMonotonic(int netID,
+  void spiralRoute(PatternRouteSpace& space, int netID, int edgeID);
+  void spiralRouteNet(PatternRouteSpace& space, int netID);
+  void routeMonotonic(PatternRouteSpace& space,
+                      int netID,
                       int edgeID,
-                      multi_array<float, 2>& d1,
-                      multi_array<float, 2>& d2,
                       int threshold,
                       int enlarge);
 
@@ -489,7 +659,7 @@ class FastRouteCore
                         int16_t& top_pin_l);
   int threeDVIA();
   void fixEdgeAssignment(int& net_layer,
-                         multi_array<Edge3D, 3>& edges_3D,
+                         const EdgeGrid3D& edges_3D,
                          int x,
                          int y,
                          int k,
@@ -500,13 +670,14 @@ class FastRouteCore
   void assignEdge(int netID, int edgeID, bool processDIR);
   void recoverEdge(int netID, int edgeID);
   void layerAssignmentV4();
+  void assignNetLayers(int netID);
   void netpinOrderInc();
   void checkRoute3D();
   void StNetOrder();
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -566,6 +737,25 @@ class FastRouteCore
   int grid_hv_;
   bool verbose_;
   float critical_nets_percentage_;
+  int maze_thread_count_;
+  // threads for the phases whose result does not depend on it
+  int thread_count_;
+  // Incremental runs only reroute the nets in net_ids_ and keep the grid
+  // passes and the 2D maze search inside route_region_ (grid coordinates).
+  bool incremental_;
+  odb::Rect route_region_;
+  // route_region_ is the pins' bounding box of the rerouted nets enlarged by
+  // this many gcells.  The monotonic pattern routes reach up to 20 gcells
+  // past the pins (enlarge 10, 15, 20), so at least that much keeps all the
+  // estimated usage of a run inside the region; the rest bounds how far the
+  // 2D maze search can detour around congestion.
+  int incremental_margin_;
+  // Grids whose usage changed since the dbGCellGrid was last written.  While
+  // db_congestion_valid_ is set only they are written by updateDbCongestion.
+  odb::Rect db_congestion_dirty_;
+  bool db_congestion_valid_;
+  int db_congestion_min_layer_;
+  int db_congestion_max_layer_;
   int via_cost_;
   int mazeedge_threshold_;
   float v_capacity_lb_;
@@ -577,15 +767,6 @@ class FastRouteCore
   std::vector<short> h_capacity_3D_;
   std::vector<short> last_col_v_capacity_3D_;
   std::vector<short> last_row_h_capacity_3D_;
-  std::vector<float> cost_hvh_;       // Horizontal first Z
-  std::vector<float> cost_vhv_;       // Vertical first Z
-  std::vector<float> cost_h_;         // Horizontal segment cost
-  std::vector<float> cost_v_;         // Vertical segment cost
-  std::vector<float> cost_lr_;        // Left and right boundary cost
-  std::vector<float> cost_tb_;        // Top and bottom boundary cost
-  std::vector<float> cost_hvh_test_;  // Vertical first Z
-  std::vector<float> cost_v_test_;    // Vertical segment cost
-  std::vector<float> cost_tb_test_;   // Top and bottom boundary cost
   std::vector<float> h_cost_table_;
   std::vector<float> v_cost_table_;
   std::vector<int> xcor_;
@@ -594,7 +775,10 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
+  // trees of the last non congestion driven FLUTE call of each net, reused
+  // by the later calls of a run and by incremental routing; cleared by
+  // clear() and removeNet()
+  std::unordered_map<const odb::dbNet*, RsmtCacheEntry> rsmt_cache_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -605,19 +789,14 @@ class FastRouteCore
   std::vector<OrderNetPin> tree_order_pv_;
   std::vector<OrderTree> tree_order_cong_;
 
-  multi_array<Edge, 2> v_edges_;       // The way it is indexed is (Y, X)
-  multi_array<Edge, 2> h_edges_;       // The way it is indexed is (Y, X)
-  multi_array<Edge3D, 3> h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<Edge3D, 3> v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<int, 2> corr_edge_;
-  multi_array<short, 2> parent_x1_;
-  multi_array<short, 2> parent_y1_;
-  multi_array<short, 2> parent_x3_;
-  multi_array<short, 2> parent_y3_;
-  multi_array<bool, 2> hv_;
-  multi_array<bool, 2> hyper_v_;
-  multi_array<bool, 2> hyper_h_;
+  EdgeGrid v_edges_;       // The way it is indexed is (Y, X)
+  EdgeGrid h_edges_;       // The way it is indexed is (Y, X)
+  EdgeGrid3D h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
+  EdgeGrid3D v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
   multi_array<bool, 2> in_region_;
+  std::vector<MazeSearchSpace> maze_spaces_;
+  std::vector<PatternRouteSpace> pattern_spaces_;
+  MazeSearchSpace3D maze_space_3D_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
@@ -76,6 +76,13 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       grid_hv_(0),
       verbose_(false),
       critical_nets_percentage_(10),
+      maze_thread_count_(0),
+      thread_count_(1),
+      incremental_(false),
+      incremental_margin_(40),
+      db_congestion_valid_(false),
+      db_congestion_min_layer_(0),
+      db_congestion_max_layer_(0),
       via_cost_(0),
       mazeedge_threshold_(0),
       v_capacity_lb_(0),
@@ -97,6 +104,7 @@ FastRouteCore::~FastRouteCore()
 void FastRouteCore::clear()
 {
   clearNets();
+  rsmt_cache_.clear();
 
   num_adjust_ = 0;
   v_capacity_ = 0;
@@ -104,8 +112,8 @@ void FastRouteCore::clear()
   total_overflow_ = 0;
   has_2D_overflow_ = false;
 
-  h_edges_.resize(boost::extents[0][0]);
-  v_edges_.resize(boost::extents[0][0]);
+  h_edges_.resize(0, 0);
+  v_edges_.resize(0, 0);
   seglist_.clear();
 
   gxs_.clear();
@@ -115,39 +123,24 @@ void FastRouteCore::clear()
   tree_order_pv_.clear();
   tree_order_cong_.clear();
 
-  h_edges_3D_.resize(boost::extents[0][0][0]);
-  v_edges_3D_.resize(boost::extents[0][0][0]);
-
-  parent_x1_.resize(boost::extents[0][0]);
-  parent_y1_.resize(boost::extents[0][0]);
-  parent_x3_.resize(boost::extents[0][0]);
-  parent_y3_.resize(boost::extents[0][0]);
-
-  net_eo_.clear();
+  h_edges_3D_.resize(0, 0, 0);
+  v_edges_3D_.resize(0, 0, 0);
 
   xcor_.clear();
   ycor_.clear();
   dcor_.clear();
 
-  hv_.resize(boost::extents[0][0]);
-  hyper_v_.resize(boost::extents[0][0]);
-  hyper_h_.resize(boost::extents[0][0]);
-  corr_edge_.resize(boost::extents[0][0]);
-
   in_region_.resize(boost::extents[0][0]);
+  maze_spaces_.clear();
+  maze_space_3D_ = MazeSearchSpace3D();
+
+  incremental_ = false;
+  db_congestion_valid_ = false;
 
   v_capacity_3D_.clear();
   h_capacity_3D_.clear();
 
-  cost_hvh_.clear();
-  cost_vhv_.clear();
-  cost_h_.clear();
-  cost_v_.clear();
-  cost_lr_.clear();
-  cost_tb_.clear();
-  cost_hvh_test_.clear();
-  cost_v_test_.clear();
-  cost_tb_test_.clear();
+  pattern_spaces_.clear();
 
   vertical_blocked_intervals_.clear();
   horizontal_blocked_intervals_.clear();
@@ -194,23 +187,11 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
     last_row_h_capacity_3D_[i] = 0;
   }
 
-  hv_.resize(boost::extents[y_range_][x_range_]);
-  hyper_v_.resize(boost::extents[y_range_][x_range_]);
-  hyper_h_.resize(boost::extents[y_range_][x_range_]);
-  corr_edge_.resize(boost::extents[y_range_][x_range_]);
-
   in_region_.resize(boost::extents[y_range_][x_range_]);
 
-  cost_hvh_.resize(x_range_);  // Horizontal first Z
-  cost_vhv_.resize(y_range_);  // Vertical first Z
-  cost_h_.resize(y_range_);    // Horizontal segment cost
-  cost_v_.resize(x_range_);    // Vertical segment cost
-  cost_lr_.resize(y_range_);   // Left and right boundary cost
-  cost_tb_.resize(x_range_);   // Top and bottom boundary cost
-
-  cost_hvh_test_.resize(y_range_);  // Vertical first Z
-  cost_v_test_.resize(x_range_);    // Vertical segment cost
-  cost_tb_test_.resize(x_range_);   // Top and bottom boundary cost
+  // the serial pattern routing uses the first space
+  pattern_spaces_.resize(1);
+  pattern_spaces_[0].resize(x_range_, y_range_);
 }
 
 void FastRouteCore::addVCapacity(short verticalCapacity, int layer)
@@ -296,6 +277,8 @@ void FastRouteCore::removeNet(odb::dbNet* db_net)
     delete delete_net;
     db_net_id_map_.erase(db_net);
   }
+  // a net created later at the same address must not find this entry
+  rsmt_cache_.erase(db_net);
 }
 
 void FastRouteCore::getNetId(odb::dbNet* db_net, int& net_id, bool& exists)
@@ -307,6 +290,9 @@ void FastRouteCore::getNetId(odb::dbNet* db_net, int& net_id, bool& exists)
 
 void FastRouteCore::clearNetRoute(const int netID)
 {
+  // the gcells under the old route lose its usage
+  addCongestionDirtyRoutes(netID);
+
   // clear used resources for the net route
   releaseNetResources(netID);
 
@@ -317,34 +303,36 @@ void FastRouteCore::clearNetRoute(const int netID)
 
 void FastRouteCore::initEdges()
 {
+  db_congestion_valid_ = false;
+
   const float LB = 0.9;
   v_capacity_lb_ = LB * v_capacity_;
   h_capacity_lb_ = LB * h_capacity_;
 
   // allocate memory and initialize for edges
 
-  h_edges_.resize(boost::extents[y_grid_][x_grid_ - 1]);
-  v_edges_.resize(boost::extents[y_grid_ - 1][x_grid_]);
+  h_edges_.resize(y_grid_, x_grid_ - 1);
+  v_edges_.resize(y_grid_ - 1, x_grid_);
 
-  v_edges_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
-  h_edges_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+  v_edges_3D_.resize(num_layers_, y_grid_, x_grid_);
+  h_edges_3D_.resize(num_layers_, y_grid_, x_grid_);
 
   for (int i = 0; i < y_grid_; i++) {
     for (int j = 0; j < x_grid_; j++) {
       // 2D edge initialization
       if (j < x_grid_ - 1) {
-        h_edges_[i][j].cap = h_capacity_;
-        h_edges_[i][j].usage = 0;
-        h_edges_[i][j].est_usage = 0;
-        h_edges_[i][j].red = 0;
-        h_edges_[i][j].last_usage = 0;
+        h_edges_.cap(i, j) = h_capacity_;
+        h_edges_.usage(i, j) = 0;
+        h_edges_.est_usage(i, j) = 0;
+        h_edges_.red(i, j) = 0;
+        h_edges_.last_usage(i, j) = 0;
       }
 
       // 3D edge initialization
       for (int k = 0; k < num_layers_; k++) {
-        h_edges_3D_[k][i][j].cap = h_capacity_3D_[k];
-        h_edges_3D_[k][i][j].usage = 0;
-        h_edges_3D_[k][i][j].red = 0;
+        h_edges_3D_.cap(k, i, j) = h_capacity_3D_[k];
+        h_edges_3D_.usage(k, i, j) = 0;
+        h_edges_3D_.red(k, i, j) = 0;
       }
     }
   }
@@ -352,18 +340,18 @@ void FastRouteCore::initEdges()
     for (int j = 0; j < x_grid_; j++) {
       // 2D edge initialization
       if (i < y_grid_ - 1) {
-        v_edges_[i][j].cap = v_capacity_;
-        v_edges_[i][j].usage = 0;
-        v_edges_[i][j].est_usage = 0;
-        v_edges_[i][j].red = 0;
-        v_edges_[i][j].last_usage = 0;
+        v_edges_.cap(i, j) = v_capacity_;
+        v_edges_.usage(i, j) = 0;
+        v_edges_.est_usage(i, j) = 0;
+        v_edges_.red(i, j) = 0;
+        v_edges_.last_usage(i, j) = 0;
       }
 
       // 3D edge initialization
       for (int k = 0; k < num_layers_; k++) {
-        v_edges_3D_[k][i][j].cap = v_capacity_3D_[k];
-        v_edges_3D_[k][i][j].usage = 0;
-        v_edges_3D_[k][i][j].red = 0;
+        v_edges_3D_.cap(k, i, j) = v_capacity_3D_[k];
+        v_edges_3D_.usage(k, i, j) = 0;
+        v_edges_3D_.red(k, i, j) = 0;
       }
     }
   }
@@ -387,11 +375,13 @@ void FastRouteCore::addAdjustment(int x1,
                                   uint16_t reducedCap,
                                   bool isReduce)
 {
+  db_congestion_valid_ = false;
+
   const int k = layer - 1;
 
   if (y1 == y2) {
     // horizontal edge
-    const int cap = h_edges_3D_[k][y1][x1].cap;
+    const int cap = h_edges_3D_.cap(k, y1, x1);
     int reduce;
 
     if (cap - reducedCap < 0) {
@@ -408,28 +398,28 @@ void FastRouteCore::addAdjustment(int x1,
       reduce = cap - reducedCap;
     }
 
-    h_edges_3D_[k][y1][x1].cap = reducedCap;
+    h_edges_3D_.cap(k, y1, x1) = reducedCap;
 
     if (!isReduce) {
       const int increase = reducedCap - cap;
       if (x1 < x_grid_ - 1) {
-        h_edges_[y1][x1].cap += increase;
-        int new_red = h_edges_[y1][x1].red - increase;
-        h_edges_[y1][x1].red = std::max(new_red, 0);
+        h_edges_.cap(y1, x1) += increase;
+        int new_red = h_edges_.red(y1, x1) - increase;
+        h_edges_.red(y1, x1) = std::max(new_red, 0);
       }
-      int new_red_3D = h_edges_3D_[k][y1][x1].red - increase;
-      h_edges_3D_[k][y1][x1].red = std::max(new_red_3D, 0);
+      int new_red_3D = h_edges_3D_.red(k, y1, x1) - increase;
+      h_edges_3D_.red(k, y1, x1) = std::max(new_red_3D, 0);
     } else {
-      h_edges_3D_[k][y1][x1].red += reduce;
+      h_edges_3D_.red(k, y1, x1) += reduce;
     }
 
     if (x1 < x_grid_ - 1) {
-      h_edges_[y1][x1].cap -= reduce;
-      h_edges_[y1][x1].red += reduce;
+      h_edges_.cap(y1, x1) -= reduce;
+      h_edges_.red(y1, x1) += reduce;
     }
 
   } else if (x1 == x2) {  // vertical edge
-    const int cap = v_edges_3D_[k][y1][x1].cap;
+    const int cap = v_edges_3D_.cap(k, y1, x1);
     int reduce;
 
     if (cap - reducedCap < 0) {
@@ -446,24 +436,24 @@ void FastRouteCore::addAdjustment(int x1,
       reduce = cap - reducedCap;
     }
 
-    v_edges_3D_[k][y1][x1].cap = reducedCap;
+    v_edges_3D_.cap(k, y1, x1) = reducedCap;
 
     if (!isReduce) {
       int increase = reducedCap - cap;
       if (y1 < y_grid_ - 1) {
-        v_edges_[y1][x1].cap += increase;
-        int new_red = v_edges_[y1][x1].red - increase;
-        v_edges_[y1][x1].red = std::max(new_red, 0);
+        v_edges_.cap(y1, x1) += increase;
+        int new_red = v_edges_.red(y1, x1) - increase;
+        v_edges_.red(y1, x1) = std::max(new_red, 0);
       }
-      int new_red_3D = v_edges_3D_[k][y1][x1].red - increase;
-      v_edges_3D_[k][y1][x1].red = std::max(new_red_3D, 0);
+      int new_red_3D = v_edges_3D_.red(k, y1, x1) - increase;
+      v_edges_3D_.red(k, y1, x1) = std::max(new_red_3D, 0);
     } else {
-      v_edges_3D_[k][y1][x1].red += reduce;
+      v_edges_3D_.red(k, y1, x1) += reduce;
     }
 
     if (y1 < y_grid_ - 1) {
-      v_edges_[y1][x1].cap -= reduce;
-      v_edges_[y1][x1].red += reduce;
+      v_edges_.cap(y1, x1) -= reduce;
+      v_edges_.red(y1, x1) += reduce;
     }
   }
 }
@@ -615,9 +605,9 @@ int FastRouteCore::getEdgeCapacity(int x1, int y1, int x2, int y2, int layer)
   const int k = layer - 1;
 
   if (y1 == y2) {  // horizontal edge
-    return h_edges_3D_[k][y1][x1].cap;
+    return h_edges_3D_.cap(k, y1, x1);
   } else if (x1 == x2) {  // vertical edge
-    return v_edges_3D_[k][y1][x1].cap;
+    return v_edges_3D_.cap(k, y1, x1);
   } else {
     logger_->error(
         GRT,
@@ -637,9 +627,9 @@ int FastRouteCore::getEdgeCapacity(FrNet* net,
   // get 2D edge capacity respecting layer restrictions
   for (int l = net->getMinLayer(); l <= net->getMaxLayer(); l++) {
     if (direction == EdgeDirection::Horizontal) {
-      cap += h_edges_3D_[l][y1][x1].cap;
+      cap += h_edges_3D_.cap(l, y1, x1);
     } else {
-      cap += v_edges_3D_[l][y1][x1].cap;
+      cap += v_edges_3D_.cap(l, y1, x1);
     }
   }
 
@@ -652,15 +642,17 @@ void FastRouteCore::incrementEdge3DUsage(int x1,
                                          int y2,
                                          int layer)
 {
+  db_congestion_valid_ = false;
+
   const int k = layer - 1;
 
   if (y1 == y2) {  // horizontal edge
     for (int x = x1; x < x2; x++) {
-      h_edges_3D_[k][y1][x].usage++;
+      h_edges_3D_.usage(k, y1, x)++;
     }
   } else if (x1 == x2) {  // vertical edge
     for (int y = y1; y < y2; y++) {
-      v_edges_3D_[k][y][x1].usage++;
+      v_edges_3D_.usage(k, y, x1)++;
     }
   }
 }
@@ -670,11 +662,6 @@ void FastRouteCore::initAuxVar()
   tree_order_cong_.clear();
 
   grid_hv_ = x_range_ * y_range_;
-
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
 }
 
 NetRouteMap FastRouteCore::getRoutes()
@@ -826,29 +813,49 @@ void FastRouteCore::getBlockage(odb::dbTechLayer* layer,
 {
   int l = layer->getRoutingLevel() - 1;
   if (x == x_grid_ - 1 && y == y_grid_ - 1 && x_grid_ > 1 && y_grid_ > 1) {
-    blockage_h = h_edges_3D_[l][y][x - 1].red;
-    blockage_v = v_edges_3D_[l][y - 1][x].red;
+    blockage_h = h_edges_3D_.red(l, y, x - 1);
+    blockage_v = v_edges_3D_.red(l, y - 1, x);
   } else {
-    blockage_h = h_edges_3D_[l][y][x].red;
-    blockage_v = v_edges_3D_[l][y][x].red;
+    blockage_h = h_edges_3D_.red(l, y, x);
+    blockage_v = v_edges_3D_.red(l, y, x);
   }
 }
 
 void FastRouteCore::updateDbCongestion(int min_routing_layer,
                                        int max_routing_layer)
 {
-  if (h_edges_3D_.num_elements() == 0) {  // no information
+  if (h_edges_3D_.empty()) {  // no information
     return;
   }
   auto block = db_->getChip()->getBlock();
   auto db_gcell = block->getGCellGrid();
-  if (db_gcell)
-    db_gcell->resetGrid();
-  else
-    db_gcell = odb::dbGCellGrid::create(block);
 
-  db_gcell->addGridPatternX(x_corner_, x_grid_, tile_size_);
-  db_gcell->addGridPatternY(y_corner_, y_grid_, tile_size_);
+  // After incremental reroutes only the gcells under the ripped-up and the
+  // new routes are rewritten.
+  odb::Rect region(0, 0, x_grid_ - 1, y_grid_ - 1);
+  if (db_gcell != nullptr && db_congestion_valid_
+      && min_routing_layer == db_congestion_min_layer_
+      && max_routing_layer == db_congestion_max_layer_) {
+    if (db_congestion_dirty_.isInverted()) {
+      return;
+    }
+    // usage of the last gcell is read from its lower-left neighbors
+    db_congestion_dirty_.bloat(1, db_congestion_dirty_);
+    db_congestion_dirty_.intersection(region, region);
+  } else {
+    if (db_gcell)
+      db_gcell->resetGrid();
+    else
+      db_gcell = odb::dbGCellGrid::create(block);
+
+    db_gcell->addGridPatternX(x_corner_, x_grid_, tile_size_);
+    db_gcell->addGridPatternY(y_corner_, y_grid_, tile_size_);
+  }
+  db_congestion_valid_ = true;
+  db_congestion_min_layer_ = min_routing_layer;
+  db_congestion_max_layer_ = max_routing_layer;
+  db_congestion_dirty_.mergeInit();
+
   auto db_tech = db_->getTech();
   for (int k = min_routing_layer - 1; k < max_routing_layer - 1; k++) {
     auto layer = db_tech->findRoutingLayer(k + 1);
@@ -862,8 +869,8 @@ void FastRouteCore::updateDbCongestion(int min_routing_layer,
     const uint8_t last_col_capV = last_col_v_capacity_3D_[k];
     bool is_horizontal
         = layer_directions_[k] == odb::dbTechLayerDir::HORIZONTAL;
-    for (int y = 0; y < y_grid_; y++) {
-      for (int x = 0; x < x_grid_; x++) {
+    for (int y = region.yMin(); y <= region.yMax(); y++) {
+      for (int x = region.xMin(); x <= region.xMax(); x++) {
         if (is_horizontal) {
           if (!regular_y_ && y == y_grid_ - 1) {
             db_gcell->setCapacity(layer, x, y, last_row_capH);
@@ -879,16 +886,16 @@ void FastRouteCore::updateDbCongestion(int min_routing_layer,
         }
         if (x == x_grid_ - 1 && y == y_grid_ - 1 && x_grid_ > 1
             && y_grid_ > 1) {
-          uint8_t blockageH = h_edges_3D_[k][y][x - 1].red;
-          uint8_t blockageV = v_edges_3D_[k][y - 1][x].red;
-          uint8_t usageH = h_edges_3D_[k][y - 1][x - 1].usage + blockageH;
-          uint8_t usageV = v_edges_3D_[k][y - 1][x - 1].usage + blockageV;
+          uint8_t blockageH = h_edges_3D_.red(k, y, x - 1);
+          uint8_t blockageV = v_edges_3D_.red(k, y - 1, x);
+          uint8_t usageH = h_edges_3D_.usage(k, y - 1, x - 1) + blockageH;
+          uint8_t usageV = v_edges_3D_.usage(k, y - 1, x - 1) + blockageV;
           db_gcell->setUsage(layer, x, y, usageH + usageV);
         } else {
-          uint8_t blockageH = h_edges_3D_[k][y][x].red;
-          uint8_t blockageV = v_edges_3D_[k][y][x].red;
-          uint8_t usageH = h_edges_3D_[k][y][x].usage + blockageH;
-          uint8_t usageV = v_edges_3D_[k][y][x].usage + blockageV;
+          uint8_t blockageH = h_edges_3D_.red(k, y, x);
+          uint8_t blockageV = v_edges_3D_.red(k, y, x);
+          uint8_t usageH = h_edges_3D_.usage(k, y, x) + blockageH;
+          uint8_t usageV = v_edges_3D_.usage(k, y, x) + blockageV;
           db_gcell->setUsage(layer, x, y, usageH + usageV);
         }
       }
@@ -932,12 +939,12 @@ void FastRouteCore::getCapacityReductionData(
         }
         if (x == x_grid_ - 1 && y == y_grid_ - 1 && x_grid_ > 1
             && y_grid_ > 1) {
-          uint8_t blockageH = h_edges_3D_[k][y][x - 1].red;
-          uint8_t blockageV = v_edges_3D_[k][y - 1][x].red;
+          uint8_t blockageH = h_edges_3D_.red(k, y, x - 1);
+          uint8_t blockageV = v_edges_3D_.red(k, y - 1, x);
           cap_red_data[x][y].reduction += blockageH + blockageV;
         } else {
-          uint8_t blockageH = h_edges_3D_[k][y][x].red;
-          uint8_t blockageV = v_edges_3D_[k][y][x].red;
+          uint8_t blockageH = h_edges_3D_.red(k, y, x);
+          uint8_t blockageV = v_edges_3D_.red(k, y, x);
           cap_red_data[x][y].reduction += blockageH + blockageV;
         }
       }
@@ -945,12 +952,53 @@ void FastRouteCore::getCapacityReductionData(
   }
 }
 
+void FastRouteCore::computeRouteRegion()
+{
+  route_region_.init(0, 0, x_grid_ - 1, y_grid_ - 1);
+  if (!incremental_) {
+    return;
+  }
+
+  odb::Rect pins_box;
+  pins_box.mergeInit();
+  for (const int& netID : net_ids_) {
+    const FrNet* net = nets_[netID];
+    for (int i = 0; i < net->getNumPins(); i++) {
+      const int x = net->getPinX(i);
+      const int y = net->getPinY(i);
+      pins_box.merge(odb::Rect(x, y, x, y));
+    }
+  }
+  if (pins_box.isInverted()) {
+    return;
+  }
+  pins_box.bloat(incremental_margin_, pins_box);
+  pins_box.intersection(route_region_, route_region_);
+}
+
+void FastRouteCore::addCongestionDirtyRoutes(const int netID)
+{
+  if (!db_congestion_valid_) {
+    return;
+  }
+  for (const TreeEdge& treeedge : sttrees_[netID].edges) {
+    const Route& route = treeedge.route;
+    for (int i = 0; i <= route.routelen && i < route.gridsX.size(); i++) {
+      const int x = route.gridsX[i];
+      const int y = route.gridsY[i];
+      db_congestion_dirty_.merge(odb::Rect(x, y, x, y));
+    }
+  }
+}
+
 NetRouteMap FastRouteCore::run()
 {
   if (netCount() == 0) {
     return getRoutes();
   }
 
+  computeRouteRegion();
+
   v_used_ggrid_.clear();
   h_used_ggrid_.clear();
 
@@ -970,7 +1018,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1388,8 +1435,11 @@ NetRouteMap FastRouteCore::run()
     }
   }
 
+  for (const int& netID : net_ids_) {
+    addCongestionDirtyRoutes(netID);
+  }
+
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
   net_ids_.clear();
   return routes;
 }
@@ -1404,6 +1454,26 @@ void FastRouteCore::setCriticalNetsPercentage(float u)
   critical_nets_percentage_ = u;
 }
 
+void FastRouteCore::setMazeThreadCount(int threads)
+{
+  maze_thread_count_ = threads;
+}
+
+void FastRouteCore::setThreadCount(int threads)
+{
+  thread_count_ = threads;
+}
+
+void FastRouteCore::setIncremental(bool incremental)
+{
+  incremental_ = incremental;
+}
+
+void FastRouteCore::setIncrementalMargin(int margin)
+{
+  incremental_margin_ = margin;
+}
+
 void FastRouteCore::setMakeWireParasiticsBuilder(
     AbstractMakeWireParasitics* builder)
 {
@@ -1480,11 +1550,11 @@ void FastRouteCore::computeCongestionInformation()
 
     for (int i = 0; i < y_grid_; i++) {
       for (int j = 0; j < x_grid_ - 1; j++) {
-        cap_per_layer_[l] += h_edges_3D_[l][i][j].cap;
-        usage_per_layer_[l] += h_edges_3D_[l][i][j].usage;
+        cap_per_layer_[l] += h_edges_3D_.cap(l, i, j);
+        usage_per_layer_[l] += h_edges_3D_.usage(l, i, j);
 
         const int overflow
-            = h_edges_3D_[l][i][j].usage - h_edges_3D_[l][i][j].cap;
+            = h_edges_3D_.usage(l, i, j) - h_edges_3D_.cap(l, i, j);
         if (overflow > 0) {
           overflow_per_layer_[l] += overflow;
           max_h_overflow_[l] = std::max(max_h_overflow_[l], overflow);
@@ -1493,11 +1563,11 @@ void FastRouteCore::computeCongestionInformation()
     }
     for (int i = 0; i < y_grid_ - 1; i++) {
       for (int j = 0; j < x_grid_; j++) {
-        cap_per_layer_[l] += v_edges_3D_[l][i][j].cap;
-        usage_per_layer_[l] += v_edges_3D_[l][i][j].usage;
+        cap_per_layer_[l] += v_edges_3D_.cap(l, i, j);
+        usage_per_layer_[l] += v_edges_3D_.usage(l, i, j);
 
         const int overflow
-            = v_edges_3D_[l][i][j].usage - v_edges_3D_[l][i][j].cap;
+            = v_edges_3D_.usage(l, i, j) - v_edges_3D_.cap(l, i, j);
         if (overflow > 0) {
           overflow_per_layer_[l] += overflow;
           max_v_overflow_[l] = std::max(max_v_overflow_[l], overflow);
@@ -31,6 +31,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
 
 #include "AbstractFastRouteRenderer.h"
 #include "DataType.h"
@@ -429,7 +430,7 @@ void FastRouteCore::fluteCongest(const int netID,
       for (int k = ys[0]; k <= ys[d - 1]; k++)  // all grids in the column
       {
         for (int j = xs[i]; j < xs[i + 1]; j++)
-          usageH += h_edges_[k][j].est_usage_red();
+          usageH += h_edges_.est_usage_red(k, j);
       }
       if (x_seg[i] != 0 && usageH != 0) {
         x_seg[i]
@@ -440,7 +441,7 @@ void FastRouteCore::fluteCongest(const int netID,
       int usageV = 0;
       for (int j = ys[i]; j < ys[i + 1]; j++) {
         for (int k = xs[0]; k <= xs[d - 1]; k++)  // all grids in the row
-          usageV += v_edges_[j][k].est_usage_red();
+          usageV += v_edges_.est_usage_red(j, k);
       }
       if (y_seg[i] != 0 && usageV != 0) {
         y_seg[i]
@@ -478,14 +479,14 @@ bool FastRouteCore::netCongestion(const int netID)
       for (int i = seg.x1; i < seg.x2; i++) {
         const int cap = getEdgeCapacity(
             nets_[netID], i, seg.y1, EdgeDirection::Horizontal);
-        if (h_edges_[seg.y1][i].est_usage >= cap) {
+        if (h_edges_.est_usage(seg.y1, i) >= cap) {
           return true;
         }
       }
       for (int i = ymin; i < ymax; i++) {
         const int cap
             = getEdgeCapacity(nets_[netID], seg.x2, i, EdgeDirection::Vertical);
-        if (v_edges_[i][seg.x2].est_usage >= cap) {
+        if (v_edges_.est_usage(i, seg.x2) >= cap) {
           return true;
         }
       }
@@ -493,14 +494,14 @@ bool FastRouteCore::netCongestion(const int netID)
       for (int i = ymin; i < ymax; i++) {
         const int cap
             = getEdgeCapacity(nets_[netID], seg.x1, i, EdgeDirection::Vertical);
-        if (v_edges_[i][seg.x1].est_usage >= cap) {
+        if (v_edges_.est_usage(i, seg.x1) >= cap) {
           return true;
         }
       }
       for (int i = seg.x1; i < seg.x2; i++) {
         const int cap = getEdgeCapacity(
             nets_[netID], i, seg.y2, EdgeDirection::Horizontal);
-        if (h_edges_[seg.y2][i].est_usage >= cap) {
+        if (h_edges_.est_usage(seg.y2, i) >= cap) {
           return true;
         }
       }
@@ -600,26 +601,26 @@ float FastRouteCore::coeffADJ(const int netID)
   if (xmin == xmax) {
     for (int j = ymin; j < ymax; j++) {
       Vcap += getEdgeCapacity(nets_[netID], xmin, j, EdgeDirection::Vertical);
-      Vusage += v_edges_[j][xmin].est_usage;
+      Vusage += v_edges_.est_usage(j, xmin);
     }
     coef = 1;
   } else if (ymin == ymax) {
     for (int i = xmin; i < xmax; i++) {
       Hcap += getEdgeCapacity(nets_[netID], i, ymin, EdgeDirection::Horizontal);
-      Husage += h_edges_[ymin][i].est_usage;
+      Husage += h_edges_.est_usage(ymin, i);
     }
     coef = 1;
   } else {
     for (int j = ymin; j <= ymax; j++) {
       for (int i = xmin; i < xmax; i++) {
         Hcap += getEdgeCapacity(nets_[netID], i, j, EdgeDirection::Horizontal);
-        Husage += h_edges_[j][i].est_usage;
+        Husage += h_edges_.est_usage(j, i);
       }
     }
     for (int j = ymin; j < ymax; j++) {
       for (int i = xmin; i <= xmax; i++) {
         Vcap += getEdgeCapacity(nets_[netID], i, j, EdgeDirection::Vertical);
-        Vusage += v_edges_[j][i].est_usage;
+        Vusage += v_edges_.est_usage(j, i);
       }
     }
     // (Husage * Vcap) resulting in zero is unlikely, but
@@ -639,88 +640,106 @@ float FastRouteCore::coeffADJ(const int netID)
   return coef;
 }
 
-void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
-                                 const bool reRoute,
-                                 const bool genTree,
-                                 const bool newType,
-                                 const bool noADJ)
+// Returns the fluteNormal tree of a net, reusing the tree of the last call
+// when the pins and coeffV did not change.  The cache entry of the net has
+// to exist before the call.
+void FastRouteCore::fluteNormalCached(const int netID,
+                                      const int acc,
+                                      const float coeffV,
+                                      Tree& t)
 {
-  Tree rsmt;
-  int numShift = 0;
+  const FrNet* net = nets_[netID];
+  RsmtCacheEntry& entry = rsmt_cache_.at(net->getDbNet());
+  if (entry.coeffV == coeffV && entry.x == net->getPinX()
+      && entry.y == net->getPinY()) {
+    t = entry.tree;
+    if (net->getNumPins() > 3) {
+      gxs_[netID] = entry.gxs;
+      gys_[netID] = entry.gys;
+      gs_[netID] = entry.gs;
+    }
+    return;
+  }
+
+  fluteNormal(netID, net->getPinX(), net->getPinY(), acc, coeffV, t);
 
-  int wl = 0;
-  int wl1 = 0;
-  int totalNumSeg = 0;
+  entry.x = net->getPinX();
+  entry.y = net->getPinY();
+  entry.coeffV = coeffV;
+  entry.tree = t;
+  if (net->getNumPins() > 3) {
+    entry.gxs = gxs_[netID];
+    entry.gys = gys_[netID];
+    entry.gs = gs_[netID];
+  }
+}
 
+void FastRouteCore::genNetRSMT(PatternRouteSpace& space,
+                               const int netID,
+                               const bool congestionDriven,
+                               const bool reRoute,
+                               const bool genTree,
+                               const bool newType,
+                               const bool noADJ,
+                               int& wl,
+                               int& wl1,
+                               int& num_segs,
+                               int& num_shifts)
+{
+  Tree rsmt;
   const int flute_accuracy = 2;
 
-  for (const int& netID : net_ids_) {
-    FrNet* net = nets_[netID];
-
-    int d = net->getNumPins();
-
-    if (reRoute) {
-      if (newType) {
-        const auto& treeedges = sttrees_[netID].edges;
-        const auto& treenodes = sttrees_[netID].nodes;
-        for (int j = 0; j < sttrees_[netID].num_edges(); j++) {
-          // only route the non-degraded edges (len>0)
-          if (sttrees_[netID].edges[j].len > 0) {
-            const TreeEdge* treeedge = &(treeedges[j]);
-            const int n1 = treeedge->n1;
-            const int n2 = treeedge->n2;
-            const int x1 = treenodes[n1].x;
-            const int y1 = treenodes[n1].y;
-            const int x2 = treenodes[n2].x;
-            const int y2 = treenodes[n2].y;
-            newRipup(treeedge, x1, y1, x2, y2, netID);
-          }
-        }
-      } else {
-        // remove the est_usage due to the segments in this net
-        for (auto& seg : seglist_[netID]) {
-          ripupSegL(&seg);
+  FrNet* net = nets_[netID];
+
+  int d = net->getNumPins();
+
+  if (reRoute) {
+    if (newType) {
+      const auto& treeedges = sttrees_[netID].edges;
+      const auto& treenodes = sttrees_[netID].nodes;
+      for (int j = 0; j < sttrees_[netID].num_edges(); j++) {
+        // only route the non-degraded edges (len>0)
+        if (sttrees_[netID].edges[j].len > 0) {
+          const TreeEdge* treeedge = &(treeedges[j]);
+          const int n1 = treeedge->n1;
+          const int n2 = treeedge->n2;
+          const int x1 = treenodes[n1].x;
+          const int y1 = treenodes[n1].y;
+          const int x2 = treenodes[n2].x;
+          const int y2 = treenodes[n2].y;
+          newRipup(treeedge, x1, y1, x2, y2, netID);
         }
       }
+    } else {
+      // remove the est_usage due to the segments in this net
+      for (auto& seg : seglist_[netID]) {
+        ripupSegL(&seg);
+      }
     }
+  }
 
-    // check net alpha because FastRoute has a special implementation of flute
-    // TODO: move this flute implementation to SteinerTreeBuilder
-    const float net_alpha = stt_builder_->getAlpha(net->getDbNet());
-    if (net_alpha > 0.0) {
-      rsmt = stt_builder_->makeSteinerTree(
-          net->getDbNet(), net->getPinX(), net->getPinY(), net->getDriverIdx());
-    } else {
-      float coeffV = 1.36;
-
-      if (congestionDriven) {
-        // call congestion driven flute to generate RSMT
-        bool cong;
-        coeffV = noADJ ? 1.2 : coeffADJ(netID);
-        cong = netCongestion(netID);
-        if (cong) {
-          fluteCongest(netID,
-                       net->getPinX(),
-                       net->getPinY(),
-                       flute_accuracy,
-                       coeffV,
-                       rsmt);
-        } else {
-          fluteNormal(netID,
-                      net->getPinX(),
-                      net->getPinY(),
-                      flute_accuracy,
-                      coeffV,
-                      rsmt);
-        }
-        if (d > 3) {
-          numShift += edgeShiftNew(rsmt, netID);
-        }
+  // check net alpha because FastRoute has a special implementation of flute
+  // TODO: move this flute implementation to SteinerTreeBuilder
+  const float net_alpha = stt_builder_->getAlpha(net->getDbNet());
+  if (net_alpha > 0.0) {
+    rsmt = stt_builder_->makeSteinerTree(
+        net->getDbNet(), net->getPinX(), net->getPinY(), net->getDriverIdx());
+  } else {
+    float coeffV = 1.36;
+
+    if (congestionDriven) {
+      // call congestion driven flute to generate RSMT
+      bool cong;
+      coeffV = noADJ ? 1.2 : coeffADJ(netID);
+      cong = netCongestion(netID);
+      if (cong) {
+        fluteCongest(netID,
+                     net->getPinX(),
+                     net->getPinY(),
+                     flute_accuracy,
+                     coeffV,
+                     rsmt);
       } else {
-        // call FLUTE to generate RSMT for each net
-        if (noADJ || HTreeSuite(netID)) {
-          coeffV = 1.2;
-        }
         fluteNormal(netID,
                     net->getPinX(),
                     net->getPinY(),
@@ -728,65 +747,127 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
                     coeffV,
                     rsmt);
       }
+      if (d > 3) {
+        num_shifts += edgeShiftNew(rsmt, netID);
+      }
+    } else {
+      // call FLUTE to generate RSMT for each net
+      if (noADJ || HTreeSuite(netID)) {
+        coeffV = 1.2;
+      }
+      fluteNormalCached(netID, flute_accuracy, coeffV, rsmt);
     }
-    if (debug_->isOn() && debug_->steinerTree_
-        && net->getDbNet() == debug_->net_) {
-      steinerTreeVisualization(rsmt, net);
-    }
+  }
+  if (debug_->isOn() && debug_->steinerTree_
+      && net->getDbNet() == debug_->net_) {
+    steinerTreeVisualization(rsmt, net);
+  }
 
-    if (genTree) {
-      copyStTree(netID, rsmt);
-    }
+  if (genTree) {
+    copyStTree(netID, rsmt);
+  }
 
-    if (net->getNumPins() != rsmt.deg) {
-      d = rsmt.deg;
-    }
+  if (net->getNumPins() != rsmt.deg) {
+    d = rsmt.deg;
+  }
 
-    if (congestionDriven) {
-      for (int j = 0; j < sttrees_[netID].num_edges(); j++) {
-        wl1 += sttrees_[netID].edges[j].len;
-      }
+  if (congestionDriven) {
+    for (int j = 0; j < sttrees_[netID].num_edges(); j++) {
+      wl1 += sttrees_[netID].edges[j].len;
     }
+  }
 
-    for (int j = 0; j < rsmt.branchCount(); j++) {
-      const int x1 = rsmt.branch[j].x;
-      const int y1 = rsmt.branch[j].y;
-      const int n = rsmt.branch[j].n;
-      const int x2 = rsmt.branch[n].x;
-      const int y2 = rsmt.branch[n].y;
-
-      wl += abs(x1 - x2) + abs(y1 - y2);
-
-      if (x1 != x2 || y1 != y2) {  // the branch is not degraded (a point)
-        // the position of this segment in seglist
-        seglist_[netID].push_back(Segment());
-        auto& seg = seglist_[netID].back();
-        if (x1 < x2) {
-          seg.x1 = x1;
-          seg.x2 = x2;
-          seg.y1 = y1;
-          seg.y2 = y2;
-        } else {
-          seg.x1 = x2;
-          seg.x2 = x1;
-          seg.y1 = y2;
-          seg.y2 = y1;
-        }
+  for (int j = 0; j < rsmt.branchCount(); j++) {
+    const int x1 = rsmt.branch[j].x;
+    const int y1 = rsmt.branch[j].y;
+    const int n = rsmt.branch[j].n;
+    const int x2 = rsmt.branch[n].x;
+    const int y2 = rsmt.branch[n].y;
+
+    wl += abs(x1 - x2) + abs(y1 - y2);
 
-        seg.netID = netID;
+    if (x1 != x2 || y1 != y2) {  // the branch is not degraded (a point)
+      // the position of this segment in seglist
+      seglist_[netID].push_back(Segment());
+      auto& seg = seglist_[netID].back();
+      if (x1 < x2) {
+        seg.x1 = x1;
+        seg.x2 = x2;
+        seg.y1 = y1;
+        seg.y2 = y2;
+      } else {
+        seg.x1 = x2;
+        seg.x2 = x1;
+        seg.y1 = y2;
+        seg.y2 = y1;
       }
-    }  // loop j
 
-    totalNumSeg += seglist_[netID].size();
+      seg.netID = netID;
+    }
+  }  // loop j
+
+  num_segs += seglist_[netID].size();
+
+  if (reRoute) {
+    // update the est_usage due to the segments in this net
+    // route the net with no previous route for each tree edge
+    newrouteL(space, netID, RouteType::NoRoute, true);
+  }
+}
 
-    if (reRoute) {
-      // update the est_usage due to the segments in this net
-      newrouteL(
-          netID,
-          RouteType::NoRoute,
-          true);  // route the net with no previous route for each tree edge
+// Builds the Steiner trees of the nets.  Trees are built concurrently with
+// the pattern routing batches.  When rerouting, a net rips up and routes
+// its L segments inside its pin and tree box, and the congestion driven
+// trees only read the edges inside it, so the result does not depend on
+// the number of threads.
+void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
+                                 const bool reRoute,
+                                 const bool genTree,
+                                 const bool newType,
+                                 const bool noADJ)
+{
+  std::atomic<int> wl = 0;
+  std::atomic<int> wl1 = 0;
+  std::atomic<int> totalNumSeg = 0;
+  std::atomic<int> numShift = 0;
+  std::atomic<int> num_reused = 0;
+
+  // the cache entries are created up front, the threads only update them
+  if (!congestionDriven) {
+    for (const int& netID : net_ids_) {
+      RsmtCacheEntry& entry = rsmt_cache_[nets_[netID]->getDbNet()];
+      if (entry.x == nets_[netID]->getPinX()
+          && entry.y == nets_[netID]->getPinY()) {
+        num_reused++;
+      }
     }
-  }  // loop i
+  }
+
+  const bool independent = !reRoute && !congestionDriven;
+  patternRouteNets(
+      0,
+      [&](PatternRouteSpace& space, const int netID) {
+        int net_wl = 0;
+        int net_wl1 = 0;
+        int num_segs = 0;
+        int num_shifts = 0;
+        genNetRSMT(space,
+                   netID,
+                   congestionDriven,
+                   reRoute,
+                   genTree,
+                   newType,
+                   noADJ,
+                   net_wl,
+                   net_wl1,
+                   num_segs,
+                   num_shifts);
+        wl += net_wl;
+        wl1 += net_wl1;
+        totalNumSeg += num_segs;
+        numShift += num_shifts;
+      },
+      independent);
 
   debugPrint(logger_,
              GRT,
@@ -794,10 +875,19 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
              1,
              "Wirelength: {}, Wirelength1: {}\nNumber of segments: {}\nNumber "
              "of shifts: {}",
-             wl,
-             wl1,
-             totalNumSeg,
-             numShift);
+             wl.load(),
+             wl1.load(),
+             totalNumSeg.load(),
+             numShift.load());
+  if (!congestionDriven) {
+    debugPrint(logger_,
+               GRT,
+               "rsmt",
+               1,
+               "Pins of {} out of {} nets are unchanged since the last run.",
+               num_reused.load(),
+               net_ids_.size());
+  }
 }
 
 }  // namespace grt
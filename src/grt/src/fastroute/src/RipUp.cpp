@@ -51,14 +51,14 @@ void FastRouteCore::ripupSegL(const Segment* seg)
   // remove L routing
   if (seg->xFirst) {
     for (int i = seg->x1; i < seg->x2; i++)
-      h_edges_[seg->y1][i].est_usage -= edgeCost;
+      h_edges_.est_usage(seg->y1, i) -= edgeCost;
     for (int i = ymin; i < ymax; i++)
-      v_edges_[i][seg->x2].est_usage -= edgeCost;
+      v_edges_.est_usage(i, seg->x2) -= edgeCost;
   } else {
     for (int i = ymin; i < ymax; i++)
-      v_edges_[i][seg->x1].est_usage -= edgeCost;
+      v_edges_.est_usage(i, seg->x1) -= edgeCost;
     for (int i = seg->x1; i < seg->x2; i++)
-      h_edges_[seg->y2][i].est_usage -= edgeCost;
+      h_edges_.est_usage(seg->y2, i) -= edgeCost;
   }
 }
 
@@ -72,35 +72,35 @@ void FastRouteCore::ripupSegZ(const Segment* seg)
   if (seg->x1 == seg->x2) {
     // remove V routing
     for (int i = ymin; i < ymax; i++)
-      v_edges_[i][seg->x1].est_usage -= edgeCost;
+      v_edges_.est_usage(i, seg->x1) -= edgeCost;
   } else if (seg->y1 == seg->y2) {
     // remove H routing
     for (int i = seg->x1; i < seg->x2; i++)
-      h_edges_[seg->y1][i].est_usage -= edgeCost;
+      h_edges_.est_usage(seg->y1, i) -= edgeCost;
   } else {
     // remove Z routing
     if (seg->HVH) {
       for (int i = seg->x1; i < seg->Zpoint; i++)
-        h_edges_[seg->y1][i].est_usage -= edgeCost;
+        h_edges_.est_usage(seg->y1, i) -= edgeCost;
       for (int i = seg->Zpoint; i < seg->x2; i++)
-        h_edges_[seg->y2][i].est_usage -= edgeCost;
+        h_edges_.est_usage(seg->y2, i) -= edgeCost;
       for (int i = ymin; i < ymax; i++)
-        v_edges_[i][seg->Zpoint].est_usage -= edgeCost;
+        v_edges_.est_usage(i, seg->Zpoint) -= edgeCost;
     } else {
       if (seg->y1 < seg->y2) {
         for (int i = seg->y1; i < seg->Zpoint; i++)
-          v_edges_[i][seg->x1].est_usage -= edgeCost;
+          v_edges_.est_usage(i, seg->x1) -= edgeCost;
         for (int i = seg->Zpoint; i < seg->y2; i++)
-          v_edges_[i][seg->x2].est_usage -= edgeCost;
+          v_edges_.est_usage(i, seg->x2) -= edgeCost;
         for (int i = seg->x1; i < seg->x2; i++)
-          h_edges_[seg->Zpoint][i].est_usage -= 1;
+          h_edges_.est_usage(seg->Zpoint, i) -= 1;
       } else {
         for (int i = seg->y2; i < seg->Zpoint; i++)
-          v_edges_[i][seg->x2].est_usage -= edgeCost;
+          v_edges_.est_usage(i, seg->x2) -= edgeCost;
         for (int i = seg->Zpoint; i < seg->y1; i++)
-          v_edges_[i][seg->x1].est_usage -= edgeCost;
+          v_edges_.est_usage(i, seg->x1) -= edgeCost;
         for (int i = seg->x1; i < seg->x2; i++)
-          h_edges_[seg->Zpoint][i].est_usage -= 1;
+          h_edges_.est_usage(seg->Zpoint, i) -= 1;
       }
     }
   }
@@ -126,40 +126,40 @@ void FastRouteCore::newRipup(const TreeEdge* treeedge,
   {
     if (treeedge->route.xFirst) {
       for (int i = x1; i < x2; i++)
-        h_edges_[y1][i].est_usage -= edgeCost;
+        h_edges_.est_usage(y1, i) -= edgeCost;
       for (int i = ymin; i < ymax; i++)
-        v_edges_[i][x2].est_usage -= edgeCost;
+        v_edges_.est_usage(i, x2) -= edgeCost;
     } else {
       for (int i = ymin; i < ymax; i++)
-        v_edges_[i][x1].est_usage -= edgeCost;
+        v_edges_.est_usage(i, x1) -= edgeCost;
       for (int i = x1; i < x2; i++)
-        h_edges_[y2][i].est_usage -= edgeCost;
+        h_edges_.est_usage(y2, i) -= edgeCost;
     }
   } else if (ripuptype == RouteType::ZRoute) {
     // remove Z routing
     const int Zpoint = treeedge->route.Zpoint;
     if (treeedge->route.HVH) {
       for (int i = x1; i < Zpoint; i++)
-        h_edges_[y1][i].est_usage -= edgeCost;
+        h_edges_.est_usage(y1, i) -= edgeCost;
       for (int i = Zpoint; i < x2; i++)
-        h_edges_[y2][i].est_usage -= edgeCost;
+        h_edges_.est_usage(y2, i) -= edgeCost;
       for (int i = ymin; i < ymax; i++)
-        v_edges_[i][Zpoint].est_usage -= edgeCost;
+        v_edges_.est_usage(i, Zpoint) -= edgeCost;
     } else {
       if (y1 < y2) {
         for (int i = y1; i < Zpoint; i++)
-          v_edges_[i][x1].est_usage -= edgeCost;
+          v_edges_.est_usage(i, x1) -= edgeCost;
         for (int i = Zpoint; i < y2; i++)
-          v_edges_[i][x2].est_usage -= edgeCost;
+          v_edges_.est_usage(i, x2) -= edgeCost;
         for (int i = x1; i < x2; i++)
-          h_edges_[Zpoint][i].est_usage -= edgeCost;
+          h_edges_.est_usage(Zpoint, i) -= edgeCost;
       } else {
         for (int i = y2; i < Zpoint; i++)
-          v_edges_[i][x2].est_usage -= edgeCost;
+          v_edges_.est_usage(i, x2) -= edgeCost;
         for (int i = Zpoint; i < y1; i++)
-          v_edges_[i][x1].est_usage -= edgeCost;
+          v_edges_.est_usage(i, x1) -= edgeCost;
         for (int i = x1; i < x2; i++)
-          h_edges_[Zpoint][i].est_usage -= edgeCost;
+          h_edges_.est_usage(Zpoint, i) -= edgeCost;
       }
     }
   } else if (ripuptype == RouteType::MazeRoute) {
@@ -168,10 +168,10 @@ void FastRouteCore::newRipup(const TreeEdge* treeedge,
     for (int i = 0; i < treeedge->route.routelen; i++) {
       if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
         const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-        v_edges_[ymin][gridsX[i]].est_usage -= edgeCost;
+        v_edges_.est_usage(ymin, gridsX[i]) -= edgeCost;
       } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
         const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-        h_edges_[gridsY[i]][xmin].est_usage -= edgeCost;
+        h_edges_.est_usage(gridsY[i], xmin) -= edgeCost;
       } else {
         logger_->error(GRT, 225, "Maze ripup wrong in newRipup.");
       }
@@ -202,7 +202,7 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
       for (int i = x1; i < x2; i++) {
         const int cap
             = getEdgeCapacity(nets_[netID], i, y1, EdgeDirection::Horizontal);
-        if (h_edges_[y1][i].est_usage > cap) {
+        if (h_edges_.est_usage(y1, i) > cap) {
           needRipup = true;
           break;
         }
@@ -211,7 +211,7 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
       for (int i = ymin; i < ymax; i++) {
         const int cap
             = getEdgeCapacity(nets_[netID], x2, i, EdgeDirection::Vertical);
-        if (v_edges_[i][x2].est_usage > cap) {
+        if (v_edges_.est_usage(i, x2) > cap) {
           needRipup = true;
           break;
         }
@@ -220,7 +220,7 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
       for (int i = ymin; i < ymax; i++) {
         const int cap
             = getEdgeCapacity(nets_[netID], x1, i, EdgeDirection::Vertical);
-        if (v_edges_[i][x1].est_usage > cap) {
+        if (v_edges_.est_usage(i, x1) > cap) {
           needRipup = true;
           break;
         }
@@ -228,7 +228,7 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
       for (int i = x1; i < x2; i++) {
         const int cap
             = getEdgeCapacity(nets_[netID], i, y2, EdgeDirection::Horizontal);
-        if (h_edges_[y2][i].est_usage > cap) {
+        if (h_edges_.est_usage(y2, i) > cap) {
           needRipup = true;
           break;
         }
@@ -247,9 +247,9 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
         treenodes[n2].status -= 1;
 
         for (int i = x1; i < x2; i++)
-          h_edges_[y1][i].est_usage -= edgeCost;
+          h_edges_.est_usage(y1, i) -= edgeCost;
         for (int i = ymin; i < ymax; i++)
-          v_edges_[i][x2].est_usage -= edgeCost;
+          v_edges_.est_usage(i, x2) -= edgeCost;
       } else {
         if (n2 >= deg) {
           treenodes[n2].status -= 2;
@@ -257,9 +257,9 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
         treenodes[n1].status -= 1;
 
         for (int i = ymin; i < ymax; i++)
-          v_edges_[i][x1].est_usage -= edgeCost;
+          v_edges_.est_usage(i, x1) -= edgeCost;
         for (int i = x1; i < x2; i++)
-          h_edges_[y2][i].est_usage -= edgeCost;
+          h_edges_.est_usage(y2, i) -= edgeCost;
       }
     }
     return needRipup;
@@ -290,14 +290,14 @@ bool FastRouteCore::newRipupCheck(const TreeEdge* treeedge,
     for (int i = 0; i < treeedge->route.routelen; i++) {
       if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
         const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-        if (v_edges_[ymin][gridsX[i]].usage_red()
+        if (v_edges_.usage_red(ymin, gridsX[i])
             >= v_capacity_ - ripup_threshold) {
           needRipup = true;
           break;
         }
       } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
         const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-        if (h_edges_[gridsY[i]][xmin].usage_red()
+        if (h_edges_.usage_red(gridsY[i], xmin)
             >= h_capacity_ - ripup_threshold) {
           needRipup = true;
           break;
@@ -322,10 +322,10 @@ bool FastRouteCore::newRipupCheck(const TreeEdge* treeedge,
       for (int i = 0; i < treeedge->route.routelen; i++) {
         if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
           const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[ymin][gridsX[i]].usage -= edgeCost;
+          v_edges_.usage(ymin, gridsX[i]) -= edgeCost;
         } else {  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
           const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][xmin].usage -= edgeCost;
+          h_edges_.usage(gridsY[i], xmin) -= edgeCost;
         }
       }
       return true;
@@ -438,13 +438,13 @@ bool FastRouteCore::newRipup3DType3(const int netID, const int edgeID)
     if (gridsL[i] == gridsL[i + 1]) {
       if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
         const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-        v_edges_[ymin][gridsX[i]].usage -= net->getEdgeCost();
-        v_edges_3D_[gridsL[i]][ymin][gridsX[i]].usage
+        v_edges_.usage(ymin, gridsX[i]) -= net->getEdgeCost();
+        v_edges_3D_.usage(gridsL[i], ymin, gridsX[i])
             -= net->getLayerEdgeCost(gridsL[i]);
       } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
         const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-        h_edges_[gridsY[i]][xmin].usage -= net->getEdgeCost();
-        h_edges_3D_[gridsL[i]][gridsY[i]][xmin].usage
+        h_edges_.usage(gridsY[i], xmin) -= net->getEdgeCost();
+        h_edges_3D_.usage(gridsL[i], gridsY[i], xmin)
             -= net->getLayerEdgeCost(gridsL[i]);
       } else {
         logger_->error(
@@ -472,24 +472,20 @@ void FastRouteCore::releaseNetResources(const int netID)
       const std::vector<short>& gridsY = treeedge->route.gridsY;
       const std::vector<short>& gridsL = treeedge->route.gridsL;
       const int routeLen = treeedge->route.routelen;
-      Edge* edge;
-      Edge3D* edge_3D;
 
       for (int i = 0; i < routeLen; i++) {
         if (gridsL[i] != gridsL[i + 1])
           continue;
         else if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
           const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-          edge = &v_edges_[ymin][gridsX[i]];
-          edge_3D = &v_edges_3D_[gridsL[i]][ymin][gridsX[i]];
-          edge->usage -= edgeCost;
-          edge_3D->usage -= nets_[netID]->getLayerEdgeCost(gridsL[i]);
+          v_edges_.usage(ymin, gridsX[i]) -= edgeCost;
+          v_edges_3D_.usage(gridsL[i], ymin, gridsX[i])
+              -= nets_[netID]->getLayerEdgeCost(gridsL[i]);
         } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
           const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-          edge = &h_edges_[gridsY[i]][xmin];
-          edge_3D = &h_edges_3D_[gridsL[i]][gridsY[i]][xmin];
-          edge->usage -= edgeCost;
-          edge_3D->usage -= nets_[netID]->getLayerEdgeCost(gridsL[i]);
+          h_edges_.usage(gridsY[i], xmin) -= edgeCost;
+          h_edges_3D_.usage(gridsL[i], gridsY[i], xmin)
+              -= nets_[netID]->getLayerEdgeCost(gridsL[i]);
         }
       }
     }
@@ -522,40 +518,40 @@ void FastRouteCore::newRipupNet(const int netID)
       {
         if (treeedge->route.xFirst) {
           for (int i = x1; i < x2; i++)
-            h_edges_[y1][i].est_usage -= edgeCost;
+            h_edges_.est_usage(y1, i) -= edgeCost;
           for (int i = ymin; i < ymax; i++)
-            v_edges_[i][x2].est_usage -= edgeCost;
+            v_edges_.est_usage(i, x2) -= edgeCost;
         } else {
           for (int i = ymin; i < ymax; i++)
-            v_edges_[i][x1].est_usage -= edgeCost;
+            v_edges_.est_usage(i, x1) -= edgeCost;
           for (int i = x1; i < x2; i++)
-            h_edges_[y2][i].est_usage -= edgeCost;
+            h_edges_.est_usage(y2, i) -= edgeCost;
         }
       } else if (ripuptype == RouteType::ZRoute) {
         // remove Z routing
         const int Zpoint = treeedge->route.Zpoint;
         if (treeedge->route.HVH) {
           for (int i = x1; i < Zpoint; i++)
-            h_edges_[y1][i].est_usage -= edgeCost;
+            h_edges_.est_usage(y1, i) -= edgeCost;
           for (int i = Zpoint; i < x2; i++)
-            h_edges_[y2][i].est_usage -= edgeCost;
+            h_edges_.est_usage(y2, i) -= edgeCost;
           for (int i = ymin; i < ymax; i++)
-            v_edges_[i][Zpoint].est_usage -= edgeCost;
+            v_edges_.est_usage(i, Zpoint) -= edgeCost;
         } else {
           if (y1 < y2) {
             for (int i = y1; i < Zpoint; i++)
-              v_edges_[i][x1].est_usage -= edgeCost;
+              v_edges_.est_usage(i, x1) -= edgeCost;
             for (int i = Zpoint; i < y2; i++)
-              v_edges_[i][x2].est_usage -= edgeCost;
+              v_edges_.est_usage(i, x2) -= edgeCost;
             for (int i = x1; i < x2; i++)
-              h_edges_[Zpoint][i].est_usage -= edgeCost;
+              h_edges_.est_usage(Zpoint, i) -= edgeCost;
           } else {
             for (int i = y2; i < Zpoint; i++)
-              v_edges_[i][x2].est_usage -= edgeCost;
+              v_edges_.est_usage(i, x2) -= edgeCost;
             for (int i = Zpoint; i < y1; i++)
-              v_edges_[i][x1].est_usage -= edgeCost;
+              v_edges_.est_usage(i, x1) -= edgeCost;
             for (int i = x1; i < x2; i++)
-              h_edges_[Zpoint][i].est_usage -= edgeCost;
+              h_edges_.est_usage(Zpoint, i) -= edgeCost;
           }
         }
       } else if (ripuptype == RouteType::MazeRoute) {
@@ -564,10 +560,10 @@ void FastRouteCore::newRipupNet(const int netID)
         for (int i = 0; i < treeedge->route.routelen; i++) {
           if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
             const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-            v_edges_[ymin][gridsX[i]].est_usage -= edgeCost;
+            v_edges_.est_usage(ymin, gridsX[i]) -= edgeCost;
           } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
             const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-            h_edges_[gridsY[i]][xmin].est_usage -= edgeCost;
+            h_edges_.est_usage(gridsY[i], xmin) -= edgeCost;
           } else {
             logger_->error(GRT,
                            123,
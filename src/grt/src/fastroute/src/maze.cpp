@@ -30,7 +30,11 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <chrono>
+#include <exception>
 
 #include "DataType.h"
 #include "FastRoute.h"
@@ -184,12 +188,12 @@ void FastRouteCore::fixOverlappingEdge(
         if (treeedge->route.gridsY[k] != treeedge->route.gridsY[k + 1]) {
           const int min_y = std::min(treeedge->route.gridsY[k],
                                      treeedge->route.gridsY[k + 1]);
-          v_edges_[min_y][treeedge->route.gridsX[k]].usage -= edgeCost;
+          v_edges_.usage(min_y, treeedge->route.gridsX[k]) -= edgeCost;
         }
       } else {
         const int min_x = std::min(treeedge->route.gridsX[k],
                                    treeedge->route.gridsX[k + 1]);
-        h_edges_[treeedge->route.gridsY[k]][min_x].usage -= edgeCost;
+        h_edges_.usage(treeedge->route.gridsY[k], min_x) -= edgeCost;
       }
     }
     for (int k = 0; k < new_route_x.size() - 1;
@@ -197,12 +201,12 @@ void FastRouteCore::fixOverlappingEdge(
       if (new_route_x[k] == new_route_x[k + 1]) {
         if (new_route_y[k] != new_route_y[k + 1]) {
           const int min_y = std::min(new_route_y[k], new_route_y[k + 1]);
-          v_edges_[min_y][new_route_x[k]].usage += edgeCost;
+          v_edges_.usage(min_y, new_route_x[k]) += edgeCost;
           v_used_ggrid_.insert(std::make_pair(min_y, new_route_x[k]));
         }
       } else {
         const int min_x = std::min(new_route_x[k], new_route_x[k + 1]);
-        h_edges_[new_route_y[k]][min_x].usage += edgeCost;
+        h_edges_.usage(new_route_y[k], min_x) += edgeCost;
         h_used_ggrid_.insert(std::make_pair(new_route_y[k], min_x));
       }
     }
@@ -497,21 +501,24 @@ void FastRouteCore::convertToMazerouteNet(const int netID)
 
 void FastRouteCore::convertToMazeroute()
 {
+  const int h_x_max = std::min(route_region_.xMax(), x_grid_ - 2);
+  const int v_y_max = std::min(route_region_.yMax(), y_grid_ - 2);
+
   for (const int& netID : net_ids_) {
     convertToMazerouteNet(netID);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
+  for (int i = route_region_.yMin(); i <= route_region_.yMax(); i++) {
+    for (int j = route_region_.xMin(); j <= h_x_max; j++) {
       // Add to keep the usage values of the last incremental routing performed
-      h_edges_[i][j].usage += h_edges_[i][j].est_usage;
+      h_edges_.usage(i, j) += h_edges_.est_usage(i, j);
     }
   }
 
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
+  for (int i = route_region_.yMin(); i <= v_y_max; i++) {
+    for (int j = route_region_.xMin(); j <= route_region_.xMax(); j++) {
       // Add to keep the usage values of the last incremental routing performed
-      v_edges_[i][j].usage += v_edges_[i][j].est_usage;
+      v_edges_.usage(i, j) += v_edges_.est_usage(i, j);
     }
   }
 
@@ -520,7 +527,11 @@ void FastRouteCore::convertToMazeroute()
 }
 
 // non recursive version of heapify
-static void heapify(std::vector<float*>& array)
+// heap_pos maps a grid index (offset from base) to its slot in the heap so
+// that a decrease-key does not have to scan the heap to find the entry.
+static void heapify(std::vector<float*>& array,
+                    const float* base,
+                    std::vector<int>& heap_pos)
 {
   bool stop = false;
   const int heapSize = array.size();
@@ -543,33 +554,53 @@ static void heapify(std::vector<float*>& array)
     }
     if (smallest != i) {
       array[i] = array[smallest];
+      heap_pos[array[i] - base] = i;
       i = smallest;
     } else {
       array[i] = tmp;
+      heap_pos[tmp - base] = i;
       stop = true;
     }
   } while (!stop);
 }
 
-static void updateHeap(std::vector<float*>& array, int i)
+static void updateHeap(std::vector<float*>& array,
+                       const float* base,
+                       std::vector<int>& heap_pos,
+                       int i)
 {
   float* tmpi = array[i];
   while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
     const int parent = parent_index(i);
     array[i] = array[parent];
+    heap_pos[array[i] - base] = i;
     i = parent;
   }
   array[i] = tmpi;
+  heap_pos[tmpi - base] = i;
 }
 
 // remove the entry with minimum distance from Priority queue
-static void removeMin(std::vector<float*>& array)
+static void removeMin(std::vector<float*>& array,
+                      const float* base,
+                      std::vector<int>& heap_pos)
 {
+  heap_pos[array[0] - base] = -1;
   array[0] = array.back();
-  heapify(array);
+  heapify(array, base, heap_pos);
   array.pop_back();
 }
 
+// add a grid that was not in the heap yet
+static void pushHeap(std::vector<float*>& array,
+                     const float* base,
+                     std::vector<int>& heap_pos,
+                     float* entry)
+{
+  array.push_back(entry);
+  updateHeap(array, base, heap_pos, array.size() - 1);
+}
+
 /*
  * num_iteration : the total number of iterations for maze route to run
  * round : the number of maze route stages runned
@@ -583,31 +614,31 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 
   if (upType == 1) {
     for (const auto& [i, j] : h_used_ggrid_) {
-      const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+      const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
 
       if (overflow > 0) {
-        h_edges_[i][j].last_usage += overflow;
-        h_edges_[i][j].congCNT++;
+        h_edges_.last_usage(i, j) += overflow;
+        h_edges_.congCNT(i, j)++;
       } else {
         if (!stopDEC) {
-          h_edges_[i][j].last_usage = h_edges_[i][j].last_usage * 0.9;
+          h_edges_.last_usage(i, j) = h_edges_.last_usage(i, j) * 0.9;
         }
       }
-      maxlimit = std::max<int>(maxlimit, h_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, h_edges_.last_usage(i, j));
     }
 
     for (const auto& [i, j] : v_used_ggrid_) {
-      const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+      const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
 
       if (overflow > 0) {
-        v_edges_[i][j].last_usage += overflow;
-        v_edges_[i][j].congCNT++;
+        v_edges_.last_usage(i, j) += overflow;
+        v_edges_.congCNT(i, j)++;
       } else {
         if (!stopDEC) {
-          v_edges_[i][j].last_usage = v_edges_[i][j].last_usage * 0.9;
+          v_edges_.last_usage(i, j) = v_edges_.last_usage(i, j) * 0.9;
         }
       }
-      maxlimit = std::max<int>(maxlimit, v_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, v_edges_.last_usage(i, j));
     }
   } else if (upType == 2) {
     if (max_adj < ahth_) {
@@ -616,104 +647,104 @@ void FastRouteCore::updateCongestionHistory(const int upType,
       stopDEC = false;
     }
     for (const auto& [i, j] : h_used_ggrid_) {
-      const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+      const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
 
       if (overflow > 0) {
-        h_edges_[i][j].congCNT++;
-        h_edges_[i][j].last_usage += overflow;
+        h_edges_.congCNT(i, j)++;
+        h_edges_.last_usage(i, j) += overflow;
       } else {
         if (!stopDEC) {
-          h_edges_[i][j].congCNT--;
-          h_edges_[i][j].congCNT = std::max<int>(0, h_edges_[i][j].congCNT);
-          h_edges_[i][j].last_usage = h_edges_[i][j].last_usage * 0.9;
+          h_edges_.congCNT(i, j)--;
+          h_edges_.congCNT(i, j) = std::max<int>(0, h_edges_.congCNT(i, j));
+          h_edges_.last_usage(i, j) = h_edges_.last_usage(i, j) * 0.9;
         }
       }
-      maxlimit = std::max<int>(maxlimit, h_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, h_edges_.last_usage(i, j));
     }
 
     for (const auto& [i, j] : v_used_ggrid_) {
-      const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+      const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
 
       if (overflow > 0) {
-        v_edges_[i][j].congCNT++;
-        v_edges_[i][j].last_usage += overflow;
+        v_edges_.congCNT(i, j)++;
+        v_edges_.last_usage(i, j) += overflow;
       } else {
         if (!stopDEC) {
-          v_edges_[i][j].congCNT--;
-          v_edges_[i][j].congCNT = std::max<int>(0, v_edges_[i][j].congCNT);
-          v_edges_[i][j].last_usage = v_edges_[i][j].last_usage * 0.9;
+          v_edges_.congCNT(i, j)--;
+          v_edges_.congCNT(i, j) = std::max<int>(0, v_edges_.congCNT(i, j));
+          v_edges_.last_usage(i, j) = v_edges_.last_usage(i, j) * 0.9;
         }
       }
-      maxlimit = std::max<int>(maxlimit, v_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, v_edges_.last_usage(i, j));
     }
 
   } else if (upType == 3) {
     for (const auto& [i, j] : h_used_ggrid_) {
-      const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+      const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
 
       if (overflow > 0) {
-        h_edges_[i][j].congCNT++;
-        h_edges_[i][j].last_usage += overflow;
+        h_edges_.congCNT(i, j)++;
+        h_edges_.last_usage(i, j) += overflow;
       } else {
         if (!stopDEC) {
-          h_edges_[i][j].congCNT--;
-          h_edges_[i][j].congCNT = std::max<int>(0, h_edges_[i][j].congCNT);
-          h_edges_[i][j].last_usage += overflow;
-          h_edges_[i][j].last_usage
-              = std::max<int>(h_edges_[i][j].last_usage, 0);
+          h_edges_.congCNT(i, j)--;
+          h_edges_.congCNT(i, j) = std::max<int>(0, h_edges_.congCNT(i, j));
+          h_edges_.last_usage(i, j) += overflow;
+          h_edges_.last_usage(i, j)
+              = std::max<int>(h_edges_.last_usage(i, j), 0);
         }
       }
-      maxlimit = std::max<int>(maxlimit, h_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, h_edges_.last_usage(i, j));
     }
 
     for (const auto& [i, j] : v_used_ggrid_) {
-      const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+      const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
 
       if (overflow > 0) {
-        v_edges_[i][j].congCNT++;
-        v_edges_[i][j].last_usage += overflow;
+        v_edges_.congCNT(i, j)++;
+        v_edges_.last_usage(i, j) += overflow;
       } else {
         if (!stopDEC) {
-          v_edges_[i][j].congCNT--;
-          v_edges_[i][j].last_usage += overflow;
-          v_edges_[i][j].last_usage
-              = std::max<int>(v_edges_[i][j].last_usage, 0);
+          v_edges_.congCNT(i, j)--;
+          v_edges_.last_usage(i, j) += overflow;
+          v_edges_.last_usage(i, j)
+              = std::max<int>(v_edges_.last_usage(i, j), 0);
         }
       }
-      maxlimit = std::max<int>(maxlimit, v_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, v_edges_.last_usage(i, j));
     }
 
   } else if (upType == 4) {
     for (const auto& [i, j] : h_used_ggrid_) {
-      const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+      const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
 
       if (overflow > 0) {
-        h_edges_[i][j].congCNT++;
-        h_edges_[i][j].last_usage += overflow;
+        h_edges_.congCNT(i, j)++;
+        h_edges_.last_usage(i, j) += overflow;
       } else {
         if (!stopDEC) {
-          h_edges_[i][j].congCNT--;
-          h_edges_[i][j].congCNT = std::max<int>(0, h_edges_[i][j].congCNT);
-          h_edges_[i][j].last_usage = h_edges_[i][j].last_usage * 0.9;
+          h_edges_.congCNT(i, j)--;
+          h_edges_.congCNT(i, j) = std::max<int>(0, h_edges_.congCNT(i, j));
+          h_edges_.last_usage(i, j) = h_edges_.last_usage(i, j) * 0.9;
         }
       }
-      maxlimit = std::max<int>(maxlimit, h_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, h_edges_.last_usage(i, j));
     }
 
     for (const auto& [i, j] : v_used_ggrid_) {
-      const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+      const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
 
       if (overflow > 0) {
-        v_edges_[i][j].congCNT++;
-        v_edges_[i][j].last_usage += overflow;
+        v_edges_.congCNT(i, j)++;
+        v_edges_.last_usage(i, j) += overflow;
       } else {
         if (!stopDEC) {
-          v_edges_[i][j].congCNT--;
-          v_edges_[i][j].congCNT = std::max<int>(0, v_edges_[i][j].congCNT);
-          v_edges_[i][j].last_usage = v_edges_[i][j].last_usage * 0.9;
+          v_edges_.congCNT(i, j)--;
+          v_edges_.congCNT(i, j) = std::max<int>(0, v_edges_.congCNT(i, j));
+          v_edges_.last_usage(i, j) = v_edges_.last_usage(i, j) * 0.9;
         }
       }
-      maxlimit = std::max<int>(maxlimit, v_edges_[i][j].last_usage);
+      maxlimit = std::max<int>(maxlimit, v_edges_.last_usage(i, j));
     }
   }
 
@@ -728,20 +759,24 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 // d2        - the distance of any grid from the destination subtree t2
 // src_heap  - the heap storing the addresses for d1
 // dest_heap - the heap storing the addresses for d2
-void FastRouteCore::setupHeap(const int netID,
+void FastRouteCore::setupHeap(MazeSearchSpace& space,
+                              const int netID,
                               const int edgeID,
-                              std::vector<float*>& src_heap,
-                              std::vector<float*>& dest_heap,
-                              multi_array<float, 2>& d1,
-                              multi_array<float, 2>& d2,
                               const int regionX1,
                               const int regionX2,
                               const int regionY1,
                               const int regionY2)
 {
+  auto& src_heap = space.src_heap;
+  auto& dest_heap = space.dest_heap;
+  auto& d1 = space.d1;
+  auto& d2 = space.d2;
+  auto& in_region = space.in_region;
+  auto& corr_edge = space.corr_edge;
+
   for (int i = regionY1; i <= regionY2; i++) {
     for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
+      in_region[i][j] = true;
   }
 
   const auto& treeedges = sttrees_[netID].edges;
@@ -808,12 +843,12 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into src_heap if in enlarged region
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region[nbr_node.y][nbr_node.x]) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d1[nbrY][nbrX] = 0;
             src_heap.push_back(&d1[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            corr_edge[nbrY][nbrX] = edge;
           }
           const Route* route = &(treeedges[edge].route);
           if (route->type != RouteType::MazeRoute) {
@@ -825,10 +860,10 @@ void FastRouteCore::setupHeap(const int netID,
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
 
-            if (in_region_[y_grid][x_grid]) {
+            if (in_region[y_grid][x_grid]) {
               d1[y_grid][x_grid] = 0;
               src_heap.push_back(&d1[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if not a degraded edge (len>0)
@@ -878,12 +913,12 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into dest_heap
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region[nbr_node.y][nbr_node.x]) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d2[nbrY][nbrX] = 0;
             dest_heap.push_back(&d2[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            corr_edge[nbrY][nbrX] = edge;
           }
 
           const Route* route = &(treeedges[edge].route);
@@ -895,10 +930,10 @@ void FastRouteCore::setupHeap(const int netID,
           for (int j = 1; j < route->routelen; j++) {
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
-            if (in_region_[y_grid][x_grid]) {
+            if (in_region[y_grid][x_grid]) {
               d2[y_grid][x_grid] = 0;
               dest_heap.push_back(&d2[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if the edge is not degraded (len>0)
@@ -912,7 +947,7 @@ void FastRouteCore::setupHeap(const int netID,
 
   for (int i = regionY1; i <= regionY2; i++) {
     for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
+      in_region[i][j] = false;
   }
 }
 
@@ -1303,6 +1338,54 @@ float getCost(const int i,
   return cost;
 }
 
+void MazeSearchSpace::resize(const int x_range,
+                             const int y_range,
+                             const int x_grid,
+                             const int y_grid,
+                             const float unreached)
+{
+  if (d1.shape()[0] == y_range && d1.shape()[1] == x_range
+      && parent_x1.shape()[0] == y_grid && parent_x1.shape()[1] == x_grid) {
+    return;
+  }
+  d1.resize(boost::extents[y_range][x_range]);
+  d2.resize(boost::extents[y_range][x_range]);
+  corr_edge.resize(boost::extents[y_range][x_range]);
+  hv.resize(boost::extents[y_range][x_range]);
+  hyper_v.resize(boost::extents[y_range][x_range]);
+  hyper_h.resize(boost::extents[y_range][x_range]);
+  in_region.resize(boost::extents[y_range][x_range]);
+  std::fill_n(in_region.data(), in_region.num_elements(), false);
+  parent_x1.resize(boost::extents[y_grid][x_grid]);
+  parent_y1.resize(boost::extents[y_grid][x_grid]);
+  parent_x3.resize(boost::extents[y_grid][x_grid]);
+  parent_y3.resize(boost::extents[y_grid][x_grid]);
+  pop_heap2.assign(y_grid * x_range, false);
+  src_heap.reserve(y_grid * x_grid);
+  dest_heap.reserve(y_grid * x_grid);
+  heap_pos.assign(d1.num_elements(), -1);
+  std::fill_n(d1.data(), d1.num_elements(), unreached);
+  std::fill_n(d2.data(), d2.num_elements(), unreached);
+  std::fill_n(hyper_v.data(), hyper_v.num_elements(), false);
+  std::fill_n(hyper_h.data(), hyper_h.num_elements(), false);
+  touched.clear();
+}
+
+void MazeSearchSpace::resetTouched(const float unreached)
+{
+  float* d1_base = d1.data();
+  float* d2_base = d2.data();
+  bool* hyper_v_base = hyper_v.data();
+  bool* hyper_h_base = hyper_h.data();
+  for (const int idx : touched) {
+    d1_base[idx] = unreached;
+    d2_base[idx] = unreached;
+    hyper_v_base[idx] = false;
+    hyper_h_base[idx] = false;
+  }
+  touched.clear();
+}
+
 void FastRouteCore::mazeRouteMSMD(const int iter,
                                   const int expand,
                                   const float cost_height,
@@ -1317,9 +1400,8 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
                                   float& slack_th)
 {
   // maze routing for multi-source, multi-destination
-  int tmpX, tmpY;
-
   const int max_usage_multiplier = 40;
+  const auto start = std::chrono::steady_clock::now();
 
   // allocate memory for distance and parent and pop_heap
   h_cost_table_.resize(max_usage_multiplier * h_capacity_);
@@ -1334,11 +1416,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
         = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
   if (ordering) {
     if (critical_nets_percentage_) {
       slack_th = CalculatePartialSlack();
@@ -1346,790 +1423,990 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
     StNetOrder();
   }
 
-  std::vector<float*> src_heap;
-  std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
-
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
-
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
+  maze_spaces_.resize(std::max(maze_thread_count_, 1));
+  for (MazeSearchSpace& space : maze_spaces_) {
+    space.resize(x_range_, y_range_, x_grid_, y_grid_, BIG_INT);
+    space.num_searches = 0;
+    space.num_touched = 0;
+  }
 
+  std::vector<int> net_order(net_ids_.size());
   for (int nidRPC = 0; nidRPC < net_ids_.size(); nidRPC++) {
-    const int netID
+    net_order[nidRPC]
         = ordering ? tree_order_cong_[nidRPC].treeIndex : net_ids_[nidRPC];
+  }
 
-    const int num_terminals = sttrees_[netID].num_terminals;
+  if (maze_thread_count_ > 0) {
+    mazeRouteMSMDParallel(net_order,
+                          iter,
+                          expand,
+                          cost_height,
+                          ripup_threshold,
+                          maze_edge_threshold,
+                          cost_type,
+                          logis_cof,
+                          via,
+                          slope,
+                          L,
+                          slack_th);
+  } else {
+    MazeSearchSpace& space = maze_spaces_[0];
+    for (int nidRPC = 0; nidRPC < net_order.size(); nidRPC++) {
+      const int netID = net_order[nidRPC];
+      int last_enlarge = -1;
+      const bool routed = mazeRouteNet(space,
+                                       netID,
+                                       iter,
+                                       expand,
+                                       cost_height,
+                                       ripup_threshold,
+                                       maze_edge_threshold,
+                                       cost_type,
+                                       logis_cof,
+                                       via,
+                                       slope,
+                                       L,
+                                       slack_th,
+                                       route_region_,
+                                       last_enlarge);
+      if (last_enlarge >= 0) {
+        enlarge_ = last_enlarge;
+      }
+      mergeUsedGrids(space);
+      if (!routed) {
+        reInitTree(netID);
+        nidRPC--;
+      }
+    }
+  }
 
-    const int origENG = expand;
+  if (logger_->debugCheck(GRT, "maze_stats", 1)) {
+    int64 num_searches = 0;
+    int64 num_touched = 0;
+    for (const MazeSearchSpace& space : maze_spaces_) {
+      num_searches += space.num_searches;
+      num_touched += space.num_touched;
+    }
+    const std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    logger_->report(
+        "maze 2D iter {}: {} searches, {} grids touched, {:.3f} s.",
+        iter,
+        num_searches,
+        num_touched,
+        elapsed.count());
+  }
 
-    netedgeOrderDec(netID);
+  h_cost_table_.clear();
+  v_cost_table_.clear();
+}
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
+// Routes the nets in batches whose search boxes do not overlap.  A net
+// never reads or writes edge usage outside of its box (the current tree
+// and routes bloated by expand), so the nets of a batch are independent
+// and the result does not depend on the number of threads.  A net is
+// placed in the batch after the last earlier net it overlaps, which keeps
+// the routing order of conflicting nets.
+void FastRouteCore::mazeRouteMSMDParallel(const std::vector<int>& net_order,
+                                          const int iter,
+                                          const int expand,
+                                          const float cost_height,
+                                          const int ripup_threshold,
+                                          const int maze_edge_threshold,
+                                          const int cost_type,
+                                          const float logis_cof,
+                                          const int via,
+                                          const int slope,
+                                          const int L,
+                                          const float slack_th)
+{
+  const int num_nets = net_order.size();
+  std::vector<odb::Rect> boxes(num_nets);
+  for (int i = 0; i < num_nets; i++) {
+    boxes[i] = netRouteBox(net_order[i], expand, route_region_);
+  }
+
+  const std::vector<std::vector<int>> batches = batchByRegion(boxes);
+
+  debugPrint(logger_,
+             utl::GRT,
+             "maze_2d",
+             1,
+             "Routing {} nets in {} batches with {} threads.",
+             num_nets,
+             batches.size(),
+             maze_thread_count_);
+
+  // enlarge_ keeps the value of the last routed edge, as in the serial
+  // flow
+  int last_routed = -1;
+  std::vector<int> last_enlarge(num_nets, -1);
+  std::vector<char> routed(num_nets, true);
+  for (const std::vector<int>& batch : batches) {
+    std::exception_ptr exception = nullptr;
+#pragma omp parallel for schedule(dynamic) num_threads(maze_thread_count_)
+    for (int i = 0; i < batch.size(); i++) {
+      const int idx = batch[i];
+      try {
+        routed[idx] = mazeRouteNet(maze_spaces_[omp_get_thread_num()],
+                                   net_order[idx],
+                                   iter,
+                                   expand,
+                                   cost_height,
+                                   ripup_threshold,
+                                   maze_edge_threshold,
+                                   cost_type,
+                                   logis_cof,
+                                   via,
+                                   slope,
+                                   L,
+                                   slack_th,
+                                   boxes[idx],
+                                   last_enlarge[idx]);
+      } catch (...) {
+#pragma omp critical
+        exception = std::current_exception();
       }
+    }
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    for (MazeSearchSpace& space : maze_spaces_) {
+      mergeUsedGrids(space);
+    }
+
+    // trees that could not be updated are rebuilt and routed again in
+    // order
+    for (const int idx : batch) {
+      while (!routed[idx]) {
+        reInitTree(net_order[idx]);
+        routed[idx] = mazeRouteNet(maze_spaces_[0],
+                                   net_order[idx],
+                                   iter,
+                                   expand,
+                                   cost_height,
+                                   ripup_threshold,
+                                   maze_edge_threshold,
+                                   cost_type,
+                                   logis_cof,
+                                   via,
+                                   slope,
+                                   L,
+                                   slack_th,
+                                   boxes[idx],
+                                   last_enlarge[idx]);
+        mergeUsedGrids(maze_spaces_[0]);
+      }
+      if (last_enlarge[idx] >= 0) {
+        last_routed = std::max(last_routed, idx);
+      }
+    }
+  }
+  if (last_routed >= 0) {
+    enlarge_ = last_enlarge[last_routed];
+  }
+}
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
+void FastRouteCore::mergeUsedGrids(MazeSearchSpace& space)
+{
+  h_used_ggrid_.insert(space.h_used_ggrid.begin(), space.h_used_ggrid.end());
+  v_used_ggrid_.insert(space.v_used_ggrid.begin(), space.v_used_ggrid.end());
+  space.h_used_ggrid.clear();
+  space.v_used_ggrid.clear();
+}
 
-      if (!enter) {
-        continue;
-      }
+void FastRouteCore::mergeUsedGrids(PatternRouteSpace& space)
+{
+  h_used_ggrid_.insert(space.h_used_ggrid.begin(), space.h_used_ggrid.end());
+  v_used_ggrid_.insert(space.v_used_ggrid.begin(), space.v_used_ggrid.end());
+  space.h_used_ggrid.clear();
+  space.v_used_ggrid.clear();
+}
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+// Rips up and reroutes the congested edges of one net.  Searches stay
+// inside bounds.  Returns false if the tree could not be updated and has
+// to be rebuilt with reInitTree.
+bool FastRouteCore::mazeRouteNet(MazeSearchSpace& space,
+                                 const int netID,
+                                 const int iter,
+                                 const int expand,
+                                 const float cost_height,
+                                 const int ripup_threshold,
+                                 const int maze_edge_threshold,
+                                 const int cost_type,
+                                 const float logis_cof,
+                                 const int via,
+                                 const int slope,
+                                 const int L,
+                                 const float slack_th,
+                                 const odb::Rect& bounds,
+                                 int& last_enlarge)
+{
+  auto& d1 = space.d1;
+  auto& d2 = space.d2;
+  auto& src_heap = space.src_heap;
+  auto& dest_heap = space.dest_heap;
+  auto& pop_heap2 = space.pop_heap2;
+  auto& corr_edge = space.corr_edge;
+  auto& parent_x1 = space.parent_x1;
+  auto& parent_y1 = space.parent_y1;
+  auto& parent_x3 = space.parent_x3;
+  auto& parent_y3 = space.parent_y3;
+  auto& hv = space.hv;
+  auto& hyper_v = space.hyper_v;
+  auto& hyper_h = space.hyper_h;
+  auto& net_eo = space.net_eo;
+  auto& heap_pos = space.heap_pos;
+  auto& touched = space.touched;
+  const float* d1_base = d1.data();
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+  int tmpX, tmpY;
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+  const int num_terminals = sttrees_[netID].num_terminals;
 
-      int decrease = 0;
+  const int origENG = expand;
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
-        }
-      }
+  netedgeOrderDec(netID, net_eo);
 
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
+      continue;
+    }
+
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
+
+    if (!enter) {
+      continue;
+    }
+
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    const int enlarge
+        = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+    last_enlarge = enlarge;
+
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    const int regionX1 = std::max(xmin - enlarge + decrease, bounds.xMin());
+    const int regionX2 = std::min(xmax + enlarge - decrease, bounds.xMax());
+    const int regionY1 = std::max(ymin - enlarge + decrease, bounds.yMin());
+    const int regionY2 = std::min(ymax + enlarge - decrease, bounds.yMax());
+
+    // d1[][] and d2[][] are BIG_INT everywhere except on the grids reached
+    // by the previous search, so only those need to be reset
+    space.resetTouched(BIG_INT);
+
+    // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
+    // grids on the two subtrees
+    setupHeap(
+        space, netID, edgeID, regionX1, regionX2, regionY1, regionY2);
+    for (int i = 0; i < src_heap.size(); i++) {
+      heap_pos[src_heap[i] - d1_base] = i;
+      touched.push_back(src_heap[i] - d1_base);
+    }
+    for (const float* dest : dest_heap) {
+      touched.push_back(dest - &d2[0][0]);
+    }
+
+    // while loop to find shortest path
+    int ind1 = (src_heap[0] - &d1[0][0]);
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = ind1 % x_range_;
+      const int curY = ind1 / x_range_;
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv[curY][curX]) {
+          preX = parent_x1[curY][curX];
+          preY = parent_y1[curY][curX];
         } else {
-          preX = curX;
-          preY = curY;
+          preX = parent_x3[curY][curX];
+          preY = parent_y3[curY][curX];
         }
+      } else {
+        preX = curX;
+        preY = curY;
+      }
+
+      removeMin(src_heap, d1_base, heap_pos);
 
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_.usage_red(curY, curX - 1)
+                         + L * h_edges_.last_usage(curY, (curX - 1));
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_.usage_red(curY, curX)
+                             + L * h_edges_.last_usage(curY, curX);
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY][curX + 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX - 1;  // the left neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // left neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          pushHeap(src_heap, d1_base, heap_pos, &d1[curY][tmpX]);
+          touched.push_back(&d1[curY][tmpX] - d1_base);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          const float* dtmp = &d1[curY][tmpX];
+          updateHeap(src_heap, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
         }
-        // right
-        if (curX < regionX2) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      }
+      // right
+      if (curX < regionX2) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_.usage_red(curY, curX)
+                         + L * h_edges_.last_usage(curY, curX);
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_.usage_red(curY, curX - 1)
+                             + L * h_edges_.last_usage(curY, curX - 1);
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY][curX - 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX + 1;  // the right neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // right neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          pushHeap(src_heap, d1_base, heap_pos, &d1[curY][tmpX]);
+          touched.push_back(&d1[curY][tmpX] - d1_base);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          const float* dtmp = &d1[curY][tmpX];
+          updateHeap(src_heap, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
         }
-        // bottom
-        if (curY > regionY1) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // bottom
+      if (curY > regionY1) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_.usage_red(curY - 1, curX)
+                         + L * v_edges_.last_usage(curY - 1, curX);
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_.usage_red(curY, curX)
+                             + L * v_edges_.last_usage(curY, curX);
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY + 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpY = curY - 1;  // the bottom neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          pushHeap(src_heap, d1_base, heap_pos, &d1[tmpY][curX]);
+          touched.push_back(&d1[tmpY][curX] - d1_base);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          const float* dtmp = &d1[tmpY][curX];
+          updateHeap(src_heap, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
         }
-        // top
-        if (curY < regionY2) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // top
+      if (curY < regionY2) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_.usage_red(curY, curX)
+                         + L * v_edges_.last_usage(curY, curX);
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_.usage_red(curY - 1, curX)
+                             + L * v_edges_.last_usage(curY - 1, curX);
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY - 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
+        tmpY = curY + 1;  // the top neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // top neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          pushHeap(src_heap, d1_base, heap_pos, &d1[tmpY][curX]);
+          touched.push_back(&d1[tmpY][curX] - d1_base);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          const float* dtmp = &d1[tmpY][curX];
+          updateHeap(src_heap, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
+        }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = (src_heap[0] - &d1[0][0]);
 
-      }  // while loop
+    }  // while loop
+    space.num_searches++;
+    space.num_touched += touched.size();
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = ind1 % x_range_;
+    const int crossY = ind1 / x_range_;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv[tmpY][tmpX]) {
+          curY = parent_y1[tmpY][tmpX];
+        } else {
+          curX = parent_x3[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
-        // split neighbor edge and return id new node
-        n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
+
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
+      // split neighbor edge and return id new node
+      n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    }
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
       }
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType2.",
+                     nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType2.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
-        // split neighbor edge and return id new node
-        n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    // (2) consider subtree2
+    if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
+      // split neighbor edge and return id new node
+      n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    }
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
       }
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType1.",
+                     nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType1.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType2.",
+                     nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType2.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-      }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
-      }
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+    int edgeCost = nets_[netID]->getEdgeCost();
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-        }
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_.usage(min_y, gridsX[i]) += edgeCost;
+        space.v_used_ggrid.emplace_back(min_y, gridsX[i]);
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_.usage(gridsY[i], min_x) += edgeCost;
+        space.h_used_ggrid.emplace_back(gridsY[i], min_x);
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+  }  // loop edgeID
 
-  h_cost_table_.clear();
-  v_cost_table_.clear();
+  return true;
 }
 
 void FastRouteCore::findCongestedEdgesNets(
@@ -2194,12 +2471,12 @@ void FastRouteCore::getCongestionGrid(
 
   for (int i = 0; i < y_grid_; i++) {
     for (int j = 0; j < x_grid_ - 1; j++) {
-      const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+      const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
       if (overflow > 0) {
         const int xreal = tile_size_ * (j + 0.5) + x_corner_;
         const int yreal = tile_size_ * (i + 0.5) + y_corner_;
-        const int usage = h_edges_[i][j].usage;
-        const int capacity = h_edges_[i][j].cap;
+        const int usage = h_edges_.usage(i, j);
+        const int capacity = h_edges_.cap(i, j);
         nets_in_congested_edges[{xreal, yreal}].congestion = {capacity, usage};
       }
     }
@@ -2217,12 +2494,12 @@ void FastRouteCore::getCongestionGrid(
 
   for (int i = 0; i < y_grid_ - 1; i++) {
     for (int j = 0; j < x_grid_; j++) {
-      const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+      const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
       if (overflow > 0) {
         const int xreal = tile_size_ * (j + 0.5) + x_corner_;
         const int yreal = tile_size_ * (i + 0.5) + y_corner_;
-        const int usage = v_edges_[i][j].usage;
-        const int capacity = v_edges_[i][j].cap;
+        const int usage = v_edges_.usage(i, j);
+        const int capacity = v_edges_.cap(i, j);
         nets_in_congested_edges[{xreal, yreal}].congestion = {capacity, usage};
       }
     }
@@ -2291,7 +2568,7 @@ void FastRouteCore::getCongestionNets(std::set<odb::dbNet*>& congestion_nets)
   int n = 0;
   // Find horizontal ggrids with congestion
   for (const auto& [i, j] : h_used_ggrid_) {
-    const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+    const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
     if (overflow > 0) {
       xs.push_back(j);
       ys.push_back(i);
@@ -2301,7 +2578,7 @@ void FastRouteCore::getCongestionNets(std::set<odb::dbNet*>& congestion_nets)
   }
   // Find vertical ggrids with congestion
   for (const auto& [i, j] : v_used_ggrid_) {
-    const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+    const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
     if (overflow > 0) {
       xs.push_back(j);
       ys.push_back(i);
@@ -2336,8 +2613,8 @@ int FastRouteCore::getOverflow2Dmaze(int* maxOverflow, int* tUsage)
 
   int total_usage = 0;
   for (const auto& [i, j] : h_used_ggrid_) {
-    total_usage += h_edges_[i][j].usage;
-    const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
+    total_usage += h_edges_.usage(i, j);
+    const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
     if (overflow > 0) {
       H_overflow += overflow;
       max_H_overflow = std::max(max_H_overflow, overflow);
@@ -2346,8 +2623,8 @@ int FastRouteCore::getOverflow2Dmaze(int* maxOverflow, int* tUsage)
   }
 
   for (const auto& [i, j] : v_used_ggrid_) {
-    total_usage += v_edges_[i][j].usage;
-    const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
+    total_usage += v_edges_.usage(i, j);
+    const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
     if (overflow > 0) {
       V_overflow += overflow;
       max_V_overflow = std::max(max_V_overflow, overflow);
@@ -2399,9 +2676,9 @@ int FastRouteCore::getOverflow2D(int* maxOverflow)
   int total_usage = 0;
 
   for (const auto& [i, j] : h_used_ggrid_) {
-    total_usage += h_edges_[i][j].est_usage;
-    const int overflow = h_edges_[i][j].est_usage - h_edges_[i][j].cap;
-    hCap += h_edges_[i][j].cap;
+    total_usage += h_edges_.est_usage(i, j);
+    const int overflow = h_edges_.est_usage(i, j) - h_edges_.cap(i, j);
+    hCap += h_edges_.cap(i, j);
     if (overflow > 0) {
       H_overflow += overflow;
       max_H_overflow = std::max(max_H_overflow, overflow);
@@ -2410,9 +2687,9 @@ int FastRouteCore::getOverflow2D(int* maxOverflow)
   }
 
   for (const auto& [i, j] : v_used_ggrid_) {
-    total_usage += v_edges_[i][j].est_usage;
-    const int overflow = v_edges_[i][j].est_usage - v_edges_[i][j].cap;
-    vCap += v_edges_[i][j].cap;
+    total_usage += v_edges_.est_usage(i, j);
+    const int overflow = v_edges_.est_usage(i, j) - v_edges_.cap(i, j);
+    vCap += v_edges_.cap(i, j);
     if (overflow > 0) {
       V_overflow += overflow;
       max_V_overflow = std::max(max_V_overflow, overflow);
@@ -2460,8 +2737,8 @@ int FastRouteCore::getOverflow3D()
 
   for (int k = 0; k < num_layers_; k++) {
     for (const auto& [i, j] : h_used_ggrid_) {
-      total_usage += h_edges_3D_[k][i][j].usage;
-      overflow = h_edges_3D_[k][i][j].usage - h_edges_3D_[k][i][j].cap;
+      total_usage += h_edges_3D_.usage(k, i, j);
+      overflow = h_edges_3D_.usage(k, i, j) - h_edges_3D_.cap(k, i, j);
 
       if (overflow > 0) {
         H_overflow += overflow;
@@ -2469,8 +2746,8 @@ int FastRouteCore::getOverflow3D()
       }
     }
     for (const auto& [i, j] : v_used_ggrid_) {
-      total_usage += v_edges_3D_[k][i][j].usage;
-      overflow = v_edges_3D_[k][i][j].usage - v_edges_3D_[k][i][j].cap;
+      total_usage += v_edges_3D_.usage(k, i, j);
+      overflow = v_edges_3D_.usage(k, i, j) - v_edges_3D_.cap(k, i, j);
       if (overflow > 0) {
         V_overflow += overflow;
         max_V_overflow = std::max(max_V_overflow, overflow);
@@ -2485,35 +2762,41 @@ int FastRouteCore::getOverflow3D()
 
 void FastRouteCore::InitEstUsage()
 {
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
-      h_edges_[i][j].est_usage = 0;
+  const int h_x_max = std::min(route_region_.xMax(), x_grid_ - 2);
+  const int v_y_max = std::min(route_region_.yMax(), y_grid_ - 2);
+
+  for (int i = route_region_.yMin(); i <= route_region_.yMax(); i++) {
+    for (int j = route_region_.xMin(); j <= h_x_max; j++) {
+      h_edges_.est_usage(i, j) = 0;
     }
   }
 
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      v_edges_[i][j].est_usage = 0;
+  for (int i = route_region_.yMin(); i <= v_y_max; i++) {
+    for (int j = route_region_.xMin(); j <= route_region_.xMax(); j++) {
+      v_edges_.est_usage(i, j) = 0;
     }
   }
 }
 
 void FastRouteCore::str_accu(const int rnd)
 {
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
-      const int overflow = h_edges_[i][j].usage - h_edges_[i][j].cap;
-      if (overflow > 0 || h_edges_[i][j].congCNT > rnd) {
-        h_edges_[i][j].last_usage += h_edges_[i][j].congCNT * overflow / 2;
+  const int h_x_max = std::min(route_region_.xMax(), x_grid_ - 2);
+  const int v_y_max = std::min(route_region_.yMax(), y_grid_ - 2);
+
+  for (int i = route_region_.yMin(); i <= route_region_.yMax(); i++) {
+    for (int j = route_region_.xMin(); j <= h_x_max; j++) {
+      const int overflow = h_edges_.usage(i, j) - h_edges_.cap(i, j);
+      if (overflow > 0 || h_edges_.congCNT(i, j) > rnd) {
+        h_edges_.last_usage(i, j) += h_edges_.congCNT(i, j) * overflow / 2;
       }
     }
   }
 
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      const int overflow = v_edges_[i][j].usage - v_edges_[i][j].cap;
-      if (overflow > 0 || v_edges_[i][j].congCNT > rnd) {
-        v_edges_[i][j].last_usage += v_edges_[i][j].congCNT * overflow / 2;
+  for (int i = route_region_.yMin(); i <= v_y_max; i++) {
+    for (int j = route_region_.xMin(); j <= route_region_.xMax(); j++) {
+      const int overflow = v_edges_.usage(i, j) - v_edges_.cap(i, j);
+      if (overflow > 0 || v_edges_.congCNT(i, j) > rnd) {
+        v_edges_.last_usage(i, j) += v_edges_.congCNT(i, j) * overflow / 2;
       }
     }
   }
@@ -2521,40 +2804,43 @@ void FastRouteCore::str_accu(const int rnd)
 
 void FastRouteCore::InitLastUsage(const int upType)
 {
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_ - 1; j++) {
-      h_edges_[i][j].last_usage = 0;
+  const int h_x_max = std::min(route_region_.xMax(), x_grid_ - 2);
+  const int v_y_max = std::min(route_region_.yMax(), y_grid_ - 2);
+
+  for (int i = route_region_.yMin(); i <= route_region_.yMax(); i++) {
+    for (int j = route_region_.xMin(); j <= h_x_max; j++) {
+      h_edges_.last_usage(i, j) = 0;
     }
   }
 
-  for (int i = 0; i < y_grid_ - 1; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      v_edges_[i][j].last_usage = 0;
+  for (int i = route_region_.yMin(); i <= v_y_max; i++) {
+    for (int j = route_region_.xMin(); j <= route_region_.xMax(); j++) {
+      v_edges_.last_usage(i, j) = 0;
     }
   }
 
   if (upType == 1) {
-    for (int i = 0; i < y_grid_; i++) {
-      for (int j = 0; j < x_grid_ - 1; j++) {
-        h_edges_[i][j].congCNT = 0;
+    for (int i = route_region_.yMin(); i <= route_region_.yMax(); i++) {
+      for (int j = route_region_.xMin(); j <= h_x_max; j++) {
+        h_edges_.congCNT(i, j) = 0;
       }
     }
 
-    for (int i = 0; i < y_grid_ - 1; i++) {
-      for (int j = 0; j < x_grid_; j++) {
-        v_edges_[i][j].congCNT = 0;
+    for (int i = route_region_.yMin(); i <= v_y_max; i++) {
+      for (int j = route_region_.xMin(); j <= route_region_.xMax(); j++) {
+        v_edges_.congCNT(i, j) = 0;
       }
     }
   } else if (upType == 2) {
-    for (int i = 0; i < y_grid_; i++) {
-      for (int j = 0; j < x_grid_ - 1; j++) {
-        h_edges_[i][j].last_usage = h_edges_[i][j].last_usage * 0.2;
+    for (int i = route_region_.yMin(); i <= route_region_.yMax(); i++) {
+      for (int j = route_region_.xMin(); j <= h_x_max; j++) {
+        h_edges_.last_usage(i, j) = h_edges_.last_usage(i, j) * 0.2;
       }
     }
 
-    for (int i = 0; i < y_grid_ - 1; i++) {
-      for (int j = 0; j < x_grid_; j++) {
-        v_edges_[i][j].last_usage = v_edges_[i][j].last_usage * 0.2;
+    for (int i = route_region_.yMin(); i <= v_y_max; i++) {
+      for (int j = route_region_.xMin(); j <= route_region_.xMax(); j++) {
+        v_edges_.last_usage(i, j) = v_edges_.last_usage(i, j) * 0.2;
       }
     }
   }
@@ -31,6 +31,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <chrono>
 
 #include "DataType.h"
 #include "FastRoute.h"
@@ -41,12 +42,6 @@ namespace grt {
 
 using utl::GRT;
 
-struct parent3D
-{
-  short l;
-  int x, y;
-};
-
 static int parent_index(int i)
 {
   return (i - 1) / 2;
@@ -63,7 +58,10 @@ static int right_index(int i)
 }
 
 // non recursive version of heapify-
-static void heapify3D(std::vector<int*>& array)
+// heap_pos maps a grid index (offset from base) to its slot in the heap.
+static void heapify3D(std::vector<int*>& array,
+                      const int* base,
+                      std::vector<int>& heap_pos)
 {
   bool stop = false;
   const int heapSize = array.size();
@@ -86,33 +84,91 @@ static void heapify3D(std::vector<int*>& array)
     }
     if (smallest != i) {
       array[i] = array[smallest];
+      heap_pos[array[i] - base] = i;
       i = smallest;
     } else {
       array[i] = tmp;
+      heap_pos[tmp - base] = i;
       stop = true;
     }
   } while (!stop);
 }
 
-static void updateHeap3D(std::vector<int*>& array, int i)
+static void updateHeap3D(std::vector<int*>& array,
+                         const int* base,
+                         std::vector<int>& heap_pos,
+                         int i)
 {
   int* tmpi = array[i];
   while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
     const int parent = parent_index(i);
     array[i] = array[parent];
+    heap_pos[array[i] - base] = i;
     i = parent;
   }
   array[i] = tmpi;
+  heap_pos[tmpi - base] = i;
 }
 
 // extract the entry with minimum distance from Priority queue
-static void removeMin3D(std::vector<int*>& array)
+static void removeMin3D(std::vector<int*>& array,
+                        const int* base,
+                        std::vector<int>& heap_pos)
 {
+  heap_pos[array[0] - base] = -1;
   array[0] = array.back();
-  heapify3D(array);
+  heapify3D(array, base, heap_pos);
   array.pop_back();
 }
 
+// add a grid that was not in the heap yet
+static void pushHeap3D(std::vector<int*>& array,
+                       const int* base,
+                       std::vector<int>& heap_pos,
+                       int* entry)
+{
+  array.push_back(entry);
+  updateHeap3D(array, base, heap_pos, array.size() - 1);
+}
+
+void MazeSearchSpace3D::resize(const int num_layers,
+                               const int x_range,
+                               const int y_range,
+                               const int x_grid,
+                               const int y_grid,
+                               const int unreached)
+{
+  if (d1.shape()[0] == num_layers && d1.shape()[1] == y_range
+      && d1.shape()[2] == x_range && parent.shape()[1] == y_grid
+      && parent.shape()[2] == x_grid) {
+    return;
+  }
+  directions.resize(boost::extents[num_layers][y_grid][x_grid]);
+  corr_edge.resize(boost::extents[num_layers][y_grid][x_grid]);
+  parent.resize(boost::extents[num_layers][y_grid][x_grid]);
+  d1.resize(boost::extents[num_layers][y_range][x_range]);
+  d2.resize(boost::extents[num_layers][y_range][x_range]);
+  std::fill_n(d1.data(), d1.num_elements(), unreached);
+  std::fill_n(d2.data(), d2.num_elements(), unreached);
+  pop_heap2.assign(d1.num_elements(), false);
+  heap_pos.assign(d1.num_elements(), -1);
+  const int64 grid_size = static_cast<int64>(num_layers) * y_grid * x_grid;
+  src_heap.reserve(grid_size);
+  dest_heap.reserve(grid_size);
+  touched.clear();
+}
+
+void MazeSearchSpace3D::resetTouched(const int unreached)
+{
+  int* d1_base = d1.data();
+  int* d2_base = d2.data();
+  for (const int idx : touched) {
+    d1_base[idx] = unreached;
+    d2_base[idx] = unreached;
+  }
+  touched.clear();
+}
+
 void FastRouteCore::addNeighborPoints(const int netID,
                                       const int n1,
                                       const int n2,
@@ -786,20 +842,22 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                                          int ripupTHlb,
                                          int ripupTHub)
 {
-  static multi_array<Direction, 3> directions_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<int, 3> corr_edge_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<parent3D, 3> pr_3D_(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-
-  int64 total_size = static_cast<int64>(num_layers_) * y_range_ * x_range_;
-  static std::vector<bool> pop_heap2_3D(total_size, false);
-
-  // allocate memory for priority queue
-  total_size = static_cast<int64>(y_grid_) * x_grid_ * num_layers_;
-  static std::vector<int*> src_heap_3D(total_size);
-  static std::vector<int*> dest_heap_3D(total_size);
+  MazeSearchSpace3D& space = maze_space_3D_;
+  const auto start = std::chrono::steady_clock::now();
+  space.resize(num_layers_, x_range_, y_range_, x_grid_, y_grid_, BIG_INT);
+  space.num_searches = 0;
+  space.num_touched = 0;
+  auto& directions_3D = space.directions;
+  auto& corr_edge_3D = space.corr_edge;
+  auto& pr_3D_ = space.parent;
+  auto& pop_heap2_3D = space.pop_heap2;
+  auto& src_heap_3D = space.src_heap;
+  auto& dest_heap_3D = space.dest_heap;
+  auto& d1_3D = space.d1;
+  auto& d2_3D = space.d2;
+  auto& heap_pos = space.heap_pos;
+  auto& touched = space.touched;
+  const int* d1_base = d1_3D.data();
 
   for (int i = 0; i < y_grid_; i++) {
     for (int j = 0; j < x_grid_; j++) {
@@ -809,11 +867,6 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
 
   const int endIND = tree_order_pv_.size() * 0.9;
 
-  static multi_array<int, 3> d1_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-  static multi_array<int, 3> d2_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-
   for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
     const int netID = tree_order_pv_[orderIndex].treeIndex;
 
@@ -863,14 +916,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
       // initialize pop_src_heap_3D_[] and pop_heap2_3D[] as false (for
       // detecting the shortest path is found or not)
 
-      for (int k = 0; k < num_layers_; k++) {
-        for (int i = regionY1; i <= regionY2; i++) {
-          for (int j = regionX1; j <= regionX2; j++) {
-            d1_3D[k][i][j] = BIG_INT;
-            d2_3D[k][i][j] = BIG_INT;
-          }
-        }
-      }
+      // d1_3D and d2_3D are BIG_INT everywhere except on the grids reached by
+      // the previous search
+      space.resetTouched(BIG_INT);
 
       // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
       // d2_3D[][] for all the grids on the two subtrees
@@ -886,6 +934,13 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                   regionX2,
                   regionY1,
                   regionY2);
+      for (int i = 0; i < src_heap_3D.size(); i++) {
+        heap_pos[src_heap_3D[i] - d1_base] = i;
+        touched.push_back(src_heap_3D[i] - d1_base);
+      }
+      for (const int* dest : dest_heap_3D) {
+        touched.push_back(dest - &d2_3D[0][0][0]);
+      }
 
       // while loop to find shortest path
       int ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
@@ -903,7 +958,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         const int remd = ind1 % (grid_hv_);
         const int curX = remd % x_range_;
         const int curY = remd / x_range_;
-        removeMin3D(src_heap_3D);
+        removeMin3D(src_heap_3D, d1_base, heap_pos);
 
         const bool Horizontal
             = layer_directions_[curL] == odb::dbTechLayerDir::HORIZONTAL;
@@ -913,8 +968,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
           if (curX > regionX1
               && directions_3D[curL][curY][curX] != Direction::East) {
             const float tmp = d1_3D[curL][curY][curX] + 1;
-            if (h_edges_3D_[curL][curY][curX - 1].usage
-                    < h_edges_3D_[curL][curY][curX - 1].cap
+            if (h_edges_3D_.usage(curL, curY, curX - 1)
+                    < h_edges_3D_.cap(curL, curY, curX - 1)
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
               const int tmpX = curX - 1;  // the left neighbor
 
@@ -926,8 +981,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                pushHeap3D(
+                    src_heap_3D, d1_base, heap_pos, &d1_3D[curL][curY][tmpX]);
+                touched.push_back(&d1_3D[curL][curY][tmpX] - d1_base);
               } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // left neighbor been put into src_heap_3D
                                  // but needs update
@@ -938,10 +994,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
                 const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                updateHeap3D(
+                    src_heap_3D, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
               }
             }
           }
@@ -951,8 +1005,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             const float tmp = d1_3D[curL][curY][curX] + 1;
             const int tmpX = curX + 1;  // the right neighbor
 
-            if (h_edges_3D_[curL][curY][curX].usage
-                    < h_edges_3D_[curL][curY][curX].cap
+            if (h_edges_3D_.usage(curL, curY, curX)
+                    < h_edges_3D_.cap(curL, curY, curX)
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
               if (d1_3D[curL][curY][tmpX]
                   >= BIG_INT)  // right neighbor not been put into
@@ -963,8 +1017,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                pushHeap3D(
+                    src_heap_3D, d1_base, heap_pos, &d1_3D[curL][curY][tmpX]);
+                touched.push_back(&d1_3D[curL][curY][tmpX] - d1_base);
               } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // right neighbor been put into src_heap_3D
                                  // but needs update
@@ -975,10 +1030,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
                 const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                updateHeap3D(
+                    src_heap_3D, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
               }
             }
           }
@@ -988,8 +1041,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
               && directions_3D[curL][curY][curX] != Direction::South) {
             const float tmp = d1_3D[curL][curY][curX] + 1;
             const int tmpY = curY - 1;  // the bottom neighbor
-            if (v_edges_3D_[curL][curY - 1][curX].usage
-                    < v_edges_3D_[curL][curY - 1][curX].cap
+            if (v_edges_3D_.usage(curL, curY - 1, curX)
+                    < v_edges_3D_.cap(curL, curY - 1, curX)
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
               if (d1_3D[curL][tmpY][curX]
                   >= BIG_INT)  // bottom neighbor not been put into
@@ -1000,8 +1053,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                pushHeap3D(
+                    src_heap_3D, d1_base, heap_pos, &d1_3D[curL][tmpY][curX]);
+                touched.push_back(&d1_3D[curL][tmpY][curX] - d1_base);
               } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // bottom neighbor been put into
                                  // src_heap_3D but needs update
@@ -1012,10 +1066,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
                 const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                updateHeap3D(
+                    src_heap_3D, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
               }
             }
           }
@@ -1024,8 +1076,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
               && directions_3D[curL][curY][curX] != Direction::North) {
             const float tmp = d1_3D[curL][curY][curX] + 1;
             const int tmpY = curY + 1;  // the top neighbor
-            if (v_edges_3D_[curL][curY][curX].usage
-                    < v_edges_3D_[curL][curY][curX].cap
+            if (v_edges_3D_.usage(curL, curY, curX)
+                    < v_edges_3D_.cap(curL, curY, curX)
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
               if (d1_3D[curL][tmpY][curX]
                   >= BIG_INT)  // top neighbor not been put into src_heap_3D
@@ -1035,8 +1087,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                pushHeap3D(
+                    src_heap_3D, d1_base, heap_pos, &d1_3D[curL][tmpY][curX]);
+                touched.push_back(&d1_3D[curL][tmpY][curX] - d1_base);
               } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // top neighbor been put into src_heap_3D
                                  // but needs update
@@ -1047,10 +1100,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
                 const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                updateHeap3D(
+                    src_heap_3D, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
               }
             }
           }
@@ -1069,8 +1120,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            pushHeap3D(
+                src_heap_3D, d1_base, heap_pos, &d1_3D[tmpL][curY][curX]);
+            touched.push_back(&d1_3D[tmpL][curY][curX] - d1_base);
           } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
@@ -1081,10 +1133,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
             const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            updateHeap3D(
+                src_heap_3D, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
           }
         }
 
@@ -1101,8 +1151,9 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            pushHeap3D(
+                src_heap_3D, d1_base, heap_pos, &d1_3D[tmpL][curY][curX]);
+            touched.push_back(&d1_3D[tmpL][curY][curX] - d1_base);
           } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
@@ -1113,10 +1164,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
             const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            updateHeap3D(
+                src_heap_3D, d1_base, heap_pos, heap_pos[dtmp - d1_base]);
           }
         }
 
@@ -1129,6 +1178,8 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         // update ind1 for next loop
         ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
       }  // while loop
+      space.num_searches++;
+      space.num_touched += touched.size();
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
         pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = false;
@@ -1541,16 +1592,16 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
           if (gridsX[i] == gridsX[i + 1])  // a vertical edge
           {
             const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-            v_edges_[min_y][gridsX[i]].usage += net->getEdgeCost();
+            v_edges_.usage(min_y, gridsX[i]) += net->getEdgeCost();
             v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-            v_edges_3D_[gridsL[i]][min_y][gridsX[i]].usage
+            v_edges_3D_.usage(gridsL[i], min_y, gridsX[i])
                 += net->getLayerEdgeCost(gridsL[i]);
           } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
           {
             const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-            h_edges_[gridsY[i]][min_x].usage += net->getEdgeCost();
+            h_edges_.usage(gridsY[i], min_x) += net->getEdgeCost();
             h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-            h_edges_3D_[gridsL[i]][gridsY[i]][min_x].usage
+            h_edges_3D_.usage(gridsL[i], gridsY[i], min_x)
                 += net->getLayerEdgeCost(gridsL[i]);
           }
         }
@@ -1562,6 +1613,15 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
       setTreeNodesVariables(netID);
     }
   }
+
+  if (logger_->debugCheck(GRT, "maze_stats", 1)) {
+    const std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    logger_->report("maze 3D: {} searches, {} grids touched, {:.3f} s.",
+                    space.num_searches,
+                    space.num_touched,
+                    elapsed.count());
+  }
 }
 
 }  // namespace grt
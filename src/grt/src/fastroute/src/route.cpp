@@ -30,7 +30,10 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <exception>
 #include <queue>
 
 #include "DataType.h"
@@ -54,24 +57,24 @@ void FastRouteCore::estimateOneSeg(Segment* seg)
   // (x2,y1)-(x2,y2)
   if (seg->x1 == seg->x2) {  // a vertical segment
     for (int i = ymin; i < ymax; i++) {
-      v_edges_[i][seg->x1].est_usage += edgeCost;
+      v_edges_.est_usage(i, seg->x1) += edgeCost;
       v_used_ggrid_.insert(std::make_pair(i, seg->x1));
     }
   } else if (seg->y1 == seg->y2) {  // a horizontal segment
     for (int i = seg->x1; i < seg->x2; i++) {
-      h_edges_[seg->y1][i].est_usage += edgeCost;
+      h_edges_.est_usage(seg->y1, i) += edgeCost;
       h_used_ggrid_.insert(std::make_pair(seg->y1, i));
     }
   } else {  // a diagonal segment
     for (int i = ymin; i < ymax; i++) {
-      v_edges_[i][seg->x1].est_usage += edgeCost / 2.0f;
-      v_edges_[i][seg->x2].est_usage += edgeCost / 2.0f;
+      v_edges_.est_usage(i, seg->x1) += edgeCost / 2.0f;
+      v_edges_.est_usage(i, seg->x2) += edgeCost / 2.0f;
       v_used_ggrid_.insert(std::make_pair(i, seg->x1));
       v_used_ggrid_.insert(std::make_pair(i, seg->x2));
     }
     for (int i = seg->x1; i < seg->x2; i++) {
-      h_edges_[seg->y1][i].est_usage += edgeCost / 2.0f;
-      h_edges_[seg->y2][i].est_usage += edgeCost / 2.0f;
+      h_edges_.est_usage(seg->y1, i) += edgeCost / 2.0f;
+      h_edges_.est_usage(seg->y2, i) += edgeCost / 2.0f;
       h_used_ggrid_.insert(std::make_pair(seg->y1, i));
       h_used_ggrid_.insert(std::make_pair(seg->y2, i));
     }
@@ -86,7 +89,7 @@ void FastRouteCore::routeSegV(Segment* seg)
   const int ymax = std::max(seg->y1, seg->y2);
 
   for (int i = ymin; i < ymax; i++) {
-    v_edges_[i][seg->x1].est_usage += edgeCost;
+    v_edges_.est_usage(i, seg->x1) += edgeCost;
     v_used_ggrid_.insert(std::make_pair(i, seg->x1));
   }
 }
@@ -96,7 +99,7 @@ void FastRouteCore::routeSegH(Segment* seg)
   const int edgeCost = nets_[seg->netID]->getEdgeCost();
 
   for (int i = seg->x1; i < seg->x2; i++) {
-    h_edges_[seg->y1][i].est_usage += edgeCost;
+    h_edges_.est_usage(seg->y1, i) += edgeCost;
     h_used_ggrid_.insert(std::make_pair(seg->y1, i));
   }
 }
@@ -118,18 +121,18 @@ void FastRouteCore::routeSegL(Segment* seg)
     float costL2 = 0;
 
     for (int i = ymin; i < ymax; i++) {
-      const float tmp1 = v_edges_[i][seg->x1].est_usage_red() - v_capacity_lb_;
+      const float tmp1 = v_edges_.est_usage_red(i, seg->x1) - v_capacity_lb_;
       if (tmp1 > 0)
         costL1 += tmp1;
-      const float tmp2 = v_edges_[i][seg->x2].est_usage_red() - v_capacity_lb_;
+      const float tmp2 = v_edges_.est_usage_red(i, seg->x2) - v_capacity_lb_;
       if (tmp2 > 0)
         costL2 += tmp2;
     }
     for (int i = seg->x1; i < seg->x2; i++) {
-      const float tmp1 = h_edges_[seg->y2][i].est_usage_red() - h_capacity_lb_;
+      const float tmp1 = h_edges_.est_usage_red(seg->y2, i) - h_capacity_lb_;
       if (tmp1 > 0)
         costL1 += tmp1;
-      const float tmp2 = h_edges_[seg->y1][i].est_usage_red() - h_capacity_lb_;
+      const float tmp2 = h_edges_.est_usage_red(seg->y1, i) - h_capacity_lb_;
       if (tmp2 > 0)
         costL2 += tmp2;
     }
@@ -137,11 +140,11 @@ void FastRouteCore::routeSegL(Segment* seg)
     if (costL1 < costL2) {
       // two parts (x1, y1)-(x1, y2) and (x1, y2)-(x2, y2)
       for (int i = ymin; i < ymax; i++) {
-        v_edges_[i][seg->x1].est_usage += edgeCost;
+        v_edges_.est_usage(i, seg->x1) += edgeCost;
         v_used_ggrid_.insert(std::make_pair(i, seg->x1));
       }
       for (int i = seg->x1; i < seg->x2; i++) {
-        h_edges_[seg->y2][i].est_usage += edgeCost;
+        h_edges_.est_usage(seg->y2, i) += edgeCost;
         h_used_ggrid_.insert(std::make_pair(seg->y2, i));
       }
       seg->xFirst = false;
@@ -149,11 +152,11 @@ void FastRouteCore::routeSegL(Segment* seg)
     else {
       // two parts (x1, y1)-(x2, y1) and (x2, y1)-(x2, y2)
       for (int i = seg->x1; i < seg->x2; i++) {
-        h_edges_[seg->y1][i].est_usage += edgeCost;
+        h_edges_.est_usage(seg->y1, i) += edgeCost;
         h_used_ggrid_.insert(std::make_pair(seg->y1, i));
       }
       for (int i = ymin; i < ymax; i++) {
-        v_edges_[i][seg->x2].est_usage += edgeCost;
+        v_edges_.est_usage(i, seg->x2) += edgeCost;
         v_used_ggrid_.insert(std::make_pair(i, seg->y2));
       }
       seg->xFirst = true;
@@ -171,23 +174,23 @@ void FastRouteCore::routeSegLFirstTime(Segment* seg)
   float costL2 = 0;
 
   for (int i = ymin; i < ymax; i++) {
-    const float tmp = v_edges_[i][seg->x1].est_usage_red() - v_capacity_lb_;
+    const float tmp = v_edges_.est_usage_red(i, seg->x1) - v_capacity_lb_;
     if (tmp > 0)
       costL1 += tmp;
   }
   for (int i = ymin; i < ymax; i++) {
-    const float tmp = v_edges_[i][seg->x2].est_usage_red() - v_capacity_lb_;
+    const float tmp = v_edges_.est_usage_red(i, seg->x2) - v_capacity_lb_;
     if (tmp > 0)
       costL2 += tmp;
   }
 
   for (int i = seg->x1; i < seg->x2; i++) {
-    const float tmp = h_edges_[seg->y2][i].est_usage_red() - h_capacity_lb_;
+    const float tmp = h_edges_.est_usage_red(seg->y2, i) - h_capacity_lb_;
     if (tmp > 0)
       costL1 += tmp;
   }
   for (int i = seg->x1; i < seg->x2; i++) {
-    const float tmp = h_edges_[seg->y1][i].est_usage_red() - h_capacity_lb_;
+    const float tmp = h_edges_.est_usage_red(seg->y1, i) - h_capacity_lb_;
     if (tmp > 0)
       costL2 += tmp;
   }
@@ -197,26 +200,26 @@ void FastRouteCore::routeSegLFirstTime(Segment* seg)
   if (costL1 < costL2) {
     // two parts (x1, y1)-(x1, y2) and (x1, y2)-(x2, y2)
     for (int i = ymin; i < ymax; i++) {
-      v_edges_[i][seg->x1].est_usage += edgeCost / 2.0f;
-      v_edges_[i][seg->x2].est_usage -= edgeCost / 2.0f;
+      v_edges_.est_usage(i, seg->x1) += edgeCost / 2.0f;
+      v_edges_.est_usage(i, seg->x2) -= edgeCost / 2.0f;
       v_used_ggrid_.insert(std::make_pair(i, seg->x1));
     }
     for (int i = seg->x1; i < seg->x2; i++) {
-      h_edges_[seg->y2][i].est_usage += edgeCost / 2.0f;
-      h_edges_[seg->y1][i].est_usage -= edgeCost / 2.0f;
+      h_edges_.est_usage(seg->y2, i) += edgeCost / 2.0f;
+      h_edges_.est_usage(seg->y1, i) -= edgeCost / 2.0f;
       h_used_ggrid_.insert(std::make_pair(seg->y2, i));
     }
     seg->xFirst = false;
   } else {
     // two parts (x1, y1)-(x2, y1) and (x2, y1)-(x2, y2)
     for (int i = seg->x1; i < seg->x2; i++) {
-      h_edges_[seg->y1][i].est_usage += edgeCost / 2.0f;
-      h_edges_[seg->y2][i].est_usage -= edgeCost / 2.0f;
+      h_edges_.est_usage(seg->y1, i) += edgeCost / 2.0f;
+      h_edges_.est_usage(seg->y2, i) -= edgeCost / 2.0f;
       h_used_ggrid_.insert(std::make_pair(seg->y1, i));
     }
     for (int i = ymin; i < ymax; i++) {
-      v_edges_[i][seg->x2].est_usage += edgeCost / 2.0f;
-      v_edges_[i][seg->x1].est_usage -= edgeCost / 2.0f;
+      v_edges_.est_usage(i, seg->x2) += edgeCost / 2.0f;
+      v_edges_.est_usage(i, seg->x1) -= edgeCost / 2.0f;
       v_used_ggrid_.insert(std::make_pair(i, seg->x2));
     }
     seg->xFirst = true;
@@ -256,7 +259,10 @@ void FastRouteCore::routeLAll(bool firstTime)
 }
 
 // L-route, rip-up the previous route according to the ripuptype
-void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
+void FastRouteCore::newrouteL(PatternRouteSpace& space,
+                              int netID,
+                              RouteType ripuptype,
+                              bool viaGuided)
 {
   const int edgeCost = nets_[netID]->getEdgeCost();
 
@@ -288,8 +294,8 @@ void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
       if (x1 == x2)  // V-routing
       {
         for (int j = ymin; j < ymax; j++) {
-          v_edges_[j][x1].est_usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(j, x1));
+          v_edges_.est_usage(j, x1) += edgeCost;
+          space.v_used_ggrid.emplace_back(j, x1);
         }
         treeedge->route.xFirst = false;
         if (treenodes[n1].status % 2 == 0) {
@@ -301,8 +307,8 @@ void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
       } else if (y1 == y2)  // H-routing
       {
         for (int j = x1; j < x2; j++) {
-          h_edges_[y1][j].est_usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(y1, j));
+          h_edges_.est_usage(y1, j) += edgeCost;
+          space.h_used_ggrid.emplace_back(y1, j);
         }
         treeedge->route.xFirst = true;
         if (treenodes[n2].status < 2) {
@@ -339,18 +345,18 @@ void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
         }
 
         for (int j = ymin; j < ymax; j++) {
-          const float tmp1 = v_edges_[j][x1].est_usage_red() - v_capacity_lb_;
+          const float tmp1 = v_edges_.est_usage_red(j, x1) - v_capacity_lb_;
           if (tmp1 > 0)
             costL1 += tmp1;
-          const float tmp2 = v_edges_[j][x2].est_usage_red() - v_capacity_lb_;
+          const float tmp2 = v_edges_.est_usage_red(j, x2) - v_capacity_lb_;
           if (tmp2 > 0)
             costL2 += tmp2;
         }
         for (int j = x1; j < x2; j++) {
-          const float tmp1 = h_edges_[y2][j].est_usage_red() - h_capacity_lb_;
+          const float tmp1 = h_edges_.est_usage_red(y2, j) - h_capacity_lb_;
           if (tmp1 > 0)
             costL1 += tmp1;
-          const float tmp2 = h_edges_[y1][j].est_usage_red() - h_capacity_lb_;
+          const float tmp2 = h_edges_.est_usage_red(y1, j) - h_capacity_lb_;
           if (tmp2 > 0)
             costL2 += tmp2;
         }
@@ -365,12 +371,12 @@ void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
 
           // two parts (x1, y1)-(x1, y2) and (x1, y2)-(x2, y2)
           for (int j = ymin; j < ymax; j++) {
-            v_edges_[j][x1].est_usage += edgeCost;
-            v_used_ggrid_.insert(std::make_pair(j, x1));
+            v_edges_.est_usage(j, x1) += edgeCost;
+            space.v_used_ggrid.emplace_back(j, x1);
           }
           for (int j = x1; j < x2; j++) {
-            h_edges_[y2][j].est_usage += edgeCost;
-            h_used_ggrid_.insert(std::make_pair(y2, j));
+            h_edges_.est_usage(y2, j) += edgeCost;
+            space.h_used_ggrid.emplace_back(y2, j);
           }
           treeedge->route.xFirst = false;
         }  // if costL1<costL2
@@ -384,12 +390,12 @@ void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
 
           // two parts (x1, y1)-(x2, y1) and (x2, y1)-(x2, y2)
           for (int j = x1; j < x2; j++) {
-            h_edges_[y1][j].est_usage += edgeCost;
-            h_used_ggrid_.insert(std::make_pair(y1, j));
+            h_edges_.est_usage(y1, j) += edgeCost;
+            space.h_used_ggrid.emplace_back(y1, j);
           }
           for (int j = ymin; j < ymax; j++) {
-            v_edges_[j][x2].est_usage += edgeCost;
-            v_used_ggrid_.insert(std::make_pair(j, x2));
+            v_edges_.est_usage(j, x2) += edgeCost;
+            space.v_used_ggrid.emplace_back(j, x2);
           }
           treeedge->route.xFirst = true;
         }
@@ -401,22 +407,106 @@ void FastRouteCore::newrouteL(int netID, RouteType ripuptype, bool viaGuided)
   }  // loop i
 }
 
-// route all segments with L, firstTime: true, first newrouteLAll, false - not
-// first
-void FastRouteCore::newrouteLAll(bool firstTime, bool viaGuided)
+void PatternRouteSpace::resize(const int x_range, const int y_range)
 {
-  if (firstTime) {
+  cost_hvh.resize(x_range);
+  cost_vhv.resize(y_range);
+  cost_h.resize(y_range);
+  cost_v.resize(x_range);
+  cost_lr.resize(y_range);
+  cost_tb.resize(x_range);
+
+  cost_hvh_test.resize(y_range);
+  cost_v_test.resize(x_range);
+  cost_tb_test.resize(x_range);
+}
+
+// Calls route_net for every net of net_ids_.  With more than one thread
+// the nets are split in batches whose boxes (the pins, tree and maze
+// routes bloated by expand) do not overlap.  Pattern routing only reads
+// and updates the edges inside the box of the net, so the nets of a batch
+// are routed concurrently.  A net goes to the batch after the last earlier
+// net it overlaps, and the result is the same as the sequential one.
+// Independent nets do not use the edges at all and form a single batch.
+// The debug renderer is not thread safe and keeps the routing sequential.
+void FastRouteCore::patternRouteNets(
+    const int expand,
+    const std::function<void(PatternRouteSpace&, int)>& route_net,
+    const bool independent)
+{
+  if (thread_count_ <= 1 || debug_->isOn()) {
+    PatternRouteSpace& space = pattern_spaces_[0];
     for (const int& netID : net_ids_) {
-      newrouteL(netID, RouteType::NoRoute, viaGuided);  // do L-routing
+      route_net(space, netID);
+      mergeUsedGrids(space);
+    }
+    return;
+  }
+
+  pattern_spaces_.resize(thread_count_);
+  for (PatternRouteSpace& space : pattern_spaces_) {
+    space.resize(x_range_, y_range_);
+  }
+
+  const int num_nets = net_ids_.size();
+  std::vector<std::vector<int>> batches;
+  if (independent) {
+    batches.resize(1);
+    for (int i = 0; i < num_nets; i++) {
+      batches[0].push_back(i);
     }
   } else {
-    for (const int& netID : net_ids_) {
-      newrouteL(netID, RouteType::LRoute, viaGuided);
+    const odb::Rect grid(0, 0, x_grid_ - 1, y_grid_ - 1);
+    std::vector<odb::Rect> boxes(num_nets);
+    for (int i = 0; i < num_nets; i++) {
+      boxes[i] = netRouteBox(net_ids_[i], expand, grid);
+    }
+    batches = batchByRegion(boxes);
+  }
+
+  debugPrint(logger_,
+             GRT,
+             "patternRouting",
+             1,
+             "Routing {} nets in {} batches with {} threads.",
+             num_nets,
+             batches.size(),
+             thread_count_);
+
+  for (const std::vector<int>& batch : batches) {
+    std::exception_ptr exception = nullptr;
+#pragma omp parallel for schedule(dynamic) num_threads(thread_count_)
+    for (int i = 0; i < batch.size(); i++) {
+      try {
+        route_net(pattern_spaces_[omp_get_thread_num()], net_ids_[batch[i]]);
+      } catch (...) {
+#pragma omp critical
+        exception = std::current_exception();
+      }
+    }
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    for (PatternRouteSpace& space : pattern_spaces_) {
+      mergeUsedGrids(space);
     }
   }
 }
 
-void FastRouteCore::newrouteZ_edge(int netID, int edgeID)
+// route all segments with L, firstTime: true, first newrouteLAll, false - not
+// first
+void FastRouteCore::newrouteLAll(bool firstTime, bool viaGuided)
+{
+  const RouteType ripuptype
+      = firstTime ? RouteType::NoRoute : RouteType::LRoute;
+  patternRouteNets(0, [&](PatternRouteSpace& space, const int netID) {
+    newrouteL(space, netID, ripuptype, viaGuided);  // do L-routing
+  });
+}
+
+void FastRouteCore::newrouteZ_edge(PatternRouteSpace& space,
+                                   int netID,
+                                   int edgeID)
 {
   const int edgeCost = nets_[netID]->getEdgeCost();
 
@@ -457,55 +547,55 @@ void FastRouteCore::newrouteZ_edge(int netID, int edgeID)
   // compute the cost for all Z routing
 
   for (int i = 0; i <= segWidth; i++) {
-    cost_hvh_[i] = 0;
-    cost_v_[i] = 0;
-    cost_tb_[i] = 0;
+    space.cost_hvh[i] = 0;
+    space.cost_v[i] = 0;
+    space.cost_tb[i] = 0;
 
-    cost_hvh_test_[i] = 0;
-    cost_v_test_[i] = 0;
-    cost_tb_test_[i] = 0;
+    space.cost_hvh_test[i] = 0;
+    space.cost_v_test[i] = 0;
+    space.cost_tb_test[i] = 0;
   }
 
   // compute the cost for all H-segs and V-segs and partial boundary seg
   // cost for V-segs
   for (int i = x1; i <= x2; i++) {
     for (int j = ymin; j < ymax; j++) {
-      const float tmp = v_edges_[j][i].est_usage_red() - v_capacity_lb_;
+      const float tmp = v_edges_.est_usage_red(j, i) - v_capacity_lb_;
       if (tmp > 0) {
-        cost_v_[i - x1] += tmp;
-        cost_v_test_[i - x1] += HCOST;
+        space.cost_v[i - x1] += tmp;
+        space.cost_v_test[i - x1] += HCOST;
       } else {
-        cost_v_test_[i - x1] += tmp;
+        space.cost_v_test[i - x1] += tmp;
       }
     }
   }
   // cost for Top&Bot boundary segs (form Z with V-seg)
   for (int j = x1; j < x2; j++) {
-    const float tmp = h_edges_[y2][j].est_usage_red() - h_capacity_lb_;
+    const float tmp = h_edges_.est_usage_red(y2, j) - h_capacity_lb_;
     if (tmp > 0) {
-      cost_tb_[0] += tmp;
-      cost_tb_test_[0] += HCOST;
+      space.cost_tb[0] += tmp;
+      space.cost_tb_test[0] += HCOST;
     } else {
-      cost_tb_test_[0] += tmp;
+      space.cost_tb_test[0] += tmp;
     }
   }
   for (int i = 1; i <= segWidth; i++) {
-    cost_tb_[i] = cost_tb_[i - 1];
+    space.cost_tb[i] = space.cost_tb[i - 1];
     const float tmp1
-        = h_edges_[y1][x1 + i - 1].est_usage_red() - h_capacity_lb_;
+        = h_edges_.est_usage_red(y1, x1 + i - 1) - h_capacity_lb_;
     if (tmp1 > 0) {
-      cost_tb_[i] += tmp1;
-      cost_tb_test_[i] += HCOST;
+      space.cost_tb[i] += tmp1;
+      space.cost_tb_test[i] += HCOST;
     } else {
-      cost_tb_test_[i] += tmp1;
+      space.cost_tb_test[i] += tmp1;
     }
     const float tmp2
-        = h_edges_[y2][x1 + i - 1].est_usage_red() - h_capacity_lb_;
+        = h_edges_.est_usage_red(y2, x1 + i - 1) - h_capacity_lb_;
     if (tmp2 > 0) {
-      cost_tb_[i] -= tmp2;
-      cost_tb_test_[i] -= HCOST;
+      space.cost_tb[i] -= tmp2;
+      space.cost_tb_test[i] -= HCOST;
     } else {
-      cost_tb_test_[i] -= tmp2;
+      space.cost_tb_test[i] -= tmp2;
     }
   }
   // compute cost for all Z routing
@@ -513,38 +603,40 @@ void FastRouteCore::newrouteZ_edge(int netID, int edgeID)
   float btTEST = BIG_INT;
   int bestZ = 0;
   for (int i = 0; i <= segWidth; i++) {
-    cost_hvh_[i] = cost_v_[i] + cost_tb_[i];
-    cost_hvh_test_[i] = cost_v_test_[i] + cost_tb_test_[i];
-    if (cost_hvh_[i] < bestcost) {
-      bestcost = cost_hvh_[i];
-      btTEST = cost_hvh_test_[i];
+    space.cost_hvh[i] = space.cost_v[i] + space.cost_tb[i];
+    space.cost_hvh_test[i] = space.cost_v_test[i] + space.cost_tb_test[i];
+    if (space.cost_hvh[i] < bestcost) {
+      bestcost = space.cost_hvh[i];
+      btTEST = space.cost_hvh_test[i];
       bestZ = i + x1;
-    } else if (cost_hvh_[i] == bestcost) {
-      if (cost_hvh_test_[i] < btTEST) {
-        btTEST = cost_hvh_test_[i];
+    } else if (space.cost_hvh[i] == bestcost) {
+      if (space.cost_hvh_test[i] < btTEST) {
+        btTEST = space.cost_hvh_test[i];
         bestZ = i + x1;
       }
     }
   }
 
   for (int i = x1; i < bestZ; i++) {
-    h_edges_[y1][i].est_usage += edgeCost;
-    h_used_ggrid_.insert(std::make_pair(y1, i));
+    h_edges_.est_usage(y1, i) += edgeCost;
+    space.h_used_ggrid.emplace_back(y1, i);
   }
   for (int i = bestZ; i < x2; i++) {
-    h_edges_[y2][i].est_usage += edgeCost;
-    h_used_ggrid_.insert(std::make_pair(y2, i));
+    h_edges_.est_usage(y2, i) += edgeCost;
+    space.h_used_ggrid.emplace_back(y2, i);
   }
   for (int i = ymin; i < ymax; i++) {
-    v_edges_[i][bestZ].est_usage += edgeCost;
-    v_used_ggrid_.insert(std::make_pair(i, bestZ));
+    v_edges_.est_usage(i, bestZ) += edgeCost;
+    space.v_used_ggrid.emplace_back(i, bestZ);
   }
   treeedge->route.HVH = true;
   treeedge->route.Zpoint = bestZ;
 }
 
 // Z-route, rip-up the previous route according to the ripuptype
-void FastRouteCore::newrouteZ(int netID, int threshold)
+void FastRouteCore::newrouteZ(PatternRouteSpace& space,
+                              int netID,
+                              int threshold)
 {
   const int edgeCost = nets_[netID]->getEdgeCost();
 
@@ -598,138 +690,138 @@ void FastRouteCore::newrouteZ(int netID, int threshold)
 
         if (status1 == 0 || status1 == 3) {
           for (int i = 0; i < segWidth; i++) {
-            cost_hvh_[i] = 0;
-            cost_hvh_test_[i] = 0;
+            space.cost_hvh[i] = 0;
+            space.cost_hvh_test[i] = 0;
           }
           for (int i = 0; i < segHeight; i++) {
-            cost_vhv_[i] = 0;
+            space.cost_vhv[i] = 0;
           }
         } else if (status1 == 2) {
           for (int i = 0; i < segWidth; i++) {
-            cost_hvh_[i] = 0;
-            cost_hvh_test_[i] = 0;
+            space.cost_hvh[i] = 0;
+            space.cost_hvh_test[i] = 0;
           }
           for (int i = 0; i < segHeight; i++) {
-            cost_vhv_[i] = via_cost_;
+            space.cost_vhv[i] = via_cost_;
           }
         } else {
           for (int i = 0; i < segWidth; i++) {
-            cost_hvh_[i] = via_cost_;
-            cost_hvh_test_[i] = via_cost_;
+            space.cost_hvh[i] = via_cost_;
+            space.cost_hvh_test[i] = via_cost_;
           }
           for (int i = 0; i < segHeight; i++) {
-            cost_vhv_[i] = 0;
+            space.cost_vhv[i] = 0;
           }
         }
 
         if (status2 == 2) {
           for (int i = 0; i < segHeight; i++) {
-            cost_vhv_[i] += via_cost_;
+            space.cost_vhv[i] += via_cost_;
           }
 
         } else if (status2 == 1) {
           for (int i = 0; i < segWidth; i++) {
-            cost_hvh_[i] += via_cost_;
-            cost_hvh_test_[i] += via_cost_;
+            space.cost_hvh[i] += via_cost_;
+            space.cost_hvh_test[i] += via_cost_;
           }
         }
 
         for (int i = 0; i < segWidth; i++) {
-          cost_v_[i] = 0;
-          cost_tb_[i] = 0;
+          space.cost_v[i] = 0;
+          space.cost_tb[i] = 0;
 
-          cost_v_test_[i] = 0;
-          cost_tb_test_[i] = 0;
+          space.cost_v_test[i] = 0;
+          space.cost_tb_test[i] = 0;
         }
         for (int i = 0; i < segHeight; i++) {
-          cost_h_[i] = 0;
-          cost_lr_[i] = 0;
+          space.cost_h[i] = 0;
+          space.cost_lr[i] = 0;
         }
 
         // compute the cost for all H-segs and V-segs and partial boundary seg
         // cost for V-segs
         for (int i = x1; i < x2; i++) {
           for (int j = ymin; j < ymax; j++) {
-            const float tmp = v_edges_[j][i].est_usage_red() - v_capacity_lb_;
+            const float tmp = v_edges_.est_usage_red(j, i) - v_capacity_lb_;
             if (tmp > 0) {
-              cost_v_[i - x1] += tmp;
-              cost_v_test_[i - x1] += HCOST;
+              space.cost_v[i - x1] += tmp;
+              space.cost_v_test[i - x1] += HCOST;
             } else {
-              cost_v_test_[i - x1] += tmp;
+              space.cost_v_test[i - x1] += tmp;
             }
           }
         }
         // cost for Top&Bot boundary segs (form Z with V-seg)
         for (int j = x1; j < x2; j++) {
-          const float tmp = h_edges_[y2][j].est_usage_red() - h_capacity_lb_;
+          const float tmp = h_edges_.est_usage_red(y2, j) - h_capacity_lb_;
           if (tmp > 0) {
-            cost_tb_[0] += tmp;
-            cost_tb_test_[0] += HCOST;
+            space.cost_tb[0] += tmp;
+            space.cost_tb_test[0] += HCOST;
           } else {
-            cost_tb_test_[0] += tmp;
+            space.cost_tb_test[0] += tmp;
           }
         }
         for (int i = 1; i < segWidth; i++) {
-          cost_tb_[i] = cost_tb_[i - 1];
+          space.cost_tb[i] = space.cost_tb[i - 1];
           const float tmp1
-              = h_edges_[y1][x1 + i - 1].est_usage_red() - h_capacity_lb_;
+              = h_edges_.est_usage_red(y1, x1 + i - 1) - h_capacity_lb_;
           if (tmp1 > 0) {
-            cost_tb_[i] += tmp1;
-            cost_tb_test_[0] += HCOST;
+            space.cost_tb[i] += tmp1;
+            space.cost_tb_test[0] += HCOST;
           } else {
-            cost_tb_test_[0] += tmp1;
+            space.cost_tb_test[0] += tmp1;
           }
           const float tmp2
-              = h_edges_[y2][x1 + i - 1].est_usage_red() - h_capacity_lb_;
+              = h_edges_.est_usage_red(y2, x1 + i - 1) - h_capacity_lb_;
           if (tmp2 > 0) {
-            cost_tb_[i] -= tmp2;
-            cost_tb_test_[0] -= HCOST;
+            space.cost_tb[i] -= tmp2;
+            space.cost_tb_test[0] -= HCOST;
           } else {
-            cost_tb_test_[0] -= tmp2;
+            space.cost_tb_test[0] -= tmp2;
           }
         }
         // cost for H-segs
         for (int i = ymin; i < ymax; i++) {
           for (int j = x1; j < x2; j++) {
-            const float tmp = h_edges_[i][j].est_usage_red() - h_capacity_lb_;
+            const float tmp = h_edges_.est_usage_red(i, j) - h_capacity_lb_;
             if (tmp > 0)
-              cost_h_[i - ymin] += tmp;
+              space.cost_h[i - ymin] += tmp;
           }
         }
         // cost for Left&Right boundary segs (form Z with H-seg)
         if (y1Smaller) {
           for (int j = y1; j < y2; j++) {
-            const float tmp = v_edges_[j][x2].est_usage_red() - v_capacity_lb_;
+            const float tmp = v_edges_.est_usage_red(j, x2) - v_capacity_lb_;
             if (tmp > 0)
-              cost_lr_[0] += tmp;
+              space.cost_lr[0] += tmp;
           }
           for (int i = 1; i < segHeight; i++) {
-            cost_lr_[i] = cost_lr_[i - 1];
+            space.cost_lr[i] = space.cost_lr[i - 1];
             const float tmp1
-                = v_edges_[y1 + i - 1][x1].est_usage_red() - v_capacity_lb_;
+                = v_edges_.est_usage_red(y1 + i - 1, x1) - v_capacity_lb_;
             if (tmp1 > 0)
-              cost_lr_[i] += tmp1;
+              space.cost_lr[i] += tmp1;
             const float tmp2
-                = v_edges_[y1 + i - 1][x2].est_usage_red() - v_capacity_lb_;
+                = v_edges_.est_usage_red(y1 + i - 1, x2) - v_capacity_lb_;
             if (tmp2 > 0)
-              cost_lr_[i] -= tmp2;
+              space.cost_lr[i] -= tmp2;
           }
         } else {
           for (int j = y2; j < y1; j++) {
-            const float tmp = v_edges_[j][x1].est_usage - v_capacity_lb_;
+            const float tmp = v_edges_.est_usage(j, x1) - v_capacity_lb_;
             if (tmp > 0)
-              cost_lr_[0] += tmp;
+              space.cost_lr[0] += tmp;
           }
           for (int i = 1; i < segHeight; i++) {
-            cost_lr_[i] = cost_lr_[i - 1];
+            space.cost_lr[i] = space.cost_lr[i - 1];
             const float tmp1
-                = v_edges_[y2 + i - 1][x2].est_usage_red() - v_capacity_lb_;
+                = v_edges_.est_usage_red(y2 + i - 1, x2) - v_capacity_lb_;
             if (tmp1 > 0)
-              cost_lr_[i] += tmp1;
+              space.cost_lr[i] += tmp1;
             const float tmp2
-                = v_edges_[y2 + i - 1][x1].est_usage_red() - v_capacity_lb_;
+                = v_edges_.est_usage_red(y2 + i - 1, x1) - v_capacity_lb_;
             if (tmp2 > 0)
-              cost_lr_[i] -= tmp2;
+              space.cost_lr[i] -= tmp2;
           }
         }
 
@@ -739,22 +831,22 @@ void FastRouteCore::newrouteZ(int netID, int threshold)
         float btTEST = BIG_INT;
         int bestZ = 0;
         for (int i = 0; i < segWidth; i++) {
-          cost_hvh_[i] += cost_v_[i] + cost_tb_[i];
-          if (cost_hvh_[i] < bestcost) {
-            bestcost = cost_hvh_[i];
-            btTEST = cost_hvh_test_[i];
+          space.cost_hvh[i] += space.cost_v[i] + space.cost_tb[i];
+          if (space.cost_hvh[i] < bestcost) {
+            bestcost = space.cost_hvh[i];
+            btTEST = space.cost_hvh_test[i];
             bestZ = i + x1;
-          } else if (cost_hvh_[i] == bestcost) {
-            if (cost_hvh_test_[i] < btTEST) {
-              btTEST = cost_hvh_test_[i];
+          } else if (space.cost_hvh[i] == bestcost) {
+            if (space.cost_hvh_test[i] < btTEST) {
+              btTEST = space.cost_hvh_test[i];
               bestZ = i + x1;
             }
           }
         }
         for (int i = 0; i < segHeight; i++) {
-          cost_vhv_[i] += cost_h_[i] + cost_lr_[i];
-          if (cost_vhv_[i] < bestcost) {
-            bestcost = cost_vhv_[i];
+          space.cost_vhv[i] += space.cost_h[i] + space.cost_lr[i];
+          if (space.cost_vhv[i] < bestcost) {
+            bestcost = space.cost_vhv[i];
             bestZ = i + ymin;
             HVH = false;
           }
@@ -772,16 +864,16 @@ void FastRouteCore::newrouteZ(int netID, int threshold)
           treenodes[n2a].hID++;
 
           for (int i = x1; i < bestZ; i++) {
-            h_edges_[y1][i].est_usage += edgeCost;
-            h_used_ggrid_.insert(std::make_pair(y1, i));
+            h_edges_.est_usage(y1, i) += edgeCost;
+            space.h_used_ggrid.emplace_back(y1, i);
           }
           for (int i = bestZ; i < x2; i++) {
-            h_edges_[y2][i].est_usage += edgeCost;
-            h_used_ggrid_.insert(std::make_pair(y2, i));
+            h_edges_.est_usage(y2, i) += edgeCost;
+            space.h_used_ggrid.emplace_back(y2, i);
           }
           for (int i = ymin; i < ymax; i++) {
-            v_edges_[i][bestZ].est_usage += edgeCost;
-            v_used_ggrid_.insert(std::make_pair(i, bestZ));
+            v_edges_.est_usage(i, bestZ) += edgeCost;
+            space.v_used_ggrid.emplace_back(i, bestZ);
           }
           treeedge->route.HVH = HVH;
           treeedge->route.Zpoint = bestZ;
@@ -797,42 +889,42 @@ void FastRouteCore::newrouteZ(int netID, int threshold)
           treenodes[n2a].lID++;
           if (y1Smaller) {
             for (int i = y1; i < bestZ; i++) {
-              v_edges_[i][x1].est_usage += edgeCost;
-              v_used_ggrid_.insert(std::make_pair(i, x1));
+              v_edges_.est_usage(i, x1) += edgeCost;
+              space.v_used_ggrid.emplace_back(i, x1);
             }
             for (int i = bestZ; i < y2; i++) {
-              v_edges_[i][x2].est_usage += edgeCost;
-              v_used_ggrid_.insert(std::make_pair(i, x2));
+              v_edges_.est_usage(i, x2) += edgeCost;
+              space.v_used_ggrid.emplace_back(i, x2);
             }
             for (int i = x1; i < x2; i++) {
-              h_edges_[bestZ][i].est_usage += edgeCost;
-              h_used_ggrid_.insert(std::make_pair(bestZ, i));
+              h_edges_.est_usage(bestZ, i) += edgeCost;
+              space.h_used_ggrid.emplace_back(bestZ, i);
             }
             treeedge->route.HVH = HVH;
             treeedge->route.Zpoint = bestZ;
           } else {
             for (int i = y2; i < bestZ; i++) {
-              v_edges_[i][x2].est_usage += edgeCost;
-              v_used_ggrid_.insert(std::make_pair(i, x2));
+              v_edges_.est_usage(i, x2) += edgeCost;
+              space.v_used_ggrid.emplace_back(i, x2);
             }
             for (int i = bestZ; i < y1; i++) {
-              v_edges_[i][x1].est_usage += edgeCost;
-              v_used_ggrid_.insert(std::make_pair(i, x1));
+              v_edges_.est_usage(i, x1) += edgeCost;
+              space.v_used_ggrid.emplace_back(i, x1);
             }
             for (int i = x1; i < x2; i++) {
-              h_edges_[bestZ][i].est_usage += edgeCost;
-              h_used_ggrid_.insert(std::make_pair(bestZ, i));
+              h_edges_.est_usage(bestZ, i) += edgeCost;
+              space.h_used_ggrid.emplace_back(bestZ, i);
             }
             treeedge->route.HVH = HVH;
             treeedge->route.Zpoint = bestZ;
           }
         }
       } else if (num_terminals == 2) {
-        newrouteZ_edge(netID, ind);
+        newrouteZ_edge(space, netID, ind);
       }
     } else if (num_terminals == 2 && sttrees_[netID].edges[ind].len > threshold
                && threshold > 4) {
-      newrouteZ_edge(netID, ind);
+      newrouteZ_edge(space, netID, ind);
     }
   }
 }
@@ -842,12 +934,15 @@ void FastRouteCore::newrouteZ(int netID, int threshold)
 // first
 void FastRouteCore::newrouteZAll(int threshold)
 {
-  for (const int& netID : net_ids_) {
-    newrouteZ(netID, threshold);  // ripup previous route and do Z-routing
-  }
+  patternRouteNets(0, [&](PatternRouteSpace& space, const int netID) {
+    // ripup previous route and do Z-routing
+    newrouteZ(space, netID, threshold);
+  });
 }
 
-void FastRouteCore::spiralRoute(int netID, int edgeID)
+void FastRouteCore::spiralRoute(PatternRouteSpace& space,
+                                int netID,
+                                int edgeID)
 {
   auto& treeedges = sttrees_[netID].edges;
   auto& treenodes = sttrees_[netID].nodes;
@@ -885,8 +980,8 @@ void FastRouteCore::spiralRoute(int netID, int edgeID)
   treeedge->route.type = RouteType::LRoute;
   if (x1 == x2) {  // V-routing
     for (int j = ymin; j < ymax; j++) {
-      v_edges_[j][x1].est_usage += edgeCost;
-      v_used_ggrid_.insert(std::make_pair(j, x1));
+      v_edges_.est_usage(j, x1) += edgeCost;
+      space.v_used_ggrid.emplace_back(j, x1);
     }
     treeedge->route.xFirst = false;
     if (treenodes[n1].status % 2 == 0) {
@@ -904,8 +999,8 @@ void FastRouteCore::spiralRoute(int netID, int edgeID)
     }
   } else if (y1 == y2) {  // H-routing
     for (int j = x1; j < x2; j++) {
-      h_edges_[y1][j].est_usage += edgeCost;
-      h_used_ggrid_.insert(std::make_pair(y1, j));
+      h_edges_.est_usage(y1, j) += edgeCost;
+      space.h_used_ggrid.emplace_back(y1, j);
     }
     treeedge->route.xFirst = true;
     if (treenodes[n2].status < 2) {
@@ -942,18 +1037,18 @@ void FastRouteCore::spiralRoute(int netID, int edgeID)
     }
 
     for (int j = ymin; j < ymax; j++) {
-      const float tmp1 = v_edges_[j][x1].est_usage_red() - v_capacity_lb_;
+      const float tmp1 = v_edges_.est_usage_red(j, x1) - v_capacity_lb_;
       if (tmp1 > 0)
         costL1 += tmp1;
-      const float tmp2 = v_edges_[j][x2].est_usage_red() - v_capacity_lb_;
+      const float tmp2 = v_edges_.est_usage_red(j, x2) - v_capacity_lb_;
       if (tmp2 > 0)
         costL2 += tmp2;
     }
     for (int j = x1; j < x2; j++) {
-      const float tmp1 = h_edges_[y2][j].est_usage_red() - h_capacity_lb_;
+      const float tmp1 = h_edges_.est_usage_red(y2, j) - h_capacity_lb_;
       if (tmp1 > 0)
         costL1 += tmp1;
-      const float tmp2 = h_edges_[y1][j].est_usage_red() - h_capacity_lb_;
+      const float tmp2 = h_edges_.est_usage_red(y1, j) - h_capacity_lb_;
       if (tmp2 > 0)
         costL2 += tmp2;
     }
@@ -977,12 +1072,12 @@ void FastRouteCore::spiralRoute(int netID, int edgeID)
 
       // two parts (x1, y1)-(x1, y2) and (x1, y2)-(x2, y2)
       for (int j = ymin; j < ymax; j++) {
-        v_edges_[j][x1].est_usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(j, x1));
+        v_edges_.est_usage(j, x1) += edgeCost;
+        space.v_used_ggrid.emplace_back(j, x1);
       }
       for (int j = x1; j < x2; j++) {
-        h_edges_[y2][j].est_usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(y2, j));
+        h_edges_.est_usage(y2, j) += edgeCost;
+        space.h_used_ggrid.emplace_back(y2, j);
       }
       treeedge->route.xFirst = false;
     } else {
@@ -1005,18 +1100,74 @@ void FastRouteCore::spiralRoute(int netID, int edgeID)
 
       // two parts (x1, y1)-(x2, y1) and (x2, y1)-(x2, y2)
       for (int j = x1; j < x2; j++) {
-        h_edges_[y1][j].est_usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(y1, j));
+        h_edges_.est_usage(y1, j) += edgeCost;
+        space.h_used_ggrid.emplace_back(y1, j);
       }
       for (int j = ymin; j < ymax; j++) {
-        v_edges_[j][x2].est_usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(j, x2));
+        v_edges_.est_usage(j, x2) += edgeCost;
+        space.v_used_ggrid.emplace_back(j, x2);
       }
       treeedge->route.xFirst = true;
     }
   }  // else L-routing
 }
 
+// Rips up a net and routes its tree edges in breadth first order from
+// the pins.
+void FastRouteCore::spiralRouteNet(PatternRouteSpace& space, const int netID)
+{
+  std::queue<int> edgeQueue;
+  newRipupNet(netID);
+
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+
+  for (int nodeID = 0; nodeID < sttrees_[netID].num_terminals; nodeID++) {
+    treenodes[nodeID].assigned = true;
+    for (int k = 0; k < treenodes[nodeID].conCNT; k++) {
+      const int edgeID = treenodes[nodeID].eID[k];
+
+      if (treeedges[edgeID].assigned == false) {
+        edgeQueue.push(edgeID);
+        treeedges[edgeID].assigned = true;
+      }
+    }
+  }
+
+  while (!edgeQueue.empty()) {
+    const int edgeID = edgeQueue.front();
+    edgeQueue.pop();
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+    if (treenodes[treeedge->n1a].assigned) {
+      spiralRoute(space, netID, edgeID);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n2a].assigned) {
+        for (int k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
+          const int edgeID = treenodes[treeedge->n2a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
+          }
+        }
+        treenodes[treeedge->n2a].assigned = true;
+      }
+    } else {
+      spiralRoute(space, netID, edgeID);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n1a].assigned) {
+        for (int k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
+          const int edgeID = treenodes[treeedge->n1a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
+          }
+        }
+        treenodes[treeedge->n1a].assigned = true;
+      }
+    }
+  }
+}
+
 void FastRouteCore::spiralRouteAll()
 {
   for (const int& netID : net_ids_) {
@@ -1091,58 +1242,9 @@ void FastRouteCore::spiralRouteAll()
     }
   }
 
-  std::queue<int> edgeQueue;
-  for (const int& netID : net_ids_) {
-    newRipupNet(netID);
-
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-
-    for (int nodeID = 0; nodeID < sttrees_[netID].num_terminals; nodeID++) {
-      treenodes[nodeID].assigned = true;
-      for (int k = 0; k < treenodes[nodeID].conCNT; k++) {
-        const int edgeID = treenodes[nodeID].eID[k];
-
-        if (treeedges[edgeID].assigned == false) {
-          edgeQueue.push(edgeID);
-          treeedges[edgeID].assigned = true;
-        }
-      }
-    }
-
-    while (!edgeQueue.empty()) {
-      const int edgeID = edgeQueue.front();
-      edgeQueue.pop();
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-      if (treenodes[treeedge->n1a].assigned) {
-        spiralRoute(netID, edgeID);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n2a].assigned) {
-          for (int k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
-            const int edgeID = treenodes[treeedge->n2a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
-          }
-          treenodes[treeedge->n2a].assigned = true;
-        }
-      } else {
-        spiralRoute(netID, edgeID);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n1a].assigned) {
-          for (int k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
-            const int edgeID = treenodes[treeedge->n1a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
-          }
-          treenodes[treeedge->n1a].assigned = true;
-        }
-      }
-    }
-  }
+  patternRouteNets(0, [&](PatternRouteSpace& space, const int netID) {
+    spiralRouteNet(space, netID);
+  });
 
   for (const int& netID : net_ids_) {
     auto& treenodes = sttrees_[netID].nodes;
@@ -1155,10 +1257,9 @@ void FastRouteCore::spiralRouteAll()
   }
 }
 
-void FastRouteCore::routeMonotonic(int netID,
+void FastRouteCore::routeMonotonic(PatternRouteSpace& space,
+                                   int netID,
                                    int edgeID,
-                                   multi_array<float, 2>& d1,
-                                   multi_array<float, 2>& d2,
                                    int threshold,
                                    int enlarge)
 {
@@ -1170,6 +1271,8 @@ void FastRouteCore::routeMonotonic(int netID,
   auto& treeedges = sttrees_[netID].edges;
   TreeEdge* treeedge = &(treeedges[edgeID]);
   const auto& treenodes = sttrees_[netID].nodes;
+  multi_array<float, 2>& d1 = space.d1;
+  multi_array<float, 2>& d2 = space.d2;
   const int n1 = treeedge->n1;
   const int n2 = treeedge->n2;
   const int x1 = treenodes[n1].x;
@@ -1226,7 +1329,7 @@ void FastRouteCore::routeMonotonic(int netID,
 
   for (int j = ymin; j <= ymax; j++) {
     for (int i = xmin; i < xmax; i++) {
-      size_t index = h_edges_[j][i].usage_red();
+      size_t index = h_edges_.usage_red(j, i);
       index = std::min(index, h_cost_table_.size() - 1);
       const float tmp = h_cost_table_[index];
       d1[j][i + 1] = d1[j][i] + tmp;
@@ -1237,7 +1340,7 @@ void FastRouteCore::routeMonotonic(int netID,
   for (int j = ymin; j < ymax; j++) {
     // update the cost of a column of grids by h-edges
     for (int i = xmin; i <= xmax; i++) {
-      size_t index = v_edges_[j][i].usage_red();
+      size_t index = v_edges_.usage_red(j, i);
       index = std::min(index, h_cost_table_.size() - 1);
       const float tmp = h_cost_table_[index];
       d2[j + 1][i] = d2[j][i] + tmp;
@@ -1307,16 +1410,16 @@ void FastRouteCore::routeMonotonic(int netID,
       for (int i = x1; i < bestp1x; i++) {
         gridsX[cnt] = i;
         gridsY[cnt] = y1;
-        h_edges_[y1][i].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(y1, i));
+        h_edges_.usage(y1, i) += edgeCost;
+        space.h_used_ggrid.emplace_back(y1, i);
         cnt++;
       }
     } else {
       for (int i = x1; i > bestp1x; i--) {
         gridsX[cnt] = i;
         gridsY[cnt] = y1;
-        h_edges_[y1][i - 1].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(y1, i - 1));
+        h_edges_.usage(y1, i - 1) += edgeCost;
+        space.h_used_ggrid.emplace_back(y1, i - 1);
         cnt++;
       }
     }
@@ -1325,16 +1428,16 @@ void FastRouteCore::routeMonotonic(int netID,
         gridsX[cnt] = bestp1x;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[i][bestp1x].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i, bestp1x));
+        v_edges_.usage(i, bestp1x) += edgeCost;
+        space.v_used_ggrid.emplace_back(i, bestp1x);
       }
     } else {
       for (int i = y1; i > bestp1y; i--) {
         gridsX[cnt] = bestp1x;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[(i - 1)][bestp1x].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i - 1, bestp1x));
+        v_edges_.usage((i - 1), bestp1x) += edgeCost;
+        space.v_used_ggrid.emplace_back(i - 1, bestp1x);
       }
     }
   } else {
@@ -1343,32 +1446,32 @@ void FastRouteCore::routeMonotonic(int netID,
         gridsX[cnt] = x1;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[i][x1].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i, x1));
+        v_edges_.usage(i, x1) += edgeCost;
+        space.v_used_ggrid.emplace_back(i, x1);
       }
     } else {
       for (int i = y1; i > bestp1y; i--) {
         gridsX[cnt] = x1;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[(i - 1)][x1].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i - 1, x1));
+        v_edges_.usage((i - 1), x1) += edgeCost;
+        space.v_used_ggrid.emplace_back(i - 1, x1);
       }
     }
     if (bestp1x > x1) {
       for (int i = x1; i < bestp1x; i++) {
         gridsX[cnt] = i;
         gridsY[cnt] = bestp1y;
-        h_edges_[bestp1y][i].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(bestp1y, i));
+        h_edges_.usage(bestp1y, i) += edgeCost;
+        space.h_used_ggrid.emplace_back(bestp1y, i);
         cnt++;
       }
     } else {
       for (int i = x1; i > bestp1x; i--) {
         gridsX[cnt] = i;
         gridsY[cnt] = bestp1y;
-        h_edges_[bestp1y][(i - 1)].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(bestp1y, i - 1));
+        h_edges_.usage(bestp1y, (i - 1)) += edgeCost;
+        space.h_used_ggrid.emplace_back(bestp1y, i - 1);
         cnt++;
       }
     }
@@ -1379,16 +1482,16 @@ void FastRouteCore::routeMonotonic(int netID,
       for (int i = bestp1x; i < x2; i++) {
         gridsX[cnt] = i;
         gridsY[cnt] = bestp1y;
-        h_edges_[bestp1y][i].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(bestp1y, i));
+        h_edges_.usage(bestp1y, i) += edgeCost;
+        space.h_used_ggrid.emplace_back(bestp1y, i);
         cnt++;
       }
     } else {
       for (int i = bestp1x; i > x2; i--) {
         gridsX[cnt] = i;
         gridsY[cnt] = bestp1y;
-        h_edges_[bestp1y][i - 1].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(bestp1y, i - 1));
+        h_edges_.usage(bestp1y, i - 1) += edgeCost;
+        space.h_used_ggrid.emplace_back(bestp1y, i - 1);
         cnt++;
       }
     }
@@ -1398,16 +1501,16 @@ void FastRouteCore::routeMonotonic(int netID,
         gridsX[cnt] = x2;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[i][x2].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i, x2));
+        v_edges_.usage(i, x2) += edgeCost;
+        space.v_used_ggrid.emplace_back(i, x2);
       }
     } else {
       for (int i = bestp1y; i > y2; i--) {
         gridsX[cnt] = x2;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[(i - 1)][x2].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i - 1, x2));
+        v_edges_.usage((i - 1), x2) += edgeCost;
+        space.v_used_ggrid.emplace_back(i - 1, x2);
       }
     }
   } else {
@@ -1416,32 +1519,32 @@ void FastRouteCore::routeMonotonic(int netID,
         gridsX[cnt] = bestp1x;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[i][bestp1x].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i, bestp1x));
+        v_edges_.usage(i, bestp1x) += edgeCost;
+        space.v_used_ggrid.emplace_back(i, bestp1x);
       }
     } else {
       for (int i = bestp1y; i > y2; i--) {
         gridsX[cnt] = bestp1x;
         gridsY[cnt] = i;
         cnt++;
-        v_edges_[(i - 1)][bestp1x].usage += edgeCost;
-        v_used_ggrid_.insert(std::make_pair(i - 1, bestp1x));
+        v_edges_.usage((i - 1), bestp1x) += edgeCost;
+        space.v_used_ggrid.emplace_back(i - 1, bestp1x);
       }
     }
     if (x2 > bestp1x) {
       for (int i = bestp1x; i < x2; i++) {
         gridsX[cnt] = i;
         gridsY[cnt] = y2;
-        h_edges_[y2][i].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(y2, i));
+        h_edges_.usage(y2, i) += edgeCost;
+        space.h_used_ggrid.emplace_back(y2, i);
         cnt++;
       }
     } else {
       for (int i = bestp1x; i > x2; i--) {
         gridsX[cnt] = i;
         gridsY[cnt] = y2;
-        h_edges_[y2][(i - 1)].usage += edgeCost;
-        h_used_ggrid_.insert(std::make_pair(y2, i - 1));
+        h_edges_.usage(y2, (i - 1)) += edgeCost;
+        space.h_used_ggrid.emplace_back(y2, i - 1);
         cnt++;
       }
     }
@@ -1477,19 +1580,24 @@ void FastRouteCore::routeMonotonicAll(int threshold,
         = costheight_ / (exp((float) (h_capacity_ - i) * logis_cof) + 1) + 1;
   }
 
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
+  pattern_spaces_.resize(std::max(thread_count_, 1));
+  for (PatternRouteSpace& space : pattern_spaces_) {
+    space.resize(x_range_, y_range_);
+    space.d1.resize(boost::extents[y_range_][x_range_]);
+    space.d2.resize(boost::extents[y_range_][x_range_]);
+  }
 
-  for (const int& netID : net_ids_) {
+  patternRouteNets(expand, [&](PatternRouteSpace& space, const int netID) {
     const int numEdges = sttrees_[netID].num_edges();
     for (int edgeID = 0; edgeID < numEdges; edgeID++) {
-      routeMonotonic(netID,
-                     edgeID,
-                     d1,
-                     d2,
-                     threshold,
-                     expand);  // ripup previous route and do Monotonic routing
+      // ripup previous route and do Monotonic routing
+      routeMonotonic(space, netID, edgeID, threshold, expand);
     }
+  });
+
+  for (PatternRouteSpace& space : pattern_spaces_) {
+    space.d1.resize(boost::extents[0][0]);
+    space.d2.resize(boost::extents[0][0]);
   }
   h_cost_table_.clear();
 }
@@ -1530,13 +1638,13 @@ void FastRouteCore::newrouteLInMaze(int netID)
     treeedge->route.type = RouteType::LRoute;
     if (x1 == x2) {  // V-routing
       for (int j = ymin; j < ymax; j++) {
-        v_edges_[j][x1].usage += edgeCost;
+        v_edges_.usage(j, x1) += edgeCost;
         v_used_ggrid_.insert(std::make_pair(j, x1));
       }
       treeedge->route.xFirst = false;
     } else if (y1 == y2) {  // H-routing
       for (int j = x1; j < x2; j++) {
-        h_edges_[y1][j].usage += edgeCost;
+        h_edges_.usage(y1, j) += edgeCost;
         h_used_ggrid_.insert(std::make_pair(y1, j));
       }
       treeedge->route.xFirst = true;
@@ -1545,18 +1653,18 @@ void FastRouteCore::newrouteLInMaze(int netID)
       int costL2 = 0;
 
       for (int j = ymin; j < ymax; j++) {
-        const int tmp1 = v_edges_[j][x1].usage_red() - v_capacity_lb_;
+        const int tmp1 = v_edges_.usage_red(j, x1) - v_capacity_lb_;
         if (tmp1 > 0)
           costL1 += tmp1;
-        const int tmp2 = v_edges_[j][x2].usage_red() - v_capacity_lb_;
+        const int tmp2 = v_edges_.usage_red(j, x2) - v_capacity_lb_;
         if (tmp2 > 0)
           costL2 += tmp2;
       }
       for (int j = x1; j < x2; j++) {
-        const int tmp1 = h_edges_[y2][j].usage_red() - h_capacity_lb_;
+        const int tmp1 = h_edges_.usage_red(y2, j) - h_capacity_lb_;
         if (tmp1 > 0)
           costL1 += tmp1;
-        const int tmp2 = h_edges_[y1][j].usage_red() - h_capacity_lb_;
+        const int tmp2 = h_edges_.usage_red(y1, j) - h_capacity_lb_;
         if (tmp2 > 0)
           costL2 += tmp2;
       }
@@ -1564,22 +1672,22 @@ void FastRouteCore::newrouteLInMaze(int netID)
       if (costL1 < costL2) {
         // two parts (x1, y1)-(x1, y2) and (x1, y2)-(x2, y2)
         for (int j = ymin; j < ymax; j++) {
-          v_edges_[j][x1].usage += edgeCost;
+          v_edges_.usage(j, x1) += edgeCost;
           v_used_ggrid_.insert(std::make_pair(j, x1));
         }
         for (int j = x1; j < x2; j++) {
-          h_edges_[y2][j].usage += edgeCost;
+          h_edges_.usage(y2, j) += edgeCost;
           h_used_ggrid_.insert(std::make_pair(y2, j));
         }
         treeedge->route.xFirst = false;
       } else {
         // two parts (x1, y1)-(x2, y1) and (x2, y1)-(x2, y2)
         for (int j = x1; j < x2; j++) {
-          h_edges_[y1][j].usage += edgeCost;
+          h_edges_.usage(y1, j) += edgeCost;
           h_used_ggrid_.insert(std::make_pair(y1, j));
         }
         for (int j = ymin; j < ymax; j++) {
-          v_edges_[j][x2].usage += edgeCost;
+          v_edges_.usage(j, x2) += edgeCost;
           v_used_ggrid_.insert(std::make_pair(j, x2));
         }
         treeedge->route.xFirst = true;
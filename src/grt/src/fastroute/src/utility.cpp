@@ -30,7 +30,10 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <exception>
 #include <fstream>
 #include <queue>
 
@@ -417,7 +420,7 @@ int FastRouteCore::threeDVIA()
 }
 
 void FastRouteCore::fixEdgeAssignment(int& net_layer,
-                                      multi_array<Edge3D, 3>& edges_3D,
+                                      const EdgeGrid3D& edges_3D,
                                       int x,
                                       int y,
                                       int k,
@@ -432,7 +435,7 @@ void FastRouteCore::fixEdgeAssignment(int& net_layer,
   if (is_vertical != vertical || best_cost > 0) {
     layer_grid[l][k] = std::numeric_limits<int>::min();
   } else {
-    layer_grid[l][k] = edges_3D[l][y][x].cap - edges_3D[l][y][x].usage;
+    layer_grid[l][k] = edges_3D.cap(l, y, x) - edges_3D.usage(l, y, x);
     best_cost = std::max(best_cost, layer_grid[l][k]);
     if (best_cost > 0) {
       // set the new min/max routing layer for the net to avoid
@@ -486,8 +489,8 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         bool is_vertical
             = layer_directions_[l] == odb::dbTechLayerDir::VERTICAL;
         if (is_vertical) {
-          layer_grid[l][k] = v_edges_3D_[l][min_y][gridsX[k]].cap
-                             - v_edges_3D_[l][min_y][gridsX[k]].usage;
+          layer_grid[l][k] = v_edges_3D_.cap(l, min_y, gridsX[k])
+                             - v_edges_3D_.usage(l, min_y, gridsX[k]);
           best_cost = std::max(best_cost, layer_grid[l][k]);
         } else {
           layer_grid[l][k] = std::numeric_limits<int>::min();
@@ -541,8 +544,8 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         bool is_horizontal
             = layer_directions_[l] == odb::dbTechLayerDir::HORIZONTAL;
         if (is_horizontal) {
-          layer_grid[l][k] = h_edges_3D_[l][gridsY[k]][min_x].cap
-                             - h_edges_3D_[l][gridsY[k]][min_x].usage;
+          layer_grid[l][k] = h_edges_3D_.cap(l, gridsY[k], min_x)
+                             - h_edges_3D_.usage(l, gridsY[k], min_x);
           best_cost = std::max(best_cost, layer_grid[l][k]);
         } else {
           layer_grid[l][k] = std::numeric_limits<int>::min();
@@ -819,33 +822,98 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
     if (gridsX[k] == gridsX[k + 1]) {
       min_y = std::min(gridsY[k], gridsY[k + 1]);
 
-      v_edges_3D_[gridsL[k]][min_y][gridsX[k]].usage
+      v_edges_3D_.usage(gridsL[k], min_y, gridsX[k])
           += net->getLayerEdgeCost(gridsL[k]);
     } else {
       min_x = std::min(gridsX[k], gridsX[k + 1]);
 
-      h_edges_3D_[gridsL[k]][gridsY[k]][min_x].usage
+      h_edges_3D_.usage(gridsL[k], gridsY[k], min_x)
           += net->getLayerEdgeCost(gridsL[k]);
     }
   }
 }
 
-void FastRouteCore::layerAssignmentV4()
+// Returns the box of the pins, tree nodes and maze routes of a net, bloated
+// by expand and clipped to bounds.  Nets without pins or tree get an
+// inverted box.
+odb::Rect FastRouteCore::netRouteBox(const int netID,
+                                     const int expand,
+                                     const odb::Rect& bounds) const
 {
-  int i, k, edgeID, nodeID, routeLen;
-  int n1, n2, connectionCNT;
-
-  int n1a, n2a;
-  std::queue<int> edgeQueue;
+  const FrNet* net = nets_[netID];
+  odb::Rect box;
+  box.mergeInit();
+  for (int i = 0; i < net->getNumPins(); i++) {
+    const int x = net->getPinX(i);
+    const int y = net->getPinY(i);
+    box.merge(odb::Rect(x, y, x, y));
+  }
+  for (const TreeNode& node : sttrees_[netID].nodes) {
+    box.merge(odb::Rect(node.x, node.y, node.x, node.y));
+  }
+  for (const TreeEdge& edge : sttrees_[netID].edges) {
+    if (edge.len == 0 || edge.route.type != RouteType::MazeRoute) {
+      continue;
+    }
+    for (int j = 0; j <= edge.route.routelen; j++) {
+      const int x = edge.route.gridsX[j];
+      const int y = edge.route.gridsY[j];
+      box.merge(odb::Rect(x, y, x, y));
+    }
+  }
+  if (box.isInverted()) {
+    return box;
+  }
+  return odb::Rect(std::max(box.xMin() - expand, bounds.xMin()),
+                   std::max(box.yMin() - expand, bounds.yMin()),
+                   std::min(box.xMax() + expand, bounds.xMax()),
+                   std::min(box.yMax() + expand, bounds.yMax()));
+}
 
-  TreeEdge* treeedge;
+// Splits items, in order, into batches whose boxes do not overlap.  An item
+// goes to the batch after the last earlier item it overlaps, so running the
+// batches one after the other keeps the order of conflicting items.  Boxes
+// are compared on a coarse grid of bins, sharing a bin counts as an overlap.
+// Inverted boxes overlap nothing.
+std::vector<std::vector<int>> FastRouteCore::batchByRegion(
+    const std::vector<odb::Rect>& boxes) const
+{
+  const int bin_size = std::max(1, std::max(x_grid_, y_grid_) / 64);
+  const int x_bins = x_grid_ / bin_size + 1;
+  const int y_bins = y_grid_ / bin_size + 1;
+  std::vector<int> bin_batch(x_bins * y_bins, -1);
+  std::vector<std::vector<int>> batches;
+  for (int i = 0; i < boxes.size(); i++) {
+    const odb::Rect& box = boxes[i];
+    int batch = 0;
+    if (!box.isInverted()) {
+      for (int y = box.yMin() / bin_size; y <= box.yMax() / bin_size; y++) {
+        for (int x = box.xMin() / bin_size; x <= box.xMax() / bin_size; x++) {
+          batch = std::max(batch, bin_batch[y * x_bins + x] + 1);
+        }
+      }
+      for (int y = box.yMin() / bin_size; y <= box.yMax() / bin_size; y++) {
+        for (int x = box.xMin() / bin_size; x <= box.xMax() / bin_size; x++) {
+          bin_batch[y * x_bins + x] = batch;
+        }
+      }
+    }
+    if (batch >= batches.size()) {
+      batches.resize(batch + 1);
+    }
+    batches[batch].push_back(i);
+  }
+  return batches;
+}
 
+void FastRouteCore::layerAssignmentV4()
+{
   for (const int& netID : net_ids_) {
     auto& treeedges = sttrees_[netID].edges;
-    for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      treeedge = &(treeedges[edgeID]);
+    for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+      TreeEdge* treeedge = &(treeedges[edgeID]);
       if (treeedge->len > 0) {
-        routeLen = treeedge->route.routelen;
+        const int routeLen = treeedge->route.routelen;
         treeedge->route.gridsL.resize(routeLen + 1, 0);
         treeedge->assigned = false;
       }
@@ -853,119 +921,179 @@ void FastRouteCore::layerAssignmentV4()
   }
   netpinOrderInc();
 
-  for (i = 0; i < tree_order_pv_.size(); i++) {
-    int netID = tree_order_pv_[i].treeIndex;
+  const int num_nets = tree_order_pv_.size();
+  if (thread_count_ <= 1) {
+    for (int i = 0; i < num_nets; i++) {
+      assignNetLayers(tree_order_pv_[i].treeIndex);
+    }
+    return;
+  }
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    const int num_terminals = sttrees_[netID].num_terminals;
+  // A net only reads and updates the 3D edges under its own route, so nets
+  // with disjoint route boxes are assigned concurrently.  Batches keep the
+  // order of overlapping nets and the result matches the sequential one.
+  std::vector<odb::Rect> boxes(num_nets);
+  for (int i = 0; i < num_nets; i++) {
+    odb::Rect& box = boxes[i];
+    box.mergeInit();
+    for (const TreeEdge& edge : sttrees_[tree_order_pv_[i].treeIndex].edges) {
+      if (edge.len <= 0) {
+        continue;
+      }
+      for (int j = 0; j <= edge.route.routelen; j++) {
+        const int x = edge.route.gridsX[j];
+        const int y = edge.route.gridsY[j];
+        box.merge(odb::Rect(x, y, x, y));
+      }
+    }
+  }
+  const std::vector<std::vector<int>> batches = batchByRegion(boxes);
 
-    for (nodeID = 0; nodeID < num_terminals; nodeID++) {
-      for (k = 0; k < treenodes[nodeID].conCNT; k++) {
-        edgeID = treenodes[nodeID].eID[k];
-        if (!treeedges[edgeID].assigned) {
-          edgeQueue.push(edgeID);
-          treeedges[edgeID].assigned = true;
-        }
+  debugPrint(logger_,
+             GRT,
+             "layer_assignment",
+             1,
+             "Assigning layers of {} nets in {} batches with {} threads.",
+             num_nets,
+             batches.size(),
+             thread_count_);
+
+  for (const std::vector<int>& batch : batches) {
+    std::exception_ptr exception = nullptr;
+#pragma omp parallel for schedule(dynamic) num_threads(thread_count_)
+    for (int i = 0; i < batch.size(); i++) {
+      try {
+        assignNetLayers(tree_order_pv_[batch[i]].treeIndex);
+      } catch (...) {
+#pragma omp critical
+        exception = std::current_exception();
       }
     }
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
 
-    while (!edgeQueue.empty()) {
-      edgeID = edgeQueue.front();
-      edgeQueue.pop();
-      treeedge = &(treeedges[edgeID]);
-      if (treenodes[treeedge->n1a].assigned) {
-        assignEdge(netID, edgeID, 1);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n2a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n2a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+void FastRouteCore::assignNetLayers(const int netID)
+{
+  int k, edgeID, nodeID, routeLen;
+  int n1, n2, connectionCNT;
+
+  int n1a, n2a;
+  std::queue<int> edgeQueue;
+
+  TreeEdge* treeedge;
+
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  const int num_terminals = sttrees_[netID].num_terminals;
+
+  for (nodeID = 0; nodeID < num_terminals; nodeID++) {
+    for (k = 0; k < treenodes[nodeID].conCNT; k++) {
+      edgeID = treenodes[nodeID].eID[k];
+      if (!treeedges[edgeID].assigned) {
+        edgeQueue.push(edgeID);
+        treeedges[edgeID].assigned = true;
+      }
+    }
+  }
+
+  while (!edgeQueue.empty()) {
+    edgeID = edgeQueue.front();
+    edgeQueue.pop();
+    treeedge = &(treeedges[edgeID]);
+    if (treenodes[treeedge->n1a].assigned) {
+      assignEdge(netID, edgeID, 1);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n2a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n2a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n2a].assigned = true;
         }
-      } else {
-        assignEdge(netID, edgeID, 0);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n1a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n1a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+        treenodes[treeedge->n2a].assigned = true;
+      }
+    } else {
+      assignEdge(netID, edgeID, 0);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n1a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n1a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n1a].assigned = true;
         }
+        treenodes[treeedge->n1a].assigned = true;
       }
     }
+  }
 
-    for (nodeID = 0; nodeID < sttrees_[netID].num_nodes(); nodeID++) {
-      treenodes[nodeID].topL = -1;
-      treenodes[nodeID].botL = num_layers_;
-      treenodes[nodeID].conCNT = 0;
-      treenodes[nodeID].hID = BIG_INT;
-      treenodes[nodeID].lID = BIG_INT;
-      treenodes[nodeID].status = 0;
-      treenodes[nodeID].assigned = false;
+  for (nodeID = 0; nodeID < sttrees_[netID].num_nodes(); nodeID++) {
+    treenodes[nodeID].topL = -1;
+    treenodes[nodeID].botL = num_layers_;
+    treenodes[nodeID].conCNT = 0;
+    treenodes[nodeID].hID = BIG_INT;
+    treenodes[nodeID].lID = BIG_INT;
+    treenodes[nodeID].status = 0;
+    treenodes[nodeID].assigned = false;
 
-      if (nodeID < num_terminals) {
-        treenodes[nodeID].botL = nets_[netID]->getPinL()[nodeID];
-        treenodes[nodeID].topL = nets_[netID]->getPinL()[nodeID];
-        treenodes[nodeID].assigned = true;
-        treenodes[nodeID].status = 1;
-      }
+    if (nodeID < num_terminals) {
+      treenodes[nodeID].botL = nets_[netID]->getPinL()[nodeID];
+      treenodes[nodeID].topL = nets_[netID]->getPinL()[nodeID];
+      treenodes[nodeID].assigned = true;
+      treenodes[nodeID].status = 1;
     }
+  }
 
-    for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      treeedge = &(treeedges[edgeID]);
+  for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    treeedge = &(treeedges[edgeID]);
 
-      if (treeedge->len > 0) {
-        routeLen = treeedge->route.routelen;
+    if (treeedge->len > 0) {
+      routeLen = treeedge->route.routelen;
 
-        n1 = treeedge->n1;
-        n2 = treeedge->n2;
-        const std::vector<short>& gridsL = treeedge->route.gridsL;
+      n1 = treeedge->n1;
+      n2 = treeedge->n2;
+      const std::vector<short>& gridsL = treeedge->route.gridsL;
 
-        n1a = treenodes[n1].stackAlias;
-        n2a = treenodes[n2].stackAlias;
-        connectionCNT = treenodes[n1a].conCNT;
-        treenodes[n1a].heights[connectionCNT] = gridsL[0];
-        treenodes[n1a].eID[connectionCNT] = edgeID;
-        treenodes[n1a].conCNT++;
+      n1a = treenodes[n1].stackAlias;
+      n2a = treenodes[n2].stackAlias;
+      connectionCNT = treenodes[n1a].conCNT;
+      treenodes[n1a].heights[connectionCNT] = gridsL[0];
+      treenodes[n1a].eID[connectionCNT] = edgeID;
+      treenodes[n1a].conCNT++;
 
-        if (gridsL[0] > treenodes[n1a].topL) {
-          treenodes[n1a].hID = edgeID;
-          treenodes[n1a].topL = gridsL[0];
-        }
-        if (gridsL[0] < treenodes[n1a].botL) {
-          treenodes[n1a].lID = edgeID;
-          treenodes[n1a].botL = gridsL[0];
-        }
+      if (gridsL[0] > treenodes[n1a].topL) {
+        treenodes[n1a].hID = edgeID;
+        treenodes[n1a].topL = gridsL[0];
+      }
+      if (gridsL[0] < treenodes[n1a].botL) {
+        treenodes[n1a].lID = edgeID;
+        treenodes[n1a].botL = gridsL[0];
+      }
 
-        treenodes[n1a].assigned = true;
+      treenodes[n1a].assigned = true;
 
-        connectionCNT = treenodes[n2a].conCNT;
-        treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
-        treenodes[n2a].eID[connectionCNT] = edgeID;
-        treenodes[n2a].conCNT++;
-        if (gridsL[routeLen] > treenodes[n2a].topL) {
-          treenodes[n2a].hID = edgeID;
-          treenodes[n2a].topL = gridsL[routeLen];
-        }
-        if (gridsL[routeLen] < treenodes[n2a].botL) {
-          treenodes[n2a].lID = edgeID;
-          treenodes[n2a].botL = gridsL[routeLen];
-        }
+      connectionCNT = treenodes[n2a].conCNT;
+      treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
+      treenodes[n2a].eID[connectionCNT] = edgeID;
+      treenodes[n2a].conCNT++;
+      if (gridsL[routeLen] > treenodes[n2a].topL) {
+        treenodes[n2a].hID = edgeID;
+        treenodes[n2a].topL = gridsL[routeLen];
+      }
+      if (gridsL[routeLen] < treenodes[n2a].botL) {
+        treenodes[n2a].lID = edgeID;
+        treenodes[n2a].botL = gridsL[routeLen];
+      }
 
-        treenodes[n2a].assigned = true;
+      treenodes[n2a].assigned = true;
 
-      }  // edge len > 0
-    }    // eunmerating edges
-  }
+    }  // edge len > 0
+  }    // eunmerating edges
 }
 
 void FastRouteCore::layerAssignment()
@@ -1237,13 +1365,13 @@ void FastRouteCore::StNetOrder()
           const int cap = getEdgeCapacity(
               nets_[netID], gridsX[i], min_y, EdgeDirection::Vertical);
           tree_order_cong_[j].xmin
-              += std::max(0, v_edges_[min_y][gridsX[i]].usage - cap);
+              += std::max(0, v_edges_.usage(min_y, gridsX[i]) - cap);
         } else {  // a horizontal edge
           min_x = std::min(gridsX[i], gridsX[i + 1]);
           const int cap = getEdgeCapacity(
               nets_[netID], min_x, gridsY[i], EdgeDirection::Horizontal);
           tree_order_cong_[j].xmin
-              += std::max(0, h_edges_[gridsY[i]][min_x].usage - cap);
+              += std::max(0, h_edges_.usage(gridsY[i], min_x) - cap);
         }
       }
     }
@@ -1377,16 +1505,16 @@ void FastRouteCore::recoverEdge(int netID, int edgeID)
       if (gridsX[i] == gridsX[i + 1])  // a vertical edge
       {
         ymin = std::min(gridsY[i], gridsY[i + 1]);
-        v_edges_[ymin][gridsX[i]].usage += net->getEdgeCost();
+        v_edges_.usage(ymin, gridsX[i]) += net->getEdgeCost();
         v_used_ggrid_.insert(std::make_pair(ymin, gridsX[i]));
-        v_edges_3D_[gridsL[i]][ymin][gridsX[i]].usage
+        v_edges_3D_.usage(gridsL[i], ymin, gridsX[i])
             += net->getLayerEdgeCost(gridsL[i]);
       } else if (gridsY[i] == gridsY[i + 1])  // a horizontal edge
       {
         xmin = std::min(gridsX[i], gridsX[i + 1]);
-        h_edges_[gridsY[i]][xmin].usage += net->getEdgeCost();
+        h_edges_.usage(gridsY[i], xmin) += net->getEdgeCost();
         h_used_ggrid_.insert(std::make_pair(gridsY[i], xmin));
-        h_edges_3D_[gridsL[i]][gridsY[i]][xmin].usage
+        h_edges_3D_.usage(gridsL[i], gridsY[i], xmin)
             += net->getLayerEdgeCost(gridsL[i]);
       }
     }
@@ -1417,11 +1545,11 @@ void FastRouteCore::removeLoops()
               if (gridsX[k] == gridsX[k + 1]) {
                 if (gridsY[k] != gridsY[k + 1]) {
                   const int min_y = std::min(gridsY[k], gridsY[k + 1]);
-                  v_edges_[min_y][gridsX[k]].usage -= edgeCost;
+                  v_edges_.usage(min_y, gridsX[k]) -= edgeCost;
                 }
               } else {
                 const int min_x = std::min(gridsX[k], gridsX[k + 1]);
-                h_edges_[gridsY[k]][min_x].usage -= edgeCost;
+                h_edges_.usage(gridsY[k], min_x) -= edgeCost;
               }
             }
 
@@ -1494,12 +1622,12 @@ void FastRouteCore::verifyEdgeUsage()
   for (int k = 0; k < num_layers_; k++) {
     for (int y = 0; y < y_grid_ - 1; ++y) {
       for (int x = 0; x < x_grid_; ++x) {
-        if (v_edges_3D[k][y][x] != v_edges_3D_[k][y][x].usage) {
+        if (v_edges_3D[k][y][x] != v_edges_3D_.usage(k, y, x)) {
           logger_->error(GRT,
                          1247,
                          "v_edge mismatch {} vs {}",
                          v_edges_3D[k][y][x],
-                         v_edges_3D_[k][y][x].usage);
+                         v_edges_3D_.usage(k, y, x));
         }
       }
     }
@@ -1507,12 +1635,12 @@ void FastRouteCore::verifyEdgeUsage()
   for (int k = 0; k < num_layers_; k++) {
     for (int y = 0; y < y_grid_; ++y) {
       for (int x = 0; x < x_grid_ - 1; ++x) {
-        if (h_edges_3D[k][y][x] != h_edges_3D_[k][y][x].usage) {
+        if (h_edges_3D[k][y][x] != h_edges_3D_.usage(k, y, x)) {
           logger_->error(GRT,
                          1248,
                          "h_edge mismatch {} vs {}",
                          h_edges_3D[k][y][x],
-                         h_edges_3D_[k][y][x].usage);
+                         h_edges_3D_.usage(k, y, x));
         }
       }
     }
@@ -1607,23 +1735,23 @@ void FastRouteCore::verify2DEdgesUsage()
   }
   for (int y = 0; y < y_grid_ - 1; ++y) {
     for (int x = 0; x < x_grid_; ++x) {
-      if (v_edges[y][x] != v_edges_[y][x].est_usage) {
+      if (v_edges[y][x] != v_edges_.est_usage(y, x)) {
         logger_->error(GRT,
                        247,
                        "v_edge mismatch {} vs {}",
                        v_edges[y][x],
-                       v_edges_[y][x].est_usage);
+                       v_edges_.est_usage(y, x));
       }
     }
   }
   for (int y = 0; y < y_grid_; ++y) {
     for (int x = 0; x < x_grid_ - 1; ++x) {
-      if (h_edges[y][x] != h_edges_[y][x].est_usage) {
+      if (h_edges[y][x] != h_edges_.est_usage(y, x)) {
         logger_->error(GRT,
                        248,
                        "h_edge mismatch {} vs {}",
                        h_edges[y][x],
-                       h_edges_[y][x].est_usage);
+                       h_edges_.est_usage(y, x));
       }
     }
   }
@@ -1637,28 +1765,28 @@ void FastRouteCore::check2DEdgesUsage()
 
   // check horizontal edges
   for (const auto& [i, j] : h_used_ggrid_) {
-    if (h_edges_[i][j].usage > max_h_edge_usage) {
+    if (h_edges_.usage(i, j) > max_h_edge_usage) {
       logger_->error(GRT,
                      228,
                      "Horizontal edge usage exceeds the maximum allowed. "
                      "({}, {}) usage={} limit={}",
                      i,
                      j,
-                     h_edges_[i][j].usage,
+                     h_edges_.usage(i, j),
                      max_h_edge_usage);
     }
   }
 
   // check vertical edges
   for (const auto& [i, j] : v_used_ggrid_) {
-    if (v_edges_[i][j].usage > max_v_edge_usage) {
+    if (v_edges_.usage(i, j) > max_v_edge_usage) {
       logger_->error(GRT,
                      229,
                      "Vertical edge usage exceeds the maximum allowed. "
                      "({}, {}) usage={} limit={}",
                      i,
                      j,
-                     v_edges_[i][j].usage,
+                     v_edges_.usage(i, j),
                      max_v_edge_usage);
     }
   }
@@ -1669,20 +1797,21 @@ static bool compareEdgeLen(const OrderNetEdge a, const OrderNetEdge b)
   return a.length > b.length;
 }
 
-void FastRouteCore::netedgeOrderDec(int netID)
+void FastRouteCore::netedgeOrderDec(int netID,
+                                    std::vector<OrderNetEdge>& net_eo)
 {
   const int numTreeedges = sttrees_[netID].num_edges();
 
-  net_eo_.clear();
+  net_eo.clear();
 
   for (int j = 0; j < numTreeedges; j++) {
     OrderNetEdge orderNet;
     orderNet.length = sttrees_[netID].edges[j].route.routelen;
     orderNet.edgeID = j;
-    net_eo_.push_back(orderNet);
+    net_eo.push_back(orderNet);
   }
 
-  std::stable_sort(net_eo_.begin(), net_eo_.end(), compareEdgeLen);
+  std::stable_sort(net_eo.begin(), net_eo.end(), compareEdgeLen);
 }
 
 void FastRouteCore::printEdge2D(int netID, int edgeID)
@@ -1901,10 +2030,10 @@ void FastRouteCore::copyBR(void)
             }
             if (gridsX[i] == gridsX[i + 1]) {
               min_y = std::min(gridsY[i], gridsY[i + 1]);
-              v_edges_[min_y][gridsX[i]].usage -= edgeCost;
+              v_edges_.usage(min_y, gridsX[i]) -= edgeCost;
             } else {
               min_x = std::min(gridsX[i], gridsX[i + 1]);
-              h_edges_[gridsY[i]][min_x].usage -= edgeCost;
+              h_edges_.usage(gridsY[i], min_x) -= edgeCost;
             }
           }
         }
@@ -1988,11 +2117,11 @@ void FastRouteCore::copyBR(void)
             }
             if (gridsX[i] == gridsX[i + 1]) {
               min_y = std::min(gridsY[i], gridsY[i + 1]);
-              v_edges_[min_y][gridsX[i]].usage += edgeCost;
+              v_edges_.usage(min_y, gridsX[i]) += edgeCost;
               v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
             } else {
               min_x = std::min(gridsX[i], gridsX[i + 1]);
-              h_edges_[gridsY[i]][min_x].usage += edgeCost;
+              h_edges_.usage(gridsY[i], min_x) += edgeCost;
               h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
             }
           }
@@ -2137,7 +2266,7 @@ int FastRouteCore::edgeShift(Tree& t, int net)
           for (j = minY; j <= maxY; j++) {
             costH[j] = 0;
             for (k = t.branch[n1].x; k < t.branch[n2].x; k++) {
-              costH[j] += h_edges_[j][k].est_usage;
+              costH[j] += h_edges_.est_usage(j, k);
             }
             // add the cost of all edges adjacent to the two steiner nodes
             for (l = 0; l < nbrCnt[n1]; l++) {
@@ -2160,12 +2289,12 @@ int FastRouteCore::edgeShift(Tree& t, int net)
                   bigY = j;
                 }
                 for (m = smallX; m < bigX; m++) {
-                  cost1 += h_edges_[smallY][m].est_usage;
-                  cost2 += h_edges_[bigY][m].est_usage;
+                  cost1 += h_edges_.est_usage(smallY, m);
+                  cost2 += h_edges_.est_usage(bigY, m);
                 }
                 for (m = smallY; m < bigY; m++) {
-                  cost1 += v_edges_[m][bigX].est_usage;
-                  cost2 += v_edges_[m][smallX].est_usage;
+                  cost1 += v_edges_.est_usage(m, bigX);
+                  cost2 += v_edges_.est_usage(m, smallX);
                 }
                 costH[j] += std::min(cost1, cost2);
               }  // if(n3!=n2)
@@ -2190,12 +2319,12 @@ int FastRouteCore::edgeShift(Tree& t, int net)
                   bigY = j;
                 }
                 for (m = smallX; m < bigX; m++) {
-                  cost1 += h_edges_[smallY][m].est_usage;
-                  cost2 += h_edges_[bigY][m].est_usage;
+                  cost1 += h_edges_.est_usage(smallY, m);
+                  cost2 += h_edges_.est_usage(bigY, m);
                 }
                 for (m = smallY; m < bigY; m++) {
-                  cost1 += v_edges_[m][bigX].est_usage;
-                  cost2 += v_edges_[m][smallX].est_usage;
+                  cost1 += v_edges_.est_usage(m, bigX);
+                  cost2 += v_edges_.est_usage(m, smallX);
                 }
                 costH[j] += std::min(cost1, cost2);
               }  // if(n3!=n1)
@@ -2248,7 +2377,7 @@ int FastRouteCore::edgeShift(Tree& t, int net)
           for (j = minX; j <= maxX; j++) {
             costV[j] = 0;
             for (k = t.branch[n1].y; k < t.branch[n2].y; k++) {
-              costV[j] += v_edges_[k][j].est_usage;
+              costV[j] += v_edges_.est_usage(k, j);
             }
             // add the cost of all edges adjacent to the two steiner nodes
             for (l = 0; l < nbrCnt[n1]; l++) {
@@ -2271,12 +2400,12 @@ int FastRouteCore::edgeShift(Tree& t, int net)
                   bigY = t.branch[n1].y;
                 }
                 for (m = smallX; m < bigX; m++) {
-                  cost1 += h_edges_[smallY][m].est_usage;
-                  cost2 += h_edges_[bigY][m].est_usage;
+                  cost1 += h_edges_.est_usage(smallY, m);
+                  cost2 += h_edges_.est_usage(bigY, m);
                 }
                 for (m = smallY; m < bigY; m++) {
-                  cost1 += v_edges_[m][bigX].est_usage;
-                  cost2 += v_edges_[m][smallX].est_usage;
+                  cost1 += v_edges_.est_usage(m, bigX);
+                  cost2 += v_edges_.est_usage(m, smallX);
                 }
                 costV[j] += std::min(cost1, cost2);
               }  // if(n3!=n2)
@@ -2301,12 +2430,12 @@ int FastRouteCore::edgeShift(Tree& t, int net)
                   bigY = t.branch[n2].y;
                 }
                 for (m = smallX; m < bigX; m++) {
-                  cost1 += h_edges_[smallY][m].est_usage;
-                  cost2 += h_edges_[bigY][m].est_usage;
+                  cost1 += h_edges_.est_usage(smallY, m);
+                  cost2 += h_edges_.est_usage(bigY, m);
                 }
                 for (m = smallY; m < bigY; m++) {
-                  cost1 += v_edges_[m][bigX].est_usage;
-                  cost2 += v_edges_[m][smallX].est_usage;
+                  cost1 += v_edges_.est_usage(m, bigX);
+                  cost2 += v_edges_.est_usage(m, smallX);
                 }
                 costV[j] += std::min(cost1, cost2);
               }  // if(n3!=n1)
@@ -0,0 +1,48 @@
+# check that -parallel_maze routes a congested gcd_nangate45 the same way
+# with 1 and 2 threads, and report its overflow and runtime next to the
+# sequential maze routing
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set guide_file1 [make_result_file gcd_parallel_maze1.guide]
+set guide_file2 [make_result_file gcd_parallel_maze2.guide]
+
+# same congestion as congestion1 so the maze routing iterations run
+set_global_routing_layer_adjustment metal2 0.9
+set_global_routing_layer_adjustment metal3 0.9
+set_global_routing_layer_adjustment metal4-metal10 1
+
+set_routing_layers -signal metal2-metal10
+
+proc route_and_report { label args } {
+  set start [clock milliseconds]
+  global_route -allow_congestion {*}$args
+  set runtime [expr [clock milliseconds] - $start]
+  set overflow [grt::total_overflow]
+  puts "$label: overflow $overflow runtime ${runtime}ms"
+  return $overflow
+}
+
+route_and_report "sequential"
+
+set overflow1 [route_and_report "parallel_maze 1 thread" \
+                 -parallel_maze -threads 1]
+write_guides $guide_file1
+
+set overflow2 [route_and_report "parallel_maze 2 threads" \
+                 -parallel_maze -threads 2]
+write_guides $guide_file2
+
+set isDiff [diff_files $guide_file1 $guide_file2]
+if { $overflow1 != $overflow2 } {
+  puts "parallel_maze overflow depends on the thread count"
+  incr isDiff
+}
+
+if { $isDiff != 0 } {
+  exit 1
+}
+
+puts "pass"
+exit
@@ -0,0 +1,31 @@
+# check that multi-threaded global routing matches the single threaded
+# gcd_nangate45 guides
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set guide_file [make_result_file gcd_threads.guide]
+set congested_file [make_result_file gcd_threads_congested.guide]
+
+# pattern routing and layer assignment
+global_route -threads 2
+write_guides $guide_file
+set isDiff [diff_files gcd.guideok $guide_file]
+
+# same congestion as congestion1 so the maze routing iterations run
+set_global_routing_layer_adjustment metal2 0.9
+set_global_routing_layer_adjustment metal3 0.9
+set_global_routing_layer_adjustment metal4-metal10 1
+
+set_routing_layers -signal metal2-metal10
+
+global_route -allow_congestion -threads 2
+write_guides $congested_file
+incr isDiff [diff_files congestion1.guideok $congested_file]
+
+if { $isDiff != 0 } {
+  exit 1
+}
+
+puts "pass"
+exit
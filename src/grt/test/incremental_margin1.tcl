@@ -0,0 +1,51 @@
+# check that incremental global routing of gcd_nangate45 stays free of
+# overflow with the smallest and the default -incremental_margin, and
+# report the runtime of each reroute
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set_global_routing_layer_adjustment metal2-metal10 0.5
+set_routing_layers -signal metal2-metal10
+
+# the FIXED PHY_* filler cells cannot be moved
+proc move_insts { step dx dy } {
+  set i 0
+  foreach inst [[ord::get_db_block] getInsts] {
+    if { $i % $step == 0 && ![$inst isFixed] } {
+      lassign [$inst getLocation] x y
+      $inst setLocation [expr { $x + $dx }] [expr { $y + $dy }]
+    }
+    incr i
+  }
+}
+
+global_route
+set failed 0
+
+foreach { margin step dx dy } { 20 25 2000 2800 40 40 -3000 1400 } {
+  global_route -start_incremental
+  move_insts $step $dx $dy
+  set start [clock milliseconds]
+  global_route -end_incremental -incremental_margin $margin
+  set runtime [expr [clock milliseconds] - $start]
+  set overflow [grt::total_overflow]
+  puts "margin $margin: overflow $overflow runtime ${runtime}ms"
+  if { $overflow != 0 } {
+    incr failed
+  }
+}
+
+if { ![catch { global_route -incremental_margin 19 } error] } {
+  puts "-incremental_margin 19 was accepted"
+  incr failed
+} else {
+  puts $error
+}
+
+if { $failed != 0 } {
+  exit 1
+}
+
+puts "pass"
+exit
@@ -60,6 +60,7 @@ record_tests {
   set_nets_to_route1
   silence
   single_row
+  snapshot1
   top_level_term1
   top_level_term2
   top_level_term3
@@ -73,3 +74,9 @@ record_tests {
   #grt_man_tcl_check
   #grt_readme_msgs_check
 }
+record_pass_fail_tests {
+  gcd_parallel_maze
+  gcd_threads
+  incremental_margin1
+  rudy_update1
+}
@@ -0,0 +1,45 @@
+# check that updating the RUDY after moving some instances of gcd_nangate45
+# gives the same tiles as computing it from scratch
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+proc rudy_tiles {} {
+  set tiles {}
+  for { set x 0 } { $x < [grt::rudy_tile_count_x] } { incr x } {
+    for { set y 0 } { $y < [grt::rudy_tile_count_y] } { incr y } {
+      lappend tiles [grt::rudy_tile $x $y]
+    }
+  }
+  return $tiles
+}
+
+# the FIXED PHY_* filler cells cannot be moved
+proc move_insts { step dx dy } {
+  set i 0
+  foreach inst [[ord::get_db_block] getInsts] {
+    if { $i % $step == 0 && ![$inst isFixed] } {
+      lassign [$inst getLocation] x y
+      $inst setLocation [expr { $x + $dx }] [expr { $y + $dy }]
+    }
+    incr i
+  }
+}
+
+grt::calculate_rudy
+
+# chain several updates so that any drift between them accumulates
+foreach { step dx dy } { 25 2000 2800 40 -3000 1400 25 -2000 -2800 } {
+  move_insts $step $dx $dy
+  grt::update_rudy
+}
+set updated [rudy_tiles]
+
+grt::calculate_rudy
+if { $updated != [rudy_tiles] } {
+  puts "Updated RUDY differs from the calculated one."
+  exit 1
+}
+
+puts "pass"
+exit
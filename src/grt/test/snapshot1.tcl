@@ -0,0 +1,18 @@
+# write a global route snapshot and check the routes read back from it
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set snapshot_file [make_result_file snapshot1.grt]
+set segs_file [make_result_file snapshot1.segs]
+set read_segs_file [make_result_file snapshot1_read.segs]
+
+global_route
+
+write_global_route_segments $segs_file
+write_global_route_snapshot $snapshot_file
+
+read_global_route_snapshot $snapshot_file
+write_global_route_segments $read_segs_file
+
+diff_files $segs_file $read_segs_file
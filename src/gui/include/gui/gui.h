@@ -678,8 +678,9 @@ class Gui
   void timingCone(odbTerm term, bool fanin, bool fanout);
   void timingPathsThrough(const std::set<odbTerm>& terms);
 
-  // open DRC
-  void loadDRC(const std::string& filename);
+  // open DRC, binary reports (.drcb) can be limited to a region
+  void loadDRC(const std::string& filename,
+               const odb::Rect& region = odb::Rect());
 
   // Force an immediate redraw.
   void redraw();
@@ -39,14 +39,17 @@
 #include <QFileDialog>
 #include <QHeaderView>
 #include <QVBoxLayout>
+#include <algorithm>
 #include <array>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/regex.hpp>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <map>
 #include <regex>
 #include <sstream>
+#include <type_traits>
 
 #include "utl/Logger.h"
 
@@ -54,6 +57,40 @@ Q_DECLARE_METATYPE(gui::DRCViolation*);
 
 namespace gui {
 
+namespace {
+
+// little endian integer read for the binary DRC report
+template <typename T>
+T readBinary(std::istream& in)
+{
+  using U = std::make_unsigned_t<T>;
+  unsigned char bytes[sizeof(T)];
+  in.read(reinterpret_cast<char*>(bytes), sizeof(T));
+  U value = 0;
+  for (size_t i = sizeof(T); i > 0; --i) {
+    value = (value << 8) | bytes[i - 1];
+  }
+  return static_cast<T>(value);
+}
+
+std::string readBinaryString(std::istream& in)
+{
+  std::string str(readBinary<uint32_t>(in), '\0');
+  in.read(str.data(), str.size());
+  return str;
+}
+
+odb::Rect readBinaryRect(std::istream& in)
+{
+  const int xlo = readBinary<int32_t>(in);
+  const int ylo = readBinary<int32_t>(in);
+  const int xhi = readBinary<int32_t>(in);
+  const int yhi = readBinary<int32_t>(in);
+  return odb::Rect(xlo, ylo, xhi, yhi);
+}
+
+}  // namespace
+
 ///////
 
 DRCViolation::DRCViolation(const std::string& name,
@@ -313,8 +350,9 @@ void DRCWidget::selectReport()
       this,
       tr("DRC Report"),
       QString(),
-      tr("DRC Report (*.rpt *.drc *.json);;TritonRoute Report (*.rpt "
-         "*.drc);;JSON (*.json);;All (*)"));
+      tr("DRC Report (*.rpt *.drc *.json *.drcb);;TritonRoute Report (*.rpt "
+         "*.drc);;TritonRoute Binary Report (*.drcb);;JSON (*.json);;All "
+         "(*)"));
   if (!filename.isEmpty()) {
     loadReport(filename);
   }
@@ -485,7 +523,7 @@ void DRCWidget::updateSelection(const Selected& selection)
   }
 }
 
-void DRCWidget::loadReport(const QString& filename)
+void DRCWidget::loadReport(const QString& filename, const odb::Rect& region)
 {
   Gui::get()->removeSelected<DRCViolation*>();
 
@@ -497,6 +535,8 @@ void DRCWidget::loadReport(const QString& filename)
       loadTRReport(filename);
     } else if (filename.endsWith(".json")) {
       loadJSONReport(filename);
+    } else if (filename.endsWith(".drcb")) {
+      loadBinaryReport(filename, region);
     } else {
       logger_->error(utl::GUI,
                      32,
@@ -633,102 +673,9 @@ void DRCWidget::loadTRReport(const QString& filename)
     }
 
     std::vector<std::any> srcs_list;
-    std::stringstream srcs_stream(sources);
-    std::string single_source;
     std::string comment;
-
-    // split sources list
-    while (getline(srcs_stream, single_source, ' ')) {
-      if (single_source.empty()) {
-        continue;
-      }
-
-      auto ident = single_source.find(':');
-      std::string item_type = single_source.substr(0, ident);
-      std::string item_name = single_source.substr(ident + 1);
-
-      std::any item = nullptr;
-
-      if (item_type == "net") {
-        odb::dbNet* net = block_->findNet(item_name.c_str());
-        if (net != nullptr) {
-          item = net;
-        } else {
-          logger_->warn(utl::GUI,
-                        44,
-                        "Unable to find net (line: {}): {}",
-                        source_line_number,
-                        item_name);
-        }
-      } else if (item_type == "inst") {
-        odb::dbInst* inst = block_->findInst(item_name.c_str());
-        if (inst != nullptr) {
-          item = inst;
-        } else {
-          logger_->warn(utl::GUI,
-                        43,
-                        "Unable to find instance (line: {}): {}",
-                        source_line_number,
-                        item_name);
-        }
-      } else if (item_type == "iterm") {
-        odb::dbITerm* iterm = block_->findITerm(item_name.c_str());
-        if (iterm != nullptr) {
-          item = iterm;
-        } else {
-          logger_->warn(utl::GUI,
-                        42,
-                        "Unable to find iterm (line: {}): {}",
-                        source_line_number,
-                        item_name);
-        }
-      } else if (item_type == "bterm") {
-        odb::dbBTerm* bterm = block_->findBTerm(item_name.c_str());
-        if (bterm != nullptr) {
-          item = bterm;
-        } else {
-          logger_->warn(utl::GUI,
-                        41,
-                        "Unable to find bterm (line: {}): {}",
-                        source_line_number,
-                        item_name);
-        }
-      } else if (item_type == "obstruction") {
-        bool found = false;
-        if (layer != nullptr) {
-          for (const auto obs : block_->getObstructions()) {
-            auto obs_bbox = obs->getBBox();
-            if (obs_bbox->getTechLayer() == layer) {
-              odb::Rect obs_rect = obs_bbox->getBox();
-              if (obs_rect.intersects(rect)) {
-                srcs_list.emplace_back(obs);
-                found = true;
-              }
-            }
-          }
-        }
-        if (!found) {
-          logger_->warn(utl::GUI,
-                        52,
-                        "Unable to find obstruction (line: {})",
-                        source_line_number);
-        }
-      } else {
-        logger_->warn(utl::GUI,
-                      51,
-                      "Unknown source type (line: {}): {}",
-                      source_line_number,
-                      item_type);
-      }
-
-      if (item.has_value()) {
-        srcs_list.push_back(item);
-      } else {
-        if (!item_name.empty()) {
-          comment += single_source + " ";
-        }
-      }
-    }
+    parseTRSources(
+        sources, layer, rect, source_line_number, srcs_list, comment);
 
     std::string name = "Layer: ";
     if (layer != nullptr) {
@@ -748,6 +695,270 @@ void DRCWidget::loadTRReport(const QString& filename)
   report.close();
 }
 
+void DRCWidget::parseTRSources(const std::string& sources,
+                               odb::dbTechLayer* layer,
+                               const odb::Rect& rect,
+                               int source_line_number,
+                               std::vector<std::any>& srcs_list,
+                               std::string& comment)
+{
+  std::stringstream srcs_stream(sources);
+  std::string single_source;
+
+  // split sources list
+  while (getline(srcs_stream, single_source, ' ')) {
+    if (single_source.empty()) {
+      continue;
+    }
+
+    auto ident = single_source.find(':');
+    std::string item_type = single_source.substr(0, ident);
+    std::string item_name = single_source.substr(ident + 1);
+
+    std::any item = nullptr;
+
+    if (item_type == "net") {
+      odb::dbNet* net = block_->findNet(item_name.c_str());
+      if (net != nullptr) {
+        item = net;
+      } else {
+        logger_->warn(utl::GUI,
+                      44,
+                      "Unable to find net (line: {}): {}",
+                      source_line_number,
+                      item_name);
+      }
+    } else if (item_type == "inst") {
+      odb::dbInst* inst = block_->findInst(item_name.c_str());
+      if (inst != nullptr) {
+        item = inst;
+      } else {
+        logger_->warn(utl::GUI,
+                      43,
+                      "Unable to find instance (line: {}): {}",
+                      source_line_number,
+                      item_name);
+      }
+    } else if (item_type == "iterm") {
+      odb::dbITerm* iterm = block_->findITerm(item_name.c_str());
+      if (iterm != nullptr) {
+        item = iterm;
+      } else {
+        logger_->warn(utl::GUI,
+                      42,
+                      "Unable to find iterm (line: {}): {}",
+                      source_line_number,
+                      item_name);
+      }
+    } else if (item_type == "bterm") {
+      odb::dbBTerm* bterm = block_->findBTerm(item_name.c_str());
+      if (bterm != nullptr) {
+        item = bterm;
+      } else {
+        logger_->warn(utl::GUI,
+                      41,
+                      "Unable to find bterm (line: {}): {}",
+                      source_line_number,
+                      item_name);
+      }
+    } else if (item_type == "obstruction") {
+      bool found = false;
+      if (layer != nullptr) {
+        for (const auto obs : block_->getObstructions()) {
+          auto obs_bbox = obs->getBBox();
+          if (obs_bbox->getTechLayer() == layer) {
+            odb::Rect obs_rect = obs_bbox->getBox();
+            if (obs_rect.intersects(rect)) {
+              srcs_list.emplace_back(obs);
+              found = true;
+            }
+          }
+        }
+      }
+      if (!found) {
+        logger_->warn(utl::GUI,
+                      52,
+                      "Unable to find obstruction (line: {})",
+                      source_line_number);
+      }
+    } else {
+      logger_->warn(utl::GUI,
+                    51,
+                    "Unknown source type (line: {}): {}",
+                    source_line_number,
+                    item_type);
+    }
+
+    if (item.has_value()) {
+      srcs_list.push_back(item);
+    } else {
+      if (!item_name.empty()) {
+        comment += single_source + " ";
+      }
+    }
+  }
+}
+
+// Loads the tiled binary report written by detailed_route (.drcb).  Only
+// the chunks whose bbox intersects region are read; an empty region loads
+// the whole report.
+void DRCWidget::loadBinaryReport(const QString& filename,
+                                 const odb::Rect& region)
+{
+  constexpr char magic[4] = {'D', 'R', 'C', 'B'};
+  constexpr uint8_t version = 1;
+  constexpr int trailer_size = sizeof(uint64_t) + sizeof(magic);
+
+  std::ifstream report(filename.toStdString(), std::ios::binary);
+  if (!report.is_open()) {
+    logger_->error(utl::GUI,
+                   104,
+                   "Unable to open TritonRoute binary DRC report: {}",
+                   filename.toStdString());
+  }
+
+  auto check_magic = [&](std::istream& in) {
+    char bytes[sizeof(magic)];
+    in.read(bytes, sizeof(bytes));
+    if (!in || !std::equal(bytes, bytes + sizeof(magic), magic)) {
+      logger_->error(utl::GUI,
+                     105,
+                     "{} is not a TritonRoute binary DRC report.",
+                     filename.toStdString());
+    }
+  };
+
+  // header
+  check_magic(report);
+  const uint8_t file_version = readBinary<uint8_t>(report);
+  if (file_version != version) {
+    logger_->error(utl::GUI,
+                   106,
+                   "Unsupported binary DRC report version {} in {}.",
+                   static_cast<int>(file_version),
+                   filename.toStdString());
+  }
+  report.ignore(3);
+  const int file_dbu = readBinary<int32_t>(report);
+  readBinary<int32_t>(report);  // tile size
+  const double scale
+      = file_dbu > 0 ? block_->getDbUnitsPerMicron() / double(file_dbu) : 1.0;
+  // region is in block DBU, the index and records are in the file's DBU
+  odb::Rect file_region = region;
+  if (scale != 1.0 && region.area() != 0) {
+    file_region = odb::Rect(std::floor(region.xMin() / scale),
+                            std::floor(region.yMin() / scale),
+                            std::ceil(region.xMax() / scale),
+                            std::ceil(region.yMax() / scale));
+  }
+
+  // trailer and index
+  report.seekg(-trailer_size, std::ios::end);
+  const uint64_t index_offset = readBinary<uint64_t>(report);
+  check_magic(report);
+  report.seekg(index_offset);
+
+  auto tech = block_->getDataBase()->getTech();
+  std::vector<odb::dbTechLayer*> layers;
+  for (uint32_t i = readBinary<uint32_t>(report); i > 0; --i) {
+    const std::string layer_name = readBinaryString(report);
+    layers.push_back(tech->findLayer(layer_name.c_str()));
+    if (layers.back() == nullptr) {
+      logger_->warn(
+          utl::GUI, 107, "Unable to find tech layer: {}", layer_name);
+    }
+  }
+  std::vector<std::string> types;
+  for (uint32_t i = readBinary<uint32_t>(report); i > 0; --i) {
+    types.push_back(readBinaryString(report));
+  }
+
+  struct Chunk
+  {
+    odb::Rect bbox;
+    uint64_t offset;
+    uint32_t count;
+    int first_record;
+  };
+  std::vector<Chunk> chunks;
+  for (uint32_t i = readBinary<uint32_t>(report); i > 0; --i) {
+    readBinary<uint16_t>(report);  // layer
+    const odb::Rect bbox = readBinaryRect(report);
+    const uint64_t offset = readBinary<uint64_t>(report);
+    const uint32_t count = readBinary<uint32_t>(report);
+    chunks.push_back({bbox, offset, count, 0});
+  }
+  if (!report) {
+    logger_->error(utl::GUI,
+                   108,
+                   "Truncated binary DRC report index in {}.",
+                   filename.toStdString());
+  }
+
+  // Violations are numbered by their position in the file, so loading a
+  // region shows the same numbers as loading the whole report.
+  std::sort(chunks.begin(), chunks.end(), [](const Chunk& a, const Chunk& b) {
+    return a.offset < b.offset;
+  });
+  int first_record = 0;
+  for (auto& chunk : chunks) {
+    chunk.first_record = first_record;
+    first_record += chunk.count;
+  }
+  if (file_region.area() != 0) {
+    chunks.erase(std::remove_if(chunks.begin(),
+                                chunks.end(),
+                                [&](const Chunk& chunk) {
+                                  return !file_region.intersects(chunk.bbox);
+                                }),
+                 chunks.end());
+  }
+
+  for (const auto& chunk : chunks) {
+    report.seekg(chunk.offset);
+    for (uint32_t i = 0; i < chunk.count; ++i) {
+      const int record = chunk.first_record + i + 1;
+      const uint16_t layer_idx = readBinary<uint16_t>(report);
+      const uint16_t type_idx = readBinary<uint16_t>(report);
+      odb::Rect rect = readBinaryRect(report);
+      const std::string sources = readBinaryString(report);
+      if (!report || layer_idx >= layers.size() || type_idx >= types.size()) {
+        logger_->error(utl::GUI,
+                       109,
+                       "Corrupt binary DRC report record {} in {}.",
+                       record,
+                       filename.toStdString());
+      }
+      if (file_region.area() != 0 && !file_region.intersects(rect)) {
+        continue;
+      }
+      if (scale != 1.0) {
+        rect = odb::Rect(rect.xMin() * scale,
+                         rect.yMin() * scale,
+                         rect.xMax() * scale,
+                         rect.yMax() * scale);
+      }
+
+      odb::dbTechLayer* layer = layers[layer_idx];
+      std::vector<std::any> srcs_list;
+      std::string comment;
+      parseTRSources(sources, layer, rect, record, srcs_list, comment);
+
+      const std::string name
+          = "Layer: " + (layer != nullptr ? layer->getName() : "<unknown>")
+            + ", Sources: " + sources;
+      std::vector<DRCViolation::DRCShape> shapes({rect});
+      violations_.push_back(std::make_unique<DRCViolation>(name,
+                                                           types[type_idx],
+                                                           srcs_list,
+                                                           shapes,
+                                                           layer,
+                                                           comment,
+                                                           record));
+    }
+  }
+}
+
 void DRCWidget::loadJSONReport(const QString& filename)
 {
   boost::property_tree::ptree tree;
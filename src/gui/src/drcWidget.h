@@ -167,7 +167,8 @@ class DRCWidget : public QDockWidget
   void focus(const Selected& selected);
 
  public slots:
-  void loadReport(const QString& filename);
+  void loadReport(const QString& filename,
+                  const odb::Rect& region = odb::Rect());
   void setBlock(odb::dbBlock* block);
   void clicked(const QModelIndex& index);
   void selectReport();
@@ -188,6 +189,13 @@ class DRCWidget : public QDockWidget
  private:
   void loadTRReport(const QString& filename);
   void loadJSONReport(const QString& filename);
+  void loadBinaryReport(const QString& filename, const odb::Rect& region);
+  void parseTRSources(const std::string& sources,
+                      odb::dbTechLayer* layer,
+                      const odb::Rect& rect,
+                      int source_line_number,
+                      std::vector<std::any>& srcs_list,
+                      std::string& comment);
   void updateModel();
 
   utl::Logger* logger_;
@@ -600,10 +600,11 @@ std::string Gui::requestUserInput(const std::string& title,
                                        QString::fromStdString(question));
 }
 
-void Gui::loadDRC(const std::string& filename)
+void Gui::loadDRC(const std::string& filename, const odb::Rect& region)
 {
   if (!filename.empty()) {
-    main_window->getDRCViewer()->loadReport(QString::fromStdString(filename));
+    main_window->getDRCViewer()->loadReport(QString::fromStdString(filename),
+                                            region);
   }
 }
 
@@ -451,6 +451,15 @@ void load_drc(const char* filename)
   gui->loadDRC(filename);
 }
 
+void load_drc_region(const char* filename, double xlo, double ylo, double xhi, double yhi)
+{
+  if (!check_gui("load_drc_region")) {
+    return;
+  }
+  auto gui = gui::Gui::get();
+  gui->loadDRC(filename, make_rect(xlo, ylo, xhi, yhi));
+}
+
 void show_widget(const char* name)
 {
   if (!check_gui("show_widget")) {
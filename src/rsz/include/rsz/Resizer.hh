@@ -369,14 +369,15 @@ class Resizer : public dbStaState
   ////////////////////////////////////////////////////////////////
   // API for timing driven placement.
   // Each pass (findResizeSlacks)
-  //  estiimate parasitics
+  //  estiimate parasitics (only invalid nets when incremental)
   //  repair design
   //  save slacks
   //  remove inserted buffers
   //  restore resized gates
   // resizeSlackPreamble must be called before the first findResizeSlacks.
   void resizeSlackPreamble();
-  void findResizeSlacks();
+  // Returns the number of nets with re-estimated parasitics.
+  int findResizeSlacks(bool incremental = false);
   // Return nets with worst slack.
   NetSeq& resizeWorstSlackNets();
   // Return net slack, if any (indicated by the bool).
@@ -1264,10 +1264,21 @@ void Resizer::resizeSlackPreamble()
 
 // Run repair_design to repair long wires and max slew, capacitance and fanout
 // violations. Find the slacks, and then undo all changes to the netlist.
-void Resizer::findResizeSlacks()
+// With incremental, only the nets marked by parasiticsInvalid since the
+// previous pass are re-estimated and STA only updates the affected delays.
+// Returns the number of nets with re-estimated parasitics.
+int Resizer::findResizeSlacks(bool incremental)
 {
   journalBegin();
-  estimateWireParasitics();
+  int estimated_net_count = 0;
+  if (incremental && parasitics_src_ == ParasiticsSrc::placement) {
+    // updateParasitics must run before repairDesign clears the invalid nets.
+    estimated_net_count = parasitics_invalid_.size();
+    updateParasitics();
+  } else {
+    estimateWireParasitics();
+    estimated_net_count = block_->getNets().size();
+  }
   int repaired_net_count, slew_violations, cap_violations;
   int fanout_violations, length_violations;
   repair_design_->repairDesign(max_wire_length_,
@@ -1284,6 +1295,7 @@ void Resizer::findResizeSlacks()
                  inserted_buffer_count_,
                  cloned_gate_count_,
                  removed_buffer_count_);
+  return estimated_net_count;
 }
 
 void Resizer::findResizeSlacks1()
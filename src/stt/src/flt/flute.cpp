@@ -33,12 +33,14 @@
 #include "stt/flute.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
 
 // Use flute LUT file reader.
@@ -215,7 +217,10 @@ static void checkLUT(LUT_TYPE LUT1,
 
 // LUTs are initialized to this order at startup.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+// Set once the LUTs are filled up to this order so the threads building
+// trees concurrently only lock while the tables are being built.
+static std::atomic<int> lut_valid_d{0};
+static std::mutex lut_mutex;
 
 extern std::string post9;
 extern std::string powv9;
@@ -255,7 +260,11 @@ static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln)
 
 void deleteLUT()
 {
+  std::lock_guard<std::mutex> lock(lut_mutex);
   deleteLUT(LUT, numsoln);
+  LUT = nullptr;
+  numsoln = nullptr;
+  lut_valid_d = 0;
 }
 
 static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln)
@@ -378,6 +387,11 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 
 static void ensureLUT(int d)
 {
+  const int valid_d = lut_valid_d.load(std::memory_order_acquire);
+  if (valid_d > 0 && (d <= valid_d || d > FLUTE_D)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(lut_mutex);
   if (LUT == nullptr) {
     readLUT();
   }